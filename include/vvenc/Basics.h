@@ -47,6 +47,7 @@ vvc@hhi.fraunhofer.de
 
 #include <cstdint>
 #include <cstdarg>
+#include <cstddef>
 #include <vector>
 
 //! \ingroup Interface
@@ -266,6 +267,58 @@ struct YUVBuffer
 
 // ====================================================================================================================
 
+/// subsystems the encoder memory is accounted to
+enum MemTag
+{
+  MEM_TAG_OTHER     = 0,       ///< memory not attributed to one of the subsystems below
+  MEM_TAG_PICTURES,            ///< pictures of the input queue and the decoded picture buffer
+  MEM_TAG_MCTF,                ///< temporal filter, incl. lead/trail pictures and padded copies
+  MEM_TAG_LINE_RSRC,           ///< slice encoder resources per CTU line (WPP)
+  MEM_TAG_CTU_RSRC,            ///< slice encoder resources per thread, incl. the coding structure tree of the CU encoder
+  MEM_TAG_ALF,                 ///< adaptive loop filter statistics
+  NUM_MEM_TAGS
+};
+
+struct MemUsage
+{
+  size_t curBytes [ NUM_MEM_TAGS ];
+  size_t peakBytes[ NUM_MEM_TAGS ];
+  size_t curTotal;
+  size_t peakTotal;            ///< peak of the total, less or equal to the sum of the subsystem peaks
+
+  MemUsage()
+  : curTotal ( 0 )
+  , peakTotal( 0 )
+  {
+    for( int i = 0; i < NUM_MEM_TAGS; i++ )
+    {
+      curBytes [ i ] = 0;
+      peakBytes[ i ] = 0;
+    }
+  }
+};
+
+/// state of the encoder input queue
+struct InputQueueStatus
+{
+  int    numPics;              ///< input pictures received but not yet encoded
+  int    numMctfPics;          ///< MCTF lead and trail pictures held in addition to the queued pictures
+  int    maxPics;              ///< maximum number of queued pictures (0: unbounded, pictures are encoded while they are passed)
+  size_t bytes;                ///< memory held by the queued pictures and the temporal filter
+  bool   wouldBlock;           ///< the next input picture is not accepted before a queued picture has been encoded
+
+  InputQueueStatus()
+  : numPics    ( 0 )
+  , numMctfPics( 0 )
+  , maxPics    ( 0 )
+  , bytes      ( 0 )
+  , wouldBlock ( false )
+  {
+  }
+};
+
+// ====================================================================================================================
+
 struct ChromaQpMappingTableParams
 {
   int               m_numQpTables;
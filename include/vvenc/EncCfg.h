@@ -230,6 +230,8 @@ public:
   int                 m_DecodingRefreshType;                            ///< random access type
   int                 m_GOPSize;                                        ///< GOP size of hierarchical structure
   int                 m_InputQueueSize;                                 ///< Size of frame input queue
+  int                 m_InputQueueMaxSize;                              ///< maximum number of queued input pictures, input and encoding are decoupled and encode would block beyond (0: off)
+  int                 m_sceneCutThreshold;                              ///< lookahead scene cut detection threshold in percent, a CRA picture is inserted at the next GOP boundary (0: off)
   bool                m_rewriteParamSets;                               ///< Flag to enable rewriting of parameter sets at random access points
   bool                m_idrRefParamList;                                ///< indicates if reference picture list syntax elements are present in slice headers of IDR pictures
   RPLEntry            m_RPLList0[ MAX_GOP ];                            ///< the RPL entries from the config file
@@ -242,6 +244,7 @@ public:
   int                 m_numRPLList1;
 
   int                 m_QP;                                             ///< QP value of key-picture (integer)
+  bool                m_constQuality;                                   ///< constant quality mode, m_QP acts as quality factor and the picture QPs follow the pre-analysed complexity
   bool                m_useSameChromaQPTables;
   ChromaQpMappingTableParams m_chromaQpMappingTableParams;
   int                 m_intraQPOffset;                                  ///< QP offset for intra slice (integer)
@@ -329,6 +332,9 @@ public:
   bool                m_useAMaxBT;
   bool                m_fastQtBtEnc;
   bool                m_contentBasedFastQtbt;
+  bool                m_splitPredictor;                                 ///< prune binary and ternary splits with the compiled-in decision tree
+  double              m_splitPredictorThreshold;                        ///< split probability below which a split is not tested
+  std::string         m_splitPredictorDumpFile;                         ///< file to write the split predictor training samples to
   int                 m_fastInterSearchMode;                            ///< Parameter that controls fast encoder settings
   bool                m_bUseEarlyCU;                                    ///< flag for using Early CU setting
   bool                m_useFastDecisionForMerge;                        ///< flag for using Fast Decision Merge RD-Cost
@@ -337,6 +343,13 @@ public:
   bool                m_bDisableIntraPUsInInterSlices;                  ///< Flag for disabling intra predicted PUs in inter slices.
   bool                m_bUseConstrainedIntraPred;                       ///< flag for using constrained intra prediction
   bool                m_bFastUDIUseMPMEnabled;
+  bool                m_fastIntraAngles;                                ///< restrict the intra SATD search to every fourth angular mode
+  int                 m_maxIntraRdCand;                                 ///< maximum number of intra modes checked with full RD after the SATD search (0: size dependent)
+  int                 m_maxMergeRdCand;                                 ///< maximum number of merge candidates checked with full RD after the SATD search (0: unrestricted)
+  int                 m_speedCtrlFps;                                   ///< target encoding frame rate of the real-time speed control (0: off)
+  int                 m_analysisMode;                                   ///< shared analysis (0: off, 1: save the analysis of this encoding, 2: load and reuse a saved analysis)
+  std::string         m_analysisFileName;                               ///< analysis file written in save and read in load mode
+  int                 m_analysisReuseLevel;                             ///< reuse of a loaded analysis (1: MCTF motion and motion search start, 2: additionally restrict the partitioning)
   bool                m_bFastMEForGenBLowDelayEnabled;
 
   bool                m_MTSImplicit;
@@ -357,6 +370,11 @@ public:
   bool                m_RCUseLCUSeparateModel;
   int                 m_RCInitialQP;
   bool                m_RCForceIntraQP;
+  int                 m_RCPass;                                         ///< two-pass rate control (0: single pass, 1: first pass writing statistics, 2: second pass reading statistics)
+  std::string         m_RCStatsFileName;                                ///< rate control statistics file of the two-pass mode
+  int                 m_RCMaxBitrate;                                   ///< maximum bit rate of the video buffering verifier (0: no VBV constraint)
+  int                 m_RCCpbSize;                                      ///< coded picture buffer size of the video buffering verifier in bits (0: one second at the maximum bit rate)
+  double              m_RCInitialCpbFullness;                           ///< initial coded picture buffer fullness relative to the buffer size
   int                 m_motionEstimationSearchMethod;
   bool                m_bRestrictMESampling;                            ///< Restrict sampling for the Selective ME
   int                 m_SearchRange;                                    ///< ME search range
@@ -364,6 +382,7 @@ public:
   int                 m_minSearchWindow;                                ///< ME minimum search window size for the Adaptive Window ME
   bool                m_bClipForBiPredMeEnabled;                        ///< Enables clipping for Bi-Pred ME.
   bool                m_bFastMEAssumingSmootherMVEnabled;               ///< Enables fast ME assuming a smoother MV.
+  bool                m_HashME;                                         ///< Enables hash based motion estimation for exact block matches
   int                 m_fastSubPel;
   int                 m_SMVD;
   int                 m_AMVRspeed;
@@ -412,6 +431,7 @@ public:
 
   bool                m_decodingParameterSetEnabled;                    ///< enable decoding parameter set
   bool                m_vuiParametersPresent;                           ///< enable generation of VUI parameters
+  bool                m_hrdParametersPresent;                           ///< enable generation of HRD parameters along with buffering period and picture timing SEI
   bool                m_aspectRatioInfoPresent;                         ///< Signals whether aspect_ratio_idc is present
   int                 m_aspectRatioIdc;                                 ///< aspect_ratio_idc
   int                 m_sarWidth;                                       ///< horizontal size of the sample aspect ratio
@@ -456,6 +476,7 @@ public:
   int                 m_MCTFNumTrailFrames;
   std::vector<int>    m_MCTFFrames;
   std::vector<double> m_MCTFStrengths;
+  bool                m_MCTFMotionSeed;                                 ///< Use the MCTF motion vectors as additional motion estimation start points
 
   int                 m_dqThresholdVal;
   bool                m_qtbttSpeedUp;
@@ -467,6 +488,8 @@ public:
   int                 m_numWppThreads;
   int                 m_ensureWppBitEqual;
   bool                m_picPartitionFlag;
+  int                 m_hugePages;                                      ///< back picture sized buffers with huge pages (0: off, 1: transparent, 2: explicit with fallback to transparent)
+  int                 m_memoryBudget;                                   ///< memory budget in MiB, the input queue size and the thread resources are derived to fit it (0: unlimited)
 public:
 
   EncCfg()
@@ -515,6 +538,8 @@ public:
       , m_DecodingRefreshType                         ( 0 )
       , m_GOPSize                                     ( 1 )
       , m_InputQueueSize                              ( 0 )
+      , m_InputQueueMaxSize                           ( 0 )
+      , m_sceneCutThreshold                           ( 0 )
       , m_rewriteParamSets                            ( false )
       , m_idrRefParamList                             ( false )
       , m_maxDecPicBuffering                          { 0, 0, 0, 0, 0, 0, 0 }           // not set -> derived
@@ -524,6 +549,7 @@ public:
       , m_numRPLList1                                 ( 0 )                             // not set -> derived
 
       , m_QP                                          ( 32 )
+      , m_constQuality                                ( false )
       , m_useSameChromaQPTables                       ( true )
       , m_chromaQpMappingTableParams                  ()
       , m_intraQPOffset                               ( 0 )
@@ -611,6 +637,9 @@ public:
       , m_useAMaxBT                                   ( false )
       , m_fastQtBtEnc                                 ( true )
       , m_contentBasedFastQtbt                        ( false )
+      , m_splitPredictor                              ( false )
+      , m_splitPredictorThreshold                     ( 0.1 )
+      , m_splitPredictorDumpFile                      ( "" )
       , m_fastInterSearchMode                         ( FASTINTERSEARCH_DISABLED )
       , m_bUseEarlyCU                                 ( false )
       , m_useFastDecisionForMerge                     ( true )
@@ -619,6 +648,12 @@ public:
       , m_bDisableIntraPUsInInterSlices               ( false )
       , m_bUseConstrainedIntraPred                    ( false )
       , m_bFastUDIUseMPMEnabled                       ( true )
+      , m_fastIntraAngles                             ( false )
+      , m_maxIntraRdCand                              ( 0 )
+      , m_maxMergeRdCand                              ( 0 )
+      , m_speedCtrlFps                                ( 0 )
+      , m_analysisMode                                ( 0 )
+      , m_analysisReuseLevel                          ( 2 )
       , m_bFastMEForGenBLowDelayEnabled               ( true )
 
       , m_MTSImplicit                                 ( false )
@@ -639,6 +674,10 @@ public:
       , m_RCUseLCUSeparateModel                       ( false )
       , m_RCInitialQP                                 ( 0 )
       , m_RCForceIntraQP                              ( false )
+      , m_RCPass                                      ( 0 )
+      , m_RCMaxBitrate                                ( 0 )
+      , m_RCCpbSize                                   ( 0 )
+      , m_RCInitialCpbFullness                        ( 0.9 )
       , m_motionEstimationSearchMethod                ( 1 )
       , m_bRestrictMESampling                         ( false )
       , m_SearchRange                                 ( 96 )
@@ -646,6 +685,7 @@ public:
       , m_minSearchWindow                             ( 8 )
       , m_bClipForBiPredMeEnabled                     ( false )
       , m_bFastMEAssumingSmootherMVEnabled            ( true )
+      , m_HashME                                      ( false )
       , m_fastSubPel                                  ( 0 )
       , m_SMVD                                        ( 0 )
       , m_AMVRspeed                                   ( 0 )
@@ -694,6 +734,7 @@ public:
 
       , m_decodingParameterSetEnabled                 ( false )
       , m_vuiParametersPresent                        ( false )
+      , m_hrdParametersPresent                        ( false )
       , m_aspectRatioInfoPresent                      ( false )
       , m_aspectRatioIdc                              ( 0 )
       , m_sarWidth                                    ( 0 )
@@ -737,6 +778,7 @@ public:
       , m_MCTFFutureReference                         ( true )
       , m_MCTFNumLeadFrames                           ( 0 )
       , m_MCTFNumTrailFrames                          ( 0 )
+      , m_MCTFMotionSeed                              ( false )
 
       , m_dqThresholdVal                              ( 8 )
       , m_qtbttSpeedUp                                ( false )
@@ -748,6 +790,8 @@ public:
       , m_numWppThreads                               ( 0 )
       , m_ensureWppBitEqual                           ( 0 )
       , m_picPartitionFlag                            ( false )
+      , m_hugePages                                   ( 0 )
+      , m_memoryBudget                                ( 0 )
   {
   }
 
@@ -758,6 +802,7 @@ public:
   bool confirmParameter( bool bflag, const char* message );
   bool initCfgParameter();
   void setCfgParameter( const EncCfg& encCfg );
+  int64_t estimateMemoryUsage() const;                                  ///< upper estimate of the peak of the accounted encoder memory in bytes (see MemUsage), valid after initCfgParameter()
 };
 
 } // namespace vvenc
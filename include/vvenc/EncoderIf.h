@@ -68,6 +68,7 @@ protected:
   virtual ~YUVWriterIf() {}
 
 public:
+  /// called in output order from an encoder-internal thread, yuvOutBuf is valid until the call returns
   virtual void outputYuv( const YUVBuffer& yuvOutBuf )
   {
   }
@@ -89,6 +90,8 @@ class VVENC_DECL EncoderIf
     void  destroyEncoderLib();
     void  encodePicture    ( bool flush, const YUVBuffer& yuvInBuf, AccessUnit& au, bool& isQueueEmpty );
     void  printSummary     ();
+    void  getMemUsage      ( MemUsage& memUsage ) const;                     ///< current and peak memory of the encoder per subsystem
+    void  getQueueStatus   ( InputQueueStatus& queueStatus ) const;          ///< depth and memory of the input queue, with InputQueueMaxSize whether the next picture would block
 };
 
 // ====================================================================================================================
@@ -61,18 +61,29 @@ class VVENC_DECL YuvIO
 {
 private:
   std::fstream  m_cHandle;                            ///< file handle
+  std::istream* m_inStream;                           ///< input stream, either file handle or stdin
+  std::ostream* m_outStream;                          ///< output stream, either file handle or stdout
+  bool          m_y4m;                                ///< YUV4MPEG2 input, every frame is preceded by a frame header
   int           m_fileBitdepth[ MAX_NUM_CH ];         ///< bitdepth of input/output video file
   int           m_MSBExtendedBitDepth[ MAX_NUM_CH ];  ///< bitdepth after addition of MSBs (with value 0)
   int           m_bitdepthShift[ MAX_NUM_CH ];        ///< number of bits to increase or decrease image by before/after write/read
 
 public:
-  void  open( const std::string &fileName, bool bWriteMode, const int fileBitDepth[ MAX_NUM_CH ], const int MSBExtendedBitDepth[ MAX_NUM_CH ], const int internalBitDepth[ MAX_NUM_CH ] );
+  YuvIO();
+
+  void  open( const std::string &fileName, bool bWriteMode, const int fileBitDepth[ MAX_NUM_CH ], const int MSBExtendedBitDepth[ MAX_NUM_CH ], const int internalBitDepth[ MAX_NUM_CH ], bool forceY4m = false ); ///< fileName "-" selects stdin/stdout
   void  close();
   bool  isEof();
   bool  isFail();
   void  skipYuvFrames( int numFrames, const ChromaFormat& inputChFmt, int width, int height );
   bool  readYuvBuf   ( YUVBuffer& yuvInBuf,        const ChromaFormat& inputChFmt,  const ChromaFormat& internChFmt, const int pad[ 2 ], bool bClipToRec709 );
   bool  writeYuvBuf  ( const YUVBuffer& yuvOutBuf, const ChromaFormat& internChFmt, const ChromaFormat& outputChFmt, bool bPackedYUVOutputMode, bool bClipToRec709 );
+
+  static bool isY4mFileName ( const std::string &fileName );          ///< checks for .y4m file extension
+  static bool parseY4mHeader( const std::string &fileName, int& width, int& height, int& frameRate, int& frameScale, ChromaFormat& chFmt, int& bitDepth ); ///< reads YUV4MPEG2 stream header, for stdin ("-") the header is consumed
+
+private:
+  bool  xReadY4mFrameHeader();
 };
 
 // ====================================================================================================================
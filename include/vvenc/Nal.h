@@ -41,8 +41,8 @@ vvc@hhi.fraunhofer.de
 ----------------------------------------------------------------------------- */
 #pragma once
 
-#include <sstream>
-#include <list>
+#include <vector>
+#include <string>
 #include "../vvenc/Basics.h"
 
 //! \ingroup Interface
@@ -120,21 +120,26 @@ struct NALUnit
   }
 };
 
-struct OutputNALUnit;
-
 /**
- * A single NALunit, with complete payload in EBSP format.
+ * A single NALunit of an access unit. The complete payload in EBSP format
+ * (NALUnit header and rbsp_bytes including any emulation_prevention_three_byte
+ * symbols) is stored in the annex B byte stream of the access unit, preceded
+ * by its start code.
  */
 struct NALUnitEBSP : public NALUnit
 {
-  std::ostringstream m_nalUnitData;
-
-  /**
-   * convert the OutputNALUnit nalu into EBSP format by writing out
-   * the NALUnit header, then the rbsp_bytes including any
-   * emulation_prevention_three_byte symbols.
-   */
-  NALUnitEBSP(OutputNALUnit& nalu);
+  uint32_t m_offset;          ///< position of the start code in the byte stream of the access unit
+  uint32_t m_startCodeSize;   ///< 4: zero_byte and start_code_prefix_one_3bytes, 3: start_code_prefix_one_3bytes only
+  uint32_t m_nalUnitSize;     ///< number of EBSP bytes following the start code
+
+  NALUnitEBSP( const NALUnit& nalu, uint32_t offset, uint32_t startCodeSize )
+    : NALUnit        ( nalu )
+    , m_offset       ( offset )
+    , m_startCodeSize( startCodeSize )
+    , m_nalUnitSize  ( 0 )
+  {}
+
+  uint32_t getAnnexBSize() const { return m_startCodeSize + m_nalUnitSize; }
 };
 //! \}
 //! \}
@@ -145,24 +150,40 @@ struct NALUnitEBSP : public NALUnit
  * working draft.  All NAL units within the object belong to the same
  * access unit.
  *
- * NALUnits held in the AccessUnit list are in EBSP format.  Attempting
- * to insert an OutputNALUnit into the access unit will automatically cause
- * the nalunit to have its headers written and anti-emulation performed.
- *
- * The AccessUnit owns all pointers stored within.  Destroying the
- * AccessUnit will delete all contained objects.
+ * The encoder writes the NAL units once, in decoding order, into one
+ * contiguous annex B byte stream (start codes included) owned by the
+ * AccessUnit. The list entries describe the position of each NAL unit
+ * within that stream, so the whole access unit can be handed to the
+ * caller as a read-only view without further copies. reset() keeps the
+ * allocated memory, an AccessUnit object can be reused for the next picture.
  */
-class AccessUnit : public std::list<NALUnitEBSP*> // NOTE: Should not inherit from STL.
+class AccessUnit : public std::vector<NALUnitEBSP> // NOTE: Should not inherit from STL.
 {
 public:
-  ~AccessUnit()
+  const uint8_t*  getAnnexB          () const                        { return m_annexB.data(); }
+  size_t          getAnnexBSize      () const                        { return m_annexB.size(); }
+  const uint8_t*  getNalUnitData     ( const NALUnitEBSP& nalu ) const { return m_annexB.data() + nalu.m_offset + nalu.m_startCodeSize; }
+  // exchanges the byte stream with the given buffer, e.g. to hand it to a writer without a copy; the NAL unit entries are no longer valid afterwards
+  void            swapAnnexB         ( std::vector<uint8_t>& annexB ) { m_annexB.swap( annexB ); }
+
+  void reset()
   {
-    for (AccessUnit::iterator it = this->begin(); it != this->end(); it++)
-    {
-      delete *it;
-    }
+    clear();
+    m_annexB.clear();
+    m_uiCts          = 0;
+    m_uiDts          = 0;
+    m_uiPOC          = 0;
+    m_eSliceType     = NUMBER_OF_SLICE_TYPES;
+    m_iTemporalLayer = 0;
+    m_iStatus        = 0;
+    m_bCtsValid      = false;
+    m_bDtsValid      = false;
+    m_bRAP           = false;
+    m_bRefPic        = false;
+    m_cInfo.clear();
   }
 
+  std::vector<uint8_t> m_annexB;                             ///< annex B byte stream of all NAL units
   uint64_t        m_uiCts          = 0;                      ///< composition time stamp
   uint64_t        m_uiDts          = 0;                      ///< decoding time stamp
   uint64_t        m_uiPOC          = 0;                      ///< picture order count
@@ -100,6 +100,7 @@ enum ErrorCodes
   VVENC_ERR_PARAMETER        = -7,     ///< inconsistent or invalid parameters
   VVENC_ERR_NOT_SUPPORTED    = -10,    ///< unsupported request
   VVENC_ERR_RESTART_REQUIRED = -11,    ///< encoder requires restart
+  VVENC_WOULD_BLOCK          = -12,    ///< input queue is full, the picture was not accepted. Call encode without input picture to encode a queued picture and pass the picture again.
   VVENC_ERR_CPU              = -30     ///< unsupported CPU SSE 4.1 needed
 };
 
@@ -269,7 +270,7 @@ typedef struct VVENC_DECL PicBuffer
   int             m_iHeight            = 0;               ///< height of the luminance plane
   int             m_iStride            = 0;               ///< stride (width + left margin + right margins) of luminance plane chrominance stride is assumed to be stride/2
   int             m_iCStride           = 0;               ///< stride (width + left margin + right margins) of chrominance plane in case its value differs from stride/2
-  int             m_iBitDepth          = 0;               ///< bit depth of input signal (8: depth 8 bit, 10: depth 10 bit  )
+  int             m_iBitDepth          = 0;               ///< bit depth of input signal (8: depth 8 bit, one byte per sample, 10: depth 10 bit, two bytes per sample )
   ColorFormat     m_eColorFormat       = VVC_CF_INVALID;  ///< color format (VVC_CF_YUV420_PLANAR)
   uint64_t        m_uiSequenceNumber   = 0;               ///< sequence number of the picture
   uint64_t        m_uiCts              = 0;               ///< composition time stamp in TicksPerSecond (see VVCEncoderParameter)
@@ -318,12 +319,14 @@ typedef struct VVENC_DECL VVEncParameter
   int m_iTemporalScale        = 0;      ///< temporal scale /denominator for fps                    (no default || 1, 1001)
   int m_iTicksPerSecond       = 90000;  ///< ticks per second e.g. 90000 for dts generation         (no default || 1..27000000)
   int m_iThreadCount          = 1;      ///< number of worker threads (no default || should not exceed the number of physical cpu's)
-  int m_iQuality              = 2;      ///< encoding quality vs speed                              (no default || 2    0: faster, 1: fast, 2: medium, 3: slow
+  int m_iQuality              = 2;      ///< encoding quality vs speed                              (no default || 2   -1: ultrafast, 0: faster, 1: fast, 2: medium, 3: slow
   int m_iPerceptualQPA        = 0;      ///< perceptual qpa usage                                   (default: 0 || Mode of perceptually motivated input-adaptive QP modification, abbrev. perceptual QP adaptation (QPA). (0 = off, 1 = SDR WPSNR based, 2 = SDR XPSNR based, 3 = HDR WPSNR based, 4 = HDR XPSNR based, 5 = HDR mean-luma based))
   int m_iTargetBitRate        = 0;      ///< target bit rate in bps                                 (no default || 0 : VBR, otherwise bitrate [bits per sec]
   VvcProfile m_eProfile       = VVC_PROFILE_MAIN_10; ///< vvc profile                               (default: main_10)
   VvcLevel m_eLevel           = VVC_LEVEL_5_1;       ///< vvc level_idc                             (default: 5.1 )
   VvcTier  m_eTier            = VVC_TIER_MAIN;       ///< vvc tier                                  (default: main )
+  int m_iInputQueueMaxSize    = 0;      ///< maximum number of queued input pictures                (default: 0 || 0: off, pictures are encoded within the encode call passing them, otherwise raised to at least the internal input queue size, see encode())
+  int m_iInternalBitDepth     = 10;     ///< internal bit depth                                     (default: 10 || 8: 8-bit input pictures are coded with 8-bit samples, 10: input pictures of 10 bit or more are coded with 10-bit samples)
 } VVEncParameter_t;
 
 
@@ -380,6 +383,8 @@ public:
     Uncompressed input pictures are passed to the encoder in display order. A compressed bitstream chunks is returned by filling the assigned AccessUnit struct.
     Data in AcccessUnit struct are valid if the encoder call returns success and the UsedSize attribute is non-zero.
     If the input parameter pcInputPicture is NULL, the encoder just returns a pending bitstream chunk if available.
+    With m_iInputQueueMaxSize set, passing a picture only queues it and a call with pcInputPicture set to NULL encodes one queued picture, once the queue holds enough pictures.
+    If the queue is full, the call returns VVENC_WOULD_BLOCK without taking the picture. The caller can avoid this by checking getQueueStatus() before preparing the next picture.
     If the call returns VVENC_NOT_ENOUGH_MEM, the BufSize attribute in AccessUnit struct indicates that the buffer is to small to retrieve the compressed data waiting for delivery.
     In this case the UsedSize attribute returns the minimum buffersize required to fetch the pending chunk. After allocating sufficient memory the encoder can retry the last call with the parameter pcInputPicture set to NULL to prevent encoding the last picture twice.
     \param[in]  pcInputPicture pointer to InputPicture structure containing uncompressed picture data and meta information, if pcInputPicture is NULL the encoder only checks for pending output data and returns a chunk if available.
@@ -389,6 +394,15 @@ public:
   */
    int encode( InputPicture* pcInputPicture, VvcAccessUnit& rcVvcAccessUnit);
 
+  /**
+    This method returns the state of the encoder input queue.
+    It reports the number of queued pictures, the MCTF lead and trail pictures and the memory they hold, and whether the next input picture would be rejected with VVENC_WOULD_BLOCK.
+    \param[out] rcQueueStatus reference to InputQueueStatus struct that retrieves the current queue state.
+    \retval     int VVENC_ERR_INITIALIZE indicates the encoder was not successfully initialized in advance, otherwise the return value VVENC_OK indicates success.
+    \pre        The encoder has to be initialized successfully.
+  */
+   int getQueueStatus( InputQueueStatus& rcQueueStatus );
+
 
    /**
      This method flushes the encoder. Use this method if a specific number of frames has to be encoded.
@@ -52,7 +52,11 @@ vvc@hhi.fraunhofer.de
 #include <stdlib.h>
 #include <stdio.h>
 #include <fcntl.h>
+#ifdef _WIN32
+#include <io.h>
+#endif
 #include <iomanip>
+#include <sstream>
 
 #include "../../../include/vvenc/Nal.h"
 #include "../vvencFFapp/ParseArg.h"
@@ -64,13 +68,14 @@ using namespace std;
 
 // ====================================================================================================================
 
-int g_verbosity = VERBOSE;
+int  g_verbosity   = VERBOSE;
+bool g_msgToStderr = false;
 
 void msgFnc( int level, const char* fmt, va_list args )
 {
   if ( g_verbosity >= level )
   {
-    vfprintf( level == 1 ? stderr : stdout, fmt, args );
+    vfprintf( ( level == 1 || g_msgToStderr ) ? stderr : stdout, fmt, args );
   }
 }
 
@@ -117,8 +122,11 @@ void EncApp::encode()
 
   printChromaFormat();
 
-  // create buffer for input YUV pic
-  YUVBufferStorage yuvInBuf( m_cEncAppCfg.m_internChromaFormat, m_cEncAppCfg.m_SourceWidth, m_cEncAppCfg.m_SourceHeight );
+  // start input reader and output writer
+  const int maxFrames = m_cEncAppCfg.m_framesToBeEncoded > 0 ? m_cEncAppCfg.m_framesToBeEncoded + m_cEncAppCfg.m_MCTFNumLeadFrames + m_cEncAppCfg.m_MCTFNumTrailFrames : 0;
+  m_yuvReader.start( m_yuvInputFile, m_cEncAppCfg, m_cEncAppCfg.m_numIOBuffers, maxFrames );
+  std::ostream& bitstream = m_cEncAppCfg.m_bitstreamFileName == "-" ? std::cout : static_cast<std::ostream&>( m_bitstream );
+  m_outputWriter.start( bitstream, m_cEncAppCfg.m_reconFileName.empty() ? nullptr : &m_yuvReconFile, m_cEncAppCfg, m_cEncAppCfg.m_numIOBuffers );
 
   // main loop
   int  framesRcvd = 0;
@@ -132,46 +140,62 @@ void EncApp::encode()
   default: break;
   }
 
+  YUVBuffer  flushBuf;
+  AccessUnit au;
   bool inputDone  = false;
   bool encDone    = false;
   while ( ! inputDone || ! encDone )
   {
-    // check for more input pictures
-    inputDone = ( m_cEncAppCfg.m_framesToBeEncoded > 0 && framesRcvd >= ( m_cEncAppCfg.m_framesToBeEncoded + m_cEncAppCfg.m_MCTFNumLeadFrames + m_cEncAppCfg.m_MCTFNumTrailFrames ) ) || m_yuvInputFile.isEof();
-
-    // read input YUV
+    // get next input YUV
+    YUVBufferStorage* yuvInBuf = nullptr;
     if ( ! inputDone )
     {
-      inputDone = ! m_yuvInputFile.readYuvBuf( yuvInBuf, m_cEncAppCfg.m_inputFileChromaFormat, m_cEncAppCfg.m_internChromaFormat, m_cEncAppCfg.m_aiPad, m_cEncAppCfg.m_bClipInputVideoToRec709Range );
+      yuvInBuf  = m_yuvReader.getPicture();
+      inputDone = ( yuvInBuf == nullptr );
       if ( ! inputDone )
       {
         if( m_cEncAppCfg.m_FrameRate > 0 )
         {
-          yuvInBuf.cts = framesRcvd * m_cEncAppCfg.m_TicksPerSecond * iTempScale / iTempRate;
-          yuvInBuf.ctsValid = true;
+          yuvInBuf->cts = framesRcvd * m_cEncAppCfg.m_TicksPerSecond * iTempScale / iTempRate;
+          yuvInBuf->ctsValid = true;
         }
 
         framesRcvd += 1;
       }
     }
 
+    // with a bounded input queue, encode queued pictures until the next input picture is accepted
+    if ( yuvInBuf && m_cEncAppCfg.m_InputQueueMaxSize > 0 )
+    {
+      InputQueueStatus queueStatus;
+      m_cEncoderIf.getQueueStatus( queueStatus );
+      while ( queueStatus.wouldBlock )
+      {
+        au.reset();
+        m_cEncoderIf.encodePicture( false, flushBuf, au, encDone );
+        if ( au.size() )
+        {
+          outputAU( au );
+        }
+        m_cEncoderIf.getQueueStatus( queueStatus );
+      }
+    }
+
     // encode picture
-    AccessUnit au;
-    m_cEncoderIf.encodePicture( inputDone, yuvInBuf, au, encDone );
+    au.reset();
+    m_cEncoderIf.encodePicture( inputDone, yuvInBuf ? *yuvInBuf : flushBuf, au, encDone );
+    m_yuvReader.releasePicture( yuvInBuf );
 
     // write out encoded access units
     if ( au.size() )
     {
       outputAU( au );
     }
-
-    // temporally skip frames
-    if ( ! inputDone && m_cEncAppCfg.m_temporalSubsampleRatio > 1 )
-    {
-      m_yuvInputFile.skipYuvFrames( m_cEncAppCfg.m_temporalSubsampleRatio - 1, m_cEncAppCfg.m_inputFileChromaFormat, m_cEncAppCfg.m_SourceWidth - m_cEncAppCfg.m_aiPad[ 0 ], m_cEncAppCfg.m_SourceHeight - m_cEncAppCfg.m_aiPad[ 1 ] );
-    }
   }
 
+  m_yuvReader.stop();
+  m_outputWriter.stop();
+
   printRateSummary( framesRcvd - ( m_cEncAppCfg.m_MCTFNumLeadFrames + m_cEncAppCfg.m_MCTFNumTrailFrames ) );
 
   // destroy encoder lib
@@ -180,19 +204,15 @@ void EncApp::encode()
   closeFileIO();
 }
 
-void EncApp::outputAU( const AccessUnit& au )
+void EncApp::outputAU( AccessUnit& au )
 {
-  const vector<uint32_t>& stats = writeAnnexB( m_bitstream, au );
-  rateStatsAccum( au, stats );
-  m_bitstream.flush();
+  rateStatsAccum( au );
+  m_outputWriter.writeAU( au );
 }
 
 void EncApp::outputYuv( const YUVBuffer& yuvOutBuf )
 {
-  if ( ! m_cEncAppCfg.m_reconFileName.empty() )
-  {
-    m_yuvReconFile.writeYuvBuf( yuvOutBuf, m_cEncAppCfg.m_internChromaFormat, m_cEncAppCfg.m_internChromaFormat, m_cEncAppCfg.m_packedYUVMode, m_cEncAppCfg.m_bClipOutputVideoToRec709Range );
-  }
+  m_outputWriter.writeYuv( yuvOutBuf );
 }
 
 // ====================================================================================================================
@@ -202,7 +222,7 @@ void EncApp::outputYuv( const YUVBuffer& yuvOutBuf )
 bool EncApp::openFileIO()
 {
   // input YUV
-  m_yuvInputFile.open( m_cEncAppCfg.m_inputFileName, false, m_cEncAppCfg.m_inputBitDepth, m_cEncAppCfg.m_MSBExtendedBitDepth, m_cEncAppCfg.m_internalBitDepth );
+  m_yuvInputFile.open( m_cEncAppCfg.m_inputFileName, false, m_cEncAppCfg.m_inputBitDepth, m_cEncAppCfg.m_MSBExtendedBitDepth, m_cEncAppCfg.m_internalBitDepth, m_cEncAppCfg.m_forceY4mInput );
   const int skipFrames = m_cEncAppCfg.m_FrameSkip - m_cEncAppCfg.m_MCTFNumLeadFrames;
   if ( skipFrames > 0 )
   {
@@ -229,6 +249,13 @@ bool EncApp::openFileIO()
   }
 
   // output bitstream
+  if ( m_cEncAppCfg.m_bitstreamFileName == "-" )
+  {
+#ifdef _WIN32
+    _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+    return true;
+  }
   m_bitstream.open( m_cEncAppCfg.m_bitstreamFileName.c_str(), fstream::binary | fstream::out );
   if ( ! m_bitstream )
   {
@@ -246,14 +273,11 @@ void EncApp::closeFileIO()
   m_bitstream.close();
 }
 
-void EncApp::rateStatsAccum(const AccessUnit& au, const std::vector<uint32_t>& annexBsizes)
+void EncApp::rateStatsAccum(const AccessUnit& au)
 {
-  AccessUnit::const_iterator it_au = au.begin();
-  vector<uint32_t>::const_iterator it_stats = annexBsizes.begin();
-
-  for (; it_au != au.end(); it_au++, it_stats++)
+  for (AccessUnit::const_iterator it_au = au.begin(); it_au != au.end(); it_au++)
   {
-    switch ((*it_au)->m_nalUnitType)
+    switch (it_au->m_nalUnitType)
     {
     case NAL_UNIT_CODED_SLICE_TRAIL:
     case NAL_UNIT_CODED_SLICE_STSA:
@@ -269,13 +293,13 @@ void EncApp::rateStatsAccum(const AccessUnit& au, const std::vector<uint32_t>& a
     case NAL_UNIT_PPS:
     case NAL_UNIT_PREFIX_APS:
     case NAL_UNIT_SUFFIX_APS:
-      m_essentialBytes += *it_stats;
+      m_essentialBytes += it_au->getAnnexBSize();
       break;
     default:
       break;
     }
 
-    m_totalBytes += *it_stats;
+    m_totalBytes += it_au->getAnnexBSize();
   }
 }
 
@@ -283,6 +307,13 @@ void EncApp::printRateSummary( int framesRcvd )
 {
   m_cEncoderIf.printSummary();
 
+  MemUsage memUsage;
+  m_cEncoderIf.getMemUsage( memUsage );
+  const double mib = 1.0 / ( 1 << 20 );
+  msgApp( DETAILS, "Peak memory: %.1f MiB, estimated %.1f MiB (pictures %.1f, MCTF %.1f, line resources %.1f, CTU resources %.1f, ALF %.1f, other %.1f MiB)\n",
+          memUsage.peakTotal * mib, m_cEncAppCfg.estimateMemoryUsage() * mib, memUsage.peakBytes[ MEM_TAG_PICTURES ] * mib, memUsage.peakBytes[ MEM_TAG_MCTF ] * mib, memUsage.peakBytes[ MEM_TAG_LINE_RSRC ] * mib,
+          memUsage.peakBytes[ MEM_TAG_CTU_RSRC ] * mib, memUsage.peakBytes[ MEM_TAG_ALF ] * mib, memUsage.peakBytes[ MEM_TAG_OTHER ] * mib );
+
   double time = (double) framesRcvd / m_cEncAppCfg.m_FrameRate * m_cEncAppCfg.m_temporalSubsampleRatio;
   msgApp( DETAILS,"Bytes written to file: %u (%.3f kbps)\n", m_totalBytes, 0.008 * m_totalBytes / time );
   if (m_cEncAppCfg.m_summaryVerboseness > 0)
@@ -51,47 +51,20 @@ vvc@hhi.fraunhofer.de
 #include "../../../include/vvenc/EncoderIf.h"
 #include "../../../include/vvenc/FileIO.h"
 #include "../vvencFFapp/EncAppCfg.h"
+#include "../vvencFFapp/FileIOThread.h"
 
 //! \ingroup EncoderApp
 //! \{
 
 // ====================================================================================================================
 
-extern int g_verbosity;
+extern int  g_verbosity;
+extern bool g_msgToStderr;
 void msgFnc( int level, const char* fmt, va_list args );
 void msgApp( int level, const char* fmt, ... );
 
 // ====================================================================================================================
 
-struct YUVBufferStorage : public YUVBuffer
-{
-  YUVBufferStorage( const ChromaFormat& chFmt, const int frameWidth, const int frameHeight )
-    : YUVBuffer()
-  {
-    for ( int i = 0; i < MAX_NUM_COMP; i++ )
-    {
-      YUVPlane& yuvPlane = yuvPlanes[ i ];
-      yuvPlane.width     = getWidthOfComponent ( chFmt, frameWidth,  i );
-      yuvPlane.height    = getHeightOfComponent( chFmt, frameHeight, i );
-      yuvPlane.stride    = yuvPlane.width;
-      const int size     = yuvPlane.stride * yuvPlane.height;
-      yuvPlane.planeBuf  = ( size > 0 ) ? new int16_t[ size ] : nullptr;
-    }
-  }
-
-  ~YUVBufferStorage()
-  {
-    for ( int i = 0; i < MAX_NUM_COMP; i++ )
-    {
-      YUVPlane& yuvPlane = yuvPlanes[ i ];
-      if ( yuvPlane.planeBuf )
-        delete [] yuvPlane.planeBuf;
-    }
-  }
-};
-
-// ====================================================================================================================
-
 class EncApp : public YUVWriterIf
 {
 private:
@@ -100,6 +73,8 @@ private:
   YuvIO        m_yuvInputFile;                    ///< input YUV file
   YuvIO        m_yuvReconFile;                    ///< output YUV reconstruction file
   std::fstream m_bitstream;                       ///< output bitstream file
+  YuvReaderThread    m_yuvReader;                 ///< reads input pictures ahead of the encoder
+  OutputWriterThread m_outputWriter;              ///< writes bitstream and reconstruction off the encoding thread
   unsigned     m_essentialBytes;
   unsigned     m_totalBytes;
 
@@ -116,7 +91,7 @@ public:
 
   bool  parseCfg( int argc, char* argv[] );           ///< parse configuration file to fill member variables
   void  encode();                                     ///< main encoding function
-  void  outputAU ( const AccessUnit& au );            ///< write encoded access units to bitstream
+  void  outputAU ( AccessUnit& au );                  ///< write encoded access units to bitstream, takes the byte stream of the access unit
   void  outputYuv( const YUVBuffer& yuvOutBuf );      ///< write reconstructed yuv output
 
 private:
@@ -125,7 +100,7 @@ private:
   void closeFileIO();
 
   // statistics
-  void rateStatsAccum  ( const AccessUnit& au, const std::vector<uint32_t>& stats );
+  void rateStatsAccum  ( const AccessUnit& au );
   void printRateSummary( int framesRcvd );
   void printChromaFormat();
 };
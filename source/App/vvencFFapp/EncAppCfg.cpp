@@ -330,12 +330,14 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   // file, i/o and source parameters
   opts.addOptions()
 
-  ("InputFile,i",                                     m_inputFileName,                                               "Original YUV input file name")
-  ("BitstreamFile,b",                                 m_bitstreamFileName,                                           "Bitstream output file name")
-  ("ReconFile,o",                                     m_reconFileName,                                               "Reconstructed YUV output file name")
+  ("InputFile,i",                                     m_inputFileName,                                               "Original YUV input file name, raw or YUV4MPEG2 (.y4m), '-' reads from stdin")
+  ("Y4M",                                             m_forceY4mInput,                                               "Read the input as YUV4MPEG2 stream regardless of the file name extension (needed for stdin)")
+  ("BitstreamFile,b",                                 m_bitstreamFileName,                                           "Bitstream output file name, '-' writes to stdout")
+  ("ReconFile,o",                                     m_reconFileName,                                               "Reconstructed YUV output file name, '-' writes to stdout")
   ("ClipInputVideoToRec709Range",                     m_bClipInputVideoToRec709Range,                                "If true then clip input video to the Rec. 709 Range on loading when InternalBitDepth is less than MSBExtendedBitDepth")
   ("ClipOutputVideoToRec709Range",                    m_bClipOutputVideoToRec709Range,                               "If true then clip output video to the Rec. 709 Range on saving when OutputBitDepth is less than InternalBitDepth")
-  ("PYUV",                                            m_packedYUVMode,                                               "If true then output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data. Ignored for interlaced output.");
+  ("PYUV",                                            m_packedYUVMode,                                               "If true then output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data. Ignored for interlaced output.")
+  ("IOBuffers",                                       m_numIOBuffers,                                                "Number of pictures buffered by the input reader and output writer threads (0: synchronous file i/o)");
 
   if ( vvenc::isTracingEnabled() )
   {
@@ -389,11 +391,14 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("DecodingRefreshType,-dr",                         m_DecodingRefreshType,                                         "Intra refresh type (0:none 1:CRA 2:IDR 3:RecPointSEI)")
   ("GOPSize,g",                                       m_GOPSize,                                                     "GOP size of temporal structure")
   ("InputQueueSize",                                  m_InputQueueSize,                                              "Size of input frames queue (default: 0, use gop size)")
+  ("InputQueueMaxSize",                               m_InputQueueMaxSize,                                           "Maximum number of queued input frames, pictures are only encoded in separate calls without input and the encoder signals when it would block (0: off, at least input queue size)")
+  ("SceneCutThreshold",                               m_sceneCutThreshold,                                           "Lookahead scene cut detection threshold in percent, inserts a CRA picture at the next GOP boundary after a cut (0: off, typical: 40)")
   ("ReWriteParamSets",                                m_rewriteParamSets,                                            "Enable rewriting of Parameter sets before every (intra) random access point")
   ("IDRRefParamList",                                 m_idrRefParamList,                                             "Enable indication of reference picture list syntax elements in slice headers of IDR pictures")
 
   /* Quantization parameters */
   ("QP,q",                                            m_QP,                                                          "Qp value")
+  ("ConstQuality",                                    m_constQuality,                                                "Constant quality mode (CRF-like): QP acts as quality factor, the picture QPs follow the lookahead complexity and visual activity")
   ("SameCQPTablesForAllChroma",                       m_useSameChromaQPTables,                                       "0: Different tables for Cb, Cr and joint Cb-Cr components, 1 (default): Same tables for all three chroma components")
   ("IntraQPOffset",                                   m_intraQPOffset,                                               "Qp offset value for intra slice, typically determined based on GOP size")
   ("LambdaFromQpEnable",                              m_lambdaFromQPEnable,                                          "Enable flag for derivation of lambda from QP")
@@ -508,6 +513,9 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("AMaxBT",                                          m_useAMaxBT,                                                   "Adaptive maximal BT-size")
   ("FastQtBtEnc",                                     m_fastQtBtEnc,                                                 "Fast encoding setting for QTBT (proposal E0023)")
   ("ContentBasedFastQtbt",                            m_contentBasedFastQtbt,                                        "Signal based QTBT speed-up")
+  ("SplitPredictor",                                  m_splitPredictor,                                              "Skip binary and ternary splits predicted as not beneficial by the compiled-in decision tree")
+  ("SplitPredictorThreshold",                         m_splitPredictorThreshold,                                     "Split predictor: split probability below which a split is skipped")
+  ("SplitPredictorDump",                              m_splitPredictorDumpFile,                                      "Split predictor: write the block features and split outcomes to this file for training (disables the pruning)")
   ("FEN",                                             m_fastInterSearchMode,                                         "fast encoder setting")
   ("ECU",                                             m_bUseEarlyCU,                                                 "Early CU setting")
   ("FDM",                                             m_useFastDecisionForMerge,                                     "Fast decision for Merge RD Cost")
@@ -516,6 +524,13 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("DisableIntraInInter",                             m_bDisableIntraPUsInInterSlices,                               "Flag to disable intra PUs in inter slices")
   ("ConstrainedIntraPred",                            m_bUseConstrainedIntraPred,                                    "Constrained Intra Prediction")
   ("FastUDIUseMPMEnabled",                            m_bFastUDIUseMPMEnabled,                                       "If enabled, adapt intra direction search, accounting for MPM")
+  ("FastIntraAngles",                                 m_fastIntraAngles,                                             "Restrict the intra SATD search to every fourth angular mode")
+  ("MaxIntraRdCand",                                  m_maxIntraRdCand,                                              "Maximum number of intra modes checked with full RD after the SATD search (0: size dependent)")
+  ("MaxMergeRdCand",                                  m_maxMergeRdCand,                                              "Maximum number of merge candidates checked with full RD after the SATD search (0: unrestricted)")
+  ("Analysis",                                        m_analysisMode,                                                "Shared analysis across renditions of the same input; 0: off; 1: save the analysis of this encoding; 2: load a saved analysis and reuse it" )
+  ("AnalysisFile",                                    m_analysisFileName,                                            "Shared analysis: file written in save and read in load mode" )
+  ("AnalysisReuseLevel",                              m_analysisReuseLevel,                                          "Shared analysis: 1: reuse the MCTF motion and the motion search start vectors; 2: additionally restrict the partitioning depths" )
+  ("SpeedControlFps",                                 m_speedCtrlFps,                                                "Real-time speed control: adapt the encoder effort per GOP to sustain this encoding frame rate (0: off)")
   ("FastMEForGenBLowDelayEnabled",                    m_bFastMEForGenBLowDelayEnabled,                               "If enabled use a fast ME for generalised B Low Delay slices")
 
   ("MTSImplicit",                                     m_MTSImplicit,                                                 "Enable implicit MTS (when explicit MTS is off)\n")
@@ -536,6 +551,11 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("RCLCUSeparateModel",                              m_RCUseLCUSeparateModel,                                       "Rate control: use CTU level separate R-lambda model" )
   ("InitialQP",                                       m_RCInitialQP,                                                 "Rate control: initial QP" )
   ("RCForceIntraQP",                                  m_RCForceIntraQP,                                              "Rate control: force intra QP to be equal to initial QP" )
+  ("RCPass",                                          m_RCPass,                                                      "Rate control: two-pass mode; 0: single pass; 1: first pass, write statistics (can use a faster configuration); 2: second pass, allocate bits from the statistics" )
+  ("RCStatsFile",                                     m_RCStatsFileName,                                             "Rate control: statistics file written by the first and read by the second pass" )
+  ("RCMaxBitrate",                                    m_RCMaxBitrate,                                                "Rate control: VBV maximum bit rate in bits/second; 0: no VBV constraint" )
+  ("RCCpbSize",                                       m_RCCpbSize,                                                   "Rate control: VBV coded picture buffer size in bits; 0: one second at the maximum bit rate" )
+  ("RCInitialCpbFullness",                            m_RCInitialCpbFullness,                                        "Rate control: initial VBV buffer fullness relative to the buffer size" )
 
   // motion search options
   ("FastSearch",                                      m_motionEstimationSearchMethod,                                "0:Full search 1:Diamond 2:Selective 3:Enhanced Diamond")
@@ -545,6 +565,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("MinSearchWindow",                                 m_minSearchWindow,                                             "Minimum motion search window size for the adaptive window ME")
   ("ClipForBiPredMEEnabled",                          m_bClipForBiPredMeEnabled,                                     "Enables clipping in the Bi-Pred ME. It is disabled to reduce encoder run-time")
   ("FastMEAssumingSmootherMVEnabled",                 m_bFastMEAssumingSmootherMVEnabled,                            "Enables fast ME assuming a smoother MV.")
+  ("HashME",                                          m_HashME,                                                      "Enables hash based motion estimation, finds exact block matches in screen content")
   ("FastSubPel",                                      m_fastSubPel,                                                  "Enables fast sub-pel ME");
 
   opts.addOptions()
@@ -572,6 +593,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
 
   ("EnableDecodingParameterSet",                      m_decodingParameterSetEnabled,                                 "Enables writing of Decoding Parameter Set")
   ("VuiParametersPresent,-vui",                       m_vuiParametersPresent,                                        "Enable generation of vui_parameters()")
+  ("HrdParametersPresent,-hrd",                       m_hrdParametersPresent,                                        "Enable generation of hrd_parameters() with buffering period and picture timing SEI (requires RCMaxBitrate)")
   ("AspectRatioInfoPresent",                          m_aspectRatioInfoPresent,                                      "Signals whether aspect_ratio_idc is present")
   ("AspectRatioIdc",                                  m_aspectRatioIdc,                                              "aspect_ratio_idc")
   ("SarWidth",                                        m_sarWidth,                                                    "horizontal size of the sample aspect ratio")
@@ -650,6 +672,7 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("MCTFNumTrailFrames",                              m_MCTFNumTrailFrames,                                          "Number of additional MCTF trail frames, which will not be encoded, but can used for MCTF filtering")
   ("MCTFFrame",                                       toMCTFFrames,                                                  "Frame to filter Strength for frame in GOP based temporal filter")
   ("MCTFStrength",                                    toMCTFStrengths,                                               "Strength for  frame in GOP based temporal filter.")
+  ("MCTFMotionSeed",                                  m_MCTFMotionSeed,                                              "Use the motion vectors of the GOP based temporal filter as additional motion estimation start points")
 
   ("FastLocalDualTreeMode",                           m_fastLocalDualTreeMode,                                       "Fast intra pass coding for local dual-tree in intra coding region, 0: off, 1: use threshold, 2: one intra mode only")
   ("QtbttExtraFast",                                  m_qtbttSpeedUp,                                                "Non-VTM compatible QTBTT speed-ups" )
@@ -660,6 +683,8 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
   ("NumWppThreads",                                   m_numWppThreads,                                               "Number of parallel wpp threads")
   ("WppBitEqual",                                     m_ensureWppBitEqual,                                           "Ensure bit equality with WPP case, 0: off (sequencial mode), 1: copy from wpp line above, 2: line wise reset")
   ("EnablePicPartitioning",                           m_picPartitionFlag,                                            "Enable picture partitioning (0: single tile, single slice, 1: multiple tiles/slices can be used)")
+  ("MemoryBudget",                                    m_memoryBudget,                                                "Memory budget in MiB, reduces the frame parallel encoders, the WPP threads and the input queue size to fit (0: unlimited)")
+  ("HugePages",                                       m_hugePages,                                                   "Back picture sized buffers with huge pages (Linux only), 0: off, 1: transparent huge pages, 2: reserved huge pages with fallback to transparent huge pages")
   ("SbTMVP",                                          m_SbTMVP,                                                      "Enable Subblock Temporal Motion Vector Prediction (0: off, 1: on) [default: off]")
 
   ("CIIP",                                            m_CIIP,                                                        "Enable CIIP mode, 0: off, 1: vtm, 2: fast, 3: faster ")
@@ -707,11 +732,33 @@ bool EncAppCfg::parseCfg( int argc, char* argv[] )
     confirmParameter( m_maxNumAlfAlternativesChroma < 1 || m_maxNumAlfAlternativesChroma > MAX_NUM_ALF_ALTERNATIVES_CHROMA, std::string( std::string( "The maximum number of ALF Chroma filter alternatives must be in the range (1-" ) + std::to_string( MAX_NUM_ALF_ALTERNATIVES_CHROMA ) + std::string( ", inclusive)" ) ).c_str() );
   }
 
+  //
+  // YUV4MPEG2 input: picture size, frame rate and sample format are given by the stream header
+  //
+  bool y4mHeaderOk = true;
+  if ( m_forceY4mInput || YuvIO::isY4mFileName( m_inputFileName ) )
+  {
+    int frameRate  = 0;
+    int frameScale = 1;
+    int bitDepth   = 8;
+    y4mHeaderOk = YuvIO::parseY4mHeader( m_inputFileName, m_SourceWidth, m_SourceHeight, frameRate, frameScale, m_inputFileChromaFormat, bitDepth );
+    if ( y4mHeaderOk )
+    {
+      // NTSC rates are signalled as 23, 29 and 59 Hz
+      m_FrameRate = frameScale == 1001 ? frameRate / 1000 - 1 : ( frameRate + frameScale / 2 ) / frameScale;
+      m_inputBitDepth[ CH_L ] = bitDepth;
+      m_inputBitDepth[ CH_C ] = bitDepth;
+    }
+  }
+
   m_confirmFailed = false;
+  confirmParameter( ! y4mHeaderOk,                                "Failed to read the YUV4MPEG2 header of the input file (InputFile)" );
   confirmParameter( m_bitstreamFileName.empty(),                  "A bitstream file name must be specified (BitstreamFile)" );
+  confirmParameter( m_bitstreamFileName == "-" && m_reconFileName == "-", "Bitstream and reconstructed YUV cannot both be written to stdout" );
   confirmParameter( m_decodeBitstreams[0] == m_bitstreamFileName, "Debug bitstream and the output bitstream cannot be equal" );
   confirmParameter( m_decodeBitstreams[1] == m_bitstreamFileName, "Decode2 bitstream and the output bitstream cannot be equal" );
   confirmParameter( m_inputFileChromaFormat < 0 || m_inputFileChromaFormat >= NUM_CHROMA_FORMAT,   "Intern chroma format must be either 400, 420, 422 or 444" );
+  confirmParameter( m_numIOBuffers < 0,                           "Number of file i/o buffers must not be negative (IOBuffers)" );
   confirmParameter( m_RCRateControlMode < 0 || m_RCRateControlMode > 3, "Invalid rate control mode");
   confirmParameter( m_RCRateControlMode == 1 && m_usePerceptQPA > 0, "CTU-level rate control cannot be combined with QPA" );
   confirmParameter( m_RCRateControlMode > 1 && m_GOPSize == 32, "Rate control is currently not supported for GOP size 32" );
@@ -766,13 +813,16 @@ void EncAppCfg::printCfg()
   msgApp( DETAILS, "Motion search range                    : %d\n", m_SearchRange );
   msgApp( DETAILS, "Intra period                           : %d\n", m_IntraPeriod );
   msgApp( DETAILS, "Decoding refresh type                  : %d\n", m_DecodingRefreshType );
+  msgApp( DETAILS, "Scene cut threshold                    : %d\n", m_sceneCutThreshold );
   msgApp( DETAILS, "QP                                     : %d\n", m_QP);
+  msgApp( DETAILS, "Constant quality                       : %d\n", m_constQuality );
   msgApp( DETAILS, "Max dQP signaling subdiv               : %d\n", m_cuQpDeltaSubdiv);
 
   msgApp( DETAILS, "Cb QP Offset (dual tree)               : %d (%d)\n", m_chromaCbQpOffset, m_chromaCbQpOffsetDualTree);
   msgApp( DETAILS, "Cr QP Offset (dual tree)               : %d (%d)\n", m_chromaCrQpOffset, m_chromaCrQpOffsetDualTree);
   msgApp( DETAILS, "GOP size                               : %d\n", m_GOPSize );
   msgApp( DETAILS, "Input queue size                       : %d\n", m_InputQueueSize );
+  msgApp( DETAILS, "Input queue max size                   : %d\n", m_InputQueueMaxSize );
   msgApp( DETAILS, "Input bit depth                        : (Y:%d, C:%d)\n", m_inputBitDepth[ CH_L ], m_inputBitDepth[ CH_C ] );
   msgApp( DETAILS, "MSB-extended bit depth                 : (Y:%d, C:%d)\n", m_MSBExtendedBitDepth[ CH_L ], m_MSBExtendedBitDepth[ CH_C ] );
   msgApp( DETAILS, "Internal bit depth                     : (Y:%d, C:%d)\n", m_internalBitDepth[ CH_L ], m_internalBitDepth[ CH_C ] );
@@ -853,6 +903,7 @@ void EncAppCfg::printCfg()
     if ( m_MCTF )
     {
       msgApp(VERBOSE, "[L:%d, T:%d] ", m_MCTFNumLeadFrames, m_MCTFNumTrailFrames);
+      msgApp(VERBOSE, "MCTFMotionSeed:%d ", m_MCTFMotionSeed);
     }
     msgApp( VERBOSE, "Affine:%d ",             m_Affine);
     msgApp( VERBOSE, "Affine_Prof:%d ",        m_PROF);
@@ -860,6 +911,7 @@ void EncAppCfg::printCfg()
     msgApp( VERBOSE, "MMVD:%d ",               m_MMVD);
     msgApp( VERBOSE, "DisFracMMVD:%d ",        m_allowDisFracMMVD);
     msgApp( VERBOSE, "FastSearch:%d ",         m_motionEstimationSearchMethod);
+    msgApp( VERBOSE, "HashME:%d ",             m_HashME);
     msgApp( VERBOSE, "SbTMVP:%d ",             m_SbTMVP);
     msgApp( VERBOSE, "Geo:%d ",                m_Geo);
     msgApp( VERBOSE, "LFNST:%d ",              m_LFNST);
@@ -871,9 +923,16 @@ void EncAppCfg::printCfg()
   msgApp( VERBOSE, "LCTUFast:%d ",             m_useFastLCTU );
   msgApp( VERBOSE, "FastMrg:%d ",              m_useFastMrg );
   msgApp( VERBOSE, "PBIntraFast:%d ",          m_usePbIntraFast );
+  msgApp( VERBOSE, "FastIntraAngles:%d ",      m_fastIntraAngles );
+  msgApp( VERBOSE, "MaxIntraRdCand:%d ",       m_maxIntraRdCand );
+  msgApp( VERBOSE, "MaxMergeRdCand:%d ",       m_maxMergeRdCand );
+  msgApp( VERBOSE, "SpeedControlFps:%d ",      m_speedCtrlFps );
+  msgApp( VERBOSE, "Analysis:%d ",             m_analysisMode );
+  if( m_analysisMode == 2 ) msgApp( VERBOSE, "AnalysisReuseLevel:%d ", m_analysisReuseLevel );
   msgApp( VERBOSE, "AMaxBT:%d ",               m_useAMaxBT );
   msgApp( VERBOSE, "FastQtBtEnc:%d ",          m_fastQtBtEnc );
   msgApp( VERBOSE, "ContentBasedFastQtbt:%d ", m_contentBasedFastQtbt );
+  msgApp( VERBOSE, "SplitPredictor:%d ",       m_splitPredictor );
   if( m_MIP ) msgApp(VERBOSE, "FastMIP:%d ",   m_useFastMIP);
   msgApp( VERBOSE, "FastLocalDualTree:%d ",    m_fastLocalDualTreeMode );
   msgApp( VERBOSE, "FastSubPel:%d ",           m_fastSubPel );
@@ -887,6 +946,13 @@ void EncAppCfg::printCfg()
     msgApp( VERBOSE, "RCLCUSeparateModel:%d ",      m_RCUseLCUSeparateModel );
     msgApp( VERBOSE, "InitialQP:%d ",               m_RCInitialQP );
     msgApp( VERBOSE, "RCForceIntraQP:%d ",          m_RCForceIntraQP );
+    msgApp( VERBOSE, "RCPass:%d ",                  m_RCPass );
+    if ( m_RCMaxBitrate )
+    {
+      msgApp( VERBOSE, "RCMaxBitrate:%d ",          m_RCMaxBitrate );
+      msgApp( VERBOSE, "RCCpbSize:%d ",             m_RCCpbSize );
+      msgApp( VERBOSE, "HRD:%d ",                   m_hrdParametersPresent );
+    }
   }
 
   msgApp( VERBOSE, "\nPARALLEL PROCESSING CFG: " );
@@ -896,6 +962,8 @@ void EncAppCfg::printCfg()
   msgApp( VERBOSE, "WPP:%d ",                  m_numWppThreads );
   msgApp( VERBOSE, "WppBitEqual:%d ",          m_ensureWppBitEqual );
   msgApp( VERBOSE, "WF:%d ",                   m_entropyCodingSyncEnabled );
+  msgApp( VERBOSE, "HugePages:%d ",            m_hugePages );
+  msgApp( VERBOSE, "MemoryBudget:%d ",         m_memoryBudget );
   msgApp( VERBOSE, "\n");
 
   msgApp( NOTICE, "\n");
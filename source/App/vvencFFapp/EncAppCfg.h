@@ -67,6 +67,8 @@ public:
   bool         m_bClipInputVideoToRec709Range;
   bool         m_bClipOutputVideoToRec709Range;
   bool         m_packedYUVMode;                                ///< If true, output 10-bit and 12-bit YUV data as 5-byte and 3-byte (respectively) packed YUV data
+  int          m_numIOBuffers;                                 ///< number of pictures buffered by the input reader and output writer threads (0: synchronous file i/o)
+  bool         m_forceY4mInput;                                ///< read input as YUV4MPEG2 regardless of the file name extension (needed for stdin)
 
 public:
 
@@ -75,6 +77,8 @@ public:
       , m_bClipInputVideoToRec709Range    ( false )
       , m_bClipOutputVideoToRec709Range   ( false )
       , m_packedYUVMode                   ( false )
+      , m_numIOBuffers                    ( 3 )
+      , m_forceY4mInput                   ( false )
   {
   }
 
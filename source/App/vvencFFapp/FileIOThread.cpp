@@ -0,0 +1,448 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+
+/** \file     FileIOThread.cpp
+    \brief    asynchronous file reader/writer threads
+*/
+
+#include "../vvencFFapp/FileIOThread.h"
+
+#include <cstring>
+#include <cassert>
+#include <algorithm>
+
+using namespace std;
+
+//! \ingroup EncoderApp
+//! \{
+
+// ====================================================================================================================
+
+bool YUVBufferStorage::hasSameSize( const YUVBuffer& yuvBuf ) const
+{
+  for ( int i = 0; i < MAX_NUM_COMP; i++ )
+  {
+    if ( yuvBuf.yuvPlanes[ i ].width != yuvPlanes[ i ].width || yuvBuf.yuvPlanes[ i ].height != yuvPlanes[ i ].height )
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void YUVBufferStorage::copyFrom( const YUVBuffer& yuvBuf )
+{
+  assert( hasSameSize( yuvBuf ) );
+  for ( int i = 0; i < MAX_NUM_COMP; i++ )
+  {
+    const YUVPlane& src = yuvBuf.yuvPlanes[ i ];
+    YUVPlane&       dst = yuvPlanes[ i ];
+    for ( int y = 0; y < src.height; y++ )
+    {
+      memcpy( dst.planeBuf + y * dst.stride, src.planeBuf + y * src.stride, src.width * sizeof( int16_t ) );
+    }
+  }
+  sequenceNumber = yuvBuf.sequenceNumber;
+  cts            = yuvBuf.cts;
+  ctsValid       = yuvBuf.ctsValid;
+}
+
+// ====================================================================================================================
+
+YuvReaderThread::YuvReaderThread()
+  : m_yuvInputFile( nullptr )
+  , m_cfg         ( nullptr )
+  , m_maxFrames   ( 0 )
+  , m_framesRead  ( 0 )
+  , m_eof         ( false )
+  , m_stop        ( false )
+{
+}
+
+YuvReaderThread::~YuvReaderThread()
+{
+  stop();
+}
+
+void YuvReaderThread::start( YuvIO& yuvInputFile, const EncAppCfg& cfg, int numBuffers, int maxFrames )
+{
+  if ( m_yuvInputFile != nullptr )
+  {
+    return;
+  }
+
+  m_yuvInputFile = &yuvInputFile;
+  m_cfg          = &cfg;
+  m_maxFrames    = maxFrames;
+  m_framesRead   = 0;
+  m_eof          = false;
+  m_stop         = false;
+
+  const int numAlloc = std::max( numBuffers, 1 );
+  for ( int i = 0; i < numAlloc; i++ )
+  {
+    m_buffers.push_back( new YUVBufferStorage( cfg.m_internChromaFormat, cfg.m_SourceWidth, cfg.m_SourceHeight ) );
+    m_freeQueue.push_back( m_buffers.back() );
+  }
+
+  if ( numBuffers > 0 )
+  {
+    m_thread = std::thread( &YuvReaderThread::xReadLoop, this );
+  }
+}
+
+void YuvReaderThread::stop()
+{
+  if ( m_yuvInputFile == nullptr )
+  {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_freeCond.notify_all();
+  if ( m_thread.joinable() )
+  {
+    m_thread.join();
+  }
+
+  for ( auto yuvBuf : m_buffers )
+  {
+    delete yuvBuf;
+  }
+  m_buffers.clear();
+  m_freeQueue.clear();
+  m_filledQueue.clear();
+  m_yuvInputFile = nullptr;
+}
+
+YUVBufferStorage* YuvReaderThread::getPicture()
+{
+  if ( m_yuvInputFile == nullptr )
+  {
+    return nullptr;
+  }
+
+  if ( ! m_thread.joinable() )
+  {
+    YUVBufferStorage* yuvBuf = m_freeQueue.front();
+    return xReadPicture( *yuvBuf ) ? yuvBuf : nullptr;
+  }
+
+  std::unique_lock<std::mutex> lock( m_mutex );
+  m_filledCond.wait( lock, [this]{ return ! m_filledQueue.empty() || m_eof; } );
+  if ( m_filledQueue.empty() )
+  {
+    return nullptr;
+  }
+  YUVBufferStorage* yuvBuf = m_filledQueue.front();
+  m_filledQueue.pop_front();
+  return yuvBuf;
+}
+
+void YuvReaderThread::releasePicture( YUVBufferStorage* yuvBuf )
+{
+  if ( ! m_thread.joinable() || yuvBuf == nullptr )
+  {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_freeQueue.push_back( yuvBuf );
+  }
+  m_freeCond.notify_one();
+}
+
+bool YuvReaderThread::xReadPicture( YUVBufferStorage& yuvBuf )
+{
+  if ( ( m_maxFrames > 0 && m_framesRead >= m_maxFrames ) || m_yuvInputFile->isEof() )
+  {
+    return false;
+  }
+
+  if ( ! m_yuvInputFile->readYuvBuf( yuvBuf, m_cfg->m_inputFileChromaFormat, m_cfg->m_internChromaFormat, m_cfg->m_aiPad, m_cfg->m_bClipInputVideoToRec709Range ) )
+  {
+    return false;
+  }
+  m_framesRead += 1;
+
+  // temporally skip frames
+  if ( m_cfg->m_temporalSubsampleRatio > 1 )
+  {
+    m_yuvInputFile->skipYuvFrames( m_cfg->m_temporalSubsampleRatio - 1, m_cfg->m_inputFileChromaFormat, m_cfg->m_SourceWidth - m_cfg->m_aiPad[ 0 ], m_cfg->m_SourceHeight - m_cfg->m_aiPad[ 1 ] );
+  }
+
+  return true;
+}
+
+void YuvReaderThread::xReadLoop()
+{
+  while ( true )
+  {
+    YUVBufferStorage* yuvBuf = nullptr;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_freeCond.wait( lock, [this]{ return ! m_freeQueue.empty() || m_stop; } );
+      if ( m_stop )
+      {
+        return;
+      }
+      yuvBuf = m_freeQueue.front();
+      m_freeQueue.pop_front();
+    }
+
+    const bool ok = xReadPicture( *yuvBuf );
+
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      if ( ok )
+      {
+        m_filledQueue.push_back( yuvBuf );
+      }
+      else
+      {
+        m_freeQueue.push_back( yuvBuf );
+        m_eof = true;
+      }
+    }
+    m_filledCond.notify_one();
+
+    if ( ! ok )
+    {
+      return;
+    }
+  }
+}
+
+// ====================================================================================================================
+
+OutputWriterThread::OutputWriterThread()
+  : m_bitstream   ( nullptr )
+  , m_yuvReconFile( nullptr )
+  , m_cfg         ( nullptr )
+  , m_numBuffers  ( 0 )
+  , m_stop        ( false )
+{
+}
+
+OutputWriterThread::~OutputWriterThread()
+{
+  stop();
+}
+
+void OutputWriterThread::start( std::ostream& bitstream, YuvIO* yuvReconFile, const EncAppCfg& cfg, int numBuffers )
+{
+  if ( m_bitstream != nullptr )
+  {
+    return;
+  }
+
+  m_bitstream    = &bitstream;
+  m_yuvReconFile = yuvReconFile;
+  m_cfg          = &cfg;
+  m_numBuffers   = numBuffers;
+  m_stop         = false;
+
+  if ( m_numBuffers > 0 )
+  {
+    m_thread = std::thread( &OutputWriterThread::xWriteLoop, this );
+  }
+}
+
+void OutputWriterThread::stop()
+{
+  if ( m_bitstream == nullptr )
+  {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_stop = true;
+  }
+  m_jobCond.notify_all();
+  if ( m_thread.joinable() )
+  {
+    m_thread.join();
+  }
+
+  for ( auto yuvBuf : m_freeYuvBufs )
+  {
+    delete yuvBuf;
+  }
+  m_freeYuvBufs.clear();
+  m_freeAnnexBBufs.clear();
+  m_bitstream    = nullptr;
+  m_yuvReconFile = nullptr;
+}
+
+void OutputWriterThread::writeAU( AccessUnit& au )
+{
+  if ( ! m_thread.joinable() )
+  {
+    m_bitstream->write( reinterpret_cast<const char*>( au.getAnnexB() ), au.getAnnexBSize() );
+    m_bitstream->flush();
+    return;
+  }
+
+  // hand the byte stream over and give the access unit a buffer, which has already been written, to fill next
+  OutputJob job;
+  job.yuvBuf = nullptr;
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    if ( ! m_freeAnnexBBufs.empty() )
+    {
+      job.annexB.swap( m_freeAnnexBBufs.front() );
+      m_freeAnnexBBufs.pop_front();
+    }
+  }
+  au.swapAnnexB( job.annexB );
+  xPushJob( std::move( job ) );
+}
+
+void OutputWriterThread::writeYuv( const YUVBuffer& yuvOutBuf )
+{
+  if ( m_yuvReconFile == nullptr )
+  {
+    return;
+  }
+
+  if ( ! m_thread.joinable() )
+  {
+    m_yuvReconFile->writeYuvBuf( yuvOutBuf, m_cfg->m_internChromaFormat, m_cfg->m_internChromaFormat, m_cfg->m_packedYUVMode, m_cfg->m_bClipOutputVideoToRec709Range );
+    return;
+  }
+
+  // the reconstruction is only valid during the callback, keep a copy for the writer thread
+  OutputJob job;
+  job.yuvBuf = nullptr;
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_freeCond.wait( lock, [this]{ return (int)m_jobQueue.size() < m_numBuffers; } );
+    if ( ! m_freeYuvBufs.empty() )
+    {
+      job.yuvBuf = m_freeYuvBufs.front();
+      m_freeYuvBufs.pop_front();
+    }
+  }
+  if ( job.yuvBuf && ! job.yuvBuf->hasSameSize( yuvOutBuf ) )
+  {
+    delete job.yuvBuf;
+    job.yuvBuf = nullptr;
+  }
+  if ( job.yuvBuf == nullptr )
+  {
+    job.yuvBuf = new YUVBufferStorage( yuvOutBuf );
+  }
+  job.yuvBuf->copyFrom( yuvOutBuf );
+
+  xPushJob( std::move( job ) );
+}
+
+void OutputWriterThread::xPushJob( OutputJob&& job )
+{
+  if ( ! m_thread.joinable() )
+  {
+    xWriteJob( job );
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_mutex );
+    m_freeCond.wait( lock, [this]{ return (int)m_jobQueue.size() < m_numBuffers; } );
+    m_jobQueue.push_back( std::move( job ) );
+  }
+  m_jobCond.notify_one();
+}
+
+void OutputWriterThread::xWriteJob( OutputJob& job )
+{
+  if ( ! job.annexB.empty() )
+  {
+    m_bitstream->write( reinterpret_cast<const char*>( job.annexB.data() ), job.annexB.size() );
+    m_bitstream->flush();
+  }
+  if ( job.yuvBuf )
+  {
+    m_yuvReconFile->writeYuvBuf( *job.yuvBuf, m_cfg->m_internChromaFormat, m_cfg->m_internChromaFormat, m_cfg->m_packedYUVMode, m_cfg->m_bClipOutputVideoToRec709Range );
+  }
+}
+
+void OutputWriterThread::xWriteLoop()
+{
+  while ( true )
+  {
+    OutputJob job;
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_jobCond.wait( lock, [this]{ return ! m_jobQueue.empty() || m_stop; } );
+      if ( m_jobQueue.empty() )
+      {
+        return;
+      }
+      job = std::move( m_jobQueue.front() );
+      m_jobQueue.pop_front();
+    }
+    m_freeCond.notify_one();
+
+    xWriteJob( job );
+
+    if ( job.yuvBuf )
+    {
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_freeYuvBufs.push_back( job.yuvBuf );
+    }
+    else if ( job.annexB.capacity() )
+    {
+      job.annexB.clear();
+      std::unique_lock<std::mutex> lock( m_mutex );
+      m_freeAnnexBBufs.push_back( std::move( job.annexB ) );
+    }
+  }
+}
+
+//! \}
+
@@ -0,0 +1,184 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     FileIOThread.h
+    \brief    asynchronous file reader/writer threads (header)
+*/
+
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "../../../include/vvenc/FileIO.h"
+#include "../../../include/vvenc/Nal.h"
+#include "../vvencFFapp/EncAppCfg.h"
+
+//! \ingroup EncoderApp
+//! \{
+
+// ====================================================================================================================
+
+struct YUVBufferStorage : public YUVBuffer
+{
+  YUVBufferStorage( const ChromaFormat& chFmt, const int frameWidth, const int frameHeight )
+    : YUVBuffer()
+  {
+    for ( int i = 0; i < MAX_NUM_COMP; i++ )
+    {
+      YUVPlane& yuvPlane = yuvPlanes[ i ];
+      yuvPlane.width     = getWidthOfComponent ( chFmt, frameWidth,  i );
+      yuvPlane.height    = getHeightOfComponent( chFmt, frameHeight, i );
+      yuvPlane.stride    = yuvPlane.width;
+      const int size     = yuvPlane.stride * yuvPlane.height;
+      yuvPlane.planeBuf  = ( size > 0 ) ? new int16_t[ size ] : nullptr;
+    }
+  }
+
+  YUVBufferStorage( const YUVBuffer& yuvBuf )
+    : YUVBuffer()
+  {
+    for ( int i = 0; i < MAX_NUM_COMP; i++ )
+    {
+      YUVPlane& yuvPlane = yuvPlanes[ i ];
+      yuvPlane.width     = yuvBuf.yuvPlanes[ i ].width;
+      yuvPlane.height    = yuvBuf.yuvPlanes[ i ].height;
+      yuvPlane.stride    = yuvPlane.width;
+      const int size     = yuvPlane.stride * yuvPlane.height;
+      yuvPlane.planeBuf  = ( size > 0 ) ? new int16_t[ size ] : nullptr;
+    }
+  }
+
+  ~YUVBufferStorage()
+  {
+    for ( int i = 0; i < MAX_NUM_COMP; i++ )
+    {
+      YUVPlane& yuvPlane = yuvPlanes[ i ];
+      if ( yuvPlane.planeBuf )
+        delete [] yuvPlane.planeBuf;
+    }
+  }
+
+  bool hasSameSize( const YUVBuffer& yuvBuf ) const;
+  void copyFrom   ( const YUVBuffer& yuvBuf );
+};
+
+// ====================================================================================================================
+
+/// reads input pictures ahead of the encoder, the read pictures are handed over through a bounded queue
+class YuvReaderThread
+{
+private:
+  YuvIO*                          m_yuvInputFile;
+  const EncAppCfg*                m_cfg;
+  int                             m_maxFrames;
+  int                             m_framesRead;
+  bool                            m_eof;
+  bool                            m_stop;
+  std::vector<YUVBufferStorage*>  m_buffers;
+  std::deque<YUVBufferStorage*>   m_freeQueue;
+  std::deque<YUVBufferStorage*>   m_filledQueue;
+  std::thread                     m_thread;
+  std::mutex                      m_mutex;
+  std::condition_variable         m_freeCond;
+  std::condition_variable         m_filledCond;
+
+public:
+  YuvReaderThread();
+  ~YuvReaderThread();
+
+  void              start         ( YuvIO& yuvInputFile, const EncAppCfg& cfg, int numBuffers, int maxFrames ); ///< numBuffers = 0: read synchronously in getPicture()
+  void              stop          ();
+  YUVBufferStorage* getPicture    ();                                   ///< returns nullptr at end of input
+  void              releasePicture( YUVBufferStorage* yuvBuf );
+
+private:
+  bool              xReadPicture  ( YUVBufferStorage& yuvBuf );
+  void              xReadLoop     ();
+};
+
+// ====================================================================================================================
+
+/// writes bitstream chunks and reconstructed pictures in a separate thread, the caller blocks only if the queue is full
+class OutputWriterThread
+{
+private:
+  struct OutputJob
+  {
+    std::vector<uint8_t> annexB;
+    YUVBufferStorage*    yuvBuf;
+  };
+
+  std::ostream*                   m_bitstream;
+  YuvIO*                          m_yuvReconFile;
+  const EncAppCfg*                m_cfg;
+  int                             m_numBuffers;
+  bool                            m_stop;
+  std::deque<YUVBufferStorage*>   m_freeYuvBufs;
+  std::deque<std::vector<uint8_t>> m_freeAnnexBBufs;
+  std::deque<OutputJob>           m_jobQueue;
+  std::thread                     m_thread;
+  std::mutex                      m_mutex;
+  std::condition_variable         m_freeCond;
+  std::condition_variable         m_jobCond;
+
+public:
+  OutputWriterThread();
+  ~OutputWriterThread();
+
+  void start    ( std::ostream& bitstream, YuvIO* yuvReconFile, const EncAppCfg& cfg, int numBuffers ); ///< numBuffers = 0: write synchronously
+  void stop     ();                                             ///< writes all pending jobs and stops the thread
+  void writeAU  ( AccessUnit& au );                             ///< takes the byte stream of the access unit and leaves a drained buffer in exchange
+  void writeYuv ( const YUVBuffer& yuvOutBuf );
+
+private:
+  void xPushJob ( OutputJob&& job );
+  void xWriteJob( OutputJob& job );
+  void xWriteLoop();
+};
+
+//! \}
+
@@ -73,14 +73,21 @@ int main(int argc, char* argv[])
   vvenc::setMsgFnc( &msgFnc );
 
   std::string simdOpt;
+  std::string bitstreamFile;
+  std::string reconFile;
   VVCEncoderFFApp::df::program_options_lite::Options opts;
   opts.addOptions()
-    ( "c",           VVCEncoderFFApp::df::program_options_lite::parseConfigFile, "" )
-    ( "Verbosity,v", g_verbosity,                               "" )
-    ( "SIMD",        simdOpt,                                   "" );
+    ( "c",               VVCEncoderFFApp::df::program_options_lite::parseConfigFile, "" )
+    ( "Verbosity,v",     g_verbosity,                           "" )
+    ( "SIMD",            simdOpt,                               "" )
+    ( "BitstreamFile,b", bitstreamFile,                         "" )
+    ( "ReconFile,o",     reconFile,                             "" );
   VVCEncoderFFApp::df::program_options_lite::SilentReporter err;
   VVCEncoderFFApp::df::program_options_lite::scanArgv( opts, argc, ( const char** ) argv, err );
 
+  // keep stdout clean when it carries the bitstream or the reconstruction
+  g_msgToStderr = ( bitstreamFile == "-" || reconFile == "-" );
+
   simdOpt = vvenc::setSIMDExtension( simdOpt );
 
   // print information
@@ -49,9 +49,17 @@ vvc@hhi.fraunhofer.de
 
 #pragma once
 
-#include <fstream>
+#include <cstdio>
+#include <cstring>
 #include "vvenc/vvenc.h"
 
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#endif
+
 namespace vvcutilities {
 
 /**
@@ -65,15 +73,17 @@ public:
   BinFileWriter(){}
 
   /// Destructor
-  virtual ~BinFileWriter() {}
+  virtual ~BinFileWriter() { close(); }
 
   bool isOpen()
   {
-    return m_cOS.is_open() ? true : false;
+    return m_pcFile ? true : false;
   }
 
   /**
     This method opens a file.
+    When the file name is "-" the bitstream is written to stdout and all further console output
+    of the process is redirected to stderr, so the bitstream can be piped into another application.
     \param[in]  pcFilename pointer to Filename.
     \retval     int, nonzero if failed
 		\pre        None
@@ -82,9 +92,33 @@ public:
   int open( const char* pcFilename )
   {
     // if there is some stream open just shut it down
-    m_cOS.close(); 
-    m_cOS.open( pcFilename, std::ios::out | std::ios::binary | std::ios::trunc);
-    return m_cOS.is_open() ? 0 : -1;
+    close();
+    if( !strcmp( pcFilename, "-" ) )
+    {
+      // keep a private handle to stdout for the bitstream and let stdout point to stderr from now on
+      fflush( stdout );
+#ifdef _WIN32
+      const int iFd = _dup( _fileno( stdout ) );
+      if( iFd < 0 || _dup2( _fileno( stderr ), _fileno( stdout ) ) < 0 )
+      {
+        return -1;
+      }
+      _setmode( iFd, _O_BINARY );
+      m_pcFile = _fdopen( iFd, "wb" );
+#else
+      const int iFd = dup( fileno( stdout ) );
+      if( iFd < 0 || dup2( fileno( stderr ), fileno( stdout ) ) < 0 )
+      {
+        return -1;
+      }
+      m_pcFile = fdopen( iFd, "wb" );
+#endif
+    }
+    else
+    {
+      m_pcFile = fopen( pcFilename, "wb" );
+    }
+    return m_pcFile ? 0 : -1;
   }
 
   /**
@@ -101,10 +135,9 @@ public:
       return 0;
     }
 
-    size_t lBefore = m_cOS.tellp();
-    m_cOS.write( (const char*)rcAccessUnit.m_pucBuffer, rcAccessUnit.m_iUsedSize );
-    // check if this read was okay
-    return (int)(lBefore + rcAccessUnit.m_iUsedSize - m_cOS.tellp());
+    const size_t lWritten = fwrite( rcAccessUnit.m_pucBuffer, 1, rcAccessUnit.m_iUsedSize, m_pcFile );
+    // check if this write was okay
+    return (int)(rcAccessUnit.m_iUsedSize - lWritten);
   }
 
   /**
@@ -112,14 +145,15 @@ public:
   */
   void close()
   {
-    if( m_cOS.is_open() )
+    if( m_pcFile )
     {
-      m_cOS.close();
+      fclose( m_pcFile );
+      m_pcFile = nullptr;
     }
   }
 
 private:
-  std::ofstream m_cOS;
+  FILE* m_pcFile = nullptr;
 };
 
 } // namespace
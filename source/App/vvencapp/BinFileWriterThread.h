@@ -0,0 +1,218 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/**
+  \ingroup VVEncoderApp
+  \file    BinFileWriterThread.h
+  \brief   This file contains the interface for class BinFileWriterThread.
+*/
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <cassert>
+
+#include "vvenc/vvenc.h"
+#include "BinFileWriter.h"
+
+namespace vvcutilities {
+
+/**
+  \ingroup VVEncoderApp
+  The BinFileWriterThread class writes access units to a BinFileWriter in a separate thread.
+  Access units are copied into a bounded queue, the caller only blocks if the queue is full.
+  With zero buffers the access units are written synchronously.
+*/
+class BinFileWriterThread
+{
+public:
+  /// Constructor
+  BinFileWriterThread() {}
+
+  /// Destructor
+  virtual ~BinFileWriterThread()
+  {
+    close();
+  }
+
+  /**
+    This method starts the writer for an already opened BinFileWriter.
+    \param[in]  rcWriter    reference to opened BinFileWriter
+    \param[in]  iNumBuffers max. number of access units queued for writing (0: synchronous writing)
+  */
+  void open( BinFileWriter& rcWriter, const int iNumBuffers )
+  {
+    if( m_pcWriter ){ assert( !m_pcWriter ); return; }
+
+    m_pcWriter    = &rcWriter;
+    m_iNumBuffers = iNumBuffers;
+    m_bStop       = false;
+    m_iRet        = 0;
+
+    if( m_iNumBuffers > 0 )
+    {
+      m_cThread = std::thread( &BinFileWriterThread::xWriteLoop, this );
+    }
+  }
+
+  /**
+    This method writes all pending access units and stops the writer thread.
+    \retval     int, nonzero if any write failed
+  */
+  int close()
+  {
+    if( ! m_pcWriter )
+    {
+      return 0;
+    }
+
+    {
+      std::unique_lock<std::mutex> cLock( m_cMutex );
+      m_bStop = true;
+    }
+    m_cFilledCond.notify_all();
+    if( m_cThread.joinable() )
+    {
+      m_cThread.join();
+    }
+
+    m_cFilledQueue.clear();
+    m_cFreeQueue.clear();
+    m_pcWriter = nullptr;
+    return m_iRet;
+  }
+
+  /**
+    This method queues an access unit for writing.
+    \param[in]  rcAccessUnit reference to Accessunit, the payload is copied.
+    \retval     int, nonzero if a previous write failed
+  */
+  int writeAU( const vvenc::VvcAccessUnit& rcAccessUnit )
+  {
+    if( ! m_pcWriter ){ assert( m_pcWriter ); return -1; }
+
+    if( ! m_cThread.joinable() )
+    {
+      return m_pcWriter->writeAU( rcAccessUnit );
+    }
+
+    if( rcAccessUnit.m_iUsedSize == 0 )
+    {
+      return 0;
+    }
+
+    std::vector<unsigned char> cPayload;
+    {
+      std::unique_lock<std::mutex> cLock( m_cMutex );
+      m_cFreeCond.wait( cLock, [this]{ return (int)m_cFilledQueue.size() < m_iNumBuffers; } );
+      if( ! m_cFreeQueue.empty() )
+      {
+        cPayload.swap( m_cFreeQueue.front() );
+        m_cFreeQueue.pop_front();
+      }
+    }
+
+    cPayload.assign( rcAccessUnit.m_pucBuffer, rcAccessUnit.m_pucBuffer + rcAccessUnit.m_iUsedSize );
+
+    int iRet = 0;
+    {
+      std::unique_lock<std::mutex> cLock( m_cMutex );
+      m_cFilledQueue.push_back( std::move( cPayload ) );
+      iRet = m_iRet;
+    }
+    m_cFilledCond.notify_one();
+    return iRet;
+  }
+
+private:
+
+  void xWriteLoop()
+  {
+    vvenc::VvcAccessUnit cAccessUnit;
+    while( true )
+    {
+      std::vector<unsigned char> cPayload;
+      {
+        std::unique_lock<std::mutex> cLock( m_cMutex );
+        m_cFilledCond.wait( cLock, [this]{ return ! m_cFilledQueue.empty() || m_bStop; } );
+        if( m_cFilledQueue.empty() )
+        {
+          return;
+        }
+        cPayload.swap( m_cFilledQueue.front() );
+        m_cFilledQueue.pop_front();
+      }
+      m_cFreeCond.notify_one();
+
+      cAccessUnit.m_pucBuffer = cPayload.data();
+      cAccessUnit.m_iBufSize  = (int)cPayload.size();
+      cAccessUnit.m_iUsedSize = (int)cPayload.size();
+      const int iRet = m_pcWriter->writeAU( cAccessUnit );
+
+      std::unique_lock<std::mutex> cLock( m_cMutex );
+      if( iRet )
+      {
+        m_iRet = iRet;
+      }
+      // keep the allocation for reuse
+      m_cFreeQueue.push_back( std::move( cPayload ) );
+    }
+  }
+
+private:
+  BinFileWriter*                          m_pcWriter    = nullptr;
+  int                                     m_iNumBuffers = 0;
+  bool                                    m_bStop       = false;
+  int                                     m_iRet        = 0;
+  std::deque<std::vector<unsigned char>>  m_cFreeQueue;
+  std::deque<std::vector<unsigned char>>  m_cFilledQueue;
+  std::thread                             m_cThread;
+  std::mutex                              m_cMutex;
+  std::condition_variable                 m_cFreeCond;
+  std::condition_variable                 m_cFilledCond;
+};
+
+} // namespace
+
@@ -69,14 +69,15 @@ public:
   virtual ~CmdLineParser() {}
 
   static void print_usage( std::string cApp, vvenc::VVEncParameter& rcParams, std::string &rcPreset,
-                           std::string &rcProfile, std::string &rcLevel, std::string &rcTier, bool bFullHelp )
+                           std::string &rcProfile, std::string &rcLevel, std::string &rcTier, int iIOBuffers, bool bFullHelp )
   {
       printf( "\n Usage:  %s  [param1] [pararm2] [...] \n", cApp.c_str() );
       std::cout <<
           "\n"
           " File input Options\n"
           "\n"
-          "\t [--input,-i <str>        ] : raw yuv input file\n"
+          "\t [--input,-i <str>        ] : raw yuv or YUV4MPEG2 (.y4m) input file, '-' reads from stdin\n"
+          "\t [--y4m                   ] : force YUV4MPEG2 input (needed for stdin, otherwise detected by file extension)\n"
           "\t [--size,-s  <intxint>    ] : specify input resolution (width x height) ["<< rcParams.m_iWidth << "x" << rcParams.m_iHeight <<"]\n"
           "\t [--format,-c  <str>      ] : set input format (yuv420, yuv420_10) [yuv420]\n"
           "\t [--framerate,-r  <int>   ] : temporal rate (framerate) e.g. 25,29,30,50,59,60 ["<< rcParams.m_iTemporalRate/rcParams.m_iTemporalScale <<"]\n"
@@ -89,17 +90,19 @@ public:
       }
       std::cout <<
           "\t [--frames,-f  <int>      ] : max. frames to encode (default: -1 all frames) \n"
+          "\t [--iobuffers    <int>    ] : pictures buffered by the input reader and output writer threads (0: synchronous file i/o) [" << iIOBuffers << "]\n"
           "\n"
           " Bitstream output options\n"
           "\n"
-          "\t [--output,-o  <str>      ] : bitstream output file (default: not set)\n"
+          "\t [--output,-o  <str>      ] : bitstream output file, '-' writes to stdout (default: not set)\n"
           "\n"
           " Encoder Options\n"
           "\n"
-          "\t [--preset      <str>     ] : select preset for specific encoding setting ( faster, fast, medium, slow ) default: [" << rcPreset << "]\n";
+          "\t [--preset      <str>     ] : select preset for specific encoding setting ( ultrafast, faster, fast, medium, slow ) default: [" << rcPreset << "]\n";
       if ( bFullHelp )
       {
         std::cout <<
+          "\t              ultrafast     : preview speed   : quality=-1 \n"
           "\t              faster        : best speed      : quality=0 \n"
           "\t              fast          : fast mode       : quality=1 \n"
           "\t              medium        : default quality : quality=2 \n"
@@ -109,6 +112,7 @@ public:
           "\t [--bitrate,-b  <int>     ] : Bitrate for rate control (0 constant QP encoding rate control off, otherwise bits per second) [" << rcParams.m_iTargetBitRate << "]\n"
           "\t [--qp  <int>             ] : QP (0-51) [" << rcParams.m_iQp << "]\n"
           "\t [--qpa <int>             ] : Perceptual QP adaption (0: off, on for 1: SDR(WPSNR), 2: SDR(XPSNR), 3: HDR(WPSNR), 4: HDR(XPSNR), 5: HDR(MeanLuma)) [" <<  rcParams.m_iPerceptualQPA << "]\n"
+          "\t [--internal-bitdepth <int>] : internal bit depth (8: 8-bit input is coded with 8-bit samples, 10) [" <<  rcParams.m_iInternalBitDepth << "]\n"
           "\t [--threads,-t  <int>     ] : number of threads (1-n) default: size <= HD:" << rcParams.m_iThreadCount << "; UHD:6\n"
           "\n"
           "\t [--gopsize,-g  <int>     ] : GOP size of temporal structure (16) [" <<  rcParams.m_iGopSize << "]\n"
@@ -129,7 +133,7 @@ public:
   }
 
   static int parse_command_line( int argc, char* argv[] , vvenc::VVEncParameter& rcParams, std::string& rcInputFile, std::string& rcBitstreamFile,
-                                 int& riFrames, int& riInputBitdepth, bool& rbThreadCountSet )
+                                 int& riFrames, int& riInputBitdepth, int& riIOBuffers, bool& rbY4m, bool& rbThreadCountSet )
   {
     int iRet = 0;
     /* Check command line parameters */
@@ -259,6 +263,21 @@ public:
         if( rcParams.m_eLogLevel > vvenc::LL_VERBOSE )
           fprintf( stdout, "[frames]               : %d\n", riFrames );
       }
+      else if( !strcmp( (const char*)argv[i_arg], "--y4m" ) )
+      {
+        i_arg++;
+        rbY4m = true;
+        if( rcParams.m_eLogLevel > vvenc::LL_VERBOSE )
+          fprintf( stdout, "[y4m]                  : 1\n" );
+      }
+      else if( !strcmp( (const char*)argv[i_arg], "--iobuffers" ) )
+      {
+        i_arg++;
+        riIOBuffers = atoi( argv[i_arg++] );
+        if( riIOBuffers < 0 ) riIOBuffers = 0;
+        if( rcParams.m_eLogLevel > vvenc::LL_VERBOSE )
+          fprintf( stdout, "[iobuffers]            : %d\n", riIOBuffers );
+      }
       else if( (!strcmp( (const char*)argv[i_arg], "-c" )) || !strcmp( (const char*)argv[i_arg], "--format" ) )
       {
         i_arg++;
@@ -319,9 +338,13 @@ public:
           {
             rcParams.m_iQuality = 0;
           }
+          else if( "ultrafast" == cPreset )
+          {
+            rcParams.m_iQuality = -1;
+          }
           else
           {
-            std::cerr << "wrong preset!   use: --preset faster, fast, medium, slow" << std::endl;
+            std::cerr << "wrong preset!   use: --preset ultrafast, faster, fast, medium, slow" << std::endl;
             return -1;
           }
         }
@@ -347,6 +370,13 @@ public:
         if( rcParams.m_eLogLevel > vvenc::LL_VERBOSE )
           fprintf( stdout, "[qpa]                  : %d\n", rcParams.m_iPerceptualQPA );
       }
+      else if( !strcmp( (const char*)argv[i_arg], "--internal-bitdepth" ) )
+      {
+        i_arg++;
+        rcParams.m_iInternalBitDepth = atoi( argv[i_arg++] );
+        if( rcParams.m_eLogLevel > vvenc::LL_VERBOSE )
+          fprintf( stdout, "[internal-bitdepth]    : %d\n", rcParams.m_iInternalBitDepth );
+      }
       else if( (!strcmp( (const char*)argv[i_arg], "--gopsize" )) || !strcmp( (const char*)argv[i_arg], "-g" ) )
       {
         i_arg++;
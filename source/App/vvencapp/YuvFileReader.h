@@ -50,9 +50,18 @@ vvc@hhi.fraunhofer.de
 #pragma once
 
 #include "vvenc/vvenc.h"
+#include "vvenc/FileIO.h"
+#include <iostream>
 #include <fstream>
+#include <string>
+#include <cstring>
 #include <cassert>
 
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
 // this function pointer takes the exported encoder function expCopyUnPack10BitBlk
 void (*extCopyUnPack10BitBlk)      ( short* pDes, const int iStride, const int iWidth, const int iHeight, const unsigned char* pSrc ) = NULL;
 
@@ -90,7 +99,7 @@ public:
 		\post       None
   */
   int open( const char* pcFilename, const int iFileBitDepth, const int iDestBitDepth, const int iWidth, const int iHeight,
-            int iRepeatTimes = 0, bool bPacked = false )
+            int iRepeatTimes = 0, bool bPacked = false, bool bForceY4m = false )
   {
     if( m_bInitialized ){ assert( !m_bInitialized ); return -1; }
 
@@ -125,9 +134,28 @@ public:
     }
 
     // if there is some stream open just shut it down
-    m_cIS.close(); 
-    m_cIS.open( pcFilename, std::ios::in | std::ios::binary );
-    int iRet = m_cIS.is_open() ? 0 : -1;
+    m_cIS.close();
+    if( !strcmp( pcFilename, "-" ) )
+    {
+#ifdef _WIN32
+      _setmode( _fileno( stdin ), _O_BINARY );
+#endif
+      m_pcIS = &std::cin;
+    }
+    else
+    {
+      m_cIS.open( pcFilename, std::ios::in | std::ios::binary );
+      m_pcIS = &m_cIS;
+    }
+    int iRet = m_pcIS->good() ? 0 : -1;
+
+    // YUV4MPEG2: skip the stream header, unless it has already been consumed by vvenc::YuvIO::parseY4mHeader()
+    m_bY4m = bForceY4m || vvenc::YuvIO::isY4mFileName( pcFilename );
+    if( 0 == iRet && m_bY4m )
+    {
+      iRet = xSkipY4mHeader();
+    }
+
     m_bInitialized = true;
     return iRet;
   }
@@ -138,7 +166,10 @@ public:
 
     delete [] m_psBuffer;
     delete [] m_cReadBuffer.m_pucDeletePicBuffer;
+    m_psBuffer = nullptr;
+    m_cReadBuffer.m_pucDeletePicBuffer = nullptr;
     m_cIS.close();
+    m_pcIS = nullptr;
 
     m_bInitialized = false;
     return 0;
@@ -180,9 +211,15 @@ public:
     if( !m_bInitialized ){ assert( m_bInitialized ); return -1; }
 
     for( unsigned int ui = 0; ui < uiNumFrames; ui++ )
-    m_cIS.seekg(m_iPicSize, m_cIS.cur );
+    {
+      if( m_bY4m && 0 != xSkipY4mFrameHeader() )
+      {
+        return -1;
+      }
+      m_pcIS->ignore( m_iPicSize );
+    }
 
-    return 0;
+    return m_pcIS->fail() ? -1 : 0;
   }
 
 
@@ -190,7 +227,7 @@ public:
   {
     if( !m_bInitialized ){ assert( m_bInitialized ); return -1; }
 
-    if( ! m_cIS.is_open() )
+    if( ! m_pcIS || ! m_pcIS->good() )
     {
       return -1;
     }
@@ -201,10 +238,14 @@ public:
     if( iRet != 0 && m_iRepeatTimes )
     {
       m_iRepeatTimes--;
-      m_cIS.clear();
-      m_cIS.seekg(0, m_cIS.beg);
+      m_pcIS->clear();
+      m_pcIS->seekg(0, m_pcIS->beg);
       // try once again
-      iRet = xReadPicture( rcReadBuffer );
+      iRet = m_bY4m ? xSkipY4mHeader() : 0;
+      if( 0 == iRet )
+      {
+        iRet = xReadPicture( rcReadBuffer );
+      }
     }
 
     if( m_bPacked )
@@ -226,6 +267,24 @@ protected:
 
 private:
 
+  int xSkipY4mHeader()
+  {
+    if( m_pcIS->peek() != 'Y' )
+    {
+      return 0;
+    }
+    std::string cHeader;
+    std::getline( *m_pcIS, cHeader );
+    return ( m_pcIS->fail() || cHeader.compare( 0, 9, "YUV4MPEG2" ) != 0 ) ? -1 : 0;
+  }
+
+  int xSkipY4mFrameHeader()
+  {
+    std::string cFrameHeader;
+    std::getline( *m_pcIS, cFrameHeader );
+    return ( m_pcIS->fail() || cFrameHeader.compare( 0, 5, "FRAME" ) != 0 ) ? -1 : 0;
+  }
+
   int xReadPicture( vvenc::PicBuffer& rcPicBuffer )
   {
     // let's focus on 420
@@ -237,13 +296,16 @@ private:
     rcPicBuffer.m_iWidth = m_iWidth;
     rcPicBuffer.m_iHeight = m_iHeight;
 
-    const size_t lBefore = m_cIS.tellg();
+    if( m_bY4m && 0 != xSkipY4mFrameHeader() )
+    {
+      return -1;
+    }
+
     xReadPlane( rcPicBuffer.m_pvY, rcPicBuffer.m_iStride, m_iReadWidth, m_iHeight );
     xReadPlane( rcPicBuffer.m_pvU, iCStride, iCWidth, iCHeight );
     xReadPlane( rcPicBuffer.m_pvV, iCStride, iCWidth, iCHeight );
     // check if this read was okay
-    const size_t lAfter = m_cIS.tellg();
-    return (int)(lBefore + m_iPicSize - lAfter);
+    return m_pcIS->fail() ? -1 : 0;
   }
 
   void xReadPlane( void* pvBuffer, const int iStride, const int iWidth, const int iHeight )
@@ -254,7 +316,7 @@ private:
       if( iStride == iWidth )
       {
         const int iReadSize = iWidth * iHeight * iFactor;
-        m_cIS.read( (char*)pvBuffer, iReadSize);
+        m_pcIS->read( (char*)pvBuffer, iReadSize);
       }
       else
       {
@@ -263,7 +325,7 @@ private:
         const int iLineOffset = iStride * iFactor; 
         for( int y = 0; y < iHeight; y++)
         {
-          m_cIS.read( pc, iReadSize );
+          m_pcIS->read( pc, iReadSize );
           pc += iLineOffset;
         }
       }
@@ -275,7 +337,7 @@ private:
       unsigned char* pucTemp = (unsigned char*) m_psBuffer;
       for( int y = 0; y < iHeight; y++)
       {
-        m_cIS.read( (char*)pucTemp, iWidth );
+        m_pcIS->read( (char*)pucTemp, iWidth );
         for( int x = 0; x < iWidth; x++)
         {
           ps[x] = pucTemp[x] << iShift;
@@ -291,7 +353,7 @@ private:
       short* psTemp = m_psBuffer;
       for( int y = 0; y < iHeight; y++)
       {
-        m_cIS.read( (char*)psTemp, 2*iWidth );
+        m_pcIS->read( (char*)psTemp, 2*iWidth );
         for( int x = 0; x < iWidth; x++)
         {
           puc[x] = (psTemp[x] + sAdd) >> iShift;
@@ -306,7 +368,7 @@ private:
       short* psTemp = m_psBuffer;
       for( int y = 0; y < iHeight; y++)
       {
-        m_cIS.read( (char*)psTemp, 2*iWidth );
+        m_pcIS->read( (char*)psTemp, 2*iWidth );
         for( int x = 0; x < iWidth; x++)
         {
           ps[x] = psTemp[x] << iShift;
@@ -322,7 +384,7 @@ private:
       short* psTemp = m_psBuffer;
       for( int y = 0; y < iHeight; y++)
       {
-        m_cIS.read( (char*)psTemp, 2*iWidth );
+        m_pcIS->read( (char*)psTemp, 2*iWidth );
         for( int x = 0; x < iWidth; x++)
         {
           ps[x] = (psTemp[x] + sAdd) >> iShift;
@@ -343,8 +405,10 @@ protected:
   int m_iHeight       = 0;
   int m_iRepeatTimes  = 0;
   bool m_bPacked      = false;
+  bool m_bY4m         = false;
   size_t m_iPicSize   = 0;
   std::ifstream m_cIS;
+  std::istream* m_pcIS = nullptr;
   vvenc::PicBuffer m_cReadBuffer;
 };
 
@@ -0,0 +1,258 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/**
+  \ingroup VVCUtilitiesExternalInterfaces
+  \file    YuvFileReaderThread.h
+  \brief   This file contains the interface for class YuvFileReaderThread.
+*/
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <algorithm>
+
+#include "vvenc/vvenc.h"
+#include "YuvFileReader.h"
+
+namespace vvcutilities {
+
+/**
+  \ingroup VVCUtilitiesExternalInterfaces
+  The YuvFileReaderThread class reads input pictures ahead of the encoder in a separate thread.
+  Pictures are read into a fixed number of buffers that circulate between a free and a filled queue,
+  so disk i/o and sample conversion overlap with encoding. With zero buffers the pictures are read
+  synchronously within getPicture().
+*/
+class YuvFileReaderThread
+{
+public:
+  /// Constructor
+  YuvFileReaderThread() {}
+
+  /// Destructor
+  virtual ~YuvFileReaderThread()
+  {
+    close();
+  }
+
+  /**
+    This method starts reading pictures from an already opened YuvFileReader.
+    \param[in]  rcReader    reference to opened YuvFileReader
+    \param[in]  iNumBuffers number of pictures to read ahead (0: synchronous reading)
+    \param[in]  iMaxFrames  max. number of pictures to read (0: read until end of file)
+    \retval     int, nonzero if failed
+  */
+  int open( YuvFileReader& rcReader, const int iNumBuffers, const int iMaxFrames )
+  {
+    if( m_pcReader ){ assert( !m_pcReader ); return -1; }
+
+    m_pcReader    = &rcReader;
+    m_iMaxFrames  = iMaxFrames;
+    m_iFramesRead = 0;
+    m_bEof        = false;
+    m_bStop       = false;
+
+    m_acBuffers.resize( std::max( iNumBuffers, 1 ) );
+    for( auto& rcPicBuffer : m_acBuffers )
+    {
+      int iRet = m_pcReader->allocBuffer( rcPicBuffer, true );
+      if( iRet ) { return iRet; }
+      rcPicBuffer.m_eColorFormat = vvenc::VVC_CF_YUV420_PLANAR;
+      m_cFreeQueue.push_back( &rcPicBuffer );
+    }
+
+    if( iNumBuffers > 0 )
+    {
+      m_cThread = std::thread( &YuvFileReaderThread::xReadLoop, this );
+    }
+    return 0;
+  }
+
+  /**
+    This method stops the reader thread and frees all buffers.
+  */
+  void close()
+  {
+    if( ! m_pcReader )
+    {
+      return;
+    }
+
+    {
+      std::unique_lock<std::mutex> cLock( m_cMutex );
+      m_bStop = true;
+    }
+    m_cFreeCond.notify_all();
+    if( m_cThread.joinable() )
+    {
+      m_cThread.join();
+    }
+
+    for( auto& rcPicBuffer : m_acBuffers )
+    {
+      delete [] rcPicBuffer.m_pucDeletePicBuffer;
+    }
+    m_acBuffers.clear();
+    m_cFreeQueue.clear();
+    m_cFilledQueue.clear();
+    m_pcReader = nullptr;
+  }
+
+  /**
+    This method returns the next input picture in display order.
+    The picture stays valid until it is handed back by releasePicture().
+    \retval     vvenc::PicBuffer*, nullptr if the end of the input has been reached
+  */
+  vvenc::PicBuffer* getPicture()
+  {
+    if( ! m_pcReader ){ assert( m_pcReader ); return nullptr; }
+
+    if( ! m_cThread.joinable() )
+    {
+      vvenc::PicBuffer* pcPicBuffer = m_cFreeQueue.front();
+      return xReadPicture( *pcPicBuffer ) ? pcPicBuffer : nullptr;
+    }
+
+    std::unique_lock<std::mutex> cLock( m_cMutex );
+    m_cFilledCond.wait( cLock, [this]{ return ! m_cFilledQueue.empty() || m_bEof; } );
+    if( m_cFilledQueue.empty() )
+    {
+      return nullptr;
+    }
+    vvenc::PicBuffer* pcPicBuffer = m_cFilledQueue.front();
+    m_cFilledQueue.pop_front();
+    return pcPicBuffer;
+  }
+
+  /**
+    This method hands a picture buffer back to the reader, after the encoder has consumed its content.
+  */
+  void releasePicture( vvenc::PicBuffer* pcPicBuffer )
+  {
+    if( ! m_cThread.joinable() || ! pcPicBuffer )
+    {
+      return;
+    }
+
+    {
+      std::unique_lock<std::mutex> cLock( m_cMutex );
+      m_cFreeQueue.push_back( pcPicBuffer );
+    }
+    m_cFreeCond.notify_one();
+  }
+
+private:
+
+  bool xReadPicture( vvenc::PicBuffer& rcPicBuffer )
+  {
+    if( m_iMaxFrames > 0 && m_iFramesRead >= m_iMaxFrames )
+    {
+      return false;
+    }
+    if( 0 != m_pcReader->readPicture( rcPicBuffer ) )
+    {
+      return false;
+    }
+    m_iFramesRead++;
+    return true;
+  }
+
+  void xReadLoop()
+  {
+    while( true )
+    {
+      vvenc::PicBuffer* pcPicBuffer = nullptr;
+      {
+        std::unique_lock<std::mutex> cLock( m_cMutex );
+        m_cFreeCond.wait( cLock, [this]{ return ! m_cFreeQueue.empty() || m_bStop; } );
+        if( m_bStop )
+        {
+          return;
+        }
+        pcPicBuffer = m_cFreeQueue.front();
+        m_cFreeQueue.pop_front();
+      }
+
+      const bool bOk = xReadPicture( *pcPicBuffer );
+
+      {
+        std::unique_lock<std::mutex> cLock( m_cMutex );
+        if( bOk )
+        {
+          m_cFilledQueue.push_back( pcPicBuffer );
+        }
+        else
+        {
+          m_cFreeQueue.push_back( pcPicBuffer );
+          m_bEof = true;
+        }
+      }
+      m_cFilledCond.notify_one();
+
+      if( ! bOk )
+      {
+        return;
+      }
+    }
+  }
+
+private:
+  YuvFileReader*                 m_pcReader    = nullptr;
+  int                            m_iMaxFrames  = 0;
+  int                            m_iFramesRead = 0;
+  bool                           m_bEof        = false;
+  bool                           m_bStop       = false;
+  std::vector<vvenc::PicBuffer>  m_acBuffers;
+  std::deque<vvenc::PicBuffer*>  m_cFreeQueue;
+  std::deque<vvenc::PicBuffer*>  m_cFilledQueue;
+  std::thread                    m_cThread;
+  std::mutex                     m_cMutex;
+  std::condition_variable        m_cFreeCond;
+  std::condition_variable        m_cFilledCond;
+};
+
+} // namespace
+
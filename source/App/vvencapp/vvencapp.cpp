@@ -62,8 +62,10 @@ vvc@hhi.fraunhofer.de
 #include "vvenc/vvenc.h"
 
 #include "BinFileWriter.h"
+#include "BinFileWriterThread.h"
 #include "CmdLineParser.h"
 #include "YuvFileReader.h"
+#include "YuvFileReaderThread.h"
 
 int main( int argc, char* argv[] )
 {
@@ -91,7 +93,7 @@ int main( int argc, char* argv[] )
   cVVEncParameter.m_iTemporalScale  = 1;                          // temporal scale (fps)
   cVVEncParameter.m_iTicksPerSecond = 90000;                      // ticks per second e.g. 90000 for dts generation
   cVVEncParameter.m_iThreadCount    = 4;                          // number of worker threads (should not exceed the number of physical cpu's)
-  cVVEncParameter.m_iQuality        = 2;                          // encoding quality (vs speed) 0: faster, 1: fast, 2: medium, 3: slow
+  cVVEncParameter.m_iQuality        = 2;                          // encoding quality (vs speed) -1: ultrafast, 0: faster, 1: fast, 2: medium, 3: slow
   cVVEncParameter.m_iPerceptualQPA  = 2;                          // percepual qpa adaption, 0 off, 1 on for sdr(wpsnr), 2 on for sdr(xpsnr), 3 on for hdr(wpsrn), 4 on for hdr(xpsnr), on for hdr(MeanLuma)
   cVVEncParameter.m_eProfile        = vvenc::VVC_PROFILE_MAIN_10; // profile: use main_10 or main_10_still_picture
   cVVEncParameter.m_eLevel          = vvenc::VVC_LEVEL_4_1;       // level
@@ -105,22 +107,24 @@ int main( int argc, char* argv[] )
 
   int iMaxFrames = 0;
   int iInputBitdepth = 8;
+  int iIOBuffers = 3;                                             // number of pictures buffered by the file reader/writer threads (0: synchronous)
 
   if(  argc > 1 && (!strcmp( (const char*) argv[1], "--help" ) || !strcmp( (const char*) argv[1], "-h" )) )
   {
     std::cout << cAppname  << " version: " << VVENC_VERSION << std::endl;
-    vvcutilities::CmdLineParser::print_usage( cAppname, cVVEncParameter, cPreset, cProfile, cLevel, cTier, false );
+    vvcutilities::CmdLineParser::print_usage( cAppname, cVVEncParameter, cPreset, cProfile, cLevel, cTier, iIOBuffers, false );
     return 0;
   }
   else if(  argc > 1 && (!strcmp( (const char*) argv[1], "--fullhelp" ) ) )
   {
     std::cout << cAppname  << " version: " << VVENC_VERSION << std::endl;
-    vvcutilities::CmdLineParser::print_usage( cAppname, cVVEncParameter, cPreset, cProfile, cLevel, cTier, true );
+    vvcutilities::CmdLineParser::print_usage( cAppname, cVVEncParameter, cPreset, cProfile, cLevel, cTier, iIOBuffers, true );
     return 0;
   }
 
   bool bThreadCountSet = false;
-  int iRet = vvcutilities::CmdLineParser::parse_command_line(  argc, argv, cVVEncParameter, cInputFile, cOutputfile, iMaxFrames, iInputBitdepth, bThreadCountSet );
+  bool bY4m = false;
+  int iRet = vvcutilities::CmdLineParser::parse_command_line(  argc, argv, cVVEncParameter, cInputFile, cOutputfile, iMaxFrames, iInputBitdepth, iIOBuffers, bY4m, bThreadCountSet );
 
   if( iRet != 0 ) 
   {
@@ -128,7 +132,7 @@ int main( int argc, char* argv[] )
     {
       bool bFullHelp = ( iRet == 3) ? true : false;
       std::cout << cAppname  << " version: " << VVENC_VERSION << std::endl;
-      vvcutilities::CmdLineParser::print_usage( cAppname, cVVEncParameter, cPreset, cProfile, cLevel, cTier, bFullHelp);
+      vvcutilities::CmdLineParser::print_usage( cAppname, cVVEncParameter, cPreset, cProfile, cLevel, cTier, iIOBuffers, bFullHelp);
       return 0;
     }
 
@@ -148,6 +152,35 @@ int main( int argc, char* argv[] )
     return -1;
   }
 
+  // open output file first, writing to stdout redirects all console output to stderr
+  vvcutilities::BinFileWriter cBinFileWriter;
+  if( 0 != cBinFileWriter.open( cOutputfile.c_str() ) )
+  {
+    std::cout << cAppname  << " [error]: failed to open output file " << cOutputfile << std::endl;
+    return -1;
+  }
+
+  // YUV4MPEG2 input: size, frame rate and sample format are given by the stream header
+  if( bY4m || vvenc::YuvIO::isY4mFileName( cInputFile ) )
+  {
+    bY4m = true;
+    vvenc::ChromaFormat eChromaFormat = vvenc::CHROMA_420;
+    int iFrameRate  = 0;
+    int iFrameScale = 0;
+    if( ! vvenc::YuvIO::parseY4mHeader( cInputFile, cVVEncParameter.m_iWidth, cVVEncParameter.m_iHeight, iFrameRate, iFrameScale, eChromaFormat, iInputBitdepth ) )
+    {
+      std::cout << cAppname  << " [error]: failed to read YUV4MPEG2 header of input file " << cInputFile << std::endl;
+      return -1;
+    }
+    if( eChromaFormat != vvenc::CHROMA_420 || ( iInputBitdepth != 8 && iInputBitdepth != 10 ) )
+    {
+      std::cout << cAppname  << " [error]: unsupported YUV4MPEG2 input format, use 4:2:0 with 8 or 10 bit" << std::endl;
+      return -1;
+    }
+    cVVEncParameter.m_iTemporalRate  = iFrameRate;
+    cVVEncParameter.m_iTemporalScale = iFrameScale;
+  }
+
   if( cVVEncParameter.m_eLogLevel > vvenc::LL_SILENT && cVVEncParameter.m_eLogLevel < vvenc::LL_NOTICE )
   {
     std::cout << "-------------------" << std::endl;
@@ -189,21 +222,25 @@ int main( int argc, char* argv[] )
 
   // open the input file
   vvcutilities::YuvFileReader cYuvFileReader;
-  if( 0 != cYuvFileReader.open( cInputFile.c_str(), iInputBitdepth, 10, cVVEncParameter.m_iWidth, cVVEncParameter.m_iHeight ) )
+  if( 0 != cYuvFileReader.open( cInputFile.c_str(), iInputBitdepth, cVVEncParameter.m_iInternalBitDepth, cVVEncParameter.m_iWidth, cVVEncParameter.m_iHeight, 0, false, bY4m ) )
   {
     std::cout << cAppname  << " [error]: failed to open input file " << cInputFile << std::endl;
     return -1;
   }
 
-  // open output file
-  vvcutilities::BinFileWriter cBinFileWriter;
-  if( !cOutputfile.empty() )
+  // read input pictures ahead of the encoder
+  vvcutilities::YuvFileReaderThread cYuvFileReaderThread;
+  if( 0 != cYuvFileReaderThread.open( cYuvFileReader, iIOBuffers, iMaxFrames ) )
   {
-    if( 0 != cBinFileWriter.open( cOutputfile.c_str() ) )
-    {
-      std::cout << cAppname  << " [error]: failed to open output file " << cOutputfile << std::endl;
-      return -1;
-    }
+    std::cout << cAppname  << " [error]: failed to allocate input buffers" << std::endl;
+    return -1;
+  }
+
+  // write access units asynchronously
+  vvcutilities::BinFileWriterThread cBinFileWriterThread;
+  if( cBinFileWriter.isOpen() )
+  {
+    cBinFileWriterThread.open( cBinFileWriter, iIOBuffers );
   }
 
 
@@ -213,14 +250,6 @@ int main( int argc, char* argv[] )
   cAccessUnit.m_pucBuffer = new unsigned char [ cAccessUnit.m_iBufSize ];
 
   vvenc::InputPicture cInputPicture;
-  iRet = cVVEnc.getPreferredBuffer( cInputPicture.m_cPicBuffer );
-  if( iRet )
-  {
-    std::cout << cAppname  << " [error]: Encoder failed to get preferredBuffer " << std::endl;
-    return iRet;
-  }
-  const unsigned char* pucDeletePicBuffer = cInputPicture.m_cPicBuffer.m_pucDeletePicBuffer;
-  cInputPicture.m_cPicBuffer.m_pucDeletePicBuffer = NULL;
 
   std::chrono::steady_clock::time_point cTPStart;
   std::chrono::steady_clock::time_point cTPEnd;
@@ -239,8 +268,8 @@ int main( int argc, char* argv[] )
   int64_t iSeqNumber = 0;
   while( !bEof )
   {
-    iRet = cYuvFileReader.readPicture( cInputPicture.m_cPicBuffer );
-    if( iRet )
+    vvenc::PicBuffer* pcPicBuffer = cYuvFileReaderThread.getPicture();
+    if( NULL == pcPicBuffer )
     {
       if( cVVEncParameter.m_eLogLevel > vvenc::LL_ERROR && cVVEncParameter.m_eLogLevel < vvenc::LL_NOTICE )
       {
@@ -251,6 +280,10 @@ int main( int argc, char* argv[] )
 
     if( !bEof )
     {
+      // the buffer is owned by the reader, the encoder copies its content
+      cInputPicture.m_cPicBuffer = *pcPicBuffer;
+      cInputPicture.m_cPicBuffer.m_pucDeletePicBuffer = NULL;
+
       // set sequence number and cts
       cInputPicture.m_cPicBuffer.m_uiSequenceNumber = iSeqNumber;
       cInputPicture.m_cPicBuffer.m_uiCts            = iSeqNumber * cVVEncParameter.m_iTicksPerSecond * cVVEncParameter.m_iTemporalScale / cVVEncParameter.m_iTemporalRate;
@@ -259,6 +292,7 @@ int main( int argc, char* argv[] )
       //std::cout << "process picture " << cInputPicture.m_cPicBuffer.m_uiSequenceNumber << " cts " << cInputPicture.m_cPicBuffer.m_uiCts << std::endl;
       // call encode
       iRet = cVVEnc.encode( &cInputPicture, cAccessUnit );
+      cYuvFileReaderThread.releasePicture( pcPicBuffer );
 
       // check success
       if( iRet != 0 )
@@ -273,7 +307,7 @@ int main( int argc, char* argv[] )
         if( cBinFileWriter.isOpen())
         {
           // write output
-          cBinFileWriter.writeAU( cAccessUnit );
+          cBinFileWriterThread.writeAU( cAccessUnit );
         }
 
         if( ! cAccessUnit.m_cInfo.empty() ) // print debug info
@@ -343,7 +377,7 @@ int main( int argc, char* argv[] )
     if( cBinFileWriter.isOpen())
     {
       // write output
-      cBinFileWriter.writeAU( cAccessUnit );
+      cBinFileWriterThread.writeAU( cAccessUnit );
     }
   };
 
@@ -351,11 +385,15 @@ int main( int argc, char* argv[] )
   double dTimeSec = cVVEnc.clockGetTimeDiffMs() / 1000;
 
   delete[] cAccessUnit.m_pucBuffer;
-  delete[] pucDeletePicBuffer;
 
+  cYuvFileReaderThread.close();
   cYuvFileReader.close();
   if( cBinFileWriter.isOpen())
   {
+    if( 0 != cBinFileWriterThread.close() )
+    {
+      std::cout << cAppname  << " [error]: failed to write output file " << cOutputfile << std::endl;
+    }
     cBinFileWriter.close();
   }
 
@@ -408,6 +408,31 @@ uint32_t InputBitstream::readByteAlignment()
   return numBits+1;
 }
 
+// ====================================================================================================================
+// Byte stream operations
+// ====================================================================================================================
+
+static size_t findZeroPairCore( const uint8_t* buf, size_t pos, size_t size )
+{
+  for( ; pos + 1 < size; pos++ )
+  {
+    if( buf[ pos ] == 0 && buf[ pos + 1 ] == 0 )
+    {
+      return pos;
+    }
+  }
+  return size;
+}
+
+BitstreamOps::BitstreamOps()
+{
+  isInitX86Done = false;
+
+  findZeroPair  = findZeroPairCore;
+}
+
+BitstreamOps g_bitstreamOps = BitstreamOps();
+
 } // namespace vvenc
 
 //! \}
@@ -216,6 +216,26 @@ public:
         std::vector<uint8_t> &getFifo()       { return m_fifo; }
 };
 
+// ====================================================================================================================
+// Byte stream operations
+// ====================================================================================================================
+
+struct BitstreamOps
+{
+  BitstreamOps();
+
+  bool isInitX86Done;
+
+#if ENABLE_SIMD_OPT_BITSTREAM && defined(TARGET_SIMD_X86)
+  void initBitstreamOpsX86();
+  template<X86_VEXT vext>
+  void _initBitstreamOpsX86();
+#endif
+  size_t ( *findZeroPair )( const uint8_t* buf, size_t pos, size_t size );   ///< position of the first two consecutive zero bytes at or after pos, size if there are none
+};
+
+extern BitstreamOps g_bitstreamOps;
+
 } // namespace vvenc
 
 //! \}
@@ -793,11 +793,78 @@ void AreaBuf<MotionInfo>::fill( const MotionInfo& val )
   }
 }
 
+// ---------------------------------------------------------------------------
+// PelStoragePool
+// ---------------------------------------------------------------------------
+
+static const size_t POOL_SIZE_CLASS_LOG2 = 16;
+
+PelStoragePool::PelStoragePool()
+  : m_numReused( 0 )
+{
+}
+
+PelStoragePool::~PelStoragePool()
+{
+  destroy();
+}
+
+size_t PelStoragePool::getSizeClass( const size_t size )
+{
+  return ( ( size + ( size_t( 1 ) << POOL_SIZE_CLASS_LOG2 ) - 1 ) >> POOL_SIZE_CLASS_LOG2 ) << POOL_SIZE_CLASS_LOG2;
+}
+
+void* PelStoragePool::alloc( const size_t size )
+{
+  const size_t sizeClass = getSizeClass( size );
+  {
+    std::lock_guard<std::mutex> lock( m_mutex );
+    auto it = m_cache.find( sizeClass );
+    if( it != m_cache.end() && ! it->second.empty() )
+    {
+      void* ptr = it->second.back();
+      it->second.pop_back();
+      m_numReused++;
+      return ptr;
+    }
+  }
+
+  // touch all pages once, so the page faults happen here and not while encoding a picture
+  void* ptr = MemAlloc::alloc( sizeClass, true );
+  ::memset( ptr, 0, sizeClass );
+  return ptr;
+}
+
+void PelStoragePool::release( void* ptr, const size_t size )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  m_cache[ getSizeClass( size ) ].push_back( ptr );
+}
+
+void PelStoragePool::destroy()
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  for( auto& sizeClass : m_cache )
+  {
+    for( auto ptr : sizeClass.second )
+    {
+      MemAlloc::dealloc( ptr );
+    }
+  }
+  m_cache.clear();
+}
+
+// ---------------------------------------------------------------------------
+// PelStorage
+// ---------------------------------------------------------------------------
+
 PelStorage::PelStorage()
+  : m_pool( nullptr )
 {
   for( uint32_t i = 0; i < MAX_NUM_COMP; i++ )
   {
-    m_origin[i] = nullptr;
+    m_origin[i]    = nullptr;
+    m_planeSize[i] = 0;
   }
 }
 
@@ -806,6 +873,70 @@ PelStorage::~PelStorage()
   destroy();
 }
 
+void PelStorage::setPool( PelStoragePool* pool )
+{
+  CHECK( ! bufs.empty(), "Trying to change the pool of an initialized buffer" );
+  m_pool = pool;
+}
+
+size_t PelStorage::getAllocSize() const
+{
+  size_t size = 0;
+  for( uint32_t i = 0; i < MAX_NUM_COMP; i++ )
+  {
+    size += m_origin[i] ? m_planeSize[i] : 0;
+  }
+  return size;
+}
+
+size_t PelStorage::getAllocSize( const ChromaFormat &_chromaFormat, const Area& _area, const unsigned _maxCUSize, const unsigned _margin, const unsigned _alignment, const bool _scaleChromaMargin, const bool _pooled )
+{
+  size_t size = 0;
+  for( uint32_t i = 0; i < getNumberValidComponents( _chromaFormat ); i++ )
+  {
+    const Size   planeSize = xGetPlaneSize( _chromaFormat, ComponentID( i ), _area, _maxCUSize, _margin, _alignment, _scaleChromaMargin );
+    const size_t planeBytes = sizeof( Pel ) * planeSize.area();
+    size += _pooled ? PelStoragePool::getSizeClass( planeBytes ) : planeBytes;
+  }
+  return size;
+}
+
+Size PelStorage::xGetPlaneSize( const ChromaFormat &_chromaFormat, const ComponentID compID, const Area& _area, const unsigned _maxCUSize, const unsigned _margin, const unsigned _alignment, const bool _scaleChromaMargin )
+{
+  unsigned extHeight = _area.height;
+  unsigned extWidth  = _area.width;
+
+  if( _maxCUSize )
+  {
+    extHeight = ( ( _area.height + _maxCUSize - 1 ) / _maxCUSize ) * _maxCUSize;
+    extWidth  = ( ( _area.width  + _maxCUSize - 1 ) / _maxCUSize ) * _maxCUSize;
+  }
+
+  const unsigned scaleX = getComponentScaleX( compID, _chromaFormat );
+  const unsigned scaleY = getComponentScaleY( compID, _chromaFormat );
+
+  unsigned scaledHeight = extHeight >> scaleY;
+  unsigned scaledWidth  = extWidth  >> scaleX;
+  unsigned ymargin      = _margin >> (_scaleChromaMargin?scaleY:0);
+  unsigned xmargin      = _margin >> (_scaleChromaMargin?scaleX:0);
+  unsigned totalWidth   = scaledWidth + 2*xmargin;
+  unsigned totalHeight  = scaledHeight +2*ymargin;
+
+  if( _alignment )
+  {
+    // make sure buffer lines are align
+    CHECK( _alignment != MEMORY_ALIGN_DEF_SIZE, "Unsupported alignment" );
+    totalWidth = ( ( totalWidth + _alignment - 1 ) / _alignment ) * _alignment;
+  }
+  return Size( totalWidth, totalHeight );
+}
+
+Pel* PelStorage::xAllocPlane( const int id, const size_t size )
+{
+  m_planeSize[id] = size;
+  return ( Pel* ) ( m_pool ? m_pool->alloc( size ) : MemAlloc::alloc( size, true ) );
+}
+
 void PelStorage::create( const UnitArea& _UnitArea )
 {
   create( _UnitArea.chromaFormat, _UnitArea.blocks[0] );
@@ -832,7 +963,7 @@ void PelStorage::create( const ChromaFormat &_chromaFormat, const Area& _area )
   }
 
   //allocate one buffer
-  m_origin[0] = ( Pel* ) xMalloc( Pel, bufSize );
+  m_origin[0] = xAllocPlane( 0, sizeof( Pel ) * bufSize );
 
   Pel* topLeft = m_origin[0];
   for( uint32_t i = 0; i < numComp; i++ )
@@ -855,38 +986,20 @@ void PelStorage::create( const ChromaFormat &_chromaFormat, const Area& _area, c
 
   const uint32_t numComp = getNumberValidComponents( _chromaFormat );
 
-  unsigned extHeight = _area.height;
-  unsigned extWidth  = _area.width;
-
-  if( _maxCUSize )
-  {
-    extHeight = ( ( _area.height + _maxCUSize - 1 ) / _maxCUSize ) * _maxCUSize;
-    extWidth  = ( ( _area.width  + _maxCUSize - 1 ) / _maxCUSize ) * _maxCUSize;
-  }
-
   for( uint32_t i = 0; i < numComp; i++ )
   {
     const ComponentID compID = ComponentID( i );
     const unsigned scaleX = getComponentScaleX( compID, _chromaFormat );
     const unsigned scaleY = getComponentScaleY( compID, _chromaFormat );
 
-    unsigned scaledHeight = extHeight >> scaleY;
-    unsigned scaledWidth  = extWidth  >> scaleX;
     unsigned ymargin      = _margin >> (_scaleChromaMargin?scaleY:0);
     unsigned xmargin      = _margin >> (_scaleChromaMargin?scaleX:0);
-    unsigned totalWidth   = scaledWidth + 2*xmargin;
-    unsigned totalHeight  = scaledHeight +2*ymargin;
-
-    if( _alignment )
-    {
-      // make sure buffer lines are align
-      CHECK( _alignment != MEMORY_ALIGN_DEF_SIZE, "Unsupported alignment" );
-      totalWidth = ( ( totalWidth + _alignment - 1 ) / _alignment ) * _alignment;
-    }
-    uint32_t area = totalWidth * totalHeight;
+    const Size planeSize  = xGetPlaneSize( _chromaFormat, compID, _area, _maxCUSize, _margin, _alignment, _scaleChromaMargin );
+    unsigned totalWidth   = planeSize.width;
+    uint32_t area         = planeSize.area();
     CHECK( !area, "Trying to create a buffer with zero area" );
 
-    m_origin[i] = ( Pel* ) xMalloc( Pel, area );
+    m_origin[i] = xAllocPlane( i, sizeof( Pel ) * area );
     Pel* topLeft = m_origin[i] + totalWidth * ymargin + xmargin;
     bufs.push_back( PelBuf( topLeft, totalWidth, _area.width >> scaleX, _area.height >> scaleY ) );
   }
@@ -919,8 +1032,10 @@ void PelStorage::takeOwnership( PelStorage& other )
   {
     PelBuf cPelBuf = other.get( ComponentID( i ) );
     bufs[i] = PelBuf( cPelBuf.bufAt( 0, 0 ), cPelBuf.stride, cPelBuf.width, cPelBuf.height );
-    std::swap( m_origin[i], other.m_origin[i]);
+    std::swap( m_origin[i],    other.m_origin[i]);
+    std::swap( m_planeSize[i], other.m_planeSize[i]);
   }
+  std::swap( m_pool, other.m_pool );
   other.destroy();
 }
 
@@ -939,7 +1054,9 @@ void PelStorage::swap( PelStorage& other )
     std::swap( bufs[i].buf,    other.bufs[i].buf );
     std::swap( bufs[i].stride, other.bufs[i].stride );
     std::swap( m_origin[i],    other.m_origin[i] );
+    std::swap( m_planeSize[i], other.m_planeSize[i] );
   }
+  std::swap( m_pool, other.m_pool );
 }
 
 void PelStorage::destroy()
@@ -949,7 +1066,14 @@ void PelStorage::destroy()
   {
     if( m_origin[i] )
     {
-      xFree( m_origin[i] );
+      if( m_pool )
+      {
+        m_pool->release( m_origin[i], m_planeSize[i] );
+      }
+      else
+      {
+        MemAlloc::dealloc( m_origin[i] );
+      }
       m_origin[i] = nullptr;
     }
   }
@@ -56,6 +56,7 @@ vvc@hhi.fraunhofer.de
 #include <string.h>
 #include <type_traits>
 #include <typeinfo>
+#include <map>
 
 //! \ingroup CommonLib
 //! \{
@@ -191,9 +192,6 @@ typedef AreaBuf<const TCoeff> CPLTescapeBuf;
 typedef AreaBuf<      bool>  PLTtypeBuf;
 typedef AreaBuf<const bool> CPLTtypeBuf;
 
-typedef AreaBuf<      LoopFilterParam>  LFPBuf;
-typedef AreaBuf<const LoopFilterParam> CLFPBuf;
-
 #define SIZE_AWARE_PER_EL_OP( OP, INC )                     \
 if( ( width & 7 ) == 0 )                                    \
 {                                                           \
@@ -920,11 +918,36 @@ const UnitBuf<const T> UnitBuf<T>::subBuf( const UnitArea& subArea ) const
 struct UnitArea;
 struct CompArea;
 
+// recycles the plane memory of picture sized buffers in size classes, buffers created again (parameter set changes,
+// new segments, MCTF intermediates) get memory, which has already been touched, instead of page faulting again
+class PelStoragePool
+{
+public:
+  PelStoragePool();
+  ~PelStoragePool();
+
+  void*  alloc      ( const size_t size );
+  void   release    ( void* ptr, const size_t size );
+  void   destroy    ();
+  size_t getNumReused() const { return m_numReused; }
+
+  static size_t getSizeClass( const size_t size );                ///< bytes allocated for a block of the given size
+
+private:
+  std::mutex                           m_mutex;
+  std::map<size_t, std::vector<void*>> m_cache;                   ///< free blocks per size class
+  size_t                               m_numReused;
+};
+
 struct PelStorage : public PelUnitBuf
 {
   PelStorage();
   ~PelStorage();
 
+  void setPool( PelStoragePool* pool ); ///< planes created afterwards are taken from and returned to the pool
+  size_t getAllocSize() const;          ///< bytes allocated for the planes owned by this storage
+  static size_t getAllocSize( const ChromaFormat &_chromaFormat, const Area& _area, const unsigned _maxCUSize, const unsigned _margin = 0, const unsigned _alignment = 0, const bool _scaleChromaMargin = true, const bool _pooled = false );
+
   void swap( PelStorage& other );
   void createFromBuf( PelUnitBuf buf );
   void takeOwnership( PelStorage& other );
@@ -955,9 +978,15 @@ struct PelStorage : public PelUnitBuf
          PelBuf     getCompactBuf(const CompArea& blk);
   const CPelBuf     getCompactBuf(const CompArea& blk) const;
 
+private:
+  Pel* xAllocPlane( const int id, const size_t size );
+  static Size xGetPlaneSize( const ChromaFormat &_chromaFormat, const ComponentID compID, const Area& _area, const unsigned _maxCUSize, const unsigned _margin, const unsigned _alignment, const bool _scaleChromaMargin );
+
 private:
 
-  Pel* m_origin[MAX_NUM_COMP];
+  Pel*            m_origin[MAX_NUM_COMP];
+  size_t          m_planeSize[MAX_NUM_COMP];
+  PelStoragePool* m_pool;
 };
 
 struct CompStorage : public PelBuf
@@ -101,10 +101,11 @@ CodingStructure::CodingStructure( XUCache& unitCache, std::mutex* mutex )
 
   for( int i = 0; i < NUM_EDGE_DIR; i++ )
   {
-    m_lfParam [ i ] = nullptr;
+    m_lfParam [ i ].setBuf( nullptr, 0, 0 );
   }
 
-  m_motionBuf = nullptr;
+  m_motionBuf     = nullptr;
+  m_motionCompact = false;
   features.resize( NUM_ENC_FEATURES );
 }
 
@@ -140,12 +141,16 @@ void CodingStructure::destroy()
 
   for( int i = 0; i < NUM_EDGE_DIR; i++ )
   {
-    xFree( m_lfParam[ i ] );
-    m_lfParam[ i ] = nullptr;
+    xFree( m_lfParam[ i ].bs );
+    m_lfParam[ i ].setBuf( nullptr, 0, 0 );
   }
 
   delete[] m_motionBuf;
-  m_motionBuf = nullptr;
+  m_motionBuf     = nullptr;
+  m_motionCompact = false;
+
+  m_mapMem   .release();
+  m_motionMem.release();
 
 
   if ( m_unitCacheMutex ) m_unitCacheMutex->lock();
@@ -164,6 +169,40 @@ void CodingStructure::releaseIntermediateData()
   clearCUs();
 }
 
+void CodingStructure::compactMotionField()
+{
+  // TMVP reads the collocated motion at the top-left 4x4 block of each 8x8 block only
+  static_assert( ( 1 << COL_MOTION_LOG2 ) == 4 * ( AMVP_DECIMATION_FACTOR > 1 ? AMVP_DECIMATION_FACTOR : 1 ), "collocated motion granularity does not match the TMVP compression" );
+  CHECK( parent, "motion field compaction is only supported for the picture coding structure" );
+
+  if( m_motionCompact )
+  {
+    return;
+  }
+
+  const int       step        = 1 << ( COL_MOTION_LOG2 - MIN_CU_LOG2 );
+  const Size      miSize      = g_miScaling.scale( area.lumaSize() );
+  const ptrdiff_t stride      = getMiMapStride();
+  const int       colWidth    = ( miSize.width  + step - 1 ) / step;
+  const int       colHeight   = ( miSize.height + step - 1 ) / step;
+  MotionInfo*     colMotion   = new MotionInfo[ colWidth * colHeight ];
+
+  for( int y = 0; y < colHeight; y++ )
+  {
+    const MotionInfo* src = m_motionBuf + y * step * stride;
+    for( int x = 0; x < colWidth; x++ )
+    {
+      colMotion[ y * colWidth + x ] = src[ x * step ];
+    }
+  }
+
+  delete[] m_motionBuf;
+  m_motionBuf     = colMotion;
+  m_motionCompact = true;
+  m_motionMem.release();
+  m_motionMem.add( sizeof( MotionInfo ) * colWidth * colHeight );
+}
+
 bool CodingStructure::isDecomp( const Position& pos, const ChannelType effChType )
 {
   if( area.blocks[effChType].contains( pos ) )
@@ -747,17 +786,6 @@ cTUTraverser CodingStructure::traverseTUs( const UnitArea& unit, const ChannelTy
 
 
 
-LFPBuf CodingStructure::getLoopFilterParamBuf(const DeblockEdgeDir& edgeDir)
-{
-  return LFPBuf(m_lfParam[edgeDir], m_mapSize[0]);
-}
-
-const CLFPBuf CodingStructure::getLoopFilterParamBuf(const DeblockEdgeDir& edgeDir) const
-{
-  return CLFPBuf(m_lfParam[edgeDir], m_mapSize[0]);
-}
-
-
 // coding utilities
 
 void CodingStructure::allocateVectorsAtPicLevel()
@@ -821,11 +849,13 @@ void CodingStructure::createInternals( const UnitArea& _unit, const bool isTopLa
     m_puPtr[i]    = _area > 0 ? new PredictionUnit*[_area] : nullptr;
     m_tuPtr[i]    = _area > 0 ? new TransformUnit* [_area] : nullptr;
     m_isDecomp[i] = _area > 0 ? new bool           [_area] : nullptr;
+    m_mapMem.add( ( sizeof( CodingUnit* ) + sizeof( PredictionUnit* ) + sizeof( TransformUnit* ) + sizeof( bool ) ) * _area );
   }
 
     for( unsigned i = 0; i < NUM_EDGE_DIR; i++ )
     {
-    m_lfParam[i] = ( isTopLayer && m_mapSize[0].area() > 0 ) ? ( LoopFilterParam* ) xMalloc( LoopFilterParam, m_mapSize[0].area() ) : nullptr;
+    const size_t planeSize = isTopLayer ? m_mapSize[0].area() : 0;
+    m_lfParam[i].setBuf( planeSize > 0 ? ( uint8_t* ) xMalloc( uint8_t, LoopFilterParamMap::NUM_PLANES * planeSize ) : nullptr, m_mapSize[0].width, planeSize );
     }
 
   numCh = getNumberValidComponents(area.chromaFormat);
@@ -846,6 +876,7 @@ void CodingStructure::createInternals( const UnitArea& _unit, const bool isTopLa
 
   unsigned _lumaAreaScaled = g_miScaling.scale( area.lumaSize() ).area();
   m_motionBuf       = new MotionInfo[_lumaAreaScaled];
+  m_motionMem.add( sizeof( MotionInfo ) * _lumaAreaScaled );
   initStructData();
 }
 
@@ -1188,6 +1219,16 @@ void CodingStructure::initStructData( const int QP, const bool skipMotBuf )
   clearTUs();
   clearCUs();
 
+  if( m_motionCompact )
+  {
+    // the picture is reused, restore the full resolution motion field
+    delete[] m_motionBuf;
+    m_motionBuf     = new MotionInfo[ g_miScaling.scale( area.lumaSize() ).area() ];
+    m_motionCompact = false;
+    m_motionMem.release();
+    m_motionMem.add( sizeof( MotionInfo ) * g_miScaling.scale( area.lumaSize() ).area() );
+  }
+
   if( QP < MAX_INT )
   {
     currQP[0] = currQP[1] = QP;
@@ -1276,6 +1317,7 @@ MotionBuf CodingStructure::getMotionBuf( const Area& _area )
   const CompArea& _luma = area.Y();
 
   CHECKD( !_luma.contains( _area ), "Trying to access motion information outside of this coding structure" );
+  CHECKD( m_motionCompact, "Trying to access the full resolution motion of a compacted motion field" );
 
   const Area miArea   = g_miScaling.scale( _area );
   const Area selfArea = g_miScaling.scale( _luma );
@@ -1288,6 +1330,7 @@ const CMotionBuf CodingStructure::getMotionBuf( const Area& _area ) const
   const CompArea& _luma = area.Y();
 
   CHECKD( !_luma.contains( _area ), "Trying to access motion information outside of this coding structure" );
+  CHECKD( m_motionCompact, "Trying to access the full resolution motion of a compacted motion field" );
 
   const Area miArea   = g_miScaling.scale( _area );
   const Area selfArea = g_miScaling.scale( _luma );
@@ -1298,6 +1341,7 @@ const CMotionBuf CodingStructure::getMotionBuf( const Area& _area ) const
 MotionInfo& CodingStructure::getMotionInfo( const Position& pos )
 {
   CHECKD( !area.Y().contains( pos ), "Trying to access motion information outside of this coding structure" );
+  CHECKD( m_motionCompact, "Trying to access the full resolution motion of a compacted motion field" );
 
   // bypass the motion buf calling and get the value directly
   const unsigned stride = g_miScaling.scaleHor( area.lumaSize().width );
@@ -1309,6 +1353,7 @@ MotionInfo& CodingStructure::getMotionInfo( const Position& pos )
 const MotionInfo& CodingStructure::getMotionInfo( const Position& pos ) const
 {
   CHECKD( !area.Y().contains( pos ), "Trying to access motion information outside of this coding structure" );
+  CHECKD( m_motionCompact, "Trying to access the full resolution motion of a compacted motion field" );
 
   // bypass the motion buf calling and get the value directly
   const unsigned stride = g_miScaling.scaleHor( area.lumaSize().width );
@@ -1317,6 +1362,21 @@ const MotionInfo& CodingStructure::getMotionInfo( const Position& pos ) const
   return *( m_motionBuf + miPos.y * stride + miPos.x );
 }
 
+const MotionInfo& CodingStructure::getColMotionInfo( const Position& pos ) const
+{
+  if( !m_motionCompact )
+  {
+    return getMotionInfo( pos );
+  }
+
+  CHECKD( !area.Y().contains( pos ), "Trying to access motion information outside of this coding structure" );
+
+  const unsigned stride = ( area.lumaSize().width + ( 1 << COL_MOTION_LOG2 ) - 1 ) >> COL_MOTION_LOG2;
+  const Position colPos = pos - area.lumaPos();
+
+  return *( m_motionBuf + ( colPos.y >> COL_MOTION_LOG2 ) * stride + ( colPos.x >> COL_MOTION_LOG2 ) );
+}
+
 PelBuf CodingStructure::getBuf( const CompArea& blk, const PictureType type )
 {
   if (!blk.valid())
@@ -110,6 +110,7 @@ public:
   void create( const ChromaFormat _chromaFormat, const Area& _area, const bool isTopLayer );
   void destroy();
   void releaseIntermediateData();
+  void compactMotionField();
 
   void rebindPicBufs();
   void createCoeffs();
@@ -231,8 +232,11 @@ private:
   int     m_offsets[MAX_NUM_COMP];
 
   MotionInfo *m_motionBuf;
+  bool        m_motionCompact;    // m_motionBuf only holds the collocated motion in COL_MOTION_LOG2 granularity
+  MemTrack    m_motionMem;
+  MemTrack    m_mapMem;
 
-  LoopFilterParam *m_lfParam[NUM_EDGE_DIR];
+  LoopFilterParamMap m_lfParam[NUM_EDGE_DIR];
 
   Size             m_mapSize[MAX_NUM_CH];
 
@@ -250,17 +254,15 @@ public:
 
   MotionInfo& getMotionInfo( const Position& pos );
   const MotionInfo& getMotionInfo( const Position& pos ) const;
+  const MotionInfo& getColMotionInfo( const Position& pos ) const;
 
   MotionInfo const* getMiMapPtr()    const { return m_motionBuf; }
   MotionInfo      * getMiMapPtr()          { return m_motionBuf; }
   ptrdiff_t         getMiMapStride() const { return ( ptrdiff_t ) g_miScaling.scaleHor( area.Y().width ); }
 
-  LFPBuf getLoopFilterParamBuf(const DeblockEdgeDir& edgeDir);
-  const CLFPBuf getLoopFilterParamBuf(const DeblockEdgeDir& edgeDir) const;
-
-  LoopFilterParam const* getLFPMapPtr   ( const DeblockEdgeDir edgeDir ) const { return m_lfParam[edgeDir]; }
-  LoopFilterParam      * getLFPMapPtr   ( const DeblockEdgeDir edgeDir )       { return m_lfParam[edgeDir]; }
-  ptrdiff_t              getLFPMapStride() const { return ( ptrdiff_t ) m_mapSize[CH_L].width; }
+  const LoopFilterParamMap& getLFPMap      ( const DeblockEdgeDir edgeDir ) const { return m_lfParam[edgeDir]; }
+        LoopFilterParamMap& getLFPMap      ( const DeblockEdgeDir edgeDir )       { return m_lfParam[edgeDir]; }
+  ptrdiff_t                 getLFPMapStride() const { return ( ptrdiff_t ) m_mapSize[CH_L].width; }
 
   UnitScale getScaling(const UnitScale::ScaliningType type, const ChannelType chType = CH_L)
   {
@@ -68,6 +68,8 @@ vvc@hhi.fraunhofer.de
 #include "StatCounter.h"
 #endif
 
+#include "MemAccounting.h"
+
 #include <mutex>
 
 // MS Visual Studio before 2014 does not support required C++11 features
@@ -204,6 +206,7 @@ static const int NOT_VALID =                                       -1;
 static const int AMVP_MAX_NUM_CANDS =                               2; ///< AMVP: advanced motion vector prediction - max number of final candidates
 static const int AMVP_MAX_NUM_CANDS_MEM =                           3; ///< AMVP: advanced motion vector prediction - max number of candidates
 static const int AMVP_DECIMATION_FACTOR =                           2;
+static const int COL_MOTION_LOG2 =                                  3; ///< granularity of the motion kept for finished pictures, which are only used as collocated pictures anymore
 static const int MRG_MAX_NUM_CANDS =                                6; ///< MERGE
 static const int AFFINE_MRG_MAX_NUM_CANDS =                         5; ///< AFFINE MERGE
 static const int IBC_MRG_MAX_NUM_CANDS =                            6; ///< IBC MERGE
@@ -535,7 +538,8 @@ static const int PLT_ENCBITDEPTH = 8;
 static const int PLT_FAST_RATIO = 100;
 
 static const int MCTF_RANGE           = 2;
-static const int MCTF_PADDING         = 128;
+static const int MCTF_MAX_MV          = 53;             ///< bound of the mctf motion in luma samples, each of the three refinement levels doubles the previous motion and adds 5, the last one another 15/16
+static const int MCTF_PADDING         = 64;             ///< covers the maximum mctf motion plus the interpolation filter taps
 static const int MCTF_ADD_QUEUE_DELAY = 2 * MCTF_RANGE + 1;
 
 static const int ENC_PPS_ID_RPR =                                 3;
@@ -634,11 +638,11 @@ inline std::string print( const char* fmt, ...)
 #if ALIGNED_MALLOC
 
 #if ( _WIN32 && ( _MSC_VER > 1300 ) ) || defined (__MINGW64_VERSION_MAJOR)
-#define xMalloc( type, len )        _aligned_malloc( sizeof(type)*(len), MEMORY_ALIGN_DEF_SIZE )
-#define xFree( ptr )                _aligned_free  ( ptr )
+#define xAlignedMalloc( type, len )      _aligned_malloc( sizeof(type)*(len), MEMORY_ALIGN_DEF_SIZE )
+#define xAlignedFree( ptr )              _aligned_free  ( ptr )
 #elif defined (__MINGW32__)
-#define xMalloc( type, len )        __mingw_aligned_malloc( sizeof(type)*(len), MEMORY_ALIGN_DEF_SIZE )
-#define xFree( ptr )                __mingw_aligned_free( ptr )
+#define xAlignedMalloc( type, len )      __mingw_aligned_malloc( sizeof(type)*(len), MEMORY_ALIGN_DEF_SIZE )
+#define xAlignedFree( ptr )              __mingw_aligned_free( ptr )
 #else
 namespace detail {
 template<typename T>
@@ -651,15 +655,19 @@ T* aligned_malloc(size_t len, size_t alignement) {
   return p;
 }
 }
-#define xMalloc( type, len )        detail::aligned_malloc<type>( len, MEMORY_ALIGN_DEF_SIZE )
-#define xFree( ptr )                free( ptr )
+#define xAlignedMalloc( type, len )      detail::aligned_malloc<type>( len, MEMORY_ALIGN_DEF_SIZE )
+#define xAlignedFree( ptr )              free( ptr )
 #endif
 
 #else
-#define xMalloc( type, len )        malloc   ( sizeof(type)*(len) )
-#define xFree( ptr )                free     ( ptr )
+#define xAlignedMalloc( type, len )      malloc   ( sizeof(type)*(len) )
+#define xAlignedFree( ptr )              free     ( ptr )
 #endif //#if ALIGNED_MALLOC
 
+// accounted to the memory account and subsystem of the current MemTagScope
+#define xMalloc( type, len )        ( type* ) MemAlloc::alloc( sizeof(type)*(len), false )
+#define xFree( ptr )                MemAlloc::dealloc( ptr )
+
 #if defined _MSC_VER
 #define ALIGN_DATA(nBytes,v) __declspec(align(nBytes)) v
 #else
@@ -0,0 +1,283 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     Hash.cpp
+    \brief    block hash tables of reconstructed pictures for hash based motion estimation
+*/
+
+#include "Hash.h"
+
+#include <algorithm>
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+// flat areas produce many identical blocks, only the first ones in raster order are kept
+static const uint32_t MAX_HASH_BUCKET_SIZE = 256;
+
+inline uint32_t BlockHash::xCombine( const uint32_t a, const uint32_t b, const uint32_t c, const uint32_t d )
+{
+  uint32_t h = a;
+  h ^= b + 0x9e3779b9u + ( h << 6 ) + ( h >> 2 );
+  h ^= c + 0x9e3779b9u + ( h << 6 ) + ( h >> 2 );
+  h ^= d + 0x9e3779b9u + ( h << 6 ) + ( h >> 2 );
+  return h;
+}
+
+inline uint32_t BlockHash::xBucket( const uint32_t hash, const int sizeIdx ) const
+{
+  // final avalanche, the combined hashes are not evenly distributed in the upper bits
+  uint32_t h = hash;
+  h ^= h >> 16;
+  h *= 0x85ebca6bu;
+  h ^= h >> 13;
+  h *= 0xc2b2ae35u;
+  h ^= h >> 16;
+  return h >> ( 32 - m_bucketBits[ sizeIdx ] );
+}
+
+bool BlockHash::isSupported( const int width, const int height )
+{
+  return width == height && width >= ( 1 << MIN_HASH_BLOCK_SIZE_LOG2 ) && width <= ( 1 << MAX_HASH_BLOCK_SIZE_LOG2 ) && ( width & ( width - 1 ) ) == 0;
+}
+
+int BlockHash::xGetBucketBits( const int numPos )
+{
+  int bits = 1;
+  while( ( 1 << bits ) < numPos && bits < 24 ) bits++;
+  return bits;
+}
+
+size_t BlockHash::getMaxTableSize( const int width, const int height )
+{
+  size_t bytes = 0;
+  for( int sizeLog2 = MIN_HASH_BLOCK_SIZE_LOG2; sizeLog2 <= MAX_HASH_BLOCK_SIZE_LOG2; sizeLog2++ )
+  {
+    const int numPos = std::max( 0, width - ( 1 << sizeLog2 ) + 1 ) * std::max( 0, height - ( 1 << sizeLog2 ) + 1 );
+    bytes += ( ( size_t( 1 ) << xGetBucketBits( numPos ) ) + 1 ) * sizeof( uint32_t ) + size_t( numPos ) * sizeof( HashEntry );
+  }
+  return bytes;
+}
+
+uint32_t BlockHash::getBlockHash( const CPelBuf& blk )
+{
+  CHECK( !isSupported( blk.width, blk.height ), "unsupported block size for hash" );
+
+  // same quad tree combination as in generate(), evaluated at the aligned sub blocks only
+  uint32_t hash[ ( 1 << ( MAX_HASH_BLOCK_SIZE_LOG2 - 1 ) ) * ( 1 << ( MAX_HASH_BLOCK_SIZE_LOG2 - 1 ) ) ];
+  int n = blk.width >> 1;
+  for( int y = 0; y < n; y++ )
+  {
+    const Pel* src0 = blk.bufAt( 0, 2 * y );
+    const Pel* src1 = src0 + blk.stride;
+    for( int x = 0; x < n; x++ )
+    {
+      hash[ y * n + x ] = xCombine( (uint16_t)src0[ 2 * x ], (uint16_t)src0[ 2 * x + 1 ], (uint16_t)src1[ 2 * x ], (uint16_t)src1[ 2 * x + 1 ] );
+    }
+  }
+  while( n > 1 )
+  {
+    const int m = n;
+    n >>= 1;
+    for( int y = 0; y < n; y++ )
+    {
+      for( int x = 0; x < n; x++ )
+      {
+        const uint32_t* h0 = &hash[ 2 * y * m + 2 * x ];
+        hash[ y * n + x ] = xCombine( h0[ 0 ], h0[ 1 ], h0[ m ], h0[ m + 1 ] );
+      }
+    }
+  }
+  return hash[ 0 ];
+}
+
+void BlockHash::generate( const CPelBuf& pic )
+{
+  const int width  = pic.width;
+  const int height = pic.height;
+
+  m_valid = false;
+  if( width < ( 1 << MIN_HASH_BLOCK_SIZE_LOG2 ) || height < ( 1 << MIN_HASH_BLOCK_SIZE_LOG2 ) )
+  {
+    return;
+  }
+
+  // hashes of the previous and the current block size at all positions, only needed while generating
+  uint32_t* levelHash[ 2 ];
+  levelHash[ 0 ] = xMalloc( uint32_t, 2 * width * height );
+  levelHash[ 1 ] = levelHash[ 0 ] + width * height;
+
+  // 2x2 blocks at all positions
+  uint32_t* dst = levelHash[ 0 ];
+  for( int y = 0; y < height - 1; y++ )
+  {
+    const Pel* src0 = pic.bufAt( 0, y );
+    const Pel* src1 = src0 + pic.stride;
+    for( int x = 0; x < width - 1; x++ )
+    {
+      dst[ y * width + x ] = xCombine( (uint16_t)src0[ x ], (uint16_t)src0[ x + 1 ], (uint16_t)src1[ x ], (uint16_t)src1[ x + 1 ] );
+    }
+  }
+
+  int cur = 0;
+  for( int sizeLog2 = 2; sizeLog2 <= MAX_HASH_BLOCK_SIZE_LOG2; sizeLog2++ )
+  {
+    const int size = 1 << sizeLog2;
+    const int half = size >> 1;
+    const int numX = width  - size + 1;
+    const int numY = height - size + 1;
+    if( numX <= 0 || numY <= 0 )
+    {
+      for( int i = std::max( 0, sizeLog2 - MIN_HASH_BLOCK_SIZE_LOG2 ); i < NUM_HASH_BLOCK_SIZES; i++ )
+      {
+        m_entries[ i ].clear();
+        m_bucketStart[ i ].clear();
+      }
+      break;
+    }
+
+    const uint32_t* src = levelHash[ cur ];
+    uint32_t*       out = levelHash[ 1 - cur ];
+    for( int y = 0; y < numY; y++ )
+    {
+      const uint32_t* s0 = src + y * width;
+      const uint32_t* s1 = s0 + half * width;
+      uint32_t*       d  = out + y * width;
+      for( int x = 0; x < numX; x++ )
+      {
+        d[ x ] = xCombine( s0[ x ], s0[ x + half ], s1[ x ], s1[ x + half ] );
+      }
+    }
+    cur = 1 - cur;
+
+    if( sizeLog2 < MIN_HASH_BLOCK_SIZE_LOG2 )
+    {
+      continue;
+    }
+
+    // bucket the positions by a counting sort on the upper hash bits
+    const int sizeIdx   = sizeLog2 - MIN_HASH_BLOCK_SIZE_LOG2;
+    const int numPos    = numX * numY;
+    const int bits      = xGetBucketBits( numPos );
+    m_bucketBits[ sizeIdx ] = bits;
+
+    std::vector<uint32_t>& start = m_bucketStart[ sizeIdx ];
+    start.assign( ( size_t( 1 ) << bits ) + 1, 0 );
+    for( int y = 0; y < numY; y++ )
+    {
+      for( int x = 0; x < numX; x++ )
+      {
+        start[ xBucket( out[ y * width + x ], sizeIdx ) + 1 ]++;
+      }
+    }
+    for( size_t i = 1; i < start.size(); i++ )
+    {
+      start[ i ] = start[ i - 1 ] + std::min( start[ i ], MAX_HASH_BUCKET_SIZE );
+    }
+
+    std::vector<HashEntry>& entries = m_entries[ sizeIdx ];
+    entries.resize( start.back() );
+    std::vector<uint32_t> fill( start.begin(), start.end() - 1 );
+    for( int y = 0; y < numY; y++ )
+    {
+      for( int x = 0; x < numX; x++ )
+      {
+        const uint32_t hash   = out[ y * width + x ];
+        const uint32_t bucket = xBucket( hash, sizeIdx );
+        if( fill[ bucket ] < start[ bucket + 1 ] )
+        {
+          entries[ fill[ bucket ]++ ] = HashEntry{ hash, ( uint32_t( y ) << 16 ) | uint32_t( x ) };
+        }
+      }
+    }
+  }
+
+  xFree( levelHash[ 0 ] );
+
+  size_t bytes = 0;
+  for( int i = 0; i < NUM_HASH_BLOCK_SIZES; i++ )
+  {
+    bytes += m_bucketStart[ i ].capacity() * sizeof( uint32_t ) + m_entries[ i ].capacity() * sizeof( HashEntry );
+  }
+  m_memTrack.release();
+  m_memTrack.add( bytes );
+
+  m_valid = true;
+}
+
+void BlockHash::release()
+{
+  for( int i = 0; i < NUM_HASH_BLOCK_SIZES; i++ )
+  {
+    std::vector<uint32_t>().swap( m_bucketStart[ i ] );
+    std::vector<HashEntry>().swap( m_entries[ i ] );
+  }
+  m_memTrack.release();
+  m_valid = false;
+}
+
+int BlockHash::getCandidates( const uint32_t hash, const int sizeLog2, Position* cand, const int maxCand ) const
+{
+  const int sizeIdx = sizeLog2 - MIN_HASH_BLOCK_SIZE_LOG2;
+  if( !m_valid || m_entries[ sizeIdx ].empty() )
+  {
+    return 0;
+  }
+
+  const uint32_t bucket = xBucket( hash, sizeIdx );
+  const std::vector<HashEntry>& entries = m_entries[ sizeIdx ];
+  int numCand = 0;
+  for( uint32_t i = m_bucketStart[ sizeIdx ][ bucket ]; i < m_bucketStart[ sizeIdx ][ bucket + 1 ] && numCand < maxCand; i++ )
+  {
+    if( entries[ i ].hash == hash )
+    {
+      cand[ numCand++ ] = Position( entries[ i ].pos & 0xffff, entries[ i ].pos >> 16 );
+    }
+  }
+  return numCand;
+}
+
+} // namespace vvenc
+
+//! \}
+
@@ -280,7 +280,7 @@ void IntraPrediction::init(ChromaFormat chromaFormatIDC, const unsigned bitDepth
     m_pMdlmTemp = new Pel[(2 * MAX_TB_SIZEY + 1)*(2 * MAX_TB_SIZEY + 1)];//MDLM will use top-above and left-below samples.
   }
 #if   ENABLE_SIMD_OPT_INTRAPRED
-  initIntraPredictionX86();
+  initIntraPredictionX86( bitDepthY );
 #endif
 
 }
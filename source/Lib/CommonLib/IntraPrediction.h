@@ -132,9 +132,9 @@ private:
   void ( *IntraPredSampleFilter)  ( PelBuf& piPred, const CPelBuf& pSrc );
 
 #if ENABLE_SIMD_OPT_INTRAPRED
-  void initIntraPredictionX86();
+  void initIntraPredictionX86( const unsigned bitDepthY );
   template <X86_VEXT vext>
-  void _initIntraPredictionX86();
+  void _initIntraPredictionX86( const unsigned bitDepthY );
 #endif
 
 public:
@@ -431,8 +431,8 @@ void LoopFilter::loopFilterPic( CodingStructure& cs, bool calcFilterStrength ) c
 
   if( calcFilterStrength )
   {
-    cs.getLoopFilterParamBuf( EDGE_VER ).memset( 0 );
-    cs.getLoopFilterParamBuf( EDGE_HOR ).memset( 0 );
+    cs.getLFPMap( EDGE_VER ).clear();
+    cs.getLFPMap( EDGE_HOR ).clear();
 
     for (int y = 0; y < pcv.heightInCtus; y++)
     {
@@ -547,8 +547,8 @@ void LoopFilter::calcFilterStrengthsCTU( CodingStructure& cs, const UnitArea& ct
   {
     UnitScale lfScale = cs.getScaling( UnitScale::LF_PARAM_MAP, CH_L );
     Area      lfArea  ( lfScale.scale( clipArea( ctuArea.Y(), cs.picture->Y() ) ) );
-    cs.getLoopFilterParamBuf( EDGE_VER ).subBuf( lfArea.pos(), lfArea.size() ).memset( 0 );
-    cs.getLoopFilterParamBuf( EDGE_HOR ).subBuf( lfArea.pos(), lfArea.size() ).memset( 0 );
+    cs.getLFPMap( EDGE_VER ).clear( lfArea.x, lfArea.y, lfArea.width, lfArea.height );
+    cs.getLFPMap( EDGE_HOR ).clear( lfArea.x, lfArea.y, lfArea.width, lfArea.height );
   }
 
   const int maxNumChannelType = cs.pcv->chrFormat != CHROMA_400 && CS::isDualITree( cs ) ? 2 : 1;
@@ -627,23 +627,47 @@ void LoopFilter::xDeblockArea( CodingStructure& cs, const UnitArea& area, const
 
   const UnitScale scale = cs.getScaling( UnitScale::LF_PARAM_MAP, CH_L );
 
-  const int lfpPtrLOffset = scale.scaleHor( incx );
+  CHECKD( scale.scaleHor( incx ) != 1, "The loop filter parameter map is expected to hold one entry per 4x4 block" );
 
-  LoopFilterParam* lfpPtr = cs.picture->cs->getLFPMapPtr( edgeDir );
-  ptrdiff_t lfpStride     = cs.picture->cs->getLFPMapStride();
-  OFFSET( lfpPtr, lfpStride, scale.scaleHor( lumaArea.x ), scale.scaleVer( lumaArea.y ) );
+  const LoopFilterParamMap& lfpMap = cs.picture->cs->getLFPMap( edgeDir );
+  const ptrdiff_t lfpStride        = lfpMap.stride;
+  ptrdiff_t       lfpIdx           = 0;
+  OFFSET( lfpIdx, lfpStride, scale.scaleHor( lumaArea.x ), scale.scaleVer( lumaArea.y ) );
+
+  const int numEdges = ( lumaArea.width + incx - 1 ) / incx;
 
   for( int dy = 0; dy < lumaArea.height; dy += incy )
   {
-    LoopFilterParam const* lineLfpPtr = lfpPtr;
-    
     const int dyInCtu = doChroma ? ( ( area.chromaPos().y + ( dy >> csy ) ) & ( pcv.maxCUSizeMask >> csy ) ) : 0;
 
-    for( int dx = 0; dx < lumaArea.width; dx += incx )
+    const uint8_t* bsPtr = lfpMap.bs + lfpIdx;
+
+    // stream over the dense boundary strength line, skipping runs of unfiltered edges
+    for( int n = 0; n < numEdges; n++ )
     {
-      if( doLuma && BsGet( lineLfpPtr->bs, COMP_Y ) )
+      if( n + 8 <= numEdges )
+      {
+        uint64_t bs8;
+        memcpy( &bs8, bsPtr + n, sizeof( bs8 ) );
+        if( !bs8 )
+        {
+          n += 7;
+          continue;
+        }
+      }
+
+      const uint8_t bs = bsPtr[n];
+      if( !bs )
+      {
+        continue;
+      }
+
+      const LoopFilterParam lfp = lfpMap.get( lfpIdx + n );
+      const int dx              = n * incx;
+
+      if( doLuma && BsGet( bs, COMP_Y ) )
       {
-        xEdgeFilterLuma<edgeDir>( cs, lumaArea.pos().offset( dx, dy ), *lineLfpPtr, picRecoBuf );
+        xEdgeFilterLuma<edgeDir>( cs, lumaArea.pos().offset( dx, dy ), lfp, picRecoBuf );
       }
 
       const int dxInCtu = doChroma ? ( ( area.chromaPos().x + ( dx >> csx ) ) & ( pcv.maxCUSizeMask >> csx ) ) : 0;
@@ -651,15 +675,13 @@ void LoopFilter::xDeblockArea( CodingStructure& cs, const UnitArea& area, const
       if( doChroma
           && ( ( edgeDir == EDGE_VER && ( dxInCtu & ( DEBLOCK_SMALLEST_BLOCK - 1 ) ) == 0 )
             || ( edgeDir == EDGE_HOR && ( dyInCtu & ( DEBLOCK_SMALLEST_BLOCK - 1 ) ) == 0 ) )
-          && ( BsGet( lineLfpPtr->bs, COMP_Cb ) | BsGet( lineLfpPtr->bs, COMP_Cr ) ) )
+          && ( BsGet( bs, COMP_Cb ) | BsGet( bs, COMP_Cr ) ) )
       {
-        xEdgeFilterChroma<edgeDir>( cs, area.chromaPos().offset( dx >> csx, dy >> csy ), *lineLfpPtr, picRecoBuf );
+        xEdgeFilterChroma<edgeDir>( cs, area.chromaPos().offset( dx >> csx, dy >> csy ), lfp, picRecoBuf );
       }
-
-      OFFSETX( lineLfpPtr, lfpStride, lfpPtrLOffset );
     }
 
-    OFFSETY( lfpPtr, lfpStride, scale.scaleVer( incy ) );
+    OFFSETY( lfpIdx, lfpStride, scale.scaleVer( incy ) );
   }
 }
 
@@ -668,8 +690,8 @@ void LoopFilter::getMaxFilterLength( const CodingUnit& cu, int& maxFilterLenghtL
   const Area&            areal      = cu.blocks[COMP_Y];
   const PreCalcValues&   pcv        = *cu.cs->pcv;
   const Position         lfpPos     = cu.cs->getScaling( UnitScale::LF_PARAM_MAP, CH_L ).scale( areal.pos() );
-  LoopFilterParam*       lfpPtrH    = cu.cs->picture->cs->getLFPMapPtr( EDGE_HOR );
-  LoopFilterParam*       lfpPtrV    = cu.cs->picture->cs->getLFPMapPtr( EDGE_VER );
+  const uint8_t*         lfpPtrH    = cu.cs->picture->cs->getLFPMap( EDGE_HOR ).sideMaxFiltLength;
+  const uint8_t*         lfpPtrV    = cu.cs->picture->cs->getLFPMap( EDGE_VER ).sideMaxFiltLength;
   ptrdiff_t              lfpStride  = cu.cs->picture->cs->getLFPMapStride();
 
   OFFSET( lfpPtrH, lfpStride, lfpPos.x, lfpPos.y );
@@ -679,13 +701,13 @@ void LoopFilter::getMaxFilterLength( const CodingUnit& cu, int& maxFilterLenghtL
   {
     for( int dx = 0, n = 0; dx < areal.width; dx += pcv.minCUSize, n++ )
     {
-      int filterLengthHor = std::max( ( lfpPtrH[n].sideMaxFiltLength & 7 ) >= 5 ? 4 : 0, ( lfpPtrH[n].sideMaxFiltLength >> 4 ) & 7 );
+      int filterLengthHor = std::max( ( lfpPtrH[n] & 7 ) >= 5 ? 4 : 0, ( lfpPtrH[n] >> 4 ) & 7 );
       if( maxFilterLenghtLumaHor < filterLengthHor )
       {
         maxFilterLenghtLumaHor = filterLengthHor;
       }
 
-      int filterLengthVer = std::max( ( lfpPtrV[n].sideMaxFiltLength & 7 ) >= 5 ? 4 : 0, ( lfpPtrV[n].sideMaxFiltLength >> 4 ) & 7 );
+      int filterLengthVer = std::max( ( lfpPtrV[n] & 7 ) >= 5 ? 4 : 0, ( lfpPtrV[n] >> 4 ) & 7 );
       if( maxFilterLenghtLumaVer < filterLengthVer )
       {
         maxFilterLenghtLumaVer = filterLengthVer;
@@ -739,7 +761,7 @@ LFCUParam xGetLoopfilterParam( const CodingUnit& cu );
 
 // filtering functions
 template<DeblockEdgeDir edgeDir>
-void xGetBoundaryStrengthSingle             ( LoopFilterParam& lfp, const CodingUnit& cu, const Position &localPos, const CodingUnit &cuP );
+void xGetBoundaryStrengthSingle             ( LoopFilterParamMap& lfp, ptrdiff_t idx, const CodingUnit& cu, const Position &localPos, const CodingUnit &cuP );
 template<DeblockEdgeDir edgeDir>
 void xSetEdgeFilterInsidePu                 ( const CodingUnit &cu, const Area &area, const bool bValue );
 
@@ -778,22 +800,10 @@ void LoopFilter::calcFilterStrengths( const CodingUnit& cu, bool clearLF )
   {
     const unsigned uiPelsInPartX   = pcv.minCUSize >> channelScaleX;
     const unsigned uiPelsInPartY   = pcv.minCUSize >> channelScaleY;
-    LoopFilterParam* lfpPtrH       = cu.cs->picture->cs->getLFPMapPtr( EDGE_HOR );
-    LoopFilterParam* lfpPtrV       = cu.cs->picture->cs->getLFPMapPtr( EDGE_VER );
-    ptrdiff_t        lfpStride     = cu.cs->picture->cs->getLFPMapStride();
     const Position         lfpPos  = cu.cs->picture->cs->getScaling( UnitScale::LF_PARAM_MAP, cu.chType ).scale( area.pos() );
-    OFFSET( lfpPtrH, lfpStride, lfpPos.x, lfpPos.y );
-    OFFSET( lfpPtrV, lfpStride, lfpPos.x, lfpPos.y );
 
-    const size_t bufLen = ( area.width / uiPelsInPartX ) * sizeof( LoopFilterParam );
-    for( int y = 0; y < area.height; y += uiPelsInPartY )
-    {
-      memset( lfpPtrH, 0, bufLen );
-      memset( lfpPtrV, 0, bufLen );
-
-      INCY( lfpPtrH, lfpStride );
-      INCY( lfpPtrV, lfpStride );
-    }
+    cu.cs->picture->cs->getLFPMap( EDGE_HOR ).clear( lfpPos.x, lfpPos.y, area.width / uiPelsInPartX, area.height / uiPelsInPartY );
+    cu.cs->picture->cs->getLFPMap( EDGE_VER ).clear( lfpPos.x, lfpPos.y, area.width / uiPelsInPartX, area.height / uiPelsInPartY );
   }
 
   const bool isCuCrossedByVirtualBoundaries = isCrossedByVirtualBoundaries( cu.cs->sps,
@@ -887,52 +897,54 @@ void LoopFilter::calcFilterStrengths( const CodingUnit& cu, bool clearLF )
   const ChannelType chType     = cu.chType;
 
   {
-    LoopFilterParam* lfpPtrV   = cu.cs->picture->cs->getLFPMapPtr( EDGE_VER );
-    ptrdiff_t        lfpStride = cu.cs->picture->cs->getLFPMapStride();
-    OFFSET( lfpPtrV, lfpStride, lfpPos.x, lfpPos.y );
+    LoopFilterParamMap& lfpMapV  = cu.cs->picture->cs->getLFPMap( EDGE_VER );
+    ptrdiff_t           lfpStride = lfpMapV.stride;
+    ptrdiff_t           lfpIdxV   = 0;
+    OFFSET( lfpIdxV, lfpStride, lfpPos.x, lfpPos.y );
 
     for( int y = 0; y < area.height; y += uiPelsInPartY )
     {
-      LoopFilterParam* lineLfpPtrV = lfpPtrV;
+      ptrdiff_t lineLfpIdxV = lfpIdxV;
       
       cuP = !cuP || cuP->blocks[chType].y + cuP->blocks[chType].height > area.y + y ? cuP : cu.cs->getCU( Position{ area.x - 1, area.y + y }, chType, TREE_D );
 
       for( int x = 0; x < area.width; x += uiPelsInPartX )
       {
-        if( lineLfpPtrV->filterEdge( chType ) ) xGetBoundaryStrengthSingle<EDGE_VER>( *lineLfpPtrV, cu, Position{ area.x + x, area.y + y }, x ? cu : *cuP );
+        if( lfpMapV.filterEdge( lineLfpIdxV, chType ) ) xGetBoundaryStrengthSingle<EDGE_VER>( lfpMapV, lineLfpIdxV, cu, Position{ area.x + x, area.y + y }, x ? cu : *cuP );
 
-        lineLfpPtrV->bs &= ~BsSet( 3, MAX_NUM_COMP );
+        lfpMapV.bs[lineLfpIdxV] &= ~BsSet( 3, MAX_NUM_COMP );
 
-        INCX( lineLfpPtrV, lfpStride );
+        INCX( lineLfpIdxV, lfpStride );
       }
 
-      INCY( lfpPtrV, lfpStride );
+      INCY( lfpIdxV, lfpStride );
     }
   }
 
   cuP = CU::getAbove( cu );
 
   {
-    LoopFilterParam* lfpPtrH   = cu.cs->picture->cs->getLFPMapPtr( EDGE_HOR );
-    ptrdiff_t        lfpStride = cu.cs->picture->cs->getLFPMapStride();
-    OFFSET( lfpPtrH, lfpStride, lfpPos.x, lfpPos.y );
+    LoopFilterParamMap& lfpMapH  = cu.cs->picture->cs->getLFPMap( EDGE_HOR );
+    ptrdiff_t           lfpStride = lfpMapH.stride;
+    ptrdiff_t           lfpIdxH   = 0;
+    OFFSET( lfpIdxH, lfpStride, lfpPos.x, lfpPos.y );
 
     for( int y = 0; y < area.height; y += uiPelsInPartY )
     {
-      LoopFilterParam* lineLfpPtrH = lfpPtrH;
+      ptrdiff_t lineLfpIdxH = lfpIdxH;
 
       for( int x = 0; x < area.width; x += uiPelsInPartX )
       {
         cuP = ( y || ( cuP && cuP->blocks[chType].x + cuP->blocks[chType].width > area.x + x ) ) ? cuP : cu.cs->getCU( Position{ area.x + x, area.y - 1 }, chType, TREE_D );
 
-        if( lineLfpPtrH->filterEdge( chType ) ) xGetBoundaryStrengthSingle<EDGE_HOR>( *lineLfpPtrH, cu, Position{ area.x + x, area.y + y }, y ? cu : *cuP );
+        if( lfpMapH.filterEdge( lineLfpIdxH, chType ) ) xGetBoundaryStrengthSingle<EDGE_HOR>( lfpMapH, lineLfpIdxH, cu, Position{ area.x + x, area.y + y }, y ? cu : *cuP );
 
-        lineLfpPtrH->bs &= ~BsSet( 3, MAX_NUM_COMP );
+        lfpMapH.bs[lineLfpIdxH] &= ~BsSet( 3, MAX_NUM_COMP );
 
-        INCX( lineLfpPtrH, lfpStride );
+        INCX( lineLfpIdxH, lfpStride );
       }
 
-      INCY( lfpPtrH, lfpStride );
+      INCY( lfpIdxH, lfpStride );
     }
   }
 }
@@ -1037,10 +1049,11 @@ void xSetMaxFilterLengthPQFromTransformSizes( const CodingUnit& cu, const Transf
     const bool        vld = isLuma( ch ) ? currTU.Y().valid() : currTU.Cb().valid();
     if( vld && perpPos<edgeDir>( currTU.blocks[ch] ) != 0 )
     {
-      LoopFilterParam* lfpPtr    = cu.cs->picture->cs->getLFPMapPtr( edgeDir );
+      LoopFilterParamMap& lfp    = cu.cs->picture->cs->getLFPMap( edgeDir );
       const UnitScale scaling    = cu.cs->picture->cs->getScaling( UnitScale::LF_PARAM_MAP, ch );
-      ptrdiff_t lfpStride        = cu.cs->picture->cs->getLFPMapStride();
-      OFFSET( lfpPtr, lfpStride, scaling.scaleHor( currTU.blocks[ch].x ), scaling.scaleVer( currTU.blocks[ch].y ) );
+      ptrdiff_t lfpStride        = lfp.stride;
+      ptrdiff_t lfpIdx           = 0;
+      OFFSET( lfpIdx, lfpStride, scaling.scaleHor( currTU.blocks[ch].x ), scaling.scaleVer( currTU.blocks[ch].y ) );
 
       const int         inc      = edgeDir ? pcv.minCUSize >> getChannelTypeScaleX( ch, cu.chromaFormat )
                                            : pcv.minCUSize >> getChannelTypeScaleY( ch, cu.chromaFormat );
@@ -1071,18 +1084,18 @@ void xSetMaxFilterLengthPQFromTransformSizes( const CodingUnit& cu, const Transf
                                  : cuP;
         const TransformUnit &tuP = cuP->firstTU->next == nullptr ? *cuP->firstTU : *CU::getTU( *cuP, posP, ch );
         const int sizePSide      = perpSize<edgeDir>( tuP.blocks[ch] );
-        LoopFilterParam& lfp     = *lfpPtr;
+        uint8_t& bs              = lfp.bs[lfpIdx];
 
         if( ct == start )
         {
-          lfp.setFilterEdge( cu.chType, bValue );
-          if( ( lfp.bs || perpPos<edgeDir>( currTU.blocks[ch] ) == perpPos<edgeDir>( cu.blocks[ch] ) ) && bValue )
+          lfp.setFilterEdge( lfpIdx, cu.chType, bValue );
+          if( ( bs || perpPos<edgeDir>( currTU.blocks[ch] ) == perpPos<edgeDir>( cu.blocks[ch] ) ) && bValue )
           {
-            lfp.bs |= BsSet( 3, MAX_NUM_COMP );
+            bs |= BsSet( 3, MAX_NUM_COMP );
           }
           else
           {
-            lfp.bs |= BsSet( 1, MAX_NUM_COMP );
+            bs |= BsSet( 1, MAX_NUM_COMP );
           }
         }
 
@@ -1103,20 +1116,20 @@ void xSetMaxFilterLengthPQFromTransformSizes( const CodingUnit& cu, const Transf
           }
 
           maxFLPQ    += 128;
-          lfp.sideMaxFiltLength = maxFLPQ;
+          lfp.sideMaxFiltLength[lfpIdx] = maxFLPQ;
         }
         else
         {
-          lfp.setFilterCMFL( ( sizeQSide >= 8 && sizePSide >= 8 ) ? 1 : 0 );
+          lfp.setFilterCMFL( lfpIdx, ( sizeQSide >= 8 && sizePSide >= 8 ) ? 1 : 0 );
         }
 
         if( ct == end && deriveBdStrngt )
         {
-          if( lfp.filterEdge( cu.chType ) ) xGetBoundaryStrengthSingle<edgeDir>( lfp, cu, Position( ( area.x + edgeDir * d ) << csx, ( area.y + ( 1 - edgeDir ) * d ) << csy ), *cuPfstCh );
-          lfp.bs &= ~BsSet( 3, MAX_NUM_COMP );
+          if( lfp.filterEdge( lfpIdx, cu.chType ) ) xGetBoundaryStrengthSingle<edgeDir>( lfp, lfpIdx, cu, Position( ( area.x + edgeDir * d ) << csx, ( area.y + ( 1 - edgeDir ) * d ) << csy ), *cuPfstCh );
+          bs &= ~BsSet( 3, MAX_NUM_COMP );
         }
 
-        OFFSET( lfpPtr, lfpStride, edgeDir, ( 1 - edgeDir ) );
+        OFFSET( lfpIdx, lfpStride, edgeDir, ( 1 - edgeDir ) );
       }
     }
   }
@@ -1134,14 +1147,14 @@ void xSetMaxFilterLengthPQForCodingSubBlocks( const CodingUnit& cu )
   
   const UnitScale  scaling   = cu.cs->picture->cs->getScaling( UnitScale::LF_PARAM_MAP, CH_L );
   const Position   lfpPos    = scaling.scale( cu.lumaPos() );
-  LoopFilterParam* lfpPtrL   = cu.cs->picture->cs->getLFPMapPtr( edgeDir );
+  uint8_t*         lfpPtrL   = cu.cs->picture->cs->getLFPMap( edgeDir ).sideMaxFiltLength;
   ptrdiff_t        lfpStride = cu.cs->picture->cs->getLFPMapStride();
 
   OFFSET( lfpPtrL, lfpStride, lfpPos.x, lfpPos.y );
 
   for( int y = 0; y < cu.Y().height; y += yInc )
   {
-    LoopFilterParam* lfpPtr = lfpPtrL;
+    uint8_t* lfpPtr = lfpPtrL;
 
     for( int x = 0; x < cu.Y().width; x += xInc )
     {
@@ -1149,22 +1162,22 @@ void xSetMaxFilterLengthPQForCodingSubBlocks( const CodingUnit& cu )
 
       uint8_t maxFLP, maxFLQ;
       uint8_t te = 0;
-      if( lfpPtr->sideMaxFiltLength & 128 )
+      if( *lfpPtr & 128 )
       {
         te = 128;
-        maxFLQ = std::min<int>(   lfpPtr->sideMaxFiltLength        & 7, 5 );
-        maxFLP =                ( lfpPtr->sideMaxFiltLength >> 4 ) & 7;
+        maxFLQ = std::min<int>(   *lfpPtr        & 7, 5 );
+        maxFLP =                ( *lfpPtr >> 4 ) & 7;
 
         if( perpVal > 0 )
         {
           maxFLP = std::min<int>( maxFLP, 5 );
         }
       }
-      else if( perpVal > 0 && (                                          ( GET_OFFSET( lfpPtr, lfpStride, -    ( 1 - edgeDir ), -    edgeDir )->sideMaxFiltLength & 128 ) || ( perpVal + 4 >= perpSize<edgeDir>( cu.Y() ) ) || ( GET_OFFSET( lfpPtr, lfpStride,     ( 1 - edgeDir ),     edgeDir )->sideMaxFiltLength & 128 ) ) )
+      else if( perpVal > 0 && (                                          ( *GET_OFFSET( lfpPtr, lfpStride, -    ( 1 - edgeDir ), -    edgeDir ) & 128 ) || ( perpVal + 4 >= perpSize<edgeDir>( cu.Y() ) ) || ( *GET_OFFSET( lfpPtr, lfpStride,     ( 1 - edgeDir ),     edgeDir ) & 128 ) ) )
       {
         maxFLP = maxFLQ = 1;
       }
-      else if( perpVal > 0 && ( ( edgeDir ? ( y == 8 ) : ( x == 8 ) ) || ( GET_OFFSET( lfpPtr, lfpStride, -2 * ( 1 - edgeDir ), -2 * edgeDir )->sideMaxFiltLength & 128 ) || ( perpVal + 8 >= perpSize<edgeDir>( cu.Y() ) ) || ( GET_OFFSET( lfpPtr, lfpStride, 2 * ( 1 - edgeDir ), 2 * edgeDir )->sideMaxFiltLength & 128 ) ) )
+      else if( perpVal > 0 && ( ( edgeDir ? ( y == 8 ) : ( x == 8 ) ) || ( *GET_OFFSET( lfpPtr, lfpStride, -2 * ( 1 - edgeDir ), -2 * edgeDir ) & 128 ) || ( perpVal + 8 >= perpSize<edgeDir>( cu.Y() ) ) || ( *GET_OFFSET( lfpPtr, lfpStride, 2 * ( 1 - edgeDir ), 2 * edgeDir ) & 128 ) ) )
       {
         maxFLP = maxFLQ = 2;
       }
@@ -1177,7 +1190,7 @@ void xSetMaxFilterLengthPQForCodingSubBlocks( const CodingUnit& cu )
       newVal += maxFLQ;
       newVal += te;
 
-      lfpPtr->sideMaxFiltLength = newVal;
+      *lfpPtr = newVal;
 
       OFFSETX( lfpPtr, lfpStride, scaling.scaleHor( xInc ) );
     }
@@ -1191,30 +1204,33 @@ void xSetEdgeFilterInsidePu( const CodingUnit &cu, const Area &area, const bool
 {
   const PreCalcValues &  pcv       = *cu.cs->pcv;
   const Position         lfpPos    =  cu.cs->getScaling( UnitScale::LF_PARAM_MAP, cu.chType ).scale( area.pos() );
-  LoopFilterParam*       lfpPtr    =  cu.cs->picture->cs->getLFPMapPtr( edgeDir );
-  ptrdiff_t              lfpStride =  cu.cs->picture->cs->getLFPMapStride();
+  LoopFilterParamMap&    lfp       =  cu.cs->picture->cs->getLFPMap( edgeDir );
+  ptrdiff_t              lfpStride =  lfp.stride;
+  ptrdiff_t              lfpIdx    =  0;
 
-  OFFSET( lfpPtr, lfpStride, lfpPos.x, lfpPos.y );
+  OFFSET( lfpIdx, lfpStride, lfpPos.x, lfpPos.y );
 
   const int inc = edgeDir ? pcv.minCUSize >> getChannelTypeScaleX( cu.chType, cu.chromaFormat )
                           : pcv.minCUSize >> getChannelTypeScaleY( cu.chType, cu.chromaFormat );
 
   for( int d = 0; d < parlSize<edgeDir>( area ); d += inc )
   {
-    lfpPtr->setFilterEdge( cu.chType, bValue );
+    lfp.setFilterEdge( lfpIdx, cu.chType, bValue );
 
-    if( lfpPtr->bs && bValue )
+    if( lfp.bs[lfpIdx] && bValue )
     {
-      lfpPtr->bs |= BsSet( 3, MAX_NUM_COMP );
+      lfp.bs[lfpIdx] |= BsSet( 3, MAX_NUM_COMP );
     }
       
-    OFFSET( lfpPtr, lfpStride, edgeDir, ( 1 - edgeDir ) );
+    OFFSET( lfpIdx, lfpStride, edgeDir, ( 1 - edgeDir ) );
   }
 }
 
 template<DeblockEdgeDir edgeDir>
-void xGetBoundaryStrengthSingle( LoopFilterParam& lfp, const CodingUnit& cuQ, const Position &localPos, const CodingUnit& cuP )
+void xGetBoundaryStrengthSingle( LoopFilterParamMap& lfp, ptrdiff_t idx, const CodingUnit& cuQ, const Position &localPos, const CodingUnit& cuP )
 {
+  uint8_t& bs = lfp.bs[idx];
+
   const Slice      &sliceQ = *cuQ.slice;
   const ChannelType chType = cuQ.chType;
   const Position    &cuPos = cuQ.blocks[chType].pos();
@@ -1232,7 +1248,7 @@ void xGetBoundaryStrengthSingle( LoopFilterParam& lfp, const CodingUnit& cuQ, co
 
   if( hasLuma )
   {
-    lfp.qp[0] = ( cuQ.qp + cuP.qp + 1 ) >> 1;
+    lfp.qp[0][idx] = ( cuQ.qp + cuP.qp + 1 ) >> 1;
   }
 
   if( hasChroma )
@@ -1251,7 +1267,7 @@ void xGetBoundaryStrengthSingle( LoopFilterParam& lfp, const CodingUnit& cuQ, co
 
       const int baseQp_P = cQP.Qp( 0 ) - qpBdOffset;
       const int baseQp_Q = cQQ.Qp( 0 ) - qpBdOffset;
-      lfp.qp[chromaIdx] = ( ( baseQp_Q + baseQp_P + 1 ) >> 1 );
+      lfp.qp[chromaIdx][idx] = ( ( baseQp_Q + baseQp_P + 1 ) >> 1 );
     }
 
 
@@ -1277,23 +1293,23 @@ void xGetBoundaryStrengthSingle( LoopFilterParam& lfp, const CodingUnit& cuQ, co
 
     if( cuQ.ispMode && edgeIdx )
     {
-      lfp.bs |= BsSet( bsY, COMP_Y ) & bsMask;
+      bs |= BsSet( bsY, COMP_Y ) & bsMask;
     }
     else
     {
-      lfp.bs |= ( BsSet( bsY, COMP_Y ) + BsSet( chrmBS, COMP_Cb ) + BsSet( chrmBS, COMP_Cr ) ) & bsMask;
+      bs |= ( BsSet( bsY, COMP_Y ) + BsSet( chrmBS, COMP_Cb ) + BsSet( chrmBS, COMP_Cr ) ) & bsMask;
     }
 
     return;
   }
   else if( cuPcIsIntra )
   {
-    lfp.bs |= ( BsSet( chrmBS, COMP_Cb ) + BsSet( chrmBS, COMP_Cr ) );
+    bs |= ( BsSet( chrmBS, COMP_Cb ) + BsSet( chrmBS, COMP_Cr ) );
   }
 
-  if( ( lfp.bs & bsMask ) && ( cuP.pu->ciip || cuQ.pu->ciip ) )
+  if( ( bs & bsMask ) && ( cuP.pu->ciip || cuQ.pu->ciip ) )
   {
-    lfp.bs |= ( BsSet( 2, COMP_Y ) + BsSet( 2, COMP_Cb ) + BsSet( 2, COMP_Cr ) ) & bsMask;
+    bs |= ( BsSet( 2, COMP_Y ) + BsSet( 2, COMP_Cb ) + BsSet( 2, COMP_Cr ) ) & bsMask;
 
     return;
   }
@@ -1301,7 +1317,7 @@ void xGetBoundaryStrengthSingle( LoopFilterParam& lfp, const CodingUnit& cuQ, co
   unsigned tmpBs = 0;
   //-- Set BS for not Intra MB : BS = 2 or 1 or 0
   // Y
-  if( lfp.bs & bsMask )
+  if( bs & bsMask )
   {
     tmpBs |= BsSet( ( TU::getCbf( tuQ, COMP_Y  ) || TU::getCbf( tuP, COMP_Y  )                                   ) ? 1 : 0, COMP_Y  );
     tmpBs |= BsSet( ( TU::getCbf( tuQ, COMP_Cb ) || TU::getCbf( tuP, COMP_Cb ) || tuQ.jointCbCr || tuP.jointCbCr ) ? 1 : 0, COMP_Cb );
@@ -1310,38 +1326,38 @@ void xGetBoundaryStrengthSingle( LoopFilterParam& lfp, const CodingUnit& cuQ, co
 
   if( BsGet( tmpBs, COMP_Y ) == 1 )
   {
-    lfp.bs |= tmpBs & bsMask;
+    bs |= tmpBs & bsMask;
 
     return;
   }
 
   if( cuP.pu->ciip || cuQ.pu->ciip )
   {
-    lfp.bs |= 1 & bsMask;
+    bs |= 1 & bsMask;
 
     return;
   }
 
   if( !hasLuma )
   {
-    lfp.bs |= tmpBs & bsMask;
+    bs |= tmpBs & bsMask;
     return;
   }
 
-  if( BsGet( lfp.bs, MAX_NUM_COMP ) != 0 && BsGet( lfp.bs, MAX_NUM_COMP ) != 3 )
+  if( BsGet( bs, MAX_NUM_COMP ) != 0 && BsGet( bs, MAX_NUM_COMP ) != 3 )
   {
-    lfp.bs |= tmpBs & bsMask;
+    bs |= tmpBs & bsMask;
     return;
   }
 
   if( hasChroma )
   {
-    lfp.bs |= tmpBs & bsMask;
+    bs |= tmpBs & bsMask;
   }
 
   if( cuP.predMode != cuQ.predMode && hasLuma )
   {
-    lfp.bs |= 1 & bsMask;
+    bs |= 1 & bsMask;
     return;
   }
 
@@ -1439,7 +1455,7 @@ void xGetBoundaryStrengthSingle( LoopFilterParam& lfp, const CodingUnit& cuQ, co
       uiBs = 1;
     }
 
-    lfp.bs |= ( uiBs + tmpBs ) & bsMask;
+    bs |= ( uiBs + tmpBs ) & bsMask;
 
     return;
   }
@@ -1453,7 +1469,7 @@ void xGetBoundaryStrengthSingle( LoopFilterParam& lfp, const CodingUnit& cuQ, co
 
   if( piRefP0 != piRefQ0 )
   {
-    lfp.bs |= ( tmpBs + 1 ) & bsMask;
+    bs |= ( tmpBs + 1 ) & bsMask;
 
     return;
   }
@@ -1461,7 +1477,7 @@ void xGetBoundaryStrengthSingle( LoopFilterParam& lfp, const CodingUnit& cuQ, co
   Mv mvP0 = miP.mv[0];
   Mv mvQ0 = miQ.mv[0];
 
-  lfp.bs |= ( ( ( abs( mvQ0.hor - mvP0.hor ) >= nThreshold ) || ( abs( mvQ0.ver - mvP0.ver ) >= nThreshold ) ) ? ( tmpBs + 1 ) : tmpBs ) & bsMask;
+  bs |= ( ( ( abs( mvQ0.hor - mvP0.hor ) >= nThreshold ) || ( abs( mvQ0.ver - mvP0.ver ) >= nThreshold ) ) ? ( tmpBs + 1 ) : tmpBs ) & bsMask;
 }
 
 LFCUParam xGetLoopfilterParam( const CodingUnit& cu )
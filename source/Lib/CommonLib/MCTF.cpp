@@ -70,6 +70,7 @@ const double MCTF::m_sigmaZeroPoint = 10.0;
 const int MCTF::m_range = MCTF_RANGE;
 const int MCTF::m_motionVectorFactor = 16;
 const int MCTF::m_padding = MCTF_PADDING;
+const int MCTF::m_subsampledPadding = 32;   // the coarse levels search up to 2*8+5 samples
 const int16_t MCTF::m_interpolationFilter[16][8] =
 {
   {   0,   0,   0,  64,   0,   0,   0,   0 },   //0
@@ -184,6 +185,7 @@ MCTF::MCTF() :  m_chromaFormatIDC(NUM_CHROMA_FORMAT)
   m_motionErrorLumaFracX = motionErrorLumaFrac;
   m_motionErrorLumaFrac8 = motionErrorLumaFrac;
   m_threadPool = nullptr;
+  m_bufPool    = nullptr;
 #if defined( TARGET_SIMD_X86 ) && ENABLE_SIMD_OPT_MCTF
 
   initMCTF_X86();
@@ -227,10 +229,12 @@ void MCTF::init( const int internalBitDepth[MAX_NUM_CH],
                  const std::vector<double>& filterStrengths,
                  const bool filterFutureReference,
                  const int MCTFMode,
+                 const bool storeMotion,
                  const int numLeadFrames,
                  const int numTrailFrames,
                  const int framesToBeEncoded,
-                 NoMallocThreadPool* threadPool)
+                 NoMallocThreadPool* threadPool,
+                 PelStoragePool* bufPool )
 {
   CHECK( filterFrames.size() != filterStrengths.size(), "should have been checked before" );
   for (int i = 0; i < MAX_NUM_CH; i++)
@@ -248,10 +252,12 @@ void MCTF::init( const int internalBitDepth[MAX_NUM_CH],
   m_input_cnt             = 0;
   m_cur_delay             = 0;
   m_MCTFMode              = MCTFMode;
+  m_storeMotion           = storeMotion;
   m_numLeadFrames         = numLeadFrames;
   m_numTrailFrames        = numTrailFrames;
   m_framesToBeEncoded     = framesToBeEncoded;
   m_threadPool            = threadPool;
+  m_bufPool               = bufPool;
 }
 
 // ====================================================================================================================
@@ -261,6 +267,7 @@ void MCTF::init( const int internalBitDepth[MAX_NUM_CH],
 Picture* MCTF::createLeadTrailPic( const YUVBuffer& yuvInBuf, const int poc )
 {
   Picture* pic = new Picture;
+  pic->bufPool = m_bufPool;
   pic->create( m_chromaFormatIDC, m_area, m_ctuSize, m_ctuSize + 16, false, m_padding );
 
   PelUnitBuf yuvOrgBuf;
@@ -389,6 +396,9 @@ void MCTF::filter( Picture* pic )
       srcPic.picBuffer.createFromBuf( curPic->getOrigBuf() );
       srcPic.mvs.allocate( m_area.width / 4, m_area.height / 4 );
 
+      // motion loaded from a shared analysis replaces the estimation, it does not depend on the coding parameters
+      const bool motionLoaded = loadMotionField( *fltrPic, srcPic.mvs, curPic->poc - process_poc );
+      if ( ! motionLoaded )
       {
         const int width = m_area.width;
         const int height = m_area.height;
@@ -410,10 +420,15 @@ void MCTF::filter( Picture* pic )
       }
 
       srcPic.index = std::min(1, std::abs(curPic->poc - process_poc) - 1);
+
+      if ( m_storeMotion && ! motionLoaded )
+      {
+        storeMotionField( *fltrPic, srcPic.mvs, curPic->poc - process_poc );
+      }
     }
 
     // filter
-    fltrBuf.create( m_chromaFormatIDC, m_area, 0, m_padding );
+    fltrPic->getScratchBuf( PIC_ORIGINAL_RSP );
     bilateralFilter( origBuf, srcFrameInfo, fltrBuf, overallStrength );
   }
 
@@ -424,11 +439,67 @@ void MCTF::filter( Picture* pic )
 // Private member functions
 // ====================================================================================================================
 
+void MCTF::storeMotionField( Picture& pic, const Array2D<MotionVector>& mvs, const int pocOffset ) const
+{
+  // the final estimation stage works on 8x8 blocks in 1/16 sample units, which matches the internal mv precision
+  static_assert( MV_FRACTIONAL_BITS_INTERNAL == 4, "mctf motion vectors require 1/16 sample internal mv precision" );
+
+  pic.mctfMotion.push_back( MctfMotionField() );
+  MctfMotionField& field = pic.mctfMotion.back();
+
+  field.pocOffset    = pocOffset;
+  field.blkSizeLog2  = 3;
+  field.widthInBlks  = std::min<int>( m_area.width  >> field.blkSizeLog2, mvs.w() );
+  field.heightInBlks = std::min<int>( m_area.height >> field.blkSizeLog2, mvs.h() );
+  field.mvs.resize   ( field.widthInBlks * field.heightInBlks );
+  field.errors.resize( field.widthInBlks * field.heightInBlks );
+
+  for ( int by = 0; by < field.heightInBlks; by++ )
+  {
+    for ( int bx = 0; bx < field.widthInBlks; bx++ )
+    {
+      const MotionVector& mv = mvs.get( bx, by );
+      field.mvs   [ by * field.widthInBlks + bx ] = Mv( mv.x, mv.y );
+      field.errors[ by * field.widthInBlks + bx ] = mv.error;
+    }
+  }
+}
+
+bool MCTF::loadMotionField( const Picture& pic, Array2D<MotionVector>& mvs, const int pocOffset ) const
+{
+  for ( const auto& field : pic.mctfMotion )
+  {
+    if ( field.pocOffset != pocOffset || field.blkSizeLog2 != 3 || field.widthInBlks > mvs.w() || field.heightInBlks > mvs.h() )
+    {
+      continue;
+    }
+
+    // the padding of the pictures only covers the motion the estimation can produce
+    const int maxMv = MCTF_MAX_MV * m_motionVectorFactor;
+    if ( std::any_of( field.mvs.begin(), field.mvs.end(), [maxMv]( const Mv& mv ) { return std::abs( mv.hor ) > maxMv || std::abs( mv.ver ) > maxMv; } ) )
+    {
+      continue;
+    }
+
+    for ( int by = 0; by < field.heightInBlks; by++ )
+    {
+      for ( int bx = 0; bx < field.widthInBlks; bx++ )
+      {
+        const Mv& mv = field.mvs[ by * field.widthInBlks + bx ];
+        mvs.get( bx, by ).set( mv.hor, mv.ver, field.errors[ by * field.widthInBlks + bx ] );
+      }
+    }
+    return true;
+  }
+  return false;
+}
+
 void MCTF::subsampleLuma(const PelStorage &input, PelStorage &output, const int factor) const
 {
   const int newWidth = input.Y().width / factor;
   const int newHeight = input.Y().height / factor;
-  output.create(CHROMA_400, Area(0, 0, newWidth, newHeight), 0, m_padding);
+  output.setPool(m_bufPool);
+  output.create(CHROMA_400, Area(0, 0, newWidth, newHeight), 0, m_subsampledPadding);
 
   const Pel* srcRow = input.Y().buf;
   const int srcStride = input.Y().stride;
@@ -448,7 +519,7 @@ void MCTF::subsampleLuma(const PelStorage &input, PelStorage &output, const int
       inRowBelow += 2;
     }
   }
-  output.extendBorderPel(m_padding, m_padding);
+  output.extendBorderPel(m_subsampledPadding, m_subsampledPadding);
 }
 
 int MCTF::motionErrorLuma(const PelStorage &orig,
@@ -644,7 +715,7 @@ void MCTF::motionEstimationLuma(Array2D<MotionVector> &mvs, const PelStorage &or
   }
 }
 
-void MCTF::applyMotionLn(const Array2D<MotionVector> &mvs, const PelStorage &input, PelStorage &output, int blockNumY, int comp ) const
+void MCTF::applyMotionLn(const Array2D<MotionVector> &mvs, const PelStorage &input, PelBuf &output, int blockNumY, int comp ) const
 {
   static const int lumaBlockSize=8;
 
@@ -660,8 +731,9 @@ void MCTF::applyMotionLn(const Array2D<MotionVector> &mvs, const PelStorage &inp
   const Pel* srcImage = input.bufs[compID].buf;
   const int srcStride  = input.bufs[compID].stride;
 
-  Pel* dstImage = output.bufs[compID].buf;
-  const int dstStride  = output.bufs[compID].stride;
+  // the output holds only the motion compensated block line
+  Pel* dstImage = output.buf;
+  const int dstStride  = output.stride;
 
   for (int x = 0, blockNumX = 0; x + blockSizeX <= width; x += blockSizeX, blockNumX++)
   {
@@ -699,7 +771,7 @@ void MCTF::applyMotionLn(const Array2D<MotionVector> &mvs, const PelStorage &inp
       }
     }
 
-    Pel* dstRow = dstImage+y*dstStride;
+    Pel* dstRow = dstImage;
     for (int by = 0; by < blockSizeY; by++, dstRow+=dstStride)
     {
       Pel* dstPel=dstRow+x;
@@ -724,18 +796,24 @@ void MCTF::applyMotionLn(const Array2D<MotionVector> &mvs, const PelStorage &inp
 
 
 void MCTF::xFinalizeBlkLine( const PelStorage &orgPic, const std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, PelStorage &newOrgPic,
-  std::vector<PelStorage>& correctedPics, int yStart, const double sigmaSqCh[MAX_NUM_CH], const std::vector<double> refStrengthCh[MAX_NUM_CH] ) const
+  PelStorage& correctedLines, int yStart, const double sigmaSqCh[MAX_NUM_CH], const std::vector<double> refStrengthCh[MAX_NUM_CH] ) const
 {
   const int numRefs = int(srcFrameInfo.size());
+  CHECK( numRefs > 2 * MCTF_RANGE, "more mctf references than expected" );
 
   for(int c=0; c< getNumberValidComponents(m_chromaFormatIDC); c++)
   {
+    const ComponentID compID=(ComponentID)c;
+    const int blkSizeY = 8 >> getComponentScaleY(compID, m_chromaFormatIDC);
+
+    // motion compensate the current block line of all references, the block lines are stacked in the line buffer
+    PelBuf correctedLn[ 2 * MCTF_RANGE ];
     for (int i = 0; i < numRefs; i++)
     {
-      applyMotionLn(srcFrameInfo[i].mvs, srcFrameInfo[i].picBuffer, correctedPics[i], yStart / 8, c);
+      correctedLn[i] = correctedLines.bufs[c].subBuf( 0, i * blkSizeY, correctedLines.bufs[c].width, blkSizeY );
+      applyMotionLn(srcFrameInfo[i].mvs, srcFrameInfo[i].picBuffer, correctedLn[i], yStart / 8, c);
     }
 
-    const ComponentID compID=(ComponentID)c;
     const int height = orgPic.bufs[c].height;
     const int width  = orgPic.bufs[c].width;
     const int srcStride = orgPic.bufs[c].stride;
@@ -745,8 +823,6 @@ void MCTF::xFinalizeBlkLine( const PelStorage &orgPic, const std::deque<Temporal
     const std::vector<double>& refStrength = refStrengthCh[ toChannelType( compID) ];
     const Pel maxSampleValue = (1<<m_internalBitDepth[ toChannelType( compID) ])-1;
 
-    
-    const int blkSizeY = 8 >> getComponentScaleY(compID, m_chromaFormatIDC);
     int yOut = yStart >> getComponentScaleY(compID, m_chromaFormatIDC);
     const Pel* srcPelRow = orgPic.bufs[c].buf + yOut * srcStride;
     Pel* dstPelRow = newOrgPic.bufs[c].buf + yOut * dstStride;
@@ -762,7 +838,7 @@ void MCTF::xFinalizeBlkLine( const PelStorage &orgPic, const std::deque<Temporal
         double newVal = (double) orgVal;
         for (int i = 0; i < numRefs; i++)
         {
-          const Pel*   pCorrectedPelPtr=correctedPics[i].bufs[c].buf+(y*correctedPics[i].bufs[c].stride+x);
+          const Pel*   pCorrectedPelPtr=correctedLn[i].buf+((y-yOut)*correctedLn[i].stride+x);
           const int    refVal = (int) *pCorrectedPelPtr;
           const double diff   = (double)(refVal - orgVal);
           const double diffSq = diff * diff;
@@ -813,10 +889,12 @@ void MCTF::bilateralFilter(const PelStorage &orgPic,  const std::deque<TemporalF
     }
   }
 
-  std::vector<PelStorage> correctedPics(numRefs);
-  for (int i = 0; i < numRefs; i++)
+  // one buffer per thread for the motion compensated block lines of all references, a filter task only needs the current block line
+  std::vector<PelStorage> correctedLines( m_threadPool ? std::max( m_threadPool->numThreads(), 1 ) : 1 );
+  for (auto& lines : correctedLines)
   {
-    correctedPics[i].create(m_chromaFormatIDC, m_area, 0, m_padding);
+    lines.setPool(m_bufPool);
+    lines.create(m_chromaFormatIDC, Area(0, 0, m_area.width, 8 * std::max(numRefs, 1)));
   }
 
 
@@ -827,7 +905,7 @@ void MCTF::bilateralFilter(const PelStorage &orgPic,  const std::deque<TemporalF
       const PelStorage *orgPic; 
       const std::deque<TemporalFilterSourcePicInfo> *srcFrameInfo; 
       PelStorage *newOrgPic;
-      std::vector<PelStorage>* correctedPics;
+      std::vector<PelStorage>* correctedLines;
       const double *sigmaSqCh;
       const std::vector<double> *refStrengthCh;
       const MCTF* mctf;
@@ -844,7 +922,7 @@ void MCTF::bilateralFilter(const PelStorage &orgPic,  const std::deque<TemporalF
       {
         ITT_TASKSTART( itt_domain_MCTF_flt, itt_handle_flt );
 
-        params->mctf->xFinalizeBlkLine( *params->orgPic, *params->srcFrameInfo, *params->newOrgPic, *params->correctedPics, params->yStart, params->sigmaSqCh, params->refStrengthCh );
+        params->mctf->xFinalizeBlkLine( *params->orgPic, *params->srcFrameInfo, *params->newOrgPic, ( *params->correctedLines )[ tId ], params->yStart, params->sigmaSqCh, params->refStrengthCh );
 
         ITT_TASKEND( itt_domain_MCTF_flt, itt_handle_flt );
         return true;
@@ -854,7 +932,7 @@ void MCTF::bilateralFilter(const PelStorage &orgPic,  const std::deque<TemporalF
       cFltParams.orgPic = &orgPic; 
       cFltParams.srcFrameInfo = &srcFrameInfo; 
       cFltParams.newOrgPic = &newOrgPic;
-      cFltParams.correctedPics = &correctedPics;
+      cFltParams.correctedLines = &correctedLines;
       cFltParams.sigmaSqCh = sigmaSqCh;
       cFltParams.refStrengthCh = refStrengthCh;
       cFltParams.mctf = this;
@@ -868,7 +946,7 @@ void MCTF::bilateralFilter(const PelStorage &orgPic,  const std::deque<TemporalF
   {
     for (int yStart = 0; yStart < orgPic.Y().height; yStart += 8)
     {
-      xFinalizeBlkLine( orgPic, srcFrameInfo, newOrgPic, correctedPics, yStart, sigmaSqCh, refStrengthCh );
+      xFinalizeBlkLine( orgPic, srcFrameInfo, newOrgPic, correctedLines[ 0 ], yStart, sigmaSqCh, refStrengthCh );
     }
   }
 }
@@ -129,10 +129,12 @@ public:
              const std::vector<double>& filterStrengths,
              const bool filterFutureReference,
              const int MCTFMode,
+             const bool storeMotion,
              const int numLeadFrames,
              const int numTrailFrames,
              const int framesToBeEncoded,
-             NoMallocThreadPool* threadPool );
+             NoMallocThreadPool* threadPool,
+             PelStoragePool* bufPool );
   void uninit();
 
   void addLeadFrame ( const YUVBuffer& yuvInBuf );
@@ -166,6 +168,7 @@ private:
   static const int      m_range;
   static const int      m_motionVectorFactor;
   static const int      m_padding;
+  static const int      m_subsampledPadding;
   static const int16_t  m_interpolationFilter[16][8];
   static const double   m_refStrengths[3][2];
 
@@ -181,10 +184,12 @@ private:
   int                   m_ctuSize;
   bool                  m_filterFutureReference;
   int                   m_MCTFMode;
+  bool                  m_storeMotion;
   int                   m_numLeadFrames;
   int                   m_numTrailFrames;
   int                   m_framesToBeEncoded;
   NoMallocThreadPool*   m_threadPool;
+  PelStoragePool*       m_bufPool;
 
   std::deque<Picture*>  m_picFifo;
   std::deque<Picture*>  m_leadFifo;
@@ -193,6 +198,8 @@ private:
   // Private functions
   Picture* createLeadTrailPic( const YUVBuffer& yuvInBuf, const int poc );
   void subsampleLuma(const PelStorage &input, PelStorage &output, const int factor = 2) const;
+  void storeMotionField( Picture& pic, const Array2D<MotionVector>& mvs, const int pocOffset ) const;
+  bool loadMotionField ( const Picture& pic, Array2D<MotionVector>& mvs, const int pocOffset ) const;
 
   int motionErrorLuma(const PelStorage &orig, const PelStorage &buffer, const int x, const int y, int dx, int dy, const int bs, const int besterror) const;
 
@@ -204,10 +211,10 @@ private:
 
   void bilateralFilter(const PelStorage &orgPic, const std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, PelStorage &newOrgPic, double overallStrength) const;
 
-  void applyMotionLn(const Array2D<MotionVector> &mvs, const PelStorage &input, PelStorage &output, int blockNumY, int comp ) const;
+  void applyMotionLn(const Array2D<MotionVector> &mvs, const PelStorage &input, PelBuf &output, int blockNumY, int comp ) const;
 
   void xFinalizeBlkLine( const PelStorage &orgPic, const std::deque<TemporalFilterSourcePicInfo> &srcFrameInfo, PelStorage &newOrgPic,
-    std::vector<PelStorage>& correctedPics, int yStart, const double sigmaSqCh[MAX_NUM_CH], const std::vector<double> refStrengthCh[MAX_NUM_CH] ) const;
+    PelStorage& correctedLines, int yStart, const double sigmaSqCh[MAX_NUM_CH], const std::vector<double> refStrengthCh[MAX_NUM_CH] ) const;
 
 }; // END CLASS DEFINITION MCTF
 
@@ -0,0 +1,349 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     MemAccounting.cpp
+ *  \brief    accounting of the encoder memory per subsystem
+ */
+
+#include "MemAccounting.h"
+#include "CommonDef.h"
+
+#include <cstdio>
+#if defined( __linux__ )
+#include <sys/mman.h>
+#endif
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+namespace
+{
+  const size_t HUGE_PAGE_SIZE = size_t( 1 ) << 21;
+
+  enum MemKind
+  {
+    MEM_KIND_DEFAULT = 0,
+    MEM_KIND_HUGE_ALIGNED,      ///< aligned to huge pages, but not advised
+    MEM_KIND_HUGE_ADVISED,
+    MEM_KIND_HUGE_MAPPED,
+  };
+
+  // stored in front of each accounted allocation, keeps the buffers aligned to MEMORY_ALIGN_DEF_SIZE
+  struct MemHeader
+  {
+    MemAccount* account;
+    size_t      size;
+    int32_t     tag;
+    int32_t     kind;
+  };
+
+  const size_t MEM_HEADER_SIZE = MEMORY_ALIGN_DEF_SIZE;
+  static_assert( sizeof( MemHeader ) <= MEM_HEADER_SIZE, "memory header exceeds its reserved space" );
+
+  thread_local MemAccount*  t_account = nullptr;
+  thread_local int          t_tag     = MEM_TAG_OTHER;
+
+  MemAccount* processAccount()
+  {
+    // never destroyed, buffers may be released during static destruction
+    static MemAccount* account = new MemAccount;
+    return account;
+  }
+
+  size_t mappedSize( size_t size )
+  {
+    return ( size + MEM_HEADER_SIZE + HUGE_PAGE_SIZE - 1 ) & ~( HUGE_PAGE_SIZE - 1 );
+  }
+}
+
+// ---------------------------------------------------------------------------
+// MemAccount
+// ---------------------------------------------------------------------------
+
+MemAccount::MemAccount()
+  : m_curTotal    ( 0 )
+  , m_peakTotal   ( 0 )
+  , m_hugePageMode( HUGE_PAGES_OFF )
+{
+  for( int i = 0; i < NUM_MEM_TAGS; i++ )
+  {
+    m_curBytes [ i ] = 0;
+    m_peakBytes[ i ] = 0;
+  }
+  for( int i = 0; i < 3; i++ )
+  {
+    m_curHugeBytes [ i ] = 0;
+    m_peakHugeBytes[ i ] = 0;
+  }
+}
+
+void MemAccount::xUpdatePeak( std::atomic<size_t>& peak, size_t cur )
+{
+  size_t prev = peak.load( std::memory_order_relaxed );
+  while( cur > prev && !peak.compare_exchange_weak( prev, cur, std::memory_order_relaxed ) );
+}
+
+void MemAccount::add( int tag, size_t bytes )
+{
+  xUpdatePeak( m_peakBytes[ tag ], m_curBytes[ tag ].fetch_add( bytes, std::memory_order_relaxed ) + bytes );
+  xUpdatePeak( m_peakTotal,        m_curTotal       .fetch_add( bytes, std::memory_order_relaxed ) + bytes );
+}
+
+void MemAccount::sub( int tag, size_t bytes )
+{
+  m_curBytes[ tag ].fetch_sub( bytes, std::memory_order_relaxed );
+  m_curTotal       .fetch_sub( bytes, std::memory_order_relaxed );
+}
+
+void MemAccount::getUsage( MemUsage& memUsage ) const
+{
+  for( int i = 0; i < NUM_MEM_TAGS; i++ )
+  {
+    memUsage.curBytes [ i ] = m_curBytes [ i ];
+    memUsage.peakBytes[ i ] = m_peakBytes[ i ];
+  }
+  memUsage.curTotal  = m_curTotal;
+  memUsage.peakTotal = m_peakTotal;
+}
+
+void MemAccount::addHugePages( size_t bytes, size_t explicitBytes, size_t advisedBytes )
+{
+  const size_t add[3] = { bytes, explicitBytes, advisedBytes };
+  for( int i = 0; i < 3; i++ )
+  {
+    xUpdatePeak( m_peakHugeBytes[ i ], m_curHugeBytes[ i ].fetch_add( add[ i ], std::memory_order_relaxed ) + add[ i ] );
+  }
+}
+
+void MemAccount::subHugePages( size_t bytes, size_t explicitBytes, size_t advisedBytes )
+{
+  m_curHugeBytes[ 0 ].fetch_sub( bytes,         std::memory_order_relaxed );
+  m_curHugeBytes[ 1 ].fetch_sub( explicitBytes, std::memory_order_relaxed );
+  m_curHugeBytes[ 2 ].fetch_sub( advisedBytes,  std::memory_order_relaxed );
+}
+
+HugePageStats MemAccount::getHugePageStats() const
+{
+  HugePageStats stats;
+  stats.peakBytes         = m_peakHugeBytes[0];
+  stats.peakExplicitBytes = m_peakHugeBytes[1];
+  stats.peakAdvisedBytes  = m_peakHugeBytes[2];
+  stats.anonHugeBytes     = 0;
+
+#if defined( __linux__ )
+  // whether advised memory is actually backed by transparent huge pages is only known to the kernel
+  if( FILE* f = fopen( "/proc/self/smaps_rollup", "r" ) )
+  {
+    char line[256];
+    unsigned long long kB = 0;
+    while( fgets( line, sizeof( line ), f ) )
+    {
+      if( sscanf( line, "AnonHugePages: %llu kB", &kB ) == 1 )
+      {
+        stats.anonHugeBytes = size_t( kB ) << 10;
+        break;
+      }
+    }
+    fclose( f );
+  }
+#endif
+
+  return stats;
+}
+
+// ---------------------------------------------------------------------------
+// MemTagScope
+// ---------------------------------------------------------------------------
+
+MemTagScope::MemTagScope( MemAccount* account, int tag )
+  : m_prevAccount( t_account )
+  , m_prevTag    ( t_tag )
+{
+  t_account = account;
+  t_tag     = tag;
+}
+
+MemTagScope::MemTagScope( int tag )
+  : m_prevAccount( t_account )
+  , m_prevTag    ( t_tag )
+{
+  t_tag = tag;
+}
+
+MemTagScope::~MemTagScope()
+{
+  t_account = m_prevAccount;
+  t_tag     = m_prevTag;
+}
+
+MemAccount* MemTagScope::account()
+{
+  return t_account ? t_account : processAccount();
+}
+
+int MemTagScope::tag()
+{
+  return t_tag;
+}
+
+// ---------------------------------------------------------------------------
+// MemTrack
+// ---------------------------------------------------------------------------
+
+void MemTrack::add( size_t bytes )
+{
+  if( !m_account )
+  {
+    m_account = MemTagScope::account();
+    m_tag     = MemTagScope::tag();
+  }
+  m_account->add( m_tag, bytes );
+  m_bytes += bytes;
+}
+
+void MemTrack::sub( size_t bytes )
+{
+  CHECKD( bytes > m_bytes, "releasing more memory than tracked" );
+  m_account->sub( m_tag, bytes );
+  m_bytes -= bytes;
+}
+
+void MemTrack::release()
+{
+  if( m_bytes )
+  {
+    sub( m_bytes );
+  }
+}
+
+// ---------------------------------------------------------------------------
+// MemAlloc
+// ---------------------------------------------------------------------------
+
+void* MemAlloc::alloc( size_t size, bool picBuf )
+{
+  MemAccount* account = MemTagScope::account();
+  char*       base    = nullptr;
+  int         kind    = MEM_KIND_DEFAULT;
+
+#if defined( __linux__ )
+  const int mode = account->getHugePageMode();
+  if( picBuf && mode != HUGE_PAGES_OFF && size >= HUGE_PAGE_SIZE )
+  {
+#if defined( MAP_HUGETLB )
+    if( mode == HUGE_PAGES_EXPLICIT )
+    {
+      // fails without reserved huge pages (vm.nr_hugepages), then fall back to transparent huge pages
+      void* ptr = mmap( nullptr, mappedSize( size ), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0 );
+      if( ptr != MAP_FAILED )
+      {
+        base = ( char* ) ptr;
+        kind = MEM_KIND_HUGE_MAPPED;
+      }
+    }
+#endif
+    if( !base )
+    {
+      void* ptr = nullptr;
+      if( posix_memalign( &ptr, HUGE_PAGE_SIZE, size + MEM_HEADER_SIZE ) )
+      {
+        THROW( "posix_memalign failed" );
+      }
+      base = ( char* ) ptr;
+      kind = MEM_KIND_HUGE_ALIGNED;
+#if defined( MADV_HUGEPAGE )
+      if( madvise( base, size + MEM_HEADER_SIZE, MADV_HUGEPAGE ) == 0 )
+      {
+        kind = MEM_KIND_HUGE_ADVISED;
+      }
+#endif
+    }
+    account->addHugePages( size, kind == MEM_KIND_HUGE_MAPPED ? size : 0, kind == MEM_KIND_HUGE_ADVISED ? size : 0 );
+  }
+#endif
+
+  if( !base )
+  {
+    base = ( char* ) xAlignedMalloc( char, size + MEM_HEADER_SIZE );
+  }
+
+  MemHeader* hdr = ( MemHeader* ) base;
+  hdr->account   = account;
+  hdr->size      = size;
+  hdr->tag       = MemTagScope::tag();
+  hdr->kind      = kind;
+  hdr->account->add( hdr->tag, size );
+
+  return base + MEM_HEADER_SIZE;
+}
+
+void MemAlloc::dealloc( void* ptr )
+{
+  if( !ptr )
+  {
+    return;
+  }
+
+  char*      base = ( char* ) ptr - MEM_HEADER_SIZE;
+  MemHeader* hdr  = ( MemHeader* ) base;
+  hdr->account->sub( hdr->tag, hdr->size );
+
+#if defined( __linux__ )
+  if( hdr->kind != MEM_KIND_DEFAULT )
+  {
+    hdr->account->subHugePages( hdr->size, hdr->kind == MEM_KIND_HUGE_MAPPED ? hdr->size : 0, hdr->kind == MEM_KIND_HUGE_ADVISED ? hdr->size : 0 );
+  }
+  if( hdr->kind == MEM_KIND_HUGE_MAPPED )
+  {
+    munmap( base, mappedSize( hdr->size ) );
+    return;
+  }
+#endif
+
+  xAlignedFree( base );
+}
+
+} // namespace vvenc
+
+//! \}
+
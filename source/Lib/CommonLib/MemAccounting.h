@@ -0,0 +1,163 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     MemAccounting.h
+ *  \brief    accounting of the encoder memory per subsystem
+ */
+
+#pragma once
+
+#include "../../../include/vvenc/Basics.h"
+
+#include <atomic>
+#include <cstddef>
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+// ---------------------------------------------------------------------------
+// Huge page backing of picture sized buffers
+// ---------------------------------------------------------------------------
+
+enum HugePageMode
+{
+  HUGE_PAGES_OFF         = 0,
+  HUGE_PAGES_TRANSPARENT = 1,   ///< advise transparent huge pages (madvise)
+  HUGE_PAGES_EXPLICIT    = 2,   ///< map reserved huge pages (MAP_HUGETLB), fall back to transparent huge pages
+};
+
+struct HugePageStats
+{
+  size_t peakBytes;             ///< peak size of the buffers large enough for huge pages
+  size_t peakExplicitBytes;     ///< thereof mapped from reserved huge pages
+  size_t peakAdvisedBytes;      ///< thereof advised for transparent huge pages
+  size_t anonHugeBytes;         ///< anonymous memory of the process currently backed by transparent huge pages
+};
+
+// ---------------------------------------------------------------------------
+// Memory account of one encoder instance
+// ---------------------------------------------------------------------------
+
+class MemAccount
+{
+public:
+  MemAccount();
+
+  void add     ( int tag, size_t bytes );
+  void sub     ( int tag, size_t bytes );
+  void getUsage( MemUsage& memUsage ) const;
+
+  void          setHugePageMode ( int mode ) { m_hugePageMode = mode; }   ///< applies to the picture sized buffers allocated for this account
+  int           getHugePageMode () const     { return m_hugePageMode; }
+  void          addHugePages    ( size_t bytes, size_t explicitBytes, size_t advisedBytes );
+  void          subHugePages    ( size_t bytes, size_t explicitBytes, size_t advisedBytes );
+  HugePageStats getHugePageStats() const;
+
+private:
+  static void xUpdatePeak( std::atomic<size_t>& peak, size_t cur );
+
+  std::atomic<size_t> m_curBytes [ NUM_MEM_TAGS ];
+  std::atomic<size_t> m_peakBytes[ NUM_MEM_TAGS ];
+  std::atomic<size_t> m_curTotal;
+  std::atomic<size_t> m_peakTotal;
+  std::atomic<int>    m_hugePageMode;
+  std::atomic<size_t> m_curHugeBytes [ 3 ];  ///< huge page sized buffers, thereof explicit and advised
+  std::atomic<size_t> m_peakHugeBytes[ 3 ];
+};
+
+// ---------------------------------------------------------------------------
+// Attributes the allocations of the current thread to an account and subsystem
+// ---------------------------------------------------------------------------
+
+class MemTagScope
+{
+public:
+  MemTagScope( MemAccount* account, int tag );
+  MemTagScope( int tag );                         ///< keeps the account of the enclosing scope
+  ~MemTagScope();
+
+  static MemAccount* account();                   ///< account of the current thread, a process wide account outside of any scope
+  static int         tag();
+
+private:
+  MemAccount* m_prevAccount;
+  int         m_prevTag;
+};
+
+// ---------------------------------------------------------------------------
+// Accounts memory which is not allocated through xMalloc (e.g. arrays of objects)
+// ---------------------------------------------------------------------------
+
+class MemTrack
+{
+public:
+  MemTrack() : m_account( nullptr ), m_tag( MEM_TAG_OTHER ), m_bytes( 0 ) {}
+  ~MemTrack() { release(); }
+  MemTrack( const MemTrack& ) = delete;
+  MemTrack& operator=( const MemTrack& ) = delete;
+
+  void add    ( size_t bytes );                   ///< the first call binds to the account and tag of the current scope
+  void sub    ( size_t bytes );
+  void release();
+
+private:
+  MemAccount* m_account;
+  int         m_tag;
+  size_t      m_bytes;
+};
+
+// ---------------------------------------------------------------------------
+// Accounted allocation (xMalloc), picture sized buffers optionally backed by huge pages (see MemAccount::setHugePageMode)
+// ---------------------------------------------------------------------------
+
+class MemAlloc
+{
+public:
+  static void*         alloc          ( size_t size, bool picBuf );
+  static void          dealloc        ( void* ptr );
+};
+
+} // namespace vvenc
+
+//! \}
+
@@ -142,6 +142,101 @@ void BlkStat::setSliceMaxBT( Slice& slice )
 }
 
 
+// ====================================================================================================================
+// scratch buffer pool
+// ====================================================================================================================
+
+
+PicScratchPool::PicScratchPool()
+  : m_chromaFormat( NUM_CHROMA_FORMAT )
+  , m_area        ()
+  , m_maxCUSize   ( 0 )
+  , m_padding     ( 0 )
+  , m_memAccount  ( nullptr )
+{
+}
+
+PicScratchPool::~PicScratchPool()
+{
+  destroy();
+}
+
+void PicScratchPool::init( const ChromaFormat chromaFormat, const Size& size, const unsigned maxCUSize, const unsigned padding )
+{
+  destroy();
+
+  m_chromaFormat = chromaFormat;
+  m_area         = Area( Position(), size );
+  m_maxCUSize    = maxCUSize;
+  m_padding      = padding;
+  m_memAccount   = MemTagScope::account();
+}
+
+void PicScratchPool::destroy()
+{
+  std::lock_guard<std::mutex> lock( m_cacheMutex );
+  for( auto& cache : m_cache )
+  {
+    for( auto& buf : cache )
+    {
+      buf->destroy();
+      delete buf;
+    }
+    cache.clear();
+  }
+}
+
+int PicScratchPool::xGetCacheIdx( const PictureType type )
+{
+  CHECK( type != PIC_SAO_TEMP && type != PIC_ORIGINAL_RSP, "no scratch buffer for this picture type" );
+  return type == PIC_SAO_TEMP ? 0 : 1;
+}
+
+void PicScratchPool::getBuf( PelStorage& buf, const PictureType type )
+{
+  CHECK( ! buf.bufs.empty(), "scratch buffer already in use" );
+  const int idx = xGetCacheIdx( type );
+
+  MemTagScope memScope( m_memAccount, MEM_TAG_PICTURES );
+
+  PelStorage* cached = nullptr;
+  {
+    std::lock_guard<std::mutex> lock( m_cacheMutex );
+    if( ! m_cache[ idx ].empty() )
+    {
+      cached = m_cache[ idx ].back();
+      m_cache[ idx ].pop_back();
+    }
+  }
+
+  if( cached )
+  {
+    buf.takeOwnership( *cached );
+    delete cached;
+  }
+  else if( type == PIC_SAO_TEMP )
+  {
+    buf.create( m_chromaFormat, m_area, m_maxCUSize, 0, MEMORY_ALIGN_DEF_SIZE );
+  }
+  else
+  {
+    // same layout as the original, which is padded for the motion compensated temporal filter
+    buf.create( m_chromaFormat, m_area, 0, m_padding );
+  }
+}
+
+void PicScratchPool::releaseBuf( PelStorage& buf, const PictureType type )
+{
+  const int idx = xGetCacheIdx( type );
+
+  PelStorage* cached = new PelStorage;
+  cached->takeOwnership( buf );
+
+  std::lock_guard<std::mutex> lock( m_cacheMutex );
+  m_cache[ idx ].push_back( cached );
+}
+
+
 // ====================================================================================================================
 // Picture
 // ====================================================================================================================
@@ -162,6 +257,10 @@ Picture::Picture()
     , encPic            ( true )
     , writePic          ( true )
     , precedingDRAP     ( false )
+    , isSceneCutIrap    ( false )
+    , lookAheadIntraCost( 0 )
+    , lookAheadInterCost( 0 )
+    , lookAheadQpOffset ( 0 )
     , refCounter        ( 0 )
     , poc               ( 0 )
     , gopId             ( 0 )
@@ -173,6 +272,9 @@ Picture::Picture()
     , ctsValid          ( false )
     , m_bufsOrigPrev    { nullptr, nullptr }
     , picInitialQP    ( 0 )
+    , speedLevel      ( 0 )
+    , scratchPool     ( nullptr )
+    , bufPool         ( nullptr )
 {
 }
 
@@ -181,21 +283,26 @@ void Picture::create( ChromaFormat _chromaFormat, const Size& size, unsigned _ma
   UnitArea::operator=( UnitArea( _chromaFormat, Area( Position{ 0, 0 }, size ) ) );
   margin            =  _margin;
   const Area a      = Area( Position(), size );
+  m_bufs[ PIC_RECONSTRUCTION ].setPool( bufPool );
   m_bufs[ PIC_RECONSTRUCTION ].create( _chromaFormat, a, _maxCUSize, _margin, MEMORY_ALIGN_DEF_SIZE );
-  m_bufs[ PIC_SAO_TEMP ].create( _chromaFormat, a, _maxCUSize, 0, MEMORY_ALIGN_DEF_SIZE );
 
   if( _decoder )
   {
+    m_bufs[ PIC_SAO_TEMP ].setPool( bufPool );
+    m_bufs[ PIC_SAO_TEMP ].create( _chromaFormat, a, _maxCUSize, 0, MEMORY_ALIGN_DEF_SIZE );
     m_bufs[ PIC_RESIDUAL ].create( _chromaFormat, Area( 0, 0, _maxCUSize, _maxCUSize ) );
   }
   else
   {
+    m_bufs[ PIC_ORIGINAL ].setPool( bufPool );
     m_bufs[ PIC_ORIGINAL ].create( _chromaFormat, a, 0, _padding );
   }
 }
 
 void Picture::destroy()
 {
+  releaseScratchBuf( PIC_SAO_TEMP );
+  releaseScratchBuf( PIC_ORIGINAL_RSP );
   for (uint32_t t = 0; t < NUM_PIC_TYPES; t++)
   {
     m_bufs[  t ].destroy();
@@ -232,6 +339,20 @@ void Picture::destroyTempBuffers()
   if( cs ) cs->rebindPicBufs();
 }
 
+void Picture::getScratchBuf( const PictureType type )
+{
+  CHECK( scratchPool == nullptr, "picture has no scratch buffer pool" );
+  scratchPool->getBuf( m_bufs[ type ], type );
+}
+
+void Picture::releaseScratchBuf( const PictureType type )
+{
+  if( scratchPool && ! m_bufs[ type ].bufs.empty() )
+  {
+    scratchPool->releaseBuf( m_bufs[ type ], type );
+  }
+}
+
 const CPelBuf     Picture::getOrigBufPrev (const CompArea &blk, const bool minus2) const { return (m_bufsOrigPrev[minus2 ? 1 : 0] && blk.valid() ? m_bufsOrigPrev[minus2 ? 1 : 0]->getBuf (blk) : PelBuf()); }
 const CPelUnitBuf Picture::getOrigBufPrev (const bool minus2)   const { return (m_bufsOrigPrev[minus2 ? 1 : 0] ? *m_bufsOrigPrev[minus2 ? 1 : 0] : PelUnitBuf()); }
 const CPelBuf     Picture::getOrigBufPrev (const ComponentID compID, const bool minus2) const { return (m_bufsOrigPrev[minus2 ? 1 : 0] ? m_bufsOrigPrev[minus2 ? 1 : 0]->getBuf (compID) : PelBuf()); }
@@ -52,9 +52,11 @@ vvc@hhi.fraunhofer.de
 #include "CodingStructure.h"
 #include "BitStream.h"
 #include "Reshape.h"
+#include "Hash.h"
 
 #include <deque>
 #include <chrono>
+#include <atomic>
 
 //! \ingroup CommonLib
 //! \{
@@ -111,6 +113,41 @@ struct StopClock
 
 struct Picture;
 
+struct MctfMotionField
+{
+  MctfMotionField() : pocOffset( 0 ), blkSizeLog2( 3 ), widthInBlks( 0 ), heightInBlks( 0 ) {}
+
+  int               pocOffset;     // poc distance of the picture the vectors point into
+  int               blkSizeLog2;
+  int               widthInBlks;
+  int               heightInBlks;
+  std::vector<Mv>   mvs;           // luma block motion in internal (1/16 sample) precision
+  std::vector<int>  errors;        // sum of squared differences of the matched block, INT_MAX if not estimated
+};
+
+struct AnalysisBlk
+{
+  uint8_t           qtDepth;
+  uint8_t           mtDepth;
+  uint8_t           interDir;      // 0 for intra blocks
+  int8_t            refIdx[ NUM_REF_PIC_LIST_01 ];
+  Mv                mv    [ NUM_REF_PIC_LIST_01 ];
+};
+
+struct PicAnalysis
+{
+  PicAnalysis() : blkSizeLog2( 3 ), widthInBlks( 0 ), heightInBlks( 0 ) {}
+
+  bool              valid() const                  { return ! blks.empty(); }
+  const AnalysisBlk& at( int x, int y ) const      { return blks[ std::min( y >> blkSizeLog2, heightInBlks - 1 ) * widthInBlks + std::min( x >> blkSizeLog2, widthInBlks - 1 ) ]; }
+  void              clear()                        { widthInBlks = heightInBlks = 0; blks.clear(); }
+
+  int               blkSizeLog2;
+  int               widthInBlks;
+  int               heightInBlks;
+  std::vector<AnalysisBlk> blks;   // luma partitioning and motion of a previous encoding of the same input
+};
+
 class BlkStat
 {
 public:
@@ -135,6 +172,34 @@ protected:
 };
 
 
+// full size picture buffers, which are only needed while a picture is being processed (SAO temp, filtered original),
+// shared between all pictures of an encoder instead of being held by every picture in the list
+class PicScratchPool
+{
+public:
+  PicScratchPool();
+  ~PicScratchPool();
+
+  void init      ( const ChromaFormat chromaFormat, const Size& size, const unsigned maxCUSize, const unsigned padding );
+  void destroy   ();
+
+  void getBuf    ( PelStorage& buf, const PictureType type );
+  void releaseBuf( PelStorage& buf, const PictureType type );
+
+private:
+  static int xGetCacheIdx( const PictureType type );
+
+private:
+  ChromaFormat             m_chromaFormat;
+  Area                     m_area;
+  unsigned                 m_maxCUSize;
+  unsigned                 m_padding;
+  MemAccount*              m_memAccount;                         ///< account of the encoder, buffers are also created in worker threads
+  std::mutex               m_cacheMutex;
+  std::vector<PelStorage*> m_cache[ 2 ];
+};
+
+
 struct Picture : public UnitArea
 {
   uint32_t margin;
@@ -146,6 +211,9 @@ struct Picture : public UnitArea
   void createTempBuffers( unsigned _maxCUSize );
   void destroyTempBuffers();
 
+  void getScratchBuf    ( const PictureType type );
+  void releaseScratchBuf( const PictureType type );
+
   void extendPicBorder();
   void finalInit( const VPS& vps, const SPS& sps, const PPS& pps, PicHeader& picHeader, XUCache& unitCache, std::mutex* mutex, APS** alfAps, APS* lmcsAps );
 
@@ -176,6 +244,7 @@ struct Picture : public UnitArea
          PelUnitBuf getSaoBuf()                                           { return getBuf(        PIC_SAO_TEMP ); }
   const CPelUnitBuf getSaoBuf()                                     const { return getBuf(        PIC_SAO_TEMP ); }
         PelStorage& getFilteredOrigBuffer()                               { return m_bufs[        PIC_ORIGINAL_RSP]; }
+        size_t      getOrigBufSize()                                const { return m_bufs[        PIC_ORIGINAL    ].getAllocSize(); }
   
          PelUnitBuf getRspOrigBuf()                                       { return getBuf(        PIC_ORIGINAL_RSP); }
   const CPelUnitBuf getRspOrigBuf()                                 const { return getBuf(        PIC_ORIGINAL_RSP); }
@@ -218,8 +287,12 @@ public:
   bool                          encPic;
   bool                          writePic;
   bool                          precedingDRAP; // preceding a DRAP picture in decoding order
+  bool                          isSceneCutIrap; // random access point inserted after a scene cut
+  Distortion                    lookAheadIntraCost;
+  Distortion                    lookAheadInterCost;
+  int                           lookAheadQpOffset; // complexity based QP offset of the constant quality mode
 
-  int                           refCounter;
+  std::atomic<int>              refCounter;
   int                           poc;
   int                           gopId;
   unsigned                      TLayer;
@@ -237,6 +310,12 @@ public:
   std::mutex                    wppMutex;
   int                           picInitialQP;
   StopClock                     encTime;
+  int                           speedLevel;      // effort reduction selected by the real-time speed control, 0: as configured
+  BlockHash                     blockHash;       // luma block hashes of the original for hash based motion estimation
+  std::vector<MctfMotionField>  mctfMotion;      // MCTF motion towards the neighbouring pictures, used to seed the motion estimation
+  PicAnalysis                   analysis;        // analysis loaded from a previous encoding, reused to restrict the partitioning and motion search
+  PicScratchPool*               scratchPool;     // source of the transient buffers of encoder pictures, nullptr: allocated with the picture
+  PelStoragePool*               bufPool;         // recycles the storage of the picture buffers on destroy, nullptr: freed
 
 private:
   std::vector<SAOBlkParam>      m_sao[ 2 ];
@@ -112,7 +112,8 @@ void RdCost::create()
 
   m_afpDistortFunc[0][DF_SAD_WITH_MASK] = RdCost::xGetSADwMask;
   // m_afpDistortFunc[1] can be used in any case
-  memcpy( m_afpDistortFunc[1], m_afpDistortFunc[0], sizeof(m_afpDistortFunc)/2);
+  memcpy( m_afpDistortFunc[1], m_afpDistortFunc[0], sizeof(m_afpDistortFunc[0]));
+  memcpy( m_afpDistortFunc[2], m_afpDistortFunc[0], sizeof(m_afpDistortFunc[0]));
 
 #if ENABLE_SIMD_OPT_DIST
 #ifdef TARGET_SIMD_X86
@@ -141,7 +142,7 @@ void RdCost::setDistParam( DistParam &rcDP, const CPelBuf& org, const Pel* piRef
   rcDP.cur.height   = org.height;
   rcDP.maximumDistortionForEarlyExit = MAX_DISTORTION;
 
-  const int base = (rcDP.bitDepth > 10 || rcDP.applyWeight) ? 1 : 0;
+  const int base = rcDP.applyWeight ? 1 : xGetDistFuncBase( rcDP.bitDepth );
   if( !useHadamard )
   {
     rcDP.distFunc = m_afpDistortFunc[base][ DF_SAD + Log2( org.width ) ];
@@ -198,7 +199,7 @@ DistParam RdCost::setDistParam( const CPelBuf& org, const CPelBuf& cur, int bitD
     index += Log2(org.width);
   }
 
-  const int base = bitDepth > 10 ? 1:0; //TBD: check does SDA ever overflow
+  const int base = xGetDistFuncBase( bitDepth ); //TBD: check does SDA ever overflow
   return DistParam( org, cur, m_afpDistortFunc[base][index], bitDepth, 0, COMP_Y);
 }
 
@@ -220,7 +221,7 @@ DistParam RdCost::setDistParam( const Pel* pOrg, const Pel* piRefY, int iOrgStri
   rcDP.subShift   = subShift;
 
   //  CHECK( useHadamard || rcDP.useMR, "only used in xDMVRCost with these default parameters (so far...)" );
-  const int base = (rcDP.bitDepth > 10) ? 1 : 0;
+  const int base = xGetDistFuncBase( rcDP.bitDepth );
 
   rcDP.distFunc = m_afpDistortFunc[base][ DF_SAD + Log2( width ) ];
   return rcDP;
@@ -239,7 +240,7 @@ Distortion RdCost::getDistPart( const CPelBuf& org, const CPelBuf& cur, int bitD
   }
   else
   {
-    const int base      = (bitDepth > 10) ? 1 : 0;
+    const int base      = xGetDistFuncBase( bitDepth );
     dist = m_afpDistortFunc[base][eDFunc + Log2(org.width)]( dp );
   }
   if (isChroma(compId))
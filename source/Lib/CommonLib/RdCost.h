@@ -106,7 +106,7 @@ class RdCost
 private:
   // for distortion
 
-  FpDistFunc              m_afpDistortFunc[2][DF_TOTAL_FUNCTIONS]; // [eDFunc]
+  FpDistFunc              m_afpDistortFunc[3][DF_TOTAL_FUNCTIONS]; // [base][eDFunc], base 0: up to 10 bit, 1: above 10 bit or weighted, 2: 8 bit
   CostMode                m_costMode;
   double                  m_distortionWeight[MAX_NUM_COMP]; // only chroma values are used.
   double                  m_dLambda;
@@ -210,6 +210,8 @@ private:
   static Distortion xGetHAD2SADs      ( const DistParam& pcDtParam );
   static Distortion xGetHADs          ( const DistParam& pcDtParam );
 
+  static int        xGetDistFuncBase  ( const int bitDepth )             { return bitDepth > 10 ? 1 : ( bitDepth == 8 ? 2 : 0 ); }
+
 #ifdef TARGET_SIMD_X86
   template<X86_VEXT vext>
   static Distortion xGetSSE_SIMD    ( const DistParam& pcDtParam );
@@ -224,6 +226,8 @@ private:
   template<X86_VEXT vext>
   static Distortion xGetHADs_SIMD   ( const DistParam& pcDtParam );
   template<X86_VEXT vext>
+  static Distortion xGetHADs8bit_SIMD( const DistParam& pcDtParam );
+  template<X86_VEXT vext>
   static Distortion xGetHAD2SADs_SIMD( const DistParam &rcDtParam );
 
   template<X86_VEXT vext> 
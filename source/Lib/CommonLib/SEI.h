@@ -160,58 +160,104 @@ class SEIBufferingPeriod : public SEI
 {
 public:
   PayloadType payloadType() const { return BUFFERING_PERIOD; }
-  void copyTo (SEIBufferingPeriod& target);
+  void copyTo (SEIBufferingPeriod& target) const;
 
   SEIBufferingPeriod()
-  : m_bpSeqParameterSetId (0)
-  , m_rapCpbParamsPresent (false)
-  , m_cpbDelayOffset      (0)
-  , m_dpbDelayOffset      (0)
+  : m_bpNalCpbParamsPresent                   (false)
+  , m_bpVclCpbParamsPresent                   (false)
+  , m_initialCpbRemovalDelayLength            (0)
+  , m_cpbRemovalDelayLength                   (0)
+  , m_dpbOutputDelayLength                    (0)
+  , m_bpCpbCnt                                (0)
+  , m_duCpbRemovalDelayIncrementLength        (0)
+  , m_dpbOutputDelayDuLength                  (0)
+  , m_concatenationFlag                       (false)
+  , m_auCpbRemovalDelayDelta                  (1)
+  , m_cpbRemovalDelayDeltasPresent            (false)
+  , m_numCpbRemovalDelayDeltas                (0)
+  , m_bpMaxSubLayers                          (0)
+  , m_bpDecodingUnitHrdParamsPresent          (false)
+  , m_decodingUnitCpbParamsInPicTimingSeiFlag (false)
+  , m_decodingUnitDpbDuParamsInPicTimingSeiFlag(false)
+  , m_sublayerInitialCpbRemovalDelayPresent   (false)
+  , m_additionalConcatenationInfoPresent      (false)
+  , m_maxInitialRemovalDelayForConcatenation  (0)
+  , m_sublayerDpbOutputOffsetsPresent         (false)
+  , m_altCpbParamsPresent                     (false)
+  , m_useAltCpbParamsFlag                     (false)
   {
-    ::memset(m_initialCpbRemovalDelay, 0, sizeof(m_initialCpbRemovalDelay));
-    ::memset(m_initialCpbRemovalDelayOffset, 0, sizeof(m_initialCpbRemovalDelayOffset));
-    ::memset(m_initialAltCpbRemovalDelay, 0, sizeof(m_initialAltCpbRemovalDelay));
-    ::memset(m_initialAltCpbRemovalDelayOffset, 0, sizeof(m_initialAltCpbRemovalDelayOffset));
+    ::memset(m_initialCpbRemovalDelay,  0, sizeof(m_initialCpbRemovalDelay));
+    ::memset(m_initialCpbRemovalOffset, 0, sizeof(m_initialCpbRemovalOffset));
+    ::memset(m_cpbRemovalDelayDelta,    0, sizeof(m_cpbRemovalDelayDelta));
+    ::memset(m_dpbOutputTidOffset,      0, sizeof(m_dpbOutputTidOffset));
   }
   virtual ~SEIBufferingPeriod() {}
 
-  uint32_t m_bpSeqParameterSetId;
-  bool m_rapCpbParamsPresent;
-  uint32_t m_cpbDelayOffset;
-  uint32_t m_dpbDelayOffset;
-  uint32_t m_initialCpbRemovalDelay         [MAX_CPB_CNT][2];
-  uint32_t m_initialCpbRemovalDelayOffset   [MAX_CPB_CNT][2];
-  uint32_t m_initialAltCpbRemovalDelay      [MAX_CPB_CNT][2];
-  uint32_t m_initialAltCpbRemovalDelayOffset[MAX_CPB_CNT][2];
-  bool m_concatenationFlag;
-  uint32_t m_auCpbRemovalDelayDelta;
+  bool      m_bpNalCpbParamsPresent;
+  bool      m_bpVclCpbParamsPresent;
+  uint32_t  m_initialCpbRemovalDelayLength;
+  uint32_t  m_cpbRemovalDelayLength;
+  uint32_t  m_dpbOutputDelayLength;
+  int       m_bpCpbCnt;
+  uint32_t  m_duCpbRemovalDelayIncrementLength;
+  uint32_t  m_dpbOutputDelayDuLength;
+  uint32_t  m_initialCpbRemovalDelay [MAX_TLAYER][MAX_CPB_CNT][2];
+  uint32_t  m_initialCpbRemovalOffset[MAX_TLAYER][MAX_CPB_CNT][2];
+  bool      m_concatenationFlag;
+  uint32_t  m_auCpbRemovalDelayDelta;
+  bool      m_cpbRemovalDelayDeltasPresent;
+  int       m_numCpbRemovalDelayDeltas;
+  int       m_bpMaxSubLayers;
+  uint32_t  m_cpbRemovalDelayDelta[15];
+  bool      m_bpDecodingUnitHrdParamsPresent;
+  bool      m_decodingUnitCpbParamsInPicTimingSeiFlag;
+  bool      m_decodingUnitDpbDuParamsInPicTimingSeiFlag;
+  bool      m_sublayerInitialCpbRemovalDelayPresent;
+  bool      m_additionalConcatenationInfoPresent;
+  uint32_t  m_maxInitialRemovalDelayForConcatenation;
+  bool      m_sublayerDpbOutputOffsetsPresent;
+  uint32_t  m_dpbOutputTidOffset[MAX_TLAYER];
+  bool      m_altCpbParamsPresent;
+  bool      m_useAltCpbParamsFlag;
 };
+
 class SEIPictureTiming : public SEI
 {
 public:
   PayloadType payloadType() const { return PICTURE_TIMING; }
-  void copyTo (SEIPictureTiming& target);
+  void copyTo (SEIPictureTiming& target) const;
 
   SEIPictureTiming()
-  : m_picStruct               (0)
-  , m_sourceScanType          (0)
-  , m_duplicateFlag           (false)
-  , m_picDpbOutputDuDelay     (0)
-  {}
+  : m_picDpbOutputDelay           (0)
+  , m_picDpbOutputDuDelay         (0)
+  , m_numDecodingUnitsMinus1      (0)
+  , m_duCommonCpbRemovalDelayFlag (false)
+  , m_cpbAltTimingInfoPresent     (false)
+  , m_delayForConcatenationEnsureFlag(false)
+  , m_displayElementalPeriodsMinus1(0)
+  {
+    ::memset(m_subLayerDelaysPresent,           0, sizeof(m_subLayerDelaysPresent));
+    ::memset(m_cpbRemovalDelayDeltaEnabledFlag, 0, sizeof(m_cpbRemovalDelayDeltaEnabledFlag));
+    ::memset(m_cpbRemovalDelayDeltaIdx,         0, sizeof(m_cpbRemovalDelayDeltaIdx));
+    ::memset(m_auCpbRemovalDelay,               0, sizeof(m_auCpbRemovalDelay));
+    ::memset(m_duCommonCpbRemovalDelayMinus1,   0, sizeof(m_duCommonCpbRemovalDelayMinus1));
+  }
   virtual ~SEIPictureTiming()
   {
   }
 
-  uint32_t  m_picStruct;
-  uint32_t  m_sourceScanType;
-  bool  m_duplicateFlag;
-
-  uint32_t  m_auCpbRemovalDelay;
+  bool      m_subLayerDelaysPresent          [MAX_TLAYER];
+  bool      m_cpbRemovalDelayDeltaEnabledFlag[MAX_TLAYER];
+  uint32_t  m_cpbRemovalDelayDeltaIdx        [MAX_TLAYER];
+  uint32_t  m_auCpbRemovalDelay              [MAX_TLAYER];
   uint32_t  m_picDpbOutputDelay;
   uint32_t  m_picDpbOutputDuDelay;
   uint32_t  m_numDecodingUnitsMinus1;
-  bool  m_duCommonCpbRemovalDelayFlag;
-  uint32_t  m_duCommonCpbRemovalDelayMinus1;
+  bool      m_duCommonCpbRemovalDelayFlag;
+  uint32_t  m_duCommonCpbRemovalDelayMinus1  [MAX_TLAYER];
+  bool      m_cpbAltTimingInfoPresent;
+  bool      m_delayForConcatenationEnsureFlag;
+  uint32_t  m_displayElementalPeriodsMinus1;
   std::vector<uint32_t> m_numNalusInDuMinus1;
   std::vector<uint32_t> m_duCpbRemovalDelayMinus1;
 };
@@ -1500,6 +1500,7 @@ SPS::SPS()
 , virtualBoundariesPosX           { 0,  0,  0 }
 , virtualBoundariesPosY           { 0,  0,  0 }
 , hrdParametersPresent            ( 0 )
+, subLayerCpbParamsPresent        ( false )
 , fieldSeqFlag                    ( false )
 , vuiParametersPresent            ( false )
 , vuiParameters                   ()
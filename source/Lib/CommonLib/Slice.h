@@ -50,6 +50,7 @@ vvc@hhi.fraunhofer.de
 #include "AlfParameters.h"
 #include "Common.h"
 #include "MotionInfo.h"
+#include "HRD.h"
 
 #include <cstring>
 #include <list>
@@ -751,8 +752,9 @@ struct SPS
 
 
   bool              hrdParametersPresent;
-//  GeneralHrdParams m_generalHrdParams;
-//  OlsHrdParams     m_olsHrdParams[MAX_TLAYER];
+  bool              subLayerCpbParamsPresent;
+  GeneralHrdParams  generalHrdParams;
+  OlsHrdParams      olsHrdParams[MAX_TLAYER];
   bool              fieldSeqFlag;
   bool              vuiParametersPresent;
   VUI               vuiParameters;
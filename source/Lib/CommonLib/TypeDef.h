@@ -129,6 +129,7 @@ namespace vvenc {
 #define ENABLE_SIMD_OPT_MCTF                            ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for MCTF
 #define ENABLE_SIMD_TRAFO                               ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for Transformation
 #define ENABLE_SIMD_OPT_QUANT                           ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for Quantization
+#define ENABLE_SIMD_OPT_BITSTREAM                       ( 1 && ENABLE_SIMD_OPT )                            ///< SIMD optimization for emulation prevention byte handling, no impact on RD performance
 
 #if ENABLE_SIMD_OPT_BUFFER
 #define ENABLE_SIMD_OPT_BCW                               1                                                 ///< SIMD optimization for GBi
@@ -600,6 +601,67 @@ struct LoopFilterParam
   void setFilterCMFL(                     int f ) { flags = ( flags & ~( 1 <<      5 ) ) | ( f <<      5 ); }
 };
 
+/// per picture deblocking edge parameters of one edge direction in structure-of-arrays layout:
+/// every field of LoopFilterParam is kept in its own byte plane (one entry per 4x4 luma edge segment),
+/// so the deblocking passes can scan the dense boundary strength plane and only gather the
+/// remaining fields for edges that are actually filtered
+struct LoopFilterParamMap
+{
+  static constexpr int NUM_PLANES = 6;
+
+  uint8_t*  bs                = nullptr;
+  uint8_t*  sideMaxFiltLength = nullptr;
+  uint8_t*  flags             = nullptr;
+  int8_t*   qp[3]             = { nullptr, nullptr, nullptr };
+  ptrdiff_t stride            = 0;
+  size_t    planeSize         = 0;
+
+  // planes are consecutive in one allocation starting at bs
+  void setBuf( uint8_t* buf, ptrdiff_t _stride, size_t _planeSize )
+  {
+    stride            = _stride;
+    planeSize         = _planeSize;
+    bs                = buf;
+    sideMaxFiltLength = buf ? buf + 1 * planeSize : nullptr;
+    flags             = buf ? buf + 2 * planeSize : nullptr;
+    for( int i = 0; i < 3; i++ )
+    {
+      qp[i]           = buf ? ( int8_t* ) ( buf + ( 3 + i ) * planeSize ) : nullptr;
+    }
+  }
+
+  LoopFilterParam get( ptrdiff_t i ) const
+  {
+    LoopFilterParam lfp;
+    lfp.qp[0]             = qp[0][i];
+    lfp.qp[1]             = qp[1][i];
+    lfp.qp[2]             = qp[2][i];
+    lfp.bs                = bs[i];
+    lfp.sideMaxFiltLength = sideMaxFiltLength[i];
+    lfp.flags             = flags[i];
+    return lfp;
+  }
+
+  bool filterEdge   ( ptrdiff_t i, ChannelType chType ) const { return ( flags[i] >> chType ) & 1; }
+  bool filterCMFL   ( ptrdiff_t i )                     const { return ( flags[i] >>      5 ) & 1; }
+
+  void setFilterEdge( ptrdiff_t i, ChannelType chType, int f ) { flags[i] = ( flags[i] & ~( 1 << chType ) ) | ( f << chType ); }
+  void setFilterCMFL( ptrdiff_t i,                     int f ) { flags[i] = ( flags[i] & ~( 1 <<      5 ) ) | ( f <<      5 ); }
+
+  void clear() { if( bs ) memset( bs, 0, NUM_PLANES * planeSize ); }
+  void clear( int x, int y, int width, int height )
+  {
+    for( int p = 0; p < NUM_PLANES; p++ )
+    {
+      uint8_t* plane = bs + p * planeSize + y * stride + x;
+      for( int h = 0; h < height; h++, plane += stride )
+      {
+        memset( plane, 0, width );
+      }
+    }
+  }
+};
+
 struct PictureHash
 {
   std::vector<uint8_t> hash;
@@ -823,10 +885,13 @@ public:
 // dynamic cache
 // ---------------------------------------------------------------------------
 
-template<typename T>
+// the entries are allocated in contiguous slabs and handed out in address order, so the units of a coding structure,
+// which are taken one after the other in coding order, end up next to each other in memory
+template<typename T, size_t SLAB_SIZE = 256>
 class dynamic_cache
 {
   std::vector<T*> m_cache;
+  std::vector<T*> m_slabs;
 public:
 
   ~dynamic_cache()
@@ -834,31 +899,35 @@ public:
     deleteEntries();
   }
 
+  // releases all entries, including the ones still in use
   void deleteEntries()
   {
-    for( auto &p : m_cache )
+    for( auto &p : m_slabs )
     {
-      delete p;
+      delete[] p;
       p = nullptr;
     }
 
+    m_slabs.clear();
     m_cache.clear();
   }
 
   T* get()
   {
-    T* ret;
-
-    if( !m_cache.empty() )
-    {
-      ret = m_cache.back();
-      m_cache.pop_back();
-    }
-    else
+    if( m_cache.empty() )
     {
-      ret = new T;
+      T* slab = new T[ SLAB_SIZE ];
+      m_slabs.push_back( slab );
+      m_cache.reserve( m_cache.size() + SLAB_SIZE );
+      for( size_t i = SLAB_SIZE; i > 0; i-- )
+      {
+        m_cache.push_back( &slab[ i - 1 ] );
+      }
     }
 
+    T* ret = m_cache.back();
+    m_cache.pop_back();
+
     return ret;
   }
 
@@ -867,9 +936,10 @@ public:
     m_cache.push_back( el );
   }
 
+  // returns all units of a coding structure in one step, in reverse order to hand them out again in the same order
   void cache( std::vector<T*>& vel )
   {
-    m_cache.insert( m_cache.end(), vel.begin(), vel.end() );
+    m_cache.insert( m_cache.end(), vel.rbegin(), vel.rend() );
     vel.clear();
   }
 };
@@ -1209,7 +1209,7 @@ bool PU::getColocatedMVP(const PredictionUnit &pu, const RefPicList refPicList,
 
   RefPicList eColRefPicList = slice.checkLDC ? refPicList : RefPicList(slice.colFromL0Flag);
 
-  const MotionInfo& mi = pColPic->cs->getMotionInfo( pos );
+  const MotionInfo& mi = pColPic->cs->getColMotionInfo( pos );
 
   if( !mi.isInter )
   {
@@ -2066,7 +2066,7 @@ bool PU::getInterMergeSbTMVPCand(const PredictionUnit &pu, MergeCtx& mrgCtx, boo
   centerPos = Position{ PosType(centerPos.x & mask), PosType(centerPos.y & mask) };
 
   // derivation of center motion parameters from the collocated CU
-  const MotionInfo &mi = pColPic->cs->getMotionInfo(centerPos);
+  const MotionInfo &mi = pColPic->cs->getColMotionInfo(centerPos);
 
   if (mi.isInter)
   {
@@ -2116,7 +2116,7 @@ bool PU::getInterMergeSbTMVPCand(const PredictionUnit &pu, MergeCtx& mrgCtx, boo
 
         colPos = Position{ PosType(colPos.x & mask), PosType(colPos.y & mask) };
 
-        const MotionInfo &colMi = pColPic->cs->getMotionInfo(colPos);
+        const MotionInfo &colMi = pColPic->cs->getColMotionInfo(colPos);
 
         MotionInfo mi;
 
@@ -0,0 +1,125 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     BitStreamX86.h
+    \brief    SIMD search for emulation prevention candidates in byte streams
+*/
+
+#pragma once
+
+#include "CommonDefX86.h"
+#include "BitStream.h"
+
+#ifdef TARGET_SIMD_X86
+#if ENABLE_SIMD_OPT_BITSTREAM
+
+//! \ingroup CommonLib
+//! \{
+
+namespace vvenc {
+
+static inline uint32_t bitScanForward( uint32_t mask )
+{
+#ifdef _WIN32
+  unsigned long idx = 0;
+  _BitScanForward( &idx, mask );
+  return idx;
+#else
+  return ( uint32_t ) __builtin_ctz( mask );
+#endif
+}
+
+template<X86_VEXT vext>
+size_t findZeroPair_SIMD( const uint8_t* buf, size_t pos, size_t size )
+{
+  // compare each byte and its successor against zero, the loads need one byte look-ahead
+#if USE_AVX2
+  if( vext >= AVX2 )
+  {
+    const __m256i vzero = _mm256_setzero_si256();
+    for( ; pos + 33 <= size; pos += 32 )
+    {
+      const __m256i vcur  = _mm256_loadu_si256( ( const __m256i* ) ( buf + pos ) );
+      const __m256i vnext = _mm256_loadu_si256( ( const __m256i* ) ( buf + pos + 1 ) );
+      const uint32_t mask = ( uint32_t ) _mm256_movemask_epi8( _mm256_and_si256( _mm256_cmpeq_epi8( vcur, vzero ), _mm256_cmpeq_epi8( vnext, vzero ) ) );
+      if( mask )
+      {
+        return pos + bitScanForward( mask );
+      }
+    }
+  }
+#endif
+  const __m128i vzero = _mm_setzero_si128();
+  for( ; pos + 17 <= size; pos += 16 )
+  {
+    const __m128i vcur  = _mm_loadu_si128( ( const __m128i* ) ( buf + pos ) );
+    const __m128i vnext = _mm_loadu_si128( ( const __m128i* ) ( buf + pos + 1 ) );
+    const uint32_t mask = ( uint32_t ) _mm_movemask_epi8( _mm_and_si128( _mm_cmpeq_epi8( vcur, vzero ), _mm_cmpeq_epi8( vnext, vzero ) ) );
+    if( mask )
+    {
+      return pos + bitScanForward( mask );
+    }
+  }
+
+  for( ; pos + 1 < size; pos++ )
+  {
+    if( buf[ pos ] == 0 && buf[ pos + 1 ] == 0 )
+    {
+      return pos;
+    }
+  }
+  return size;
+}
+
+template<X86_VEXT vext>
+void BitstreamOps::_initBitstreamOpsX86()
+{
+  findZeroPair = findZeroPair_SIMD<vext>;
+}
+
+template void BitstreamOps::_initBitstreamOpsX86<SIMDX86>();
+
+} // namespace vvenc
+
+//! \}
+
+#endif // ENABLE_SIMD_OPT_BITSTREAM
+#endif // TARGET_SIMD_X86
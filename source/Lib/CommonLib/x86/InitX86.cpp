@@ -61,6 +61,7 @@ vvc@hhi.fraunhofer.de
 #include "MCTF.h"
 #include "TrQuant_EMT.h"
 #include "QuantRDOQ2.h"
+#include "BitStream.h"
 
 #ifdef TARGET_SIMD_X86
 
@@ -118,6 +119,33 @@ void PelBufferOps::initPelBufOpsX86()
 }
 #endif
 
+#if ENABLE_SIMD_OPT_BITSTREAM
+void BitstreamOps::initBitstreamOpsX86()
+{
+  if ( isInitX86Done )
+    return;
+
+  auto vext = read_x86_extension_flags();
+  switch (vext){
+    case AVX512:
+    case AVX2:
+      _initBitstreamOpsX86<AVX2>();
+      break;
+    case AVX:
+      _initBitstreamOpsX86<AVX>();
+      break;
+    case SSE42:
+    case SSE41:
+      _initBitstreamOpsX86<SSE41>();
+      break;
+    default:
+      break;
+  }
+
+  isInitX86Done = true;
+}
+#endif
+
 
 #if ENABLE_SIMD_DBLF
 void LoopFilter::initLoopFilterX86()
@@ -257,20 +285,20 @@ void AffineGradientSearch::initAffineGradientSearchX86()
 #endif
 
 #if ENABLE_SIMD_OPT_INTRAPRED
-void IntraPrediction::initIntraPredictionX86()
+void IntraPrediction::initIntraPredictionX86( const unsigned bitDepthY )
 {
   auto vext = read_x86_extension_flags();
   switch (vext){
     case AVX512:
     case AVX2:
-      _initIntraPredictionX86<AVX2>();
+      _initIntraPredictionX86<AVX2>( bitDepthY );
       break;
     case AVX:
-      _initIntraPredictionX86<AVX>();
+      _initIntraPredictionX86<AVX>( bitDepthY );
       break;
     case SSE42:
     case SSE41:
-      _initIntraPredictionX86<SSE41>();
+      _initIntraPredictionX86<SSE41>( bitDepthY );
       break;
     default:
       break;
@@ -1011,6 +1011,98 @@ static void simdInterpolateVerM16_AVX2( const int16_t *src, int srcStride, int16
 }
 
 
+// SIMD interpolation of 8-bit samples in the first filter stage: the products of 8-bit samples with the luma and
+// chroma filter coefficients and their sum including the stage offset stay within 16 bit, so the taps are accumulated
+// in 16-bit lanes without widening. Partial sums may wrap around, the final sum is exact.
+template<int N>
+static inline __m128i simdInterpolate8bitP8( const int16_t* src, int cStride, const __m128i* vcoeff, const __m128i& voffset )
+{
+  __m128i vsum = voffset;
+  for( int i = 0; i < N; i++ )
+  {
+    vsum = _mm_add_epi16( vsum, _mm_mullo_epi16( _mm_loadu_si128( ( const __m128i* ) &src[i * cStride] ), vcoeff[i] ) );
+  }
+  return vsum;
+}
+
+#ifdef USE_AVX2
+template<int N>
+static inline __m256i simdInterpolate8bitP16( const int16_t* src, int cStride, const __m256i* vcoeff, const __m256i& voffset )
+{
+  __m256i vsum = voffset;
+  for( int i = 0; i < N; i++ )
+  {
+    vsum = _mm256_add_epi16( vsum, _mm256_mullo_epi16( _mm256_loadu_si256( ( const __m256i* ) &src[i * cStride] ), vcoeff[i] ) );
+  }
+  return vsum;
+}
+
+#endif
+// SIMD interpolation of 8-bit samples, horizontal or vertical first stage, block width modulo 8
+template<X86_VEXT vext, int N, bool shiftBack>
+static void simdInterpolate8bitM8( const int16_t* src, int srcStride, int cStride, int16_t *dst, int dstStride, int width, int height, int shift, int offset, const ClpRng& clpRng, int16_t const *coeff )
+{
+  CHECKD( clpRng.bd != 8, "Only 8-bit samples can be filtered in 16-bit lanes" );
+
+  __m128i vcoeff[N];
+  for( int i = 0; i < N; i++ )
+  {
+    vcoeff[i] = _mm_set1_epi16( coeff[i] );
+  }
+  __m128i voffset  = _mm_set1_epi16( offset );
+  __m128i vibdimin = _mm_set1_epi16( clpRng.min );
+  __m128i vibdimax = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  __m256i vcoeff16[N];
+  for( int i = 0; i < N; i++ )
+  {
+    vcoeff16[i] = _mm256_set1_epi16( coeff[i] );
+  }
+  __m256i voffset16  = _mm256_set1_epi16( offset );
+  __m256i vibdimin16 = _mm256_set1_epi16( clpRng.min );
+  __m256i vibdimax16 = _mm256_set1_epi16( clpRng.max );
+#endif
+
+  for( int row = 0; row < height; row++ )
+  {
+    cond_mm_prefetch( (const char*)( src + N * cStride + srcStride ), _MM_HINT_T0 );
+    int col = 0;
+#ifdef USE_AVX2
+    if( vext >= AVX2 )
+    {
+      for( ; col + 16 <= width; col += 16 )
+      {
+        __m256i vsum = simdInterpolate8bitP16<N>( &src[col], cStride, vcoeff16, voffset16 );
+        vsum = _mm256_srai_epi16( vsum, shift );
+
+        if( shiftBack )
+        { //clip
+          vsum = _mm256_min_epi16( vibdimax16, _mm256_max_epi16( vibdimin16, vsum ) );
+        }
+        _mm256_storeu_si256( ( __m256i * )&dst[col], vsum );
+      }
+    }
+#endif
+    for( ; col < width; col += 8 )
+    {
+      __m128i vsum = simdInterpolate8bitP8<N>( &src[col], cStride, vcoeff, voffset );
+      vsum = _mm_srai_epi16( vsum, shift );
+
+      if( shiftBack )
+      { //clip
+        vsum = _mm_min_epi16( vibdimax, _mm_max_epi16( vibdimin, vsum ) );
+      }
+      _mm_storeu_si128( ( __m128i * )&dst[col], vsum );
+    }
+    src += srcStride;
+    dst += dstStride;
+  }
+#if USE_AVX2
+
+  _mm256_zeroupper();
+#endif
+}
+
 template<int N, bool isLast>
 inline void interpolate( const int16_t* src, int cStride, int16_t *dst, int width, int shift, int offset, int bitdepth, int maxVal, int16_t const *c )
 {
@@ -1292,6 +1384,11 @@ static void simdFilter( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
       offset = 1 << (shift - 1);
     }
   }
+  if( clpRng.bd == 8 && isFirst && !biMCForDMVR && N != 2 && !( width & 0x07 ) )
+  {
+    simdInterpolate8bitM8<vext, N, isLast>( src, srcStride, cStride, dst, dstStride, width, height, shift, offset, clpRng, c );
+    return;
+  }
   if( clpRng.bd <= 10 )
   {
     if( N == 8 && !( width & 0x07 ) )
@@ -2020,35 +2117,52 @@ void simdFilter16xX_N8( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
       vcoeffv[i/2] = ( coeffV[i] & 0xffff ) | ( coeffV[i+1] << 16 );
     }
 
+    // 8-bit samples are filtered in 16-bit lanes, the first stage has no shift then
+    const bool is8bit = clpRng.bd == 8;
+    __m256i vcoeffh8[8];
+    __m256i voffset8 = _mm256_set1_epi16( offset1st );
+
+    for( int i = 0; i < 8; i++ )
+    {
+      vcoeffh8[i] = _mm256_set1_epi16( coeffH[i] );
+    }
+
     for( int row = 0; row < extHeight; row++ )
     {
       _mm_prefetch( ( const char* ) ( src + 2 * srcStride ), _MM_HINT_T0 );
       _mm_prefetch( ( const char* ) ( src + ( 16 >> 1 ) + 2 * srcStride ), _MM_HINT_T0 );
       _mm_prefetch( ( const char* ) ( src + 16 + filterSpan + 2 * srcStride ), _MM_HINT_T0 );
 
-      __m256i vsrca0, vsrca1, vsrcb0, vsrcb1;
-      __m256i vsrc0 = _mm256_loadu_si256( ( const __m256i * ) &src[0] );
-      __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i * ) &src[4] );
-
-      vsrca0 = _mm256_shuffle_epi8 ( vsrc0, vshuf0 );
-      vsrca1 = _mm256_shuffle_epi8 ( vsrc0, vshuf1 );  
-      vsrc0  = _mm256_loadu_si256  ( ( const __m256i * ) &src[8] );
-      vsuma  = _mm256_add_epi32    ( _mm256_madd_epi16( vsrca0, _mm256_set1_epi32( vcoeffh[0] ) ), _mm256_madd_epi16( vsrca1, _mm256_set1_epi32( vcoeffh[1] ) ) );
-      vsrcb0 = _mm256_shuffle_epi8 ( vsrc1, vshuf0 );
-      vsrcb1 = _mm256_shuffle_epi8 ( vsrc1, vshuf1 );
-      vsumb  = _mm256_add_epi32    ( _mm256_madd_epi16( vsrcb0, _mm256_set1_epi32( vcoeffh[0] ) ), _mm256_madd_epi16( vsrcb1, _mm256_set1_epi32( vcoeffh[1] ) ) );
-      vsrc1  = _mm256_add_epi32    ( _mm256_madd_epi16( vsrcb0, _mm256_set1_epi32( vcoeffh[2] ) ), _mm256_madd_epi16( vsrcb1, _mm256_set1_epi32( vcoeffh[3] ) ) );
-      vsrca0 = _mm256_shuffle_epi8 ( vsrc0, vshuf0 );
-      vsrca1 = _mm256_shuffle_epi8 ( vsrc0, vshuf1 );
-      vsrc0  = _mm256_add_epi32    ( _mm256_madd_epi16( vsrca0, _mm256_set1_epi32( vcoeffh[2] ) ), _mm256_madd_epi16( vsrca1, _mm256_set1_epi32( vcoeffh[3] ) ) );
-      vsuma  = _mm256_add_epi32    ( vsuma, vsrc1 );
-      vsumb  = _mm256_add_epi32    ( vsumb, vsrc0 );
-
-      vsuma = _mm256_add_epi32  ( vsuma, voffset1 );
-      vsumb = _mm256_add_epi32  ( vsumb, voffset1 );
-      vsuma = _mm256_srai_epi32 ( vsuma, shift1st );
-      vsumb = _mm256_srai_epi32 ( vsumb, shift1st );
-      vsum  = _mm256_packs_epi32( vsuma, vsumb );
+      if( is8bit )
+      {
+        vsum = simdInterpolate8bitP16<8>( src, 1, vcoeffh8, voffset8 );
+      }
+      else
+      {
+        __m256i vsrca0, vsrca1, vsrcb0, vsrcb1;
+        __m256i vsrc0 = _mm256_loadu_si256( ( const __m256i * ) &src[0] );
+        __m256i vsrc1 = _mm256_loadu_si256( ( const __m256i * ) &src[4] );
+
+        vsrca0 = _mm256_shuffle_epi8 ( vsrc0, vshuf0 );
+        vsrca1 = _mm256_shuffle_epi8 ( vsrc0, vshuf1 );  
+        vsrc0  = _mm256_loadu_si256  ( ( const __m256i * ) &src[8] );
+        vsuma  = _mm256_add_epi32    ( _mm256_madd_epi16( vsrca0, _mm256_set1_epi32( vcoeffh[0] ) ), _mm256_madd_epi16( vsrca1, _mm256_set1_epi32( vcoeffh[1] ) ) );
+        vsrcb0 = _mm256_shuffle_epi8 ( vsrc1, vshuf0 );
+        vsrcb1 = _mm256_shuffle_epi8 ( vsrc1, vshuf1 );
+        vsumb  = _mm256_add_epi32    ( _mm256_madd_epi16( vsrcb0, _mm256_set1_epi32( vcoeffh[0] ) ), _mm256_madd_epi16( vsrcb1, _mm256_set1_epi32( vcoeffh[1] ) ) );
+        vsrc1  = _mm256_add_epi32    ( _mm256_madd_epi16( vsrcb0, _mm256_set1_epi32( vcoeffh[2] ) ), _mm256_madd_epi16( vsrcb1, _mm256_set1_epi32( vcoeffh[3] ) ) );
+        vsrca0 = _mm256_shuffle_epi8 ( vsrc0, vshuf0 );
+        vsrca1 = _mm256_shuffle_epi8 ( vsrc0, vshuf1 );
+        vsrc0  = _mm256_add_epi32    ( _mm256_madd_epi16( vsrca0, _mm256_set1_epi32( vcoeffh[2] ) ), _mm256_madd_epi16( vsrca1, _mm256_set1_epi32( vcoeffh[3] ) ) );
+        vsuma  = _mm256_add_epi32    ( vsuma, vsrc1 );
+        vsumb  = _mm256_add_epi32    ( vsumb, vsrc0 );
+
+        vsuma = _mm256_add_epi32  ( vsuma, voffset1 );
+        vsumb = _mm256_add_epi32  ( vsumb, voffset1 );
+        vsuma = _mm256_srai_epi32 ( vsuma, shift1st );
+        vsumb = _mm256_srai_epi32 ( vsumb, shift1st );
+        vsum  = _mm256_packs_epi32( vsuma, vsumb );
+      }
 
       if( row < 7 )
       {
@@ -2096,7 +2210,10 @@ void simdFilter16xX_N8( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
     Pel* tmp = ( Pel* ) alloca( 16 * extHeight * sizeof( Pel ) );
     VALGRIND_MEMCLEAR( tmp );
 
-    simdInterpolateHorM8<vext, 8, false >( src, srcStride, tmp, 16, 16, extHeight, shift1st, offset1st, clpRng, coeffH );
+    if( clpRng.bd == 8 )
+      simdInterpolate8bitM8<vext, 8, false>( src, srcStride, 1, tmp, 16, 16, extHeight, shift1st, offset1st, clpRng, coeffH );
+    else
+      simdInterpolateHorM8<vext, 8, false >( src, srcStride, tmp, 16, 16, extHeight, shift1st, offset1st, clpRng, coeffH );
     simdInterpolateVerM8<vext, 8, isLast>( tmp, 16, dst, dstStride, 16,    height, shift2nd, offset2nd, clpRng, coeffV );
   }
 }
@@ -2137,13 +2254,19 @@ void simdFilter16xX_N4( const ClpRng& clpRng, Pel const *src, int srcStride, Pel
 #if USE_AVX2
   if( vext >= AVX2 )
   {
-    simdInterpolateHorM16_AVX2<vext, 4, false >( src, srcStride, tmp, 16, 16, extHeight, shift1st, offset1st, clpRng, coeffH );
+    if( clpRng.bd == 8 )
+      simdInterpolate8bitM8<vext, 4, false>( src, srcStride, 1, tmp, 16, 16, extHeight, shift1st, offset1st, clpRng, coeffH );
+    else
+      simdInterpolateHorM16_AVX2<vext, 4, false >( src, srcStride, tmp, 16, 16, extHeight, shift1st, offset1st, clpRng, coeffH );
     simdInterpolateVerM16_AVX2<vext, 4, isLast>( tmp, 16, dst, dstStride, 16,    height, shift2nd, offset2nd, clpRng, coeffV );
   }
   else
 #endif
   {
-    simdInterpolateHorM8<vext, 4, false >( src, srcStride, tmp, 16, 16, extHeight, shift1st, offset1st, clpRng, coeffH );
+    if( clpRng.bd == 8 )
+      simdInterpolate8bitM8<vext, 4, false>( src, srcStride, 1, tmp, 16, 16, extHeight, shift1st, offset1st, clpRng, coeffH );
+    else
+      simdInterpolateHorM8<vext, 4, false >( src, srcStride, tmp, 16, 16, extHeight, shift1st, offset1st, clpRng, coeffH );
     simdInterpolateVerM8<vext, 4, isLast>( tmp, 16, dst, dstStride, 16,    height, shift2nd, offset2nd, clpRng, coeffV );
   }
 }
@@ -2204,36 +2327,54 @@ void simdFilter8xX_N8( const ClpRng& clpRng, Pel const *src, int srcStride, Pel*
       vcoeffv[i / 2] = ( coeffV[i] & 0xffff ) | ( coeffV[i + 1] << 16 );
     }
 
+    // 8-bit samples are filtered in 16-bit lanes, the first stage has no shift then
+    const bool is8bit = clpRng.bd == 8;
+    __m128i xcoeffh8[8];
+    __m128i xoffset8 = _mm_set1_epi16( offset1st );
+
+    for( int i = 0; i < 8; i++ )
+    {
+      xcoeffh8[i] = _mm_set1_epi16( coeffH[i] );
+    }
+
     for( int row = 0; row < extHeight; row++ )
     {
       _mm_prefetch( ( const char* ) ( src + 2 * srcStride ), _MM_HINT_T0 );
       _mm_prefetch( ( const char* ) ( src + ( 16 >> 1 ) + 2 * srcStride ), _MM_HINT_T0 );
       _mm_prefetch( ( const char* ) ( src + 16 + filterSpan + 2 * srcStride ), _MM_HINT_T0 );
 
-      __m128i xsrc0 = _mm_loadu_si128( ( const __m128i * ) &src[0] );
-      __m128i xsrc1 = _mm_loadu_si128( ( const __m128i * ) &src[4] );
+      __m128i xsump;
+
+      if( is8bit )
+      {
+        xsump = simdInterpolate8bitP8<8>( src, 1, xcoeffh8, xoffset8 );
+      }
+      else
+      {
+        __m128i xsrc0 = _mm_loadu_si128( ( const __m128i * ) &src[0] );
+        __m128i xsrc1 = _mm_loadu_si128( ( const __m128i * ) &src[4] );
 
-      __m256i vsrc0, vsrca0, vsrca1;
+        __m256i vsrc0, vsrca0, vsrca1;
 
-      vsrc0  = _mm256_castsi128_si256   ( xsrc0 );
-      vsrc0  = _mm256_inserti128_si256  ( vsrc0, xsrc1, 1 );
-      vsrca0 = _mm256_shuffle_epi8      ( vsrc0, vshuf0 );
-      vsrca1 = _mm256_shuffle_epi8      ( vsrc0, vshuf1 );
-      vsum   = _mm256_add_epi32         ( _mm256_madd_epi16( vsrca0, _mm256_set1_epi32( vcoeffh[0] ) ), _mm256_madd_epi16( vsrca1, _mm256_set1_epi32( vcoeffh[1] ) ) );
+        vsrc0  = _mm256_castsi128_si256   ( xsrc0 );
+        vsrc0  = _mm256_inserti128_si256  ( vsrc0, xsrc1, 1 );
+        vsrca0 = _mm256_shuffle_epi8      ( vsrc0, vshuf0 );
+        vsrca1 = _mm256_shuffle_epi8      ( vsrc0, vshuf1 );
+        vsum   = _mm256_add_epi32         ( _mm256_madd_epi16( vsrca0, _mm256_set1_epi32( vcoeffh[0] ) ), _mm256_madd_epi16( vsrca1, _mm256_set1_epi32( vcoeffh[1] ) ) );
       
-      xsrc0  = _mm_loadu_si128          ( (const __m128i *) &src[8] );
+        xsrc0  = _mm_loadu_si128          ( (const __m128i *) &src[8] );
 
-      vsrc0  = _mm256_castsi128_si256   ( xsrc1 );
-      vsrc0  = _mm256_inserti128_si256  ( vsrc0, xsrc0, 1 );
-      vsrca0 = _mm256_shuffle_epi8      ( vsrc0, vshuf0 );
-      vsrca1 = _mm256_shuffle_epi8      ( vsrc0, vshuf1 );
-      vsum   = _mm256_add_epi32         ( vsum, _mm256_add_epi32( _mm256_madd_epi16( vsrca0, _mm256_set1_epi32( vcoeffh[2] ) ), _mm256_madd_epi16( vsrca1, _mm256_set1_epi32( vcoeffh[3] ) ) ) );
+        vsrc0  = _mm256_castsi128_si256   ( xsrc1 );
+        vsrc0  = _mm256_inserti128_si256  ( vsrc0, xsrc0, 1 );
+        vsrca0 = _mm256_shuffle_epi8      ( vsrc0, vshuf0 );
+        vsrca1 = _mm256_shuffle_epi8      ( vsrc0, vshuf1 );
+        vsum   = _mm256_add_epi32         ( vsum, _mm256_add_epi32( _mm256_madd_epi16( vsrca0, _mm256_set1_epi32( vcoeffh[2] ) ), _mm256_madd_epi16( vsrca1, _mm256_set1_epi32( vcoeffh[3] ) ) ) );
 
-      vsum   = _mm256_add_epi32         ( vsum, voffset1 );
-      vsum   = _mm256_srai_epi32        ( vsum, shift1st );
+        vsum   = _mm256_add_epi32         ( vsum, voffset1 );
+        vsum   = _mm256_srai_epi32        ( vsum, shift1st );
 
-      __m128i
-      xsump  = _mm256_cvtepi32_epi16x   ( vsum );
+        xsump  = _mm256_cvtepi32_epi16x   ( vsum );
+      }
 
       if( row < 7 )
       {
@@ -2280,7 +2421,10 @@ void simdFilter8xX_N8( const ClpRng& clpRng, Pel const *src, int srcStride, Pel*
     Pel* tmp = ( Pel* ) alloca( 8 * extHeight * sizeof( Pel ) );
     VALGRIND_MEMCLEAR( tmp );
 
-    simdInterpolateHorM8<vext, 8, false >( src, srcStride, tmp, 8, 8, extHeight, shift1st, offset1st, clpRng, coeffH );
+    if( clpRng.bd == 8 )
+      simdInterpolate8bitM8<vext, 8, false>( src, srcStride, 1, tmp, 8, 8, extHeight, shift1st, offset1st, clpRng, coeffH );
+    else
+      simdInterpolateHorM8<vext, 8, false >( src, srcStride, tmp, 8, 8, extHeight, shift1st, offset1st, clpRng, coeffH );
     simdInterpolateVerM8<vext, 8, isLast>( tmp, 8, dst, dstStride, 8,    height, shift2nd, offset2nd, clpRng, coeffV );
   }
 }
@@ -2346,6 +2490,16 @@ void simdFilter8xX_N4( const ClpRng& clpRng, Pel const *src, int srcStride, Pel*
       vcoeffv[i / 2] = ( coeffV[i] & 0xffff ) | ( coeffV[i + 1] << 16 );
     }
 
+    // 8-bit samples are filtered in 16-bit lanes, the first stage has no shift then
+    const bool is8bit = clpRng.bd == 8;
+    __m128i vcoeffh8[4];
+    __m128i voffset8 = _mm_set1_epi16( offset1st );
+
+    for( int i = 0; i < 4; i++ )
+    {
+      vcoeffh8[i] = _mm_set1_epi16( coeffH[i] );
+    }
+
     __m256i vsum;
 
     for( int row = 0; row < extHeight; row++ )
@@ -2354,22 +2508,31 @@ void simdFilter8xX_N4( const ClpRng& clpRng, Pel const *src, int srcStride, Pel*
       _mm_prefetch( ( const char* ) ( src + ( width >> 1 ) + 2 * srcStride ), _MM_HINT_T0 );
       _mm_prefetch( ( const char* ) ( src + width + filterSpan + 2 * srcStride ), _MM_HINT_T0 );
 
-      __m256i vtmp02, vtmp13;
+      __m128i vsump;
+
+      if( is8bit )
+      {
+        vsump = simdInterpolate8bitP8<4>( src, 1, vcoeffh8, voffset8 );
+      }
+      else
+      {
+        __m256i vtmp02, vtmp13;
 
-      __m256i vsrc = _mm256_castsi128_si256(   _mm_loadu_si128( ( const __m128i* )&src[0] ) );
-      vsrc    = _mm256_inserti128_si256( vsrc, _mm_loadu_si128( ( const __m128i* )&src[4] ), 1 );
+        __m256i vsrc = _mm256_castsi128_si256(   _mm_loadu_si128( ( const __m128i* )&src[0] ) );
+        vsrc    = _mm256_inserti128_si256( vsrc, _mm_loadu_si128( ( const __m128i* )&src[4] ), 1 );
 
-      vtmp02  = _mm256_shuffle_epi8( vsrc, vshuf0 );
-      vtmp13  = _mm256_shuffle_epi8( vsrc, vshuf1 );
+        vtmp02  = _mm256_shuffle_epi8( vsrc, vshuf0 );
+        vtmp13  = _mm256_shuffle_epi8( vsrc, vshuf1 );
 
-      vtmp02  = _mm256_madd_epi16  ( vtmp02, _mm256_set1_epi32( vcoeffh[0] ) );
-      vtmp13  = _mm256_madd_epi16  ( vtmp13, _mm256_set1_epi32( vcoeffh[1] ) );
-      vsum    = _mm256_add_epi32   ( vtmp02, vtmp13 );
+        vtmp02  = _mm256_madd_epi16  ( vtmp02, _mm256_set1_epi32( vcoeffh[0] ) );
+        vtmp13  = _mm256_madd_epi16  ( vtmp13, _mm256_set1_epi32( vcoeffh[1] ) );
+        vsum    = _mm256_add_epi32   ( vtmp02, vtmp13 );
 
-      vsum    = _mm256_add_epi32   ( vsum, voffset1 );
-      vsum    = _mm256_srai_epi32  ( vsum, shift1st );
+        vsum    = _mm256_add_epi32   ( vsum, voffset1 );
+        vsum    = _mm256_srai_epi32  ( vsum, shift1st );
 
-      __m128i vsump = _mm256_cvtepi32_epi16x( vsum );
+        vsump = _mm256_cvtepi32_epi16x( vsum );
+      }
 
       if( row < 3 )
       {
@@ -2416,7 +2579,10 @@ void simdFilter8xX_N4( const ClpRng& clpRng, Pel const *src, int srcStride, Pel*
     Pel* tmp = ( Pel* ) alloca( 8 * extHeight * sizeof( Pel ) );
     VALGRIND_MEMCLEAR( tmp );
 
-    simdInterpolateHorM8<vext, 4, false >( src, srcStride, tmp, 8, 8, extHeight, shift1st, offset1st, clpRng, coeffH );
+    if( clpRng.bd == 8 )
+      simdInterpolate8bitM8<vext, 4, false>( src, srcStride, 1, tmp, 8, 8, extHeight, shift1st, offset1st, clpRng, coeffH );
+    else
+      simdInterpolateHorM8<vext, 4, false >( src, srcStride, tmp, 8, 8, extHeight, shift1st, offset1st, clpRng, coeffH );
     simdInterpolateVerM8<vext, 4, isLast>( tmp, 8, dst, dstStride, 8,    height, shift2nd, offset2nd, clpRng, coeffV );
   }
 }
@@ -457,6 +457,92 @@ void IntraPredAngleLumaCore_SIMD(int16_t* pDstBuf,const ptrdiff_t dstStride,int1
   _mm256_zeroupper();
 #endif
 }
+// 8-bit variant of the luma angular prediction: the 4-tap cubic and smoothing filters applied to 8-bit reference
+// samples, including the rounding offset, stay within 16 bit, so the taps are accumulated in 16-bit lanes
+template< X86_VEXT vext >
+void IntraPredAngleLuma8bitCore_SIMD(int16_t* pDstBuf,const ptrdiff_t dstStride,int16_t* refMain,int width,int height,int deltaPos,int intraPredAngle,const TFilterCoeff *ff_unused,const bool useCubicFilter,const ClpRng& clpRng)
+{
+  CHECKD( clpRng.bd != 8, "Only 8-bit samples can be filtered in 16-bit lanes" );
+  CHECK( width != 4 && ( width & 7 ), "Unsupported size in IntraPredAngleLuma8bitCore_SIMD" );
+
+  __m128i offset = _mm_set1_epi16( 32 );
+  __m128i vbdmin = _mm_set1_epi16( clpRng.min );
+  __m128i vbdmax = _mm_set1_epi16( clpRng.max );
+#ifdef USE_AVX2
+  __m256i offset16 = _mm256_set1_epi16( 32 );
+  __m256i vbdmin16 = _mm256_set1_epi16( clpRng.min );
+  __m256i vbdmax16 = _mm256_set1_epi16( clpRng.max );
+#endif
+
+  for (int y = 0; y<height; y++ )
+  {
+    int deltaInt   = deltaPos >> 5;
+    int deltaFract = deltaPos & (32 - 1);
+
+    const TFilterCoeff      intraSmoothingFilter[4] = {TFilterCoeff(16 - (deltaFract >> 1)), TFilterCoeff(32 - (deltaFract >> 1)), TFilterCoeff(16 + (deltaFract >> 1)), TFilterCoeff(deltaFract >> 1)};
+    const TFilterCoeff *f = useCubicFilter ? InterpolationFilter::getChromaFilterTable(deltaFract) : intraSmoothingFilter;
+
+    const int16_t* ref = &refMain[deltaInt];
+    int16_t* pDst      = &pDstBuf[y*dstStride];
+
+    if( width == 4 )
+    {
+      __m128i sum = offset;
+      for( int i = 0; i < 4; i++ )
+      {
+        sum = _mm_add_epi16( sum, _mm_mullo_epi16( _mm_loadl_epi64( ( __m128i const * )&ref[i] ), _mm_set1_epi16( f[i] ) ) );
+      }
+      sum = _mm_srai_epi16( sum, 6 );
+
+      if (useCubicFilter)
+        sum = _mm_min_epi16( vbdmax, _mm_max_epi16( vbdmin, sum ) );
+
+      _mm_storel_epi64( ( __m128i * )(pDst), sum );
+    }
+    else
+    {
+      int x = 0;
+#ifdef USE_AVX2
+      if( vext >= AVX2 )
+      {
+        for( ; x + 16 <= width; x += 16 )
+        {
+          __m256i sum = offset16;
+          for( int i = 0; i < 4; i++ )
+          {
+            sum = _mm256_add_epi16( sum, _mm256_mullo_epi16( _mm256_loadu_si256( ( __m256i const * )&ref[x + i] ), _mm256_set1_epi16( f[i] ) ) );
+          }
+          sum = _mm256_srai_epi16( sum, 6 );
+
+          if (useCubicFilter)
+            sum = _mm256_min_epi16( vbdmax16, _mm256_max_epi16( vbdmin16, sum ) );
+
+          _mm256_storeu_si256( ( __m256i * )(pDst + x), sum );
+        }
+      }
+#endif
+      for( ; x < width; x += 8 )
+      {
+        __m128i sum = offset;
+        for( int i = 0; i < 4; i++ )
+        {
+          sum = _mm_add_epi16( sum, _mm_mullo_epi16( _mm_loadu_si128( ( __m128i const * )&ref[x + i] ), _mm_set1_epi16( f[i] ) ) );
+        }
+        sum = _mm_srai_epi16( sum, 6 );
+
+        if (useCubicFilter)
+          sum = _mm_min_epi16( vbdmax, _mm_max_epi16( vbdmin, sum ) );
+
+        _mm_storeu_si128( ( __m128i * )(pDst + x), sum );
+      }
+    }
+    deltaPos += intraPredAngle;
+  }
+#if USE_AVX2
+  _mm256_zeroupper();
+#endif
+}
+
 #define _mm_storeu_si32(p, a) (void)(*(int*)(p) = _mm_cvtsi128_si32((a)))
 #define _mm_loadu_si64(p) _mm_loadl_epi64((__m128i const*)(p))
 #define _mm_loadu_si32(p) _mm_cvtsi32_si128(*(unsigned int const*)(p))
@@ -1424,16 +1510,16 @@ void IntraHorVerPDPC_SIMD(Pel* pDsty,const int dstStride,Pel* refSide,const int
 
 
 template<X86_VEXT vext>
-void IntraPrediction::_initIntraPredictionX86()
+void IntraPrediction::_initIntraPredictionX86( const unsigned bitDepthY )
 {
-  IntraPredAngleLuma    = IntraPredAngleLumaCore_SIMD<vext>;
+  IntraPredAngleLuma    = bitDepthY == 8 ? IntraPredAngleLuma8bitCore_SIMD<vext> : IntraPredAngleLumaCore_SIMD<vext>;
   IntraPredAngleChroma  = IntraPredAngleChroma_SIMD<vext>;
   IntraAnglePDPC        = IntraAnglePDPC_SIMD<vext>;
   IntraHorVerPDPC       = IntraHorVerPDPC_SIMD<vext>;
   IntraPredSampleFilter = IntraPredSampleFilter_SIMD<vext>;
   xPredIntraPlanar      = xPredIntraPlanar_SIMD<vext>;
 }
-template void IntraPrediction::_initIntraPredictionX86<SIMDX86>();
+template void IntraPrediction::_initIntraPredictionX86<SIMDX86>( const unsigned bitDepthY );
 
 } // namespace vvenc
 
@@ -639,6 +639,210 @@ static uint32_t xCalcHAD8x8_SSE( const Torg *piOrg, const Tcur *piCur, const int
 }
 
 
+//8-bit samples only: the differences of two 8x8 blocks fit into 10 bit, so the whole transform stays within 16-bit lanes
+static inline void xHAD8x8Butterflies_SSE( __m128i* m1, __m128i* m2 )
+{
+  m1[0] = _mm_add_epi16( m2[0], m2[4] );
+  m1[1] = _mm_add_epi16( m2[1], m2[5] );
+  m1[2] = _mm_add_epi16( m2[2], m2[6] );
+  m1[3] = _mm_add_epi16( m2[3], m2[7] );
+  m1[4] = _mm_sub_epi16( m2[0], m2[4] );
+  m1[5] = _mm_sub_epi16( m2[1], m2[5] );
+  m1[6] = _mm_sub_epi16( m2[2], m2[6] );
+  m1[7] = _mm_sub_epi16( m2[3], m2[7] );
+
+  m2[0] = _mm_add_epi16( m1[0], m1[2] );
+  m2[1] = _mm_add_epi16( m1[1], m1[3] );
+  m2[2] = _mm_sub_epi16( m1[0], m1[2] );
+  m2[3] = _mm_sub_epi16( m1[1], m1[3] );
+  m2[4] = _mm_add_epi16( m1[4], m1[6] );
+  m2[5] = _mm_add_epi16( m1[5], m1[7] );
+  m2[6] = _mm_sub_epi16( m1[4], m1[6] );
+  m2[7] = _mm_sub_epi16( m1[5], m1[7] );
+
+  m1[0] = _mm_add_epi16( m2[0], m2[1] );
+  m1[1] = _mm_sub_epi16( m2[0], m2[1] );
+  m1[2] = _mm_add_epi16( m2[2], m2[3] );
+  m1[3] = _mm_sub_epi16( m2[2], m2[3] );
+  m1[4] = _mm_add_epi16( m2[4], m2[5] );
+  m1[5] = _mm_sub_epi16( m2[4], m2[5] );
+  m1[6] = _mm_add_epi16( m2[6], m2[7] );
+  m1[7] = _mm_sub_epi16( m2[6], m2[7] );
+}
+
+static inline void xTranspose8x8_16bit_SSE( __m128i* m1, __m128i* m2 )
+{
+  m2[0] = _mm_unpacklo_epi16( m1[0], m1[1] );
+  m2[1] = _mm_unpackhi_epi16( m1[0], m1[1] );
+  m2[2] = _mm_unpacklo_epi16( m1[2], m1[3] );
+  m2[3] = _mm_unpackhi_epi16( m1[2], m1[3] );
+  m2[4] = _mm_unpacklo_epi16( m1[4], m1[5] );
+  m2[5] = _mm_unpackhi_epi16( m1[4], m1[5] );
+  m2[6] = _mm_unpacklo_epi16( m1[6], m1[7] );
+  m2[7] = _mm_unpackhi_epi16( m1[6], m1[7] );
+
+  m1[0] = _mm_unpacklo_epi32( m2[0], m2[2] );
+  m1[1] = _mm_unpackhi_epi32( m2[0], m2[2] );
+  m1[2] = _mm_unpacklo_epi32( m2[1], m2[3] );
+  m1[3] = _mm_unpackhi_epi32( m2[1], m2[3] );
+  m1[4] = _mm_unpacklo_epi32( m2[4], m2[6] );
+  m1[5] = _mm_unpackhi_epi32( m2[4], m2[6] );
+  m1[6] = _mm_unpacklo_epi32( m2[5], m2[7] );
+  m1[7] = _mm_unpackhi_epi32( m2[5], m2[7] );
+
+  m2[0] = _mm_unpacklo_epi64( m1[0], m1[4] );
+  m2[1] = _mm_unpackhi_epi64( m1[0], m1[4] );
+  m2[2] = _mm_unpacklo_epi64( m1[1], m1[5] );
+  m2[3] = _mm_unpackhi_epi64( m1[1], m1[5] );
+  m2[4] = _mm_unpacklo_epi64( m1[2], m1[6] );
+  m2[5] = _mm_unpackhi_epi64( m1[2], m1[6] );
+  m2[6] = _mm_unpacklo_epi64( m1[3], m1[7] );
+  m2[7] = _mm_unpackhi_epi64( m1[3], m1[7] );
+}
+
+static uint32_t xCalcHAD8x8_8bit_SSE( const Torg *piOrg, const Tcur *piCur, const int iStrideOrg, const int iStrideCur )
+{
+  __m128i m1[8], m2[8];
+
+  for( int k = 0; k < 8; k++ )
+  {
+    m2[k] = _mm_sub_epi16( _mm_loadu_si128( ( const __m128i* ) piOrg ), _mm_lddqu_si128( ( const __m128i* ) piCur ) );
+    piCur += iStrideCur;
+    piOrg += iStrideOrg;
+  }
+
+  // vertical, transpose, horizontal
+  xHAD8x8Butterflies_SSE ( m1, m2 );
+  xTranspose8x8_16bit_SSE( m1, m2 );
+  xHAD8x8Butterflies_SSE ( m1, m2 );
+
+  const __m128i vone = _mm_set1_epi16( 1 );
+  __m128i iSum = _mm_setzero_si128();
+  for( int i = 0; i < 8; i++ )
+  {
+    m1[i] = _mm_abs_epi16( m1[i] );
+    iSum  = _mm_add_epi32( iSum, _mm_madd_epi16( m1[i], vone ) );
+  }
+  iSum = _mm_hadd_epi32( iSum, iSum );
+  iSum = _mm_hadd_epi32( iSum, iSum );
+
+  uint32_t sad   = _mm_cvtsi128_si32( iSum );
+  uint32_t absDc = _mm_extract_epi16( m1[0], 0 );
+  sad -= absDc;
+  sad += absDc >> 2;
+  sad = ( ( sad + 2 ) >> 2 );
+
+  return sad;
+}
+
+#ifdef USE_AVX2
+static inline void xHAD8x8Butterflies_AVX2( __m256i* m1, __m256i* m2 )
+{
+  m1[0] = _mm256_add_epi16( m2[0], m2[4] );
+  m1[1] = _mm256_add_epi16( m2[1], m2[5] );
+  m1[2] = _mm256_add_epi16( m2[2], m2[6] );
+  m1[3] = _mm256_add_epi16( m2[3], m2[7] );
+  m1[4] = _mm256_sub_epi16( m2[0], m2[4] );
+  m1[5] = _mm256_sub_epi16( m2[1], m2[5] );
+  m1[6] = _mm256_sub_epi16( m2[2], m2[6] );
+  m1[7] = _mm256_sub_epi16( m2[3], m2[7] );
+
+  m2[0] = _mm256_add_epi16( m1[0], m1[2] );
+  m2[1] = _mm256_add_epi16( m1[1], m1[3] );
+  m2[2] = _mm256_sub_epi16( m1[0], m1[2] );
+  m2[3] = _mm256_sub_epi16( m1[1], m1[3] );
+  m2[4] = _mm256_add_epi16( m1[4], m1[6] );
+  m2[5] = _mm256_add_epi16( m1[5], m1[7] );
+  m2[6] = _mm256_sub_epi16( m1[4], m1[6] );
+  m2[7] = _mm256_sub_epi16( m1[5], m1[7] );
+
+  m1[0] = _mm256_add_epi16( m2[0], m2[1] );
+  m1[1] = _mm256_sub_epi16( m2[0], m2[1] );
+  m1[2] = _mm256_add_epi16( m2[2], m2[3] );
+  m1[3] = _mm256_sub_epi16( m2[2], m2[3] );
+  m1[4] = _mm256_add_epi16( m2[4], m2[5] );
+  m1[5] = _mm256_sub_epi16( m2[4], m2[5] );
+  m1[6] = _mm256_add_epi16( m2[6], m2[7] );
+  m1[7] = _mm256_sub_epi16( m2[6], m2[7] );
+}
+
+static inline void xTranspose8x8_16bit_AVX2( __m256i* m1, __m256i* m2 )
+{
+  // the unpack instructions work within 128-bit lanes, i.e. on two 8x8 blocks at once
+  m2[0] = _mm256_unpacklo_epi16( m1[0], m1[1] );
+  m2[1] = _mm256_unpackhi_epi16( m1[0], m1[1] );
+  m2[2] = _mm256_unpacklo_epi16( m1[2], m1[3] );
+  m2[3] = _mm256_unpackhi_epi16( m1[2], m1[3] );
+  m2[4] = _mm256_unpacklo_epi16( m1[4], m1[5] );
+  m2[5] = _mm256_unpackhi_epi16( m1[4], m1[5] );
+  m2[6] = _mm256_unpacklo_epi16( m1[6], m1[7] );
+  m2[7] = _mm256_unpackhi_epi16( m1[6], m1[7] );
+
+  m1[0] = _mm256_unpacklo_epi32( m2[0], m2[2] );
+  m1[1] = _mm256_unpackhi_epi32( m2[0], m2[2] );
+  m1[2] = _mm256_unpacklo_epi32( m2[1], m2[3] );
+  m1[3] = _mm256_unpackhi_epi32( m2[1], m2[3] );
+  m1[4] = _mm256_unpacklo_epi32( m2[4], m2[6] );
+  m1[5] = _mm256_unpackhi_epi32( m2[4], m2[6] );
+  m1[6] = _mm256_unpacklo_epi32( m2[5], m2[7] );
+  m1[7] = _mm256_unpackhi_epi32( m2[5], m2[7] );
+
+  m2[0] = _mm256_unpacklo_epi64( m1[0], m1[4] );
+  m2[1] = _mm256_unpackhi_epi64( m1[0], m1[4] );
+  m2[2] = _mm256_unpacklo_epi64( m1[1], m1[5] );
+  m2[3] = _mm256_unpackhi_epi64( m1[1], m1[5] );
+  m2[4] = _mm256_unpacklo_epi64( m1[2], m1[6] );
+  m2[5] = _mm256_unpackhi_epi64( m1[2], m1[6] );
+  m2[6] = _mm256_unpacklo_epi64( m1[3], m1[7] );
+  m2[7] = _mm256_unpackhi_epi64( m1[3], m1[7] );
+}
+#endif
+
+//8-bit samples only: two horizontally adjacent 8x8 SATDs, equal to one half of xCalcHAD16x16_AVX2
+static uint32_t xCalcHAD2x8x8_8bit_AVX2( const Torg *piOrg, const Tcur *piCur, const int iStrideOrg, const int iStrideCur )
+{
+  uint32_t sad = 0;
+
+#ifdef USE_AVX2
+  __m256i m1[8], m2[8];
+
+  for( int k = 0; k < 8; k++ )
+  {
+    m2[k] = _mm256_sub_epi16( _mm256_lddqu_si256( ( const __m256i* ) piOrg ), _mm256_lddqu_si256( ( const __m256i* ) piCur ) );
+    piCur += iStrideCur;
+    piOrg += iStrideOrg;
+  }
+
+  xHAD8x8Butterflies_AVX2 ( m1, m2 );
+  xTranspose8x8_16bit_AVX2( m1, m2 );
+  xHAD8x8Butterflies_AVX2 ( m1, m2 );
+
+  const __m256i vone = _mm256_set1_epi16( 1 );
+  __m256i iSum = _mm256_setzero_si256();
+  for( int i = 0; i < 8; i++ )
+  {
+    m1[i] = _mm256_abs_epi16( m1[i] );
+    iSum  = _mm256_add_epi32( iSum, _mm256_madd_epi16( m1[i], vone ) );
+  }
+  iSum = _mm256_hadd_epi32( iSum, iSum );
+  iSum = _mm256_hadd_epi32( iSum, iSum );
+
+  // the extract indices have to be immediates, also in unoptimized builds
+  const uint32_t sum[2]   = { ( uint32_t ) _mm256_extract_epi32( iSum, 0 ), ( uint32_t ) _mm256_extract_epi32( iSum, 4 ) };
+  const uint32_t absDc[2] = { ( uint32_t ) _mm256_extract_epi16( m1[0], 0 ), ( uint32_t ) _mm256_extract_epi16( m1[0], 8 ) };
+  for( int b = 0; b < 2; b++ )
+  {
+    uint32_t tmp = sum[b];
+    tmp -= absDc[b];
+    tmp += absDc[b] >> 2;
+    tmp = ( ( tmp + 2 ) >> 2 );
+    sad += tmp;
+  }
+
+#endif
+  return ( sad );
+}
+
 //working up to 12-bit
 static uint32_t xCalcHAD16x8_SSE( const Torg *piOrg, const Tcur *piCur, const int iStrideOrg, const int iStrideCur, const int iBitDepth )
 {
@@ -2262,6 +2466,52 @@ Distortion RdCost::xGetHADs_SIMD( const DistParam &rcDtParam )
   return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
 }
 
+template<X86_VEXT vext >
+Distortion RdCost::xGetHADs8bit_SIMD( const DistParam &rcDtParam )
+{
+  const int iRows = rcDtParam.org.height;
+  const int iCols = rcDtParam.org.width;
+
+  // the rectangular transforms keep their 32-bit implementation, they would not fit into 16-bit lanes
+  if( iRows != iCols || ( iRows & 7 ) != 0 )
+  {
+    return xGetHADs_SIMD<vext>( rcDtParam );
+  }
+
+  const Pel*  piOrg = rcDtParam.org.buf;
+  const Pel*  piCur = rcDtParam.cur.buf;
+  const int iStrideCur = rcDtParam.cur.stride;
+  const int iStrideOrg = rcDtParam.org.stride;
+
+  Distortion uiSum = 0;
+  if( vext >= AVX2 && ( iCols & 15 ) == 0 )
+  {
+    for( int y = 0; y < iRows; y += 8 )
+    {
+      for( int x = 0; x < iCols; x += 16 )
+      {
+        uiSum += xCalcHAD2x8x8_8bit_AVX2( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += 8*iStrideOrg;
+      piCur += 8*iStrideCur;
+    }
+  }
+  else
+  {
+    for( int y = 0; y < iRows; y += 8 )
+    {
+      for( int x = 0; x < iCols; x += 8 )
+      {
+        uiSum += xCalcHAD8x8_8bit_SSE( &piOrg[x], &piCur[x], iStrideOrg, iStrideCur );
+      }
+      piOrg += 8*iStrideOrg;
+      piCur += 8*iStrideCur;
+    }
+  }
+
+  return uiSum >> DISTORTION_PRECISION_ADJUSTMENT(rcDtParam.bitDepth);
+}
+
 template <X86_VEXT vext>
 void RdCost::_initRdCostX86()
 {
@@ -2297,6 +2547,15 @@ void RdCost::_initRdCostX86()
 
   m_afpDistortFunc[0][DF_HAD_2SAD ] = RdCost::xGetHAD2SADs_SIMD<vext>;
   m_afpDistortFunc[0][DF_SAD_WITH_MASK] = xGetSADwMask_SIMD<vext>;
+
+  // 8-bit internal sample range: square SATDs in 16-bit lanes, everything else as above
+  memcpy( m_afpDistortFunc[2], m_afpDistortFunc[0], sizeof( m_afpDistortFunc[0] ) );
+  m_afpDistortFunc[2][DF_HAD]     = RdCost::xGetHADs8bit_SIMD<vext>;
+  m_afpDistortFunc[2][DF_HAD8]    = RdCost::xGetHADs8bit_SIMD<vext>;
+  m_afpDistortFunc[2][DF_HAD16]   = RdCost::xGetHADs8bit_SIMD<vext>;
+  m_afpDistortFunc[2][DF_HAD32]   = RdCost::xGetHADs8bit_SIMD<vext>;
+  m_afpDistortFunc[2][DF_HAD64]   = RdCost::xGetHADs8bit_SIMD<vext>;
+  m_afpDistortFunc[2][DF_HAD128]  = RdCost::xGetHADs8bit_SIMD<vext>;
 }
 
 template void RdCost::_initRdCostX86<SIMDX86>();
@@ -94,6 +94,7 @@ bool tryDecodePicture( Picture* pcEncPic, const int expectedPoc, const std::stri
       ffwdDecoder.pcDecLib->setDebugPOC                    ( debugPOC );
       ffwdDecoder.pcDecLib->setDecodedPictureHashSEIEnabled( true );
       ffwdDecoder.pcDecLib->setAPSMapEnc                   ( &apsMap );
+      ffwdDecoder.pcDecLib->setPicBufPool                  ( ffwdDecoder.picBufPool );
 
       msg( INFO, "start to decode %s \n", bitstreamFileName.c_str() );
     }
@@ -407,10 +408,14 @@ DecLib::DecLib()
   , m_maxDecSubPicIdx(0)
   , m_maxDecSliceAddrInSubPic(-1)
   , m_apsMapEnc( nullptr )
+  , m_picBufPool( nullptr )
 {
 #if ENABLE_SIMD_OPT_BUFFER
   g_pelBufOP.initPelBufOpsX86();
 #endif
+#if ENABLE_SIMD_OPT_BITSTREAM && defined( TARGET_SIMD_X86 )
+  g_bitstreamOps.initBitstreamOpsX86();
+#endif
 #if ENABLE_SIMD_TRAFO
   g_tCoeffOps.initTCoeffOps();
 #endif
@@ -468,6 +473,7 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
   if (m_cListPic.size() < (uint32_t)m_iMaxRefPicNum)
   {
     pic = new Picture();
+    pic->bufPool = m_picBufPool;
 
     pic->create( sps.chromaFormatIdc, Size( pps.picWidthInLumaSamples, pps.picHeightInLumaSamples ), sps.CTUSize, sps.CTUSize + 16, true, layerId );
 
@@ -502,6 +508,7 @@ Picture* DecLib::xGetNewPicBuffer ( const SPS &sps, const PPS &pps, const uint32
     m_iMaxRefPicNum++;
 
     pic = new Picture();
+    pic->bufPool = m_picBufPool;
 
     m_cListPic.push_back( pic );
 
@@ -1479,8 +1486,8 @@ bool DecLib::xDecodeSlice(InputNALUnit &nalu, int& iSkipFrame, int iPOCLastDispl
 
   if( m_bFirstSliceInPicture )
   {
-    m_pic->cs->getLoopFilterParamBuf( EDGE_VER ).memset( 0 );
-    m_pic->cs->getLoopFilterParamBuf( EDGE_HOR ).memset( 0 );
+    m_pic->cs->getLFPMap( EDGE_VER ).clear();
+    m_pic->cs->getLFPMap( EDGE_HOR ).clear();
   }
 
 
@@ -147,6 +147,7 @@ private:
   int                     m_maxDecSubPicIdx;
   int                     m_maxDecSliceAddrInSubPic;
   ParameterSetMap<APS>*   m_apsMapEnc;
+  PelStoragePool*         m_picBufPool;
 
 public:
   int                     m_targetSubPicIdx;
@@ -192,6 +193,7 @@ public:
   int   getPreScalingListAPSId() { return m_PreScalingListAPSId; }
   void  setPreScalingListAPSId(int id) { m_PreScalingListAPSId = id; }
   void  setAPSMapEnc( ParameterSetMap<APS>* apsMap ) { m_apsMapEnc = apsMap;  }
+  void  setPicBufPool( PelStoragePool* pool )        { m_picBufPool = pool; }
   bool  isNewPicture( std::ifstream *bitstreamFile, class InputByteStream *bytestream );
   bool  isNewAccessUnit( bool newPicture, std::ifstream *bitstreamFile, class InputByteStream *bytestream );
 
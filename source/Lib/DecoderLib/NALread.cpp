@@ -54,6 +54,7 @@ vvc@hhi.fraunhofer.de
 #include <vector>
 #include <algorithm>
 #include <ostream>
+#include <cstring>
 #include "../../../include/vvenc/Nal.h"
 
 //! \ingroup DecoderLib
@@ -64,27 +65,45 @@ namespace vvenc {
 static void convertPayloadToRBSP(std::vector<uint8_t>& nalUnitBuf, InputBitstream *bitstream, bool isVclNalUnit)
 {
   uint32_t zeroCount = 0;
-  std::vector<uint8_t>::iterator it_read, it_write;
+  uint8_t* buf       = nalUnitBuf.data();
+  const size_t size  = nalUnitBuf.size();
+  size_t   read      = 0;
+  size_t   write     = 0;
 
-  uint32_t pos = 0;
   bitstream->clearEmulationPreventionByteLocation();
-  for (it_read = it_write = nalUnitBuf.begin(); it_read != nalUnitBuf.end(); it_read++, it_write++, pos++)
+  while (read < size)
   {
-    CHECK(zeroCount >= 2 && *it_read < 0x03, "Zero count is '2' and read value is small than '3'");
-    if (zeroCount == 2 && *it_read == 0x03)
+    if (zeroCount == 0)
     {
-      bitstream->pushEmulationPreventionByteLocation( pos );
-      pos++;
-      it_read++;
+      // there is no emulation_prevention_three_byte before the next pair of zero bytes, move up to there at once
+      const size_t next = g_bitstreamOps.findZeroPair(buf, read, size);
+      if (next > read)
+      {
+        zeroCount = buf[next - 1] == 0x00 ? 1 : 0;
+        if (write != read)
+        {
+          memmove(buf + write, buf + read, next - read);
+        }
+        write += next - read;
+        read   = next;
+        continue;
+      }
+    }
+
+    CHECK(zeroCount >= 2 && buf[read] < 0x03, "Zero count is '2' and read value is small than '3'");
+    if (zeroCount == 2 && buf[read] == 0x03)
+    {
+      bitstream->pushEmulationPreventionByteLocation( uint32_t( read ) );
+      read++;
       zeroCount = 0;
-      if (it_read == nalUnitBuf.end())
+      if (read == size)
       {
         break;
       }
-      CHECK(*it_read > 0x03, "Read a value bigger than '3'");
+      CHECK(buf[read] > 0x03, "Read a value bigger than '3'");
     }
-    zeroCount = (*it_read == 0x00) ? zeroCount+1 : 0;
-    *it_write = *it_read;
+    zeroCount = (buf[read] == 0x00) ? zeroCount+1 : 0;
+    buf[write++] = buf[read++];
   }
   CHECK(zeroCount != 0, "Zero count not '0'");
 
@@ -93,9 +112,9 @@ static void convertPayloadToRBSP(std::vector<uint8_t>& nalUnitBuf, InputBitstrea
     // Remove cabac_zero_word from payload if present
     int n = 0;
 
-    while (it_write[-1] == 0x00)
+    while (write > 0 && buf[write - 1] == 0x00)
     {
-      it_write--;
+      write--;
       n++;
     }
 
@@ -105,7 +124,7 @@ static void convertPayloadToRBSP(std::vector<uint8_t>& nalUnitBuf, InputBitstrea
     }
   }
 
-  nalUnitBuf.resize(it_write - nalUnitBuf.begin());
+  nalUnitBuf.resize(write);
 }
 
 #if ENABLE_TRACING
@@ -123,7 +123,7 @@ void SEIReader::parseSEImessage(InputBitstream* bs, SEIMessages& seis, const Nal
   CHECK(m_pcBitstream->getNumBitsUntilByteAligned(), "Bitstream not aligned");
   do
   {
-    xReadSEImessage(seis, nalUnitType, sps, pDecodedMessageOutputStream);
+    xReadSEImessage(seis, nalUnitType, temporalId, sps, pDecodedMessageOutputStream);
 
     /* SEI messages are an integer number of bytes, something has failed
     * in the parsing if bitstream not byte-aligned */
@@ -134,7 +134,7 @@ void SEIReader::parseSEImessage(InputBitstream* bs, SEIMessages& seis, const Nal
   xReadRbspTrailingBits();
 }
 
-void SEIReader::xReadSEImessage(SEIMessages& seis, const NalUnitType nalUnitType, const SPS *sps, std::ostream *pDecodedMessageOutputStream)
+void SEIReader::xReadSEImessage(SEIMessages& seis, const NalUnitType nalUnitType, const uint32_t temporalId, const SPS *sps, std::ostream *pDecodedMessageOutputStream)
 {
 #if ENABLE_TRACING
   xTraceSEIHeader();
@@ -194,25 +194,23 @@ void SEIReader::xReadSEImessage(SEIMessages& seis, const NalUnitType nalUnitType
       }
       break;
     case SEI::BUFFERING_PERIOD:
-      if (!sps)
-      {
-        msg( WARNING, "Warning: Found Buffering period SEI message, but no active SPS is available. Ignoring.");
-      }
-      else
       {
-        sei = new SEIBufferingPeriod;
-        xParseSEIBufferingPeriod((SEIBufferingPeriod&) *sei, payloadSize, sps, pDecodedMessageOutputStream);
+        SEIBufferingPeriod* bp = new SEIBufferingPeriod;
+        xParseSEIBufferingPeriod(*bp, payloadSize, pDecodedMessageOutputStream);
+        bp->copyTo( m_bufferingPeriod );
+        m_bufferingPeriodAvailable = true;
+        sei = bp;
       }
       break;
     case SEI::PICTURE_TIMING:
-      if (!sps)
+      if (!m_bufferingPeriodAvailable)
       {
-        msg( WARNING, "Warning: Found Picture timing SEI message, but no active SPS is available. Ignoring.");
+        msg( WARNING, "Warning: Found Picture timing SEI message, but no active buffering period is available. Ignoring.");
       }
       else
       {
         sei = new SEIPictureTiming;
-        xParseSEIPictureTiming((SEIPictureTiming&)*sei, payloadSize, sps, pDecodedMessageOutputStream);
+        xParseSEIPictureTiming((SEIPictureTiming&)*sei, payloadSize, temporalId, m_bufferingPeriod, pDecodedMessageOutputStream);
       }
       break;
     case SEI::RECOVERY_POINT:
@@ -253,7 +251,7 @@ void SEIReader::xReadSEImessage(SEIMessages& seis, const NalUnitType nalUnitType
       break;
     case SEI::SCALABLE_NESTING:
       sei = new SEIScalableNesting;
-      xParseSEIScalableNesting((SEIScalableNesting&) *sei, nalUnitType, payloadSize, sps, pDecodedMessageOutputStream);
+      xParseSEIScalableNesting((SEIScalableNesting&) *sei, nalUnitType, temporalId, payloadSize, sps, pDecodedMessageOutputStream);
       break;
     case SEI::TEMP_MOTION_CONSTRAINED_TILE_SETS:
       sei = new SEITempMotionConstrainedTileSets;
@@ -478,14 +476,171 @@ void SEIReader::xParseSEIDecodingUnitInfo(SEIDecodingUnitInfo& sei, uint32_t pay
   THROW("no support");
 }
 
-void SEIReader::xParseSEIBufferingPeriod(SEIBufferingPeriod& sei, uint32_t payloadSize, const SPS *sps, std::ostream *pDecodedMessageOutputStream)
+void SEIReader::xParseSEIBufferingPeriod(SEIBufferingPeriod& sei, uint32_t payloadSize, std::ostream *pDecodedMessageOutputStream)
 {
-  THROW("no support");
+  uint32_t code;
+  output_sei_message_header(sei, pDecodedMessageOutputStream, payloadSize);
+
+  sei_read_flag( pDecodedMessageOutputStream, code, "bp_nal_hrd_parameters_present_flag" );             sei.m_bpNalCpbParamsPresent = code;
+  sei_read_flag( pDecodedMessageOutputStream, code, "bp_vcl_hrd_parameters_present_flag" );             sei.m_bpVclCpbParamsPresent = code;
+
+  sei_read_code( pDecodedMessageOutputStream, 5, code, "bp_cpb_initial_removal_delay_length_minus1" );  sei.m_initialCpbRemovalDelayLength = code + 1;
+  sei_read_code( pDecodedMessageOutputStream, 5, code, "bp_cpb_removal_delay_length_minus1" );          sei.m_cpbRemovalDelayLength        = code + 1;
+  sei_read_code( pDecodedMessageOutputStream, 5, code, "bp_dpb_output_delay_length_minus1" );           sei.m_dpbOutputDelayLength         = code + 1;
+  sei_read_flag( pDecodedMessageOutputStream, code, "bp_du_hrd_params_present_flag" );                  sei.m_bpDecodingUnitHrdParamsPresent = code;
+  if( sei.m_bpDecodingUnitHrdParamsPresent )
+  {
+    sei_read_code( pDecodedMessageOutputStream, 5, code, "bp_du_cpb_removal_delay_increment_length_minus1" ); sei.m_duCpbRemovalDelayIncrementLength = code + 1;
+    sei_read_code( pDecodedMessageOutputStream, 5, code, "bp_dpb_output_delay_du_length_minus1" );      sei.m_dpbOutputDelayDuLength = code + 1;
+    sei_read_flag( pDecodedMessageOutputStream, code, "bp_du_cpb_params_in_pic_timing_sei_flag" );      sei.m_decodingUnitCpbParamsInPicTimingSeiFlag = code;
+    sei_read_flag( pDecodedMessageOutputStream, code, "bp_du_dpb_params_in_pic_timing_sei_flag" );      sei.m_decodingUnitDpbDuParamsInPicTimingSeiFlag = code;
+  }
+  else
+  {
+    sei.m_duCpbRemovalDelayIncrementLength = 24;
+    sei.m_dpbOutputDelayDuLength = 24;
+    sei.m_decodingUnitDpbDuParamsInPicTimingSeiFlag = false;
+  }
+
+  sei_read_flag( pDecodedMessageOutputStream, code, "bp_concatenation_flag" );                          sei.m_concatenationFlag = code;
+  sei_read_flag( pDecodedMessageOutputStream, code, "bp_additional_concatenation_info_present_flag" );  sei.m_additionalConcatenationInfoPresent = code;
+  if( sei.m_additionalConcatenationInfoPresent )
+  {
+    sei_read_code( pDecodedMessageOutputStream, sei.m_initialCpbRemovalDelayLength, code, "bp_max_initial_removal_delay_for_concatenation" ); sei.m_maxInitialRemovalDelayForConcatenation = code;
+  }
+
+  sei_read_code( pDecodedMessageOutputStream, sei.m_cpbRemovalDelayLength, code, "bp_cpb_removal_delay_delta_minus1" ); sei.m_auCpbRemovalDelayDelta = code + 1;
+  sei_read_code( pDecodedMessageOutputStream, 3, code, "bp_max_sublayers_minus1" );                     sei.m_bpMaxSubLayers = code + 1;
+  if( sei.m_bpMaxSubLayers - 1 > 0 )
+  {
+    sei_read_flag( pDecodedMessageOutputStream, code, "bp_cpb_removal_delay_deltas_present_flag" );     sei.m_cpbRemovalDelayDeltasPresent = code;
+  }
+  else
+  {
+    sei.m_cpbRemovalDelayDeltasPresent = false;
+  }
+  if( sei.m_cpbRemovalDelayDeltasPresent )
+  {
+    sei_read_uvlc( pDecodedMessageOutputStream, code, "bp_num_cpb_removal_delay_deltas_minus1" );       sei.m_numCpbRemovalDelayDeltas = code + 1;
+    CHECK( sei.m_numCpbRemovalDelayDeltas > 15, "bp_num_cpb_removal_delay_deltas_minus1 out of range" );
+    for( int i = 0; i < sei.m_numCpbRemovalDelayDeltas; i++ )
+    {
+      sei_read_code( pDecodedMessageOutputStream, sei.m_cpbRemovalDelayLength, code, "bp_cpb_removal_delay_delta_val[i]" ); sei.m_cpbRemovalDelayDelta[i] = code;
+    }
+  }
+  sei_read_uvlc( pDecodedMessageOutputStream, code, "bp_cpb_cnt_minus1" );                              sei.m_bpCpbCnt = code + 1;
+  CHECK( sei.m_bpCpbCnt > MAX_CPB_CNT, "bp_cpb_cnt_minus1 out of range" );
+  if( sei.m_bpMaxSubLayers - 1 > 0 )
+  {
+    sei_read_flag( pDecodedMessageOutputStream, code, "bp_sublayer_initial_cpb_removal_delay_present_flag" ); sei.m_sublayerInitialCpbRemovalDelayPresent = code;
+  }
+  else
+  {
+    sei.m_sublayerInitialCpbRemovalDelayPresent = false;
+  }
+  for( int i = ( sei.m_sublayerInitialCpbRemovalDelayPresent ? 0 : sei.m_bpMaxSubLayers - 1 ); i < sei.m_bpMaxSubLayers; i++ )
+  {
+    for( int nalOrVcl = 0; nalOrVcl < 2; nalOrVcl++ )
+    {
+      if( ( ( nalOrVcl == 0 ) && sei.m_bpNalCpbParamsPresent ) || ( ( nalOrVcl == 1 ) && sei.m_bpVclCpbParamsPresent ) )
+      {
+        for( int j = 0; j < sei.m_bpCpbCnt; j++ )
+        {
+          sei_read_code( pDecodedMessageOutputStream, sei.m_initialCpbRemovalDelayLength, code, nalOrVcl ? "bp_vcl_initial_cpb_removal_delay[i][j]" : "bp_nal_initial_cpb_removal_delay[i][j]" );
+          sei.m_initialCpbRemovalDelay[i][j][nalOrVcl] = code;
+          sei_read_code( pDecodedMessageOutputStream, sei.m_initialCpbRemovalDelayLength, code, nalOrVcl ? "bp_vcl_initial_cpb_removal_offset[i][j]" : "bp_nal_initial_cpb_removal_offset[i][j]" );
+          sei.m_initialCpbRemovalOffset[i][j][nalOrVcl] = code;
+          if( sei.m_bpDecodingUnitHrdParamsPresent )
+          {
+            sei_read_code( pDecodedMessageOutputStream, sei.m_initialCpbRemovalDelayLength, code, nalOrVcl ? "bp_vcl_initial_alt_cpb_removal_delay[i][j]" : "bp_nal_initial_alt_cpb_removal_delay[i][j]" );
+            sei_read_code( pDecodedMessageOutputStream, sei.m_initialCpbRemovalDelayLength, code, nalOrVcl ? "bp_vcl_initial_alt_cpb_removal_offset[i][j]" : "bp_nal_initial_alt_cpb_removal_offset[i][j]" );
+          }
+        }
+      }
+    }
+  }
+  if( sei.m_bpMaxSubLayers - 1 > 0 )
+  {
+    sei_read_flag( pDecodedMessageOutputStream, code, "bp_sublayer_dpb_output_offsets_present_flag" );  sei.m_sublayerDpbOutputOffsetsPresent = code;
+  }
+  else
+  {
+    sei.m_sublayerDpbOutputOffsetsPresent = false;
+  }
+  if( sei.m_sublayerDpbOutputOffsetsPresent )
+  {
+    for( int i = 0; i < sei.m_bpMaxSubLayers - 1; i++ )
+    {
+      sei_read_uvlc( pDecodedMessageOutputStream, code, "bp_dpb_output_tid_offset[i]" );                sei.m_dpbOutputTidOffset[i] = code;
+    }
+    sei.m_dpbOutputTidOffset[sei.m_bpMaxSubLayers - 1] = 0;
+  }
+  sei_read_flag( pDecodedMessageOutputStream, code, "bp_alt_cpb_params_present_flag" );                 sei.m_altCpbParamsPresent = code;
+  if( sei.m_altCpbParamsPresent )
+  {
+    sei_read_flag( pDecodedMessageOutputStream, code, "bp_use_alt_cpb_params_flag" );                   sei.m_useAltCpbParamsFlag = code;
+  }
 }
 
-void SEIReader::xParseSEIPictureTiming(SEIPictureTiming& sei, uint32_t payloadSize, const SPS *sps, std::ostream *pDecodedMessageOutputStream)
+void SEIReader::xParseSEIPictureTiming(SEIPictureTiming& sei, uint32_t payloadSize, const uint32_t temporalId, const SEIBufferingPeriod& bp, std::ostream *pDecodedMessageOutputStream)
 {
-  THROW("no support");
+  uint32_t code;
+  output_sei_message_header(sei, pDecodedMessageOutputStream, payloadSize);
+
+  sei_read_code( pDecodedMessageOutputStream, bp.m_cpbRemovalDelayLength, code, "pt_cpb_removal_delay_minus1[bp_max_sub_layers_minus1]" );
+  sei.m_auCpbRemovalDelay[bp.m_bpMaxSubLayers - 1] = code + 1;
+  for( int i = temporalId; i < bp.m_bpMaxSubLayers - 1; i++ )
+  {
+    sei_read_flag( pDecodedMessageOutputStream, code, "pt_sublayer_delays_present_flag[i]" );           sei.m_subLayerDelaysPresent[i] = code;
+    if( sei.m_subLayerDelaysPresent[i] )
+    {
+      if( bp.m_cpbRemovalDelayDeltasPresent )
+      {
+        sei_read_flag( pDecodedMessageOutputStream, code, "pt_cpb_removal_delay_delta_enabled_flag[i]" ); sei.m_cpbRemovalDelayDeltaEnabledFlag[i] = code;
+      }
+      else
+      {
+        sei.m_cpbRemovalDelayDeltaEnabledFlag[i] = false;
+      }
+      if( sei.m_cpbRemovalDelayDeltaEnabledFlag[i] )
+      {
+        if( ( bp.m_numCpbRemovalDelayDeltas - 1 ) > 0 )
+        {
+          sei_read_code( pDecodedMessageOutputStream, ceilLog2( bp.m_numCpbRemovalDelayDeltas ), code, "pt_cpb_removal_delay_delta_idx[i]" );
+          sei.m_cpbRemovalDelayDeltaIdx[i] = code;
+        }
+        else
+        {
+          sei.m_cpbRemovalDelayDeltaIdx[i] = 0;
+        }
+      }
+      else
+      {
+        sei_read_code( pDecodedMessageOutputStream, bp.m_cpbRemovalDelayLength, code, "pt_cpb_removal_delay_minus1[i]" );
+        sei.m_auCpbRemovalDelay[i] = code + 1;
+      }
+    }
+  }
+  sei_read_code( pDecodedMessageOutputStream, bp.m_dpbOutputDelayLength, code, "pt_dpb_output_delay" );  sei.m_picDpbOutputDelay = code;
+
+  if( bp.m_altCpbParamsPresent )
+  {
+    THROW( "alternative CPB timing not supported" );
+  }
+
+  if( bp.m_bpDecodingUnitHrdParamsPresent && bp.m_decodingUnitDpbDuParamsInPicTimingSeiFlag )
+  {
+    sei_read_code( pDecodedMessageOutputStream, bp.m_dpbOutputDelayDuLength, code, "pt_dpb_output_du_delay" ); sei.m_picDpbOutputDuDelay = code;
+  }
+  if( bp.m_bpDecodingUnitHrdParamsPresent && bp.m_decodingUnitCpbParamsInPicTimingSeiFlag )
+  {
+    THROW( "decoding unit CPB parameters in picture timing SEI not supported" );
+  }
+  if( bp.m_additionalConcatenationInfoPresent )
+  {
+    sei_read_flag( pDecodedMessageOutputStream, code, "pt_delay_for_concatenation_ensured_flag" );      sei.m_delayForConcatenationEnsureFlag = code;
+  }
+  sei_read_code( pDecodedMessageOutputStream, 8, code, "pt_display_elemental_periods_minus1" );         sei.m_displayElementalPeriodsMinus1 = code;
 }
 
 void SEIReader::xParseSEIRecoveryPoint(SEIRecoveryPoint& sei, uint32_t payloadSize, std::ostream *pDecodedMessageOutputStream)
@@ -691,7 +846,7 @@ void SEIReader::xParseSEISOPDescription(SEISOPDescription &sei, uint32_t payload
   }
 }
 
-void SEIReader::xParseSEIScalableNesting(SEIScalableNesting& sei, const NalUnitType nalUnitType, uint32_t payloadSize, const SPS *sps, std::ostream *pDecodedMessageOutputStream)
+void SEIReader::xParseSEIScalableNesting(SEIScalableNesting& sei, const NalUnitType nalUnitType, const uint32_t temporalId, uint32_t payloadSize, const SPS *sps, std::ostream *pDecodedMessageOutputStream)
 {
   uint32_t uiCode;
   SEIMessages seis;
@@ -733,7 +888,7 @@ void SEIReader::xParseSEIScalableNesting(SEIScalableNesting& sei, const NalUnitT
   // read nested SEI messages
   do
   {
-    xReadSEImessage(sei.m_nestedSEIs, nalUnitType, sps, pDecodedMessageOutputStream);
+    xReadSEImessage(sei.m_nestedSEIs, nalUnitType, temporalId, sps, pDecodedMessageOutputStream);
   } while (m_pcBitstream->getNumBitsLeft() > 8);
 
   if (pDecodedMessageOutputStream)
@@ -788,6 +788,82 @@ void HLSyntaxReader::parseLmcsAps( APS* aps )
   info.chrResScalingOffset = (1 - 2 * signCW) * absCW;
 }
 
+void HLSyntaxReader::parseGeneralHrdParameters( GeneralHrdParams *hrd )
+{
+  uint32_t  symbol;
+  READ_CODE( 32, symbol, "num_units_in_tick");                  hrd->numUnitsInTick = symbol;
+  READ_CODE( 32, symbol, "time_scale");                         hrd->timeScale = symbol;
+  READ_FLAG( hrd->generalNalHrdParamsPresent, "general_nal_hrd_parameters_present_flag");
+  READ_FLAG( hrd->generalVclHrdParamsPresent, "general_vcl_hrd_parameters_present_flag");
+  if( hrd->generalNalHrdParamsPresent || hrd->generalVclHrdParamsPresent )
+  {
+    READ_FLAG( hrd->generalSamePicTimingInAllOlsFlag, "general_same_pic_timing_in_all_ols_flag");
+    READ_FLAG( hrd->generalDecodingUnitHrdParamsPresent, "general_decoding_unit_hrd_params_present_flag");
+    if( hrd->generalDecodingUnitHrdParamsPresent )
+    {
+      READ_CODE( 8, symbol, "tick_divisor_minus2");             hrd->tickDivisorMinus2 = symbol;
+    }
+    READ_CODE( 4, symbol, "bit_rate_scale");                    hrd->bitRateScale = symbol;
+    READ_CODE( 4, symbol, "cpb_size_scale");                    hrd->cpbSizeScale = symbol;
+    if( hrd->generalDecodingUnitHrdParamsPresent )
+    {
+      READ_CODE( 4, symbol, "cpb_size_du_scale");               hrd->cpbSizeDuScale = symbol;
+    }
+    READ_UVLC( symbol, "hrd_cpb_cnt_minus1");                   hrd->hrdCpbCntMinus1 = symbol;
+    CHECK( symbol >= MAX_CPB_CNT, "hrd_cpb_cnt_minus1 out of range" );
+  }
+}
+
+void HLSyntaxReader::parseOlsHrdParameters( GeneralHrdParams *generalHrd, OlsHrdParams *olsHrd, uint32_t firstSubLayer, uint32_t maxNumSubLayersMinus1 )
+{
+  uint32_t  symbol;
+  for( uint32_t i = firstSubLayer; i <= maxNumSubLayersMinus1; i++ )
+  {
+    OlsHrdParams *hrd = &(olsHrd[i]);
+    READ_FLAG( hrd->fixedPicRateGeneralFlag, "fixed_pic_rate_general_flag");
+    if( !hrd->fixedPicRateGeneralFlag )
+    {
+      READ_FLAG( hrd->fixedPicRateWithinCvsFlag, "fixed_pic_rate_within_cvs_flag");
+    }
+    else
+    {
+      hrd->fixedPicRateWithinCvsFlag = true;
+    }
+    hrd->lowDelayHrdFlag = false;
+    if( hrd->fixedPicRateWithinCvsFlag )
+    {
+      READ_UVLC( symbol, "elemental_duration_in_tc_minus1");    hrd->elementDurationInTcMinus1 = symbol;
+    }
+    else if( ( generalHrd->generalNalHrdParamsPresent || generalHrd->generalVclHrdParamsPresent ) && generalHrd->hrdCpbCntMinus1 == 0 )
+    {
+      READ_FLAG( hrd->lowDelayHrdFlag, "low_delay_hrd_flag");
+    }
+
+    for( int nalOrVcl = 0; nalOrVcl < 2; nalOrVcl++ )
+    {
+      if( ( nalOrVcl == 0 && generalHrd->generalNalHrdParamsPresent ) || ( nalOrVcl == 1 && generalHrd->generalVclHrdParamsPresent ) )
+      {
+        for( int j = 0; j <= generalHrd->hrdCpbCntMinus1; j++ )
+        {
+          READ_UVLC( symbol, "bit_rate_value_minus1");          hrd->bitRateValueMinus1[j][nalOrVcl] = symbol;
+          READ_UVLC( symbol, "cpb_size_value_minus1");          hrd->cpbSizeValueMinus1[j][nalOrVcl] = symbol;
+          if( generalHrd->generalDecodingUnitHrdParamsPresent )
+          {
+            READ_UVLC( symbol, "cpb_size_du_value_minus1");     hrd->duCpbSizeValueMinus1[j][nalOrVcl] = symbol;
+            READ_UVLC( symbol, "bit_rate_du_value_minus1");     hrd->duBitRateValueMinus1[j][nalOrVcl] = symbol;
+          }
+          READ_FLAG( hrd->cbrFlag[j][nalOrVcl], "cbr_flag");
+        }
+      }
+    }
+  }
+  // the parameters of the sub-layers not signalled are inferred from the highest sub-layer
+  for( uint32_t i = 0; i < firstSubLayer; i++ )
+  {
+    olsHrd[i] = olsHrd[maxNumSubLayersMinus1];
+  }
+}
+
 void  HLSyntaxReader::parseVUI(VUI* pcVUI, SPS *pcSPS)
 {
   assert(0); //to be checked
@@ -1277,7 +1353,17 @@ void HLSyntaxReader::parseSPS(SPS* pcSPS)
     READ_FLAG( pcSPS->hrdParametersPresent, "sps_general_hrd_params_present_flag");
     if( pcSPS->hrdParametersPresent )
     {
-      THROW("no support");
+      parseGeneralHrdParameters( &pcSPS->generalHrdParams );
+      if ((pcSPS->maxTLayers - 1) > 0)
+      {
+        READ_FLAG( pcSPS->subLayerCpbParamsPresent, "sps_sublayer_cpb_params_present_flag");
+      }
+      else
+      {
+        pcSPS->subLayerCpbParamsPresent = false;
+      }
+      uint32_t firstSubLayer = pcSPS->subLayerCpbParamsPresent ? 0 : (pcSPS->maxTLayers - 1);
+      parseOlsHrdParameters( &pcSPS->generalHrdParams, pcSPS->olsHrdParams, firstSubLayer, pcSPS->maxTLayers - 1);
     }
   }
 
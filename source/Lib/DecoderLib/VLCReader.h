@@ -146,6 +146,8 @@ public:
   void  parseLmcsAps          ( APS* aps );
 
   void  parseVUI              ( VUI* pcVUI, SPS* pcSPS );
+  void  parseGeneralHrdParameters( GeneralHrdParams *hrd );
+  void  parseOlsHrdParameters ( GeneralHrdParams *generalHrd, OlsHrdParams *olsHrd, uint32_t firstSubLayer, uint32_t maxNumSubLayersMinus1 );
   void  parseConstraintInfo   ( ConstraintInfo *cinfo);
   void  parseProfileTierLevel ( ProfileTierLevel *ptl, bool profileTierPresentFlag, int maxNumSubLayersMinus1);
   void  parsePictureHeader    ( PicHeader* picHeader, ParameterSetManager *parameterSetManager, bool readRbspTrailingBits );
@@ -668,6 +668,18 @@ double BitAllocation::getPicVisualActivity (const Slice* slice, const EncCfg* en
                                             slice->sps->bitDepths[CH_L], (encCfg->m_SourceWidth > 2048 || encCfg->m_SourceHeight > 1280) && isXPSNRQPA);
 }
 
+int BitAllocation::getPicVisualActivityQPOffset (const Slice* slice, const EncCfg* encCfg)
+{
+  if (slice == nullptr || slice->pic == nullptr || encCfg == nullptr) return 0;
+
+  const bool   isXPSNRQPA = (encCfg->m_usePerceptQPA & 1) == 0;
+  const double hpEnerPic  = getPicVisualActivity (slice, encCfg);
+  const double hpEnerAvg  = getAveragePictureActivity (encCfg->m_SourceWidth, encCfg->m_SourceHeight, 0,
+                                                       (encCfg->m_usePerceptQPATempFiltISlice || !slice->isIntra()) && isXPSNRQPA, slice->sps->bitDepths[CH_L]);
+  // picture-level counterpart of the slice QP adaptation of the QPA
+  return apprI3Log2 (hpEnerPic / hpEnerAvg);
+}
+
 } // namespace vvenc
 
 //! \}
@@ -67,6 +67,7 @@ namespace vvenc {
     int getCtuPumpingReducingQP (const Slice* slice, const CPelBuf& origY, const Distortion uiSadBestForQPA,
                                  std::vector<int>& ctuPumpRedQP, const uint32_t ctuRsAddr, const int baseQP);
     double getPicVisualActivity (const Slice* slice, const EncCfg* encCfg, const PelBuf* origBuf = nullptr);
+    int getPicVisualActivityQPOffset (const Slice* slice, const EncCfg* encCfg);
   }
 
 } // namespace vvenc
@@ -568,6 +568,7 @@ EncAdaptiveLoopFilter::EncAdaptiveLoopFilter()
 
 void EncAdaptiveLoopFilter::init( const EncCfg& encCfg, CABACWriter& cabacEstimator, CtxCache& ctxCache, NoMallocThreadPool* threadpool )
 {
+  MemTagScope memScope( MEM_TAG_ALF );
 
   AdaptiveLoopFilter::create( encCfg.m_SourceWidth, encCfg.m_SourceHeight, encCfg.m_internChromaFormat, encCfg.m_CTUSize, encCfg.m_CTUSize, encCfg.m_MaxCodingDepth, encCfg.m_internalBitDepth );
 
@@ -585,6 +586,7 @@ void EncAdaptiveLoopFilter::init( const EncCfg& encCfg, CABACWriter& cabacEstima
     for( int i = 0; i != m_filterShapes[chType].size(); i++ )
     {
       m_alfCovarianceFrame[chType][i] = new AlfCovariance[numClasses];
+      m_covarianceMem.add( sizeof( AlfCovariance ) * numClasses );
       for( int k = 0; k < numClasses; k++ )
       {
         m_alfCovarianceFrame[chType][i][k].create( m_filterShapes[chType][i].numCoeff, numBins );
@@ -616,6 +618,7 @@ void EncAdaptiveLoopFilter::init( const EncCfg& encCfg, CABACWriter& cabacEstima
       for( int j = 0; j < m_numCTUsInPic; j++ )
       {
         m_alfCovariance[compIdx][i][j] = new AlfCovariance[numClasses];
+        m_covarianceMem.add( sizeof( AlfCovariance ) * numClasses );
         for( int k = 0; k < numClasses; k++ )
         {
           m_alfCovariance[compIdx][i][j][k].create( m_filterShapes[chType][i].numCoeff, numBins );
@@ -661,6 +664,7 @@ void EncAdaptiveLoopFilter::init( const EncCfg& encCfg, CABACWriter& cabacEstima
     for( int i = 0; i != m_filterShapesCcAlf[compIdx-1].size(); i++ )
     {
       m_alfCovarianceFrameCcAlf[compIdx - 1][i] = new AlfCovariance[numFilters];
+      m_covarianceMem.add( sizeof( AlfCovariance ) * numFilters );
       for (int k = 0; k < numFilters; k++)
       {
         m_alfCovarianceFrameCcAlf[compIdx - 1][i][k].create(m_filterShapesCcAlf[compIdx - 1][i].numCoeff, numBins);
@@ -670,6 +674,7 @@ void EncAdaptiveLoopFilter::init( const EncCfg& encCfg, CABACWriter& cabacEstima
       for (int j = 0; j < numFilters; j++)
       {
         m_alfCovarianceCcAlf[compIdx - 1][i][j] = new AlfCovariance[m_numCTUsInPic];
+        m_covarianceMem.add( sizeof( AlfCovariance ) * m_numCTUsInPic );
         for (int k = 0; k < m_numCTUsInPic; k++)
         {
           m_alfCovarianceCcAlf[compIdx - 1][i][j][k].create(m_filterShapesCcAlf[compIdx - 1][i].numCoeff, numBins);
@@ -701,6 +706,7 @@ void EncAdaptiveLoopFilter::destroy()
   {
     return;
   }
+  m_covarianceMem.release();
   for( int channelIdx = 0; channelIdx < MAX_NUM_CH; channelIdx++ )
   {
     if( m_alfCovarianceFrame[channelIdx] )
@@ -284,6 +284,7 @@ private:
   uint8_t*               m_ctuAlternativeTmp[MAX_NUM_COMP];
   AlfCovariance***       m_alfCovarianceCcAlf[2];           // [compIdx-1][shapeIdx][ctbAddr][filterIdx]
   AlfCovariance**        m_alfCovarianceFrameCcAlf[2];      // [compIdx-1][shapeIdx][filterIdx]
+  MemTrack               m_covarianceMem;
 
   //for RDO
   AlfParam               m_alfParamTemp;
@@ -0,0 +1,284 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     EncAnalysis.cpp
+    \brief    shared analysis, saves the analysis of an encoding and reuses it for further renditions of the same input
+*/
+
+#include "EncAnalysis.h"
+#include "CommonLib/CodingStructure.h"
+#include "CommonLib/UnitTools.h"
+#include "vvenc/EncCfg.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+static const uint32_t ANALYSIS_FILE_MAGIC   = 0x56564141; // "VVAA"
+static const uint32_t ANALYSIS_FILE_VERSION = 1;
+
+template<typename T>
+static void writeValues( std::ofstream& file, const T* values, const size_t num )
+{
+  file.write( reinterpret_cast<const char*>( values ), sizeof( T ) * num );
+}
+
+template<typename T>
+static bool readValues( std::ifstream& file, T* values, const size_t num )
+{
+  file.read( reinterpret_cast<char*>( values ), sizeof( T ) * num );
+  return file.good();
+}
+
+EncAnalysis::EncAnalysis()
+  : m_mode  ( 0 )
+  , m_width ( 0 )
+  , m_height( 0 )
+{
+}
+
+void EncAnalysis::init( const EncCfg& encCfg )
+{
+  uninit();
+
+  m_mode     = encCfg.m_analysisMode;
+  m_fileName = encCfg.m_analysisFileName;
+  m_width    = encCfg.m_SourceWidth;
+  m_height   = encCfg.m_SourceHeight;
+
+  // the header ties the file to the picture size and to the layout of the stored blocks
+  uint32_t header[ 5 ] = { ANALYSIS_FILE_MAGIC, ANALYSIS_FILE_VERSION, (uint32_t)m_width, (uint32_t)m_height, (uint32_t)sizeof( AnalysisBlk ) };
+  if ( isSaving() )
+  {
+    m_outFile.open( m_fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc );
+    if ( m_outFile.fail() )
+    {
+      EXIT( "Failed to open analysis file for writing: " << m_fileName.c_str() );
+    }
+    writeValues( m_outFile, header, 5 );
+  }
+  else if ( isLoading() )
+  {
+    m_inFile.open( m_fileName.c_str(), std::ios::in | std::ios::binary );
+    if ( m_inFile.fail() )
+    {
+      EXIT( "Failed to open analysis file for reading: " << m_fileName.c_str() );
+    }
+    uint32_t fileHeader[ 5 ];
+    if ( ! readValues( m_inFile, fileHeader, 5 ) || fileHeader[ 0 ] != ANALYSIS_FILE_MAGIC || fileHeader[ 1 ] != ANALYSIS_FILE_VERSION || fileHeader[ 4 ] != header[ 4 ] )
+    {
+      EXIT( "Invalid analysis file: " << m_fileName.c_str() );
+    }
+    if ( fileHeader[ 2 ] != header[ 2 ] || fileHeader[ 3 ] != header[ 3 ] )
+    {
+      EXIT( "Analysis file " << m_fileName.c_str() << " was created for a picture size of " << fileHeader[ 2 ] << "x" << fileHeader[ 3 ] );
+    }
+  }
+}
+
+void EncAnalysis::uninit()
+{
+  if ( m_outFile.is_open() )
+  {
+    m_outFile.close();
+  }
+  if ( m_inFile.is_open() )
+  {
+    m_inFile.close();
+  }
+  m_readAhead.clear();
+  m_mode = 0;
+}
+
+void EncAnalysis::storePicAnalysis( Picture& pic )
+{
+  PicAnalysis& analysis = pic.analysis;
+  const CompArea& picArea = pic.Y();
+  analysis.clear();
+  analysis.widthInBlks  = ( picArea.width  + ( 1 << analysis.blkSizeLog2 ) - 1 ) >> analysis.blkSizeLog2;
+  analysis.heightInBlks = ( picArea.height + ( 1 << analysis.blkSizeLog2 ) - 1 ) >> analysis.blkSizeLog2;
+  analysis.blks.resize( analysis.widthInBlks * analysis.heightInBlks );
+
+  for ( const CodingUnit* cu : pic.cs->cus )
+  {
+    if ( cu->chType != CH_L )
+    {
+      continue;
+    }
+    AnalysisBlk blk;
+    blk.qtDepth  = cu->qtDepth;
+    blk.mtDepth  = cu->mtDepth;
+    blk.interDir = 0;
+    for ( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+    {
+      blk.refIdx[ l ] = -1;
+      blk.mv    [ l ] = Mv();
+    }
+    if ( CU::isInter( *cu ) && cu->pu )
+    {
+      const PredictionUnit& pu = *cu->pu;
+      blk.interDir = pu.interDir;
+      for ( int l = 0; l < NUM_REF_PIC_LIST_01; l++ )
+      {
+        if ( pu.interDir & ( 1 << l ) )
+        {
+          blk.refIdx[ l ] = (int8_t)pu.refIdx[ l ];
+          blk.mv    [ l ] = pu.mv[ l ];
+        }
+      }
+    }
+
+    const CompArea& area = cu->blocks[ COMP_Y ];
+    const int bx0 = area.x >> analysis.blkSizeLog2;
+    const int by0 = area.y >> analysis.blkSizeLog2;
+    const int bx1 = std::min( ( area.x + (int)area.width  - 1 ) >> analysis.blkSizeLog2, analysis.widthInBlks  - 1 );
+    const int by1 = std::min( ( area.y + (int)area.height - 1 ) >> analysis.blkSizeLog2, analysis.heightInBlks - 1 );
+    for ( int by = by0; by <= by1; by++ )
+    {
+      for ( int bx = bx0; bx <= bx1; bx++ )
+      {
+        analysis.blks[ by * analysis.widthInBlks + bx ] = blk;
+      }
+    }
+  }
+}
+
+void EncAnalysis::savePicture( const Picture& pic )
+{
+  if ( ! isSaving() )
+  {
+    return;
+  }
+
+  const PicAnalysis& analysis = pic.analysis;
+  const int32_t picInfo[ 2 ] = { pic.poc, (int32_t)pic.mctfMotion.size() };
+  writeValues( m_outFile, picInfo, 2 );
+  for ( const auto& field : pic.mctfMotion )
+  {
+    const int32_t fieldInfo[ 4 ] = { field.pocOffset, field.blkSizeLog2, field.widthInBlks, field.heightInBlks };
+    writeValues( m_outFile, fieldInfo, 4 );
+    writeValues( m_outFile, field.mvs.data(),    field.mvs.size() );
+    writeValues( m_outFile, field.errors.data(), field.errors.size() );
+  }
+  const int32_t gridInfo[ 3 ] = { analysis.blkSizeLog2, analysis.widthInBlks, analysis.heightInBlks };
+  writeValues( m_outFile, gridInfo, 3 );
+  writeValues( m_outFile, analysis.blks.data(), analysis.blks.size() );
+
+  if ( m_outFile.fail() )
+  {
+    EXIT( "Failed to write analysis file: " << m_fileName.c_str() );
+  }
+}
+
+void EncAnalysis::loadPicture( Picture& pic )
+{
+  if ( ! isLoading() )
+  {
+    return;
+  }
+
+  auto it = m_readAhead.find( pic.poc );
+  while ( it == m_readAhead.end() )
+  {
+    int       poc = -1;
+    PicRecord record;
+    if ( ! xReadRecord( poc, record ) )
+    {
+      EXIT( "Analysis of picture " << pic.poc << " not found in file " << m_fileName.c_str() );
+    }
+    it = m_readAhead.insert( std::make_pair( poc, std::move( record ) ) ).first;
+    if ( poc != pic.poc )
+    {
+      it = m_readAhead.end();
+    }
+  }
+
+  pic.mctfMotion = std::move( it->second.mctfMotion );
+  pic.analysis   = std::move( it->second.analysis );
+  m_readAhead.erase( it );
+}
+
+bool EncAnalysis::xReadRecord( int& poc, PicRecord& record )
+{
+  int32_t picInfo[ 2 ];
+  if ( ! readValues( m_inFile, picInfo, 2 ) )
+  {
+    return false;
+  }
+  poc = picInfo[ 0 ];
+
+  record.mctfMotion.resize( std::max( picInfo[ 1 ], 0 ) );
+  for ( auto& field : record.mctfMotion )
+  {
+    int32_t fieldInfo[ 4 ];
+    if ( ! readValues( m_inFile, fieldInfo, 4 ) || fieldInfo[ 2 ] < 0 || fieldInfo[ 3 ] < 0 )
+    {
+      return false;
+    }
+    field.pocOffset    = fieldInfo[ 0 ];
+    field.blkSizeLog2  = fieldInfo[ 1 ];
+    field.widthInBlks  = fieldInfo[ 2 ];
+    field.heightInBlks = fieldInfo[ 3 ];
+    field.mvs.resize   ( field.widthInBlks * field.heightInBlks );
+    field.errors.resize( field.widthInBlks * field.heightInBlks );
+    if ( ! readValues( m_inFile, field.mvs.data(), field.mvs.size() ) || ! readValues( m_inFile, field.errors.data(), field.errors.size() ) )
+    {
+      return false;
+    }
+  }
+
+  int32_t gridInfo[ 3 ];
+  if ( ! readValues( m_inFile, gridInfo, 3 ) || gridInfo[ 1 ] < 0 || gridInfo[ 2 ] < 0 )
+  {
+    return false;
+  }
+  record.analysis.blkSizeLog2  = gridInfo[ 0 ];
+  record.analysis.widthInBlks  = gridInfo[ 1 ];
+  record.analysis.heightInBlks = gridInfo[ 2 ];
+  record.analysis.blks.resize( record.analysis.widthInBlks * record.analysis.heightInBlks );
+  return readValues( m_inFile, record.analysis.blks.data(), record.analysis.blks.size() );
+}
+
+} // namespace vvenc
+
+//! \}
+
@@ -85,6 +85,11 @@ void EncCu::initPic( Picture* pic )
 {
   const ReshapeData& reshapeData = pic->reshapeData;
   m_cRdCost.setReshapeParams( reshapeData.getReshapeLumaLevelToWeightPLUT(), reshapeData.getChromaWeight() );
+
+  m_speedParams = SpeedCtrl::getSpeedParams( *m_pcEncCfg, pic->speedLevel );
+  m_modeCtrl.setSpeedParams    ( m_speedParams );
+  m_cIntraSearch.setSpeedParams( m_speedParams );
+  m_cInterSearch.setSpeedParams( m_speedParams );
   m_cInterSearch.setSearchRange( pic->cs->slice, *m_pcEncCfg );
 
   m_wppMutex = m_pcEncCfg->m_numWppThreads ? &pic->wppMutex : nullptr;
@@ -161,7 +166,7 @@ void EncCu::updateLambda(const Slice& slice, const double ctuLambda, const int c
 }
 
 void EncCu::init( const EncCfg& encCfg, const SPS& sps, LoopFilter* LoopFilter,
-                  std::vector<int>* const globalCtuQpVector, Ctx* syncPicCtx, RateCtrl* pRateCtrl )
+                  std::vector<int>* const globalCtuQpVector, Ctx* syncPicCtx, RateCtrl* pRateCtrl, SplitPredictorDump* splitPredDump )
 {
   DecCu::init( &m_cTrQuant, &m_cIntraSearch, &m_cInterSearch, encCfg.m_internChromaFormat );
   m_cRdCost.create     ();
@@ -171,7 +176,8 @@ void EncCu::init( const EncCfg& encCfg, const SPS& sps, LoopFilter* LoopFilter,
     m_cRdCost.setReshapeInfo( encCfg.m_lumaReshapeEnable ? encCfg.m_reshapeSignalType : RESHAPE_SIGNAL_PQ, encCfg.m_internalBitDepth[ CH_L ], encCfg.m_internChromaFormat );
   }
 
-  m_modeCtrl.init     ( encCfg, &m_cRdCost );
+  m_modeCtrl.init     ( encCfg, &m_cRdCost, splitPredDump );
+  m_speedParams       = SpeedCtrl::getSpeedParams( encCfg, 0 );
   m_cIntraSearch.init ( encCfg, &m_cTrQuant, &m_cRdCost, &m_SortedPelUnitBufs, m_unitCache );
   m_cInterSearch.init ( encCfg, &m_cTrQuant, &m_cRdCost, &m_modeCtrl, m_cIntraSearch.getSaveCSBuf() );
   m_cTrQuant.init     ( nullptr, encCfg.m_RDOQ, encCfg.m_useRDOQTS, encCfg.m_useSelectiveRDOQ, true, false /*m_useTransformSkipFast*/, encCfg.m_dqThresholdVal );
@@ -1960,6 +1966,10 @@ void EncCu::xCheckRDCostMerge( CodingStructure *&tempCS, CodingStructure *&bestC
           break;
         }
       }
+      if( m_speedParams.maxMergeRdCand > 0 )
+      {
+        uiNumMrgSATDCand = std::min<unsigned>( uiNumMrgSATDCand, m_speedParams.maxMergeRdCand );
+      }
       m_mergeBestSATDCost = candCostList[0];
       if (testCIIP && isChromaEnabled(pu.cs->pcv->chrFormat) && pu.chromaSize().width != 2 )
       {
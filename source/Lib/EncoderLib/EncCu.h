@@ -181,6 +181,7 @@ private:
 
   CABACWriter*          m_CABACEstimator;
   EncModeCtrl           m_modeCtrl;
+  SpeedParams           m_speedParams;
   TrQuant               m_cTrQuant;                          ///< transform & quantization
   RateCtrl*             m_pcRateCtrl;
 
@@ -202,7 +203,7 @@ public:
   EncCu();
   virtual ~EncCu();
 
-  void  init                  ( const EncCfg& encCfg, const SPS& sps, LoopFilter* LoopFilter, std::vector<int>* const globalCtuQpVector, Ctx* syncPicCtx, RateCtrl* pRateCtrl );
+  void  init                  ( const EncCfg& encCfg, const SPS& sps, LoopFilter* LoopFilter, std::vector<int>* const globalCtuQpVector, Ctx* syncPicCtx, RateCtrl* pRateCtrl, SplitPredictorDump* splitPredDump );
   void  setCtuEncRsrc         ( CABACWriter* cabacEstimator, CtxCache* ctxCache, ReuseUniMv* pReuseUniMv, BlkUniMvInfoBuffer* pBlkUniMvInfoBuffer, AffineProfList* pAffineProfList );
   void  destroy               ();
 
@@ -246,6 +246,8 @@ EncGOP::EncGOP()
   , m_actualHeadBits     ( 0 )
   , m_actualTotalBits    ( 0 )
   , m_estimatedBits      ( 0 )
+  , m_totalCoded         ( 0 )
+  , m_lastBPSEI          ( 0 )
 {
 }
 
@@ -275,20 +277,23 @@ EncGOP::~EncGOP()
 }
 
 
-void EncGOP::init( const EncCfg& encCfg, const SPS& sps, const PPS& pps, RateCtrl& rateCtrl, NoMallocThreadPool* threadPool )
+void EncGOP::init( const EncCfg& encCfg, const SPS& sps, const PPS& pps, RateCtrl& rateCtrl, SplitPredictorDump* splitPredDump, NoMallocThreadPool* threadPool, PelStoragePool* picBufPool )
 {
   m_pcEncCfg   = &encCfg;
   m_pcRateCtrl = &rateCtrl;
 
+  m_ffwdDecoder.picBufPool = picBufPool;
+
   m_seiEncoder.init( encCfg );
   m_Reshaper.init  ( encCfg );
 
   const int maxEncoder = ( encCfg.m_frameParallel && encCfg.m_numFppThreads > 1 ) ? encCfg.m_numFppThreads : 1;
+  m_speedCtrl.init( encCfg, maxEncoder );
   m_picEncoderList.resize( maxEncoder );
   for ( int i = 0; i < maxEncoder; i++ )
   {
     m_picEncoderList[ i ] = new EncPicture;
-    m_picEncoderList[ i ]->init( encCfg, &m_globalCtuQpVector, sps, pps, rateCtrl, threadPool );
+    m_picEncoderList[ i ]->init( encCfg, &m_globalCtuQpVector, sps, pps, rateCtrl, splitPredDump, threadPool );
   }
 
   if ( encCfg.m_frameParallel )
@@ -378,6 +383,7 @@ void EncGOP::encodePicture( std::vector<Picture*> encList, PicList& picList, Acc
 
     m_numPicEncoder += 1;
     xSyncAlfAps( *pic, pic->picApsMap, m_gopApsMap );
+    pic->speedLevel = m_speedCtrl.getSpeedLevel();
 
     if ( m_pcEncCfg->m_frameParallel && m_gopThreadPool )
     {
@@ -421,6 +427,18 @@ void EncGOP::encodePicture( std::vector<Picture*> encList, PicList& picList, Acc
   }
   taskObjList.clear();
 
+  // no picture encoder is running, free the hash tables of pictures no longer used for reference
+  if ( m_pcEncCfg->m_HashME )
+  {
+    for ( auto& refPic : picList )
+    {
+      if ( ! refPic->isReferenced && refPic->refCounter <= 0 )
+      {
+        refPic->blockHash.release();
+      }
+    }
+  }
+
   // write data
   Picture* pic = encList.front();
   CHECK( ! pic->isReconstructed, "error: try to write picture which hasn't been reconstructed yet" );
@@ -431,6 +449,7 @@ void EncGOP::encodePicture( std::vector<Picture*> encList, PicList& picList, Acc
   }
 
   xUpdateAfterPicRC( pic );
+  m_speedCtrl.updateAfterPicture( *pic );
 
   if ( m_pcEncCfg->m_useAMaxBT )
   {
@@ -533,7 +552,7 @@ NalUnitType EncGOP::xGetNalUnitType( int pocCurr, int lastIDR ) const
     return NAL_UNIT_CODED_SLICE_IDR_N_LP;
   }
 
-  if (m_pcEncCfg->m_DecodingRefreshType != 3 && pocCurr % m_pcEncCfg->m_IntraPeriod == 0)
+  if (m_pcEncCfg->m_DecodingRefreshType != 3 && (pocCurr % m_pcEncCfg->m_IntraPeriod == 0 || xIsSceneCutIrap(pocCurr)))
   {
     if (m_pcEncCfg->m_DecodingRefreshType == 1)
     {
@@ -567,6 +586,12 @@ NalUnitType EncGOP::xGetNalUnitType( int pocCurr, int lastIDR ) const
 }
 
 
+bool EncGOP::xIsSceneCutIrap( int poc ) const
+{
+  return std::find( m_sceneCutIrapPocs.begin(), m_sceneCutIrapPocs.end(), poc ) != m_sceneCutIrapPocs.end();
+}
+
+
 int EncGOP::xGetSliceDepth( int poc ) const
 {
   int depth = 0;
@@ -694,7 +719,18 @@ void EncGOP::xInitFirstSlice( Picture& pic, PicList& picList, bool isEncodeLtRef
   Slice* slice          = pic.allocateNewSlice();
   pic.cs->picHeader     = new PicHeader;
   const SPS& sps        = *(slice->sps);
-  SliceType sliceType   = ( curPoc % (unsigned)(m_pcEncCfg->m_IntraPeriod) == 0 || m_pcEncCfg->m_GOPList[ gopId ].m_sliceType== 'I' ) ? ( I_SLICE ) : ( m_pcEncCfg->m_GOPList[ gopId ].m_sliceType== 'P' ? P_SLICE : B_SLICE );
+
+  // pictures are initialised in coding order, so an inserted random access point is known before its leading and trailing pictures
+  if ( pic.isSceneCutIrap )
+  {
+    if ( m_sceneCutIrapPocs.size() >= 2 )
+    {
+      m_sceneCutIrapPocs.erase( m_sceneCutIrapPocs.begin() );
+    }
+    m_sceneCutIrapPocs.push_back( curPoc );
+  }
+
+  SliceType sliceType   = ( curPoc % (unsigned)(m_pcEncCfg->m_IntraPeriod) == 0 || pic.isSceneCutIrap || m_pcEncCfg->m_GOPList[ gopId ].m_sliceType== 'I' ) ? ( I_SLICE ) : ( m_pcEncCfg->m_GOPList[ gopId ].m_sliceType== 'P' ? P_SLICE : B_SLICE );
   NalUnitType naluType  = xGetNalUnitType( curPoc, m_lastIDR );
 
   // update IRAP
@@ -858,7 +894,7 @@ void EncGOP::xInitFirstSlice( Picture& pic, PicList& picList, bool isEncodeLtRef
   // reshaper
   xInitLMCS( pic );
 
-  if (m_pcEncCfg->m_usePerceptQPA)
+  if (m_pcEncCfg->m_usePerceptQPA || m_pcEncCfg->m_constQuality)
   {
     // set pointers to previous pictures for QP adaptation
     pic.m_bufsOrigPrev[0] = &pic.m_bufs[PIC_ORIGINAL];
@@ -1031,7 +1067,7 @@ void EncGOP::xInitLMCS( Picture& pic )
       }
       else
       {
-        pic.getFilteredOrigBuffer().create( pic.cs->pcv->chrFormat, Area( 0, 0, origBuf.get( COMP_Y ).width, origBuf.get( COMP_Y ).height) );
+        pic.getScratchBuf( PIC_ORIGINAL_RSP );
         PelUnitBuf rspOrigBuf = pic.getRspOrigBuf();
         rspOrigBuf.get(COMP_Y).rspSignal( origBuf.get(COMP_Y), m_Reshaper.getFwdLUT());
         if( CHROMA_400 != pic.cs->pcv->chrFormat )
@@ -1126,6 +1162,13 @@ void EncGOP::xSelectReferencePictureList( Slice* slice, int curPoc, int gopId, i
     if ( m_pcEncCfg->m_IntraPeriod > 0 && m_pcEncCfg->m_DecodingRefreshType > 0 )
     {
       int POCIndex = curPoc%m_pcEncCfg->m_IntraPeriod;
+      for (int irapPoc : m_sceneCutIrapPocs)
+      {
+        if (irapPoc <= curPoc && curPoc - irapPoc < POCIndex)
+        {
+          POCIndex = curPoc - irapPoc;
+        }
+      }
       if (POCIndex == 0)
         POCIndex = m_pcEncCfg->m_IntraPeriod;
       if (POCIndex == m_pcEncCfg->m_RPLList0[extraNum].m_POC)
@@ -1200,6 +1243,7 @@ void EncGOP::xWritePicture( Picture& pic, AccessUnit& au, bool isEncodeLtRef )
   }
 
   m_actualTotalBits += xWriteParameterSets( pic, au, m_HLSWriter );
+  m_actualTotalBits += xWriteLeadingSEIs  ( pic, au );
   m_actualTotalBits += xWritePictureSlices( pic, au, m_HLSWriter );
 
   pic.encTime.stopTimer();
@@ -1218,6 +1262,13 @@ int EncGOP::xWriteParameterSets( Picture& pic, AccessUnit& accessUnit, HLSWriter
   const PPS& pps      = *(slice->pps);
   int actualTotalBits = 0;
 
+  // the access unit delimiter is written first, all NAL units are appended in decoding order
+  bool IrapOrGdrAu = slice->picHeader->gdrPic || (slice->isIRAP() && !slice->pps->mixedNaluTypesInPic);
+  if ((( slice->vps->maxLayers > 1 && IrapOrGdrAu) || m_pcEncCfg->m_AccessUnitDelimiter) && slice->nuhLayerId )
+  {
+    xWriteAccessUnitDelimiter( accessUnit, slice, IrapOrGdrAu, hlsWriter );
+  }
+
   if ( m_bFirstWrite || ( m_pcEncCfg->m_rewriteParamSets && slice->isIRAP() ) )
   {
     if (slice->sps->vpsId != 0)
@@ -1230,12 +1281,6 @@ int EncGOP::xWriteParameterSets( Picture& pic, AccessUnit& accessUnit, HLSWriter
     m_bFirstWrite = false;
   }
 
-  bool IrapOrGdrAu = slice->picHeader->gdrPic || (slice->isIRAP() && !slice->pps->mixedNaluTypesInPic);
-  if ((( slice->vps->maxLayers > 1 && IrapOrGdrAu) || m_pcEncCfg->m_AccessUnitDelimiter) && slice->nuhLayerId )
-  {
-    xWriteAccessUnitDelimiter( accessUnit, slice, IrapOrGdrAu, hlsWriter );
-  }
-
   // send LMCS APS when LMCSModel is updated. It can be updated even current slice does not enable reshaper.
   // For example, in RA, update is on intra slice, but intra slice may not use reshaper
   if ( sps.lumaReshapeEnable && slice->picHeader->lmcsApsId >= 0 )
@@ -1322,16 +1367,51 @@ int EncGOP::xWritePictureSlices( Picture& pic, AccessUnit& accessUnit, HLSWriter
     hlsWriter.codeTilesWPPEntryPoint( slice );
     xAttachSliceDataToNalUnit( nalu, &pic.sliceDataStreams[ sliceIdx ] );
 
-    accessUnit.push_back( new NALUnitEBSP( nalu ) );
-    numBytes += unsigned( accessUnit.back()->m_nalUnitData.str().size() );
+    write( accessUnit, nalu );
+    numBytes += unsigned( accessUnit.back().m_nalUnitSize );
   }
 
-  xCabacZeroWordPadding( pic, slice, pic.sliceDataNumBins, numBytes, accessUnit.back()->m_nalUnitData );
+  xCabacZeroWordPadding( pic, slice, pic.sliceDataNumBins, numBytes, accessUnit );
 
   return numBytes * 8;
 }
 
 
+int EncGOP::xWriteLeadingSEIs( const Picture& pic, AccessUnit& accessUnit )
+{
+  const Slice* slice = pic.slices[ 0 ];
+  const SPS& sps     = *slice->sps;
+  SEIMessages leadingSeiMessages;
+
+  if ( ! sps.hrdParametersPresent )
+  {
+    return 0;
+  }
+
+  // buffering period at each random access point, timing relative to the last buffering period
+  const bool writeBP = slice->isIRAP() || m_totalCoded == 0;
+  const int cpbRemovalDelay = std::max( 1, m_totalCoded - m_lastBPSEI );
+  const int dpbOutputDelay  = std::max( 0, sps.numReorderPics[ sps.maxTLayers - 1 ] + pic.poc - m_totalCoded );
+  if ( writeBP )
+  {
+    SEIBufferingPeriod* bufferingPeriodSei = new SEIBufferingPeriod();
+    const double cpbFullness = m_pcEncCfg->m_RCRateControlMode && m_pcRateCtrl->encRCSeq->isVBVEnabled() ? m_pcRateCtrl->encRCSeq->getVBVFullness() : m_pcEncCfg->m_RCInitialCpbFullness * m_pcEncCfg->m_RCCpbSize;
+    m_seiEncoder.initBufferingPeriodSEI( bufferingPeriodSei, sps, cpbFullness );
+    leadingSeiMessages.push_back( bufferingPeriodSei );
+    m_lastBPSEI = m_totalCoded;
+  }
+  SEIPictureTiming* pictureTimingSei = new SEIPictureTiming();
+  m_seiEncoder.initPictureTimingSEI( pictureTimingSei, sps, cpbRemovalDelay, dpbOutputDelay );
+  leadingSeiMessages.push_back( pictureTimingSei );
+  m_totalCoded++;
+
+  xWriteSEI( NAL_UNIT_PREFIX_SEI, leadingSeiMessages, accessUnit, slice->TLayer, &sps );
+  deleteSEIs( leadingSeiMessages );
+
+  return (int)(accessUnit.back().m_nalUnitSize) * 8;
+}
+
+
 void EncGOP::xWriteTrailingSEIs( const Picture& pic, AccessUnit& accessUnit, std::string& digestStr )
 {
   const Slice* slice = pic.slices[ 0 ];
@@ -1345,9 +1425,8 @@ void EncGOP::xWriteTrailingSEIs( const Picture& pic, AccessUnit& accessUnit, std
     trailingSeiMessages.push_back( decodedPictureHashSei );
   }
 
-  // Note: using accessUnit.end() works only as long as this function is called after slice coding and before EOS/EOB NAL units
-  AccessUnit::iterator pos = accessUnit.end();
-  xWriteSEISeparately( NAL_UNIT_SUFFIX_SEI, trailingSeiMessages, accessUnit, pos, slice->TLayer, slice->sps );
+  // Note: appending works only as long as this function is called after slice coding and before EOS/EOB NAL units
+  xWriteSEISeparately( NAL_UNIT_SUFFIX_SEI, trailingSeiMessages, accessUnit, slice->TLayer, slice->sps );
 
   deleteSEIs( trailingSeiMessages );
 }
@@ -1358,8 +1437,8 @@ int EncGOP::xWriteVPS ( AccessUnit &accessUnit, const VPS *vps, HLSWriter& hlsWr
   OutputNALUnit nalu(NAL_UNIT_VPS);
   hlsWriter.setBitstream( &nalu.m_Bitstream );
   hlsWriter.codeVPS( vps );
-  accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  write( accessUnit, nalu );
+  return (int)(accessUnit.back().m_nalUnitSize) * 8;
 }
 
 
@@ -1373,8 +1452,8 @@ int EncGOP::xWriteDCI ( AccessUnit &accessUnit, const DCI *dci, HLSWriter& hlsWr
   OutputNALUnit nalu(NAL_UNIT_DCI);
   hlsWriter.setBitstream( &nalu.m_Bitstream );
   hlsWriter.codeDCI( dci );
-  accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  write( accessUnit, nalu );
+  return (int)(accessUnit.back().m_nalUnitSize) * 8;
 }
 
 
@@ -1383,8 +1462,8 @@ int EncGOP::xWriteSPS ( AccessUnit &accessUnit, const SPS *sps, HLSWriter& hlsWr
   OutputNALUnit nalu(NAL_UNIT_SPS);
   hlsWriter.setBitstream( &nalu.m_Bitstream );
   hlsWriter.codeSPS( sps );
-  accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  write( accessUnit, nalu );
+  return (int)(accessUnit.back().m_nalUnitSize) * 8;
 }
 
 
@@ -1393,8 +1472,8 @@ int EncGOP::xWritePPS ( AccessUnit &accessUnit, const PPS *pps, const SPS *sps,
   OutputNALUnit nalu(NAL_UNIT_PPS);
   hlsWriter.setBitstream( &nalu.m_Bitstream );
   hlsWriter.codePPS( pps, sps );
-  accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  write( accessUnit, nalu );
+  return (int)(accessUnit.back().m_nalUnitSize) * 8;
 }
 
 
@@ -1403,8 +1482,8 @@ int EncGOP::xWriteAPS( AccessUnit &accessUnit, const APS *aps, HLSWriter& hlsWri
   OutputNALUnit nalu(eNalUnitType, aps->temporalId);
   hlsWriter.setBitstream(&nalu.m_Bitstream);
   hlsWriter.codeAPS(aps);
-  accessUnit.push_back(new NALUnitEBSP(nalu));
-  return (int)(accessUnit.back()->m_nalUnitData.str().size()) * 8;
+  write( accessUnit, nalu );
+  return (int)(accessUnit.back().m_nalUnitSize) * 8;
 }
 
 
@@ -1413,24 +1492,24 @@ void EncGOP::xWriteAccessUnitDelimiter ( AccessUnit &accessUnit, Slice* slice, b
   OutputNALUnit nalu(NAL_UNIT_ACCESS_UNIT_DELIMITER, slice->TLayer);
   hlsWriter.setBitstream(&nalu.m_Bitstream);
   hlsWriter.codeAUD( IrapOrGdr, 2-slice->sliceType );
-  accessUnit.push_front(new NALUnitEBSP(nalu));
+  CHECK( ! accessUnit.empty(), "access unit delimiter has to be the first NAL unit of the access unit" );
+  write( accessUnit, nalu );
 }
 
 
-void EncGOP::xWriteSEI (NalUnitType naluType, SEIMessages& seiMessages, AccessUnit &accessUnit, AccessUnit::iterator &auPos, int temporalId, const SPS *sps)
+void EncGOP::xWriteSEI (NalUnitType naluType, SEIMessages& seiMessages, AccessUnit &accessUnit, int temporalId, const SPS *sps)
 {
   if (seiMessages.empty())
   {
     return;
   }
   OutputNALUnit nalu(naluType, temporalId);
-  m_seiWriter.writeSEImessages(nalu.m_Bitstream, seiMessages, sps, false);
-  auPos = accessUnit.insert(auPos, new NALUnitEBSP(nalu));
-  auPos++;
+  m_seiWriter.writeSEImessages(nalu.m_Bitstream, seiMessages, sps, temporalId, false);
+  write( accessUnit, nalu );
 }
 
 
-void EncGOP::xWriteSEISeparately (NalUnitType naluType, SEIMessages& seiMessages, AccessUnit &accessUnit, AccessUnit::iterator &auPos, int temporalId, const SPS *sps)
+void EncGOP::xWriteSEISeparately (NalUnitType naluType, SEIMessages& seiMessages, AccessUnit &accessUnit, int temporalId, const SPS *sps)
 {
   if (seiMessages.empty())
   {
@@ -1441,9 +1520,8 @@ void EncGOP::xWriteSEISeparately (NalUnitType naluType, SEIMessages& seiMessages
     SEIMessages tmpMessages;
     tmpMessages.push_back(*sei);
     OutputNALUnit nalu(naluType, temporalId);
-    m_seiWriter.writeSEImessages(nalu.m_Bitstream, tmpMessages, sps, false);
-    auPos = accessUnit.insert(auPos, new NALUnitEBSP(nalu));
-    auPos++;
+    m_seiWriter.writeSEImessages(nalu.m_Bitstream, tmpMessages, sps, temporalId, false);
+    write( accessUnit, nalu );
   }
 }
 
@@ -1466,7 +1544,7 @@ void EncGOP::xAttachSliceDataToNalUnit( OutputNALUnit& rNalu, const OutputBitstr
 }
 
 
-void EncGOP::xCabacZeroWordPadding( const Picture& pic, const Slice* slice, uint32_t binCountsInNalUnits, uint32_t numBytesInVclNalUnits, std::ostringstream &nalUnitData )
+void EncGOP::xCabacZeroWordPadding( const Picture& pic, const Slice* slice, uint32_t binCountsInNalUnits, uint32_t numBytesInVclNalUnits, AccessUnit& accessUnit )
 {
   const PPS &pps                     = *(slice->pps);
   const SPS &sps                     = *(slice->sps);
@@ -1489,12 +1567,15 @@ void EncGOP::xCabacZeroWordPadding( const Picture& pic, const Slice* slice, uint
       const uint32_t numberOfAdditionalCabacZeroBytes = numberOfAdditionalCabacZeroWords * 3;
       if ( m_pcEncCfg->m_cabacZeroWordPaddingEnabled )
       {
-        std::vector<uint8_t> zeroBytesPadding(numberOfAdditionalCabacZeroBytes, uint8_t(0));
+        // the last slice NAL unit is at the end of the byte stream
+        std::vector<uint8_t>& nalUnitData = accessUnit.m_annexB;
+        const size_t          paddingPos  = nalUnitData.size();
+        nalUnitData.resize( paddingPos + numberOfAdditionalCabacZeroBytes, uint8_t(0) );
         for( uint32_t i = 0; i < numberOfAdditionalCabacZeroWords; i++ )
         {
-          zeroBytesPadding[ i * 3 + 2 ] = 3;  // 00 00 03
+          nalUnitData[ paddingPos + i * 3 + 2 ] = 3;  // 00 00 03
         }
-        nalUnitData.write( reinterpret_cast<const char*>(&(zeroBytesPadding[ 0 ])), numberOfAdditionalCabacZeroBytes );
+        accessUnit.back().m_nalUnitSize += numberOfAdditionalCabacZeroBytes;
         msg( NOTICE, "Adding %d bytes of padding\n", numberOfAdditionalCabacZeroWords * 3 );
       }
       else
@@ -1516,7 +1597,7 @@ void EncGOP::picInitRateControl( int gopId, Picture& pic, Slice* slice )
   {
     frameLevel = 0;
   }
-  m_pcRateCtrl->initRCPic( frameLevel );
+  m_pcRateCtrl->initRCPic( frameLevel, slice->poc );
   m_estimatedBits = m_pcRateCtrl->encRCPic->targetBits;
 
   int sliceQP = m_pcEncCfg->m_RCInitialQP;
@@ -1535,7 +1616,7 @@ void EncGOP::picInitRateControl( int gopId, Picture& pic, Slice* slice )
   {
     m_pcRateCtrl->encRCPic->calCostSliceI( &pic );
 
-    if ( m_pcEncCfg->m_IntraPeriod != 1 )   // do not refine allocated bits for all intra case
+    if ( m_pcEncCfg->m_IntraPeriod != 1 && ! m_pcRateCtrl->encRCSeq->isTwoPass() )   // do not refine allocated bits for all intra case or if they are known from the first pass
     {
       int bits = m_pcRateCtrl->encRCSeq->totalFrames > 0 ? m_pcRateCtrl->encRCSeq->getLeftAverageBits() : m_pcRateCtrl->encRCSeq->averageBits;
       bits = m_pcRateCtrl->encRCPic->getRefineBitsForIntra( bits );
@@ -1570,6 +1651,20 @@ void EncGOP::picInitRateControl( int gopId, Picture& pic, Slice* slice )
 
 void EncGOP::xUpdateAfterPicRC(const Picture* pic)
 {
+  if ( m_pcEncCfg->m_RCPass == 1 )
+  {
+    const Slice* slice = pic->slices[ 0 ];
+    TRCPassStats stats;
+    stats.poc       = pic->poc;
+    stats.tempLayer = pic->TLayer;
+    stats.sliceType = slice->sliceType == I_SLICE ? 'I' : ( slice->sliceType == P_SLICE ? 'P' : 'B' );
+    stats.qp        = slice->sliceQp;
+    stats.numBits   = m_actualTotalBits;
+    stats.intraCost = pic->lookAheadIntraCost;
+    stats.interCost = pic->lookAheadInterCost;
+    m_pcRateCtrl->addRCPassStats( stats );
+  }
+
   if ( m_pcEncCfg->m_RCRateControlMode < 1 )
   {
     return;
@@ -1645,22 +1740,14 @@ void EncGOP::xCalculateAddPSNR( const Picture* pic, CPelUnitBuf cPicD, AccessUni
   uint32_t numRBSPBytes = 0;
   for (AccessUnit::const_iterator it = accessUnit.begin(); it != accessUnit.end(); it++)
   {
-    uint32_t numRBSPBytes_nal = uint32_t((*it)->m_nalUnitData.str().size());
+    uint32_t numRBSPBytes_nal = it->m_nalUnitSize;
     if (m_pcEncCfg->m_summaryVerboseness > 0)
     {
-      msg( NOTICE, "*** %6s numBytesInNALunit: %u\n", nalUnitTypeToString((*it)->m_nalUnitType), numRBSPBytes_nal);
+      msg( NOTICE, "*** %6s numBytesInNALunit: %u\n", nalUnitTypeToString(it->m_nalUnitType), numRBSPBytes_nal);
     }
-    if( ( *it )->m_nalUnitType != NAL_UNIT_PREFIX_SEI && ( *it )->m_nalUnitType != NAL_UNIT_SUFFIX_SEI )
+    if( it->m_nalUnitType != NAL_UNIT_PREFIX_SEI && it->m_nalUnitType != NAL_UNIT_SUFFIX_SEI )
     {
-      numRBSPBytes += numRBSPBytes_nal;
-      if (it == accessUnit.begin() || (*it)->m_nalUnitType == NAL_UNIT_VPS || (*it)->m_nalUnitType == NAL_UNIT_DCI || (*it)->m_nalUnitType == NAL_UNIT_SPS || (*it)->m_nalUnitType == NAL_UNIT_PPS || (*it)->m_nalUnitType == NAL_UNIT_PREFIX_APS || (*it)->m_nalUnitType == NAL_UNIT_SUFFIX_APS)
-      {
-        numRBSPBytes += 4;
-      }
-      else
-      {
-        numRBSPBytes += 3;
-      }
+      numRBSPBytes += numRBSPBytes_nal + it->m_startCodeSize;
     }
   }
 
@@ -1743,6 +1830,13 @@ void EncGOP::xCalculateAddPSNR( const Picture* pic, CPelUnitBuf cPicD, AccessUni
     accessUnit.m_cInfo.append( cEncTime );
     msg(NOTICE, cEncTime.c_str() );
 
+    if( m_speedCtrl.isEnabled() )
+    {
+      std::string cSpeedLevel = print(" [SL %d]", pic->speedLevel );
+      accessUnit.m_cInfo.append( cSpeedLevel );
+      msg(NOTICE, cSpeedLevel.c_str() );
+    }
+
     std::string cRefPics;
     for( int iRefList = 0; iRefList < 2; iRefList++ )
     {
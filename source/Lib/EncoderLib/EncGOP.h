@@ -55,6 +55,7 @@ vvc@hhi.fraunhofer.de
 #include "CommonLib/Picture.h"
 #include "CommonLib/CommonDef.h"
 #include "RateCtrl.h"
+#include "SpeedCtrl.h"
 
 #include <vector>
 #include <list>
@@ -75,6 +76,7 @@ namespace vvenc {
 
 class InputByteStream;
 class DecLib;
+struct OutputNALUnit;
 
 struct FFwdDecoder
 {
@@ -85,6 +87,7 @@ struct FFwdDecoder
   std::ifstream* bitstreamFile;
   InputByteStream* bytestream;
   DecLib *pcDecLib;
+  PelStoragePool* picBufPool;
 
   FFwdDecoder()
     : bDecode1stPart      ( true )
@@ -94,6 +97,7 @@ struct FFwdDecoder
       , bitstreamFile     ( nullptr )
       , bytestream        ( nullptr )
       , pcDecLib          ( nullptr )
+      , picBufPool        ( nullptr )
   {}
 };
 
@@ -115,6 +119,7 @@ private:
   int                       m_pocCRA;
   int                       m_associatedIRAPPOC;
   NalUnitType               m_associatedIRAPType;
+  std::vector<int>          m_sceneCutIrapPocs;                   ///< most recent random access points inserted after scene cuts
 
   const EncCfg*             m_pcEncCfg;
   HLSWriter                 m_HLSWriter;
@@ -125,6 +130,7 @@ private:
   FFwdDecoder               m_ffwdDecoder;
   ParameterSetMap<APS>      m_gopApsMap;
   RateCtrl*                 m_pcRateCtrl;
+  SpeedCtrl                 m_speedCtrl;
 
   std::vector<EncPicture*>  m_picEncoderList;
   std::list<Picture*>       m_encodePics;
@@ -138,12 +144,14 @@ private:
   int                       m_actualHeadBits;
   int                       m_actualTotalBits;
   int                       m_estimatedBits;
+  int                       m_totalCoded;           // access units written so far, in decoding order
+  int                       m_lastBPSEI;            // decoding order index of the last buffering period SEI
 
 public:
   EncGOP();
   virtual ~EncGOP();
 
-  void init               ( const EncCfg& encCfg, const SPS& sps, const PPS& pps, RateCtrl& rateCtrl, NoMallocThreadPool* threadPool );
+  void init               ( const EncCfg& encCfg, const SPS& sps, const PPS& pps, RateCtrl& rateCtrl, SplitPredictorDump* splitPredDump, NoMallocThreadPool* threadPool, PelStoragePool* picBufPool );
   void encodePicture      ( std::vector<Picture*> encList, PicList& picList, AccessUnit& au, bool isEncodeLtRef );
   void finishEncPicture   ( EncPicture* picEncoder, Picture& pic );
   void printOutSummary    ( int numAllPicCoded, const bool printMSEBasedSNR, const bool printSequenceMSE, const bool printHexPsnr, const BitDepths &bitDepths );
@@ -159,6 +167,7 @@ private:
   void xUpdateRasInit                 ( Slice* slice );
 
   NalUnitType xGetNalUnitType         ( int pocCurr, int lastIdr ) const;
+  bool xIsSceneCutIrap                ( int poc ) const;
   int  xGetSliceDepth                 ( int poc ) const;
   bool xIsSliceTemporalSwitchingPoint ( const Slice* slice, PicList& picList, int gopId ) const;
 
@@ -173,6 +182,7 @@ private:
   void xWritePicture                  ( Picture& pic, AccessUnit& au, bool isEncodeLtRef );
   int  xWriteParameterSets            ( Picture& pic, AccessUnit& accessUnit, HLSWriter& hlsWriter );
   int  xWritePictureSlices            ( Picture& pic, AccessUnit& accessUnit, HLSWriter& hlsWriter );
+  int  xWriteLeadingSEIs              ( const Picture& pic, AccessUnit& accessUnit );
   void xWriteTrailingSEIs             ( const Picture& pic, AccessUnit& accessUnit, std::string& digestStr );
   int  xWriteVPS                      ( AccessUnit &accessUnit, const VPS *vps, HLSWriter& hlsWriter );
   int  xWriteDCI                      ( AccessUnit &accessUnit, const DCI *dci, HLSWriter& hlsWriter );
@@ -180,10 +190,10 @@ private:
   int  xWritePPS                      ( AccessUnit &accessUnit, const PPS *pps, const SPS *sps, HLSWriter& hlsWriter );
   int  xWriteAPS                      ( AccessUnit &accessUnit, const APS *aps, HLSWriter& hlsWriter, NalUnitType eNalUnitType );
   void xWriteAccessUnitDelimiter      ( AccessUnit &accessUnit, Slice* slice, bool IrapOrGdr, HLSWriter& hlsWriter );
-  void xWriteSEI                      ( NalUnitType naluType, SEIMessages& seiMessages, AccessUnit &accessUnit, AccessUnit::iterator &auPos, int temporalId, const SPS *sps );
-  void xWriteSEISeparately            ( NalUnitType naluType, SEIMessages& seiMessages, AccessUnit &accessUnit, AccessUnit::iterator &auPos, int temporalId, const SPS *sps );
+  void xWriteSEI                      ( NalUnitType naluType, SEIMessages& seiMessages, AccessUnit &accessUnit, int temporalId, const SPS *sps );
+  void xWriteSEISeparately            ( NalUnitType naluType, SEIMessages& seiMessages, AccessUnit &accessUnit, int temporalId, const SPS *sps );
   void xAttachSliceDataToNalUnit      ( OutputNALUnit& rNalu, const OutputBitstream* pcBitstreamRedirect );
-  void xCabacZeroWordPadding          ( const Picture& pic, const Slice* slice, uint32_t binCountsInNalUnits, uint32_t numBytesInVclNalUnits, std::ostringstream &nalUnitData );
+  void xCabacZeroWordPadding          ( const Picture& pic, const Slice* slice, uint32_t binCountsInNalUnits, uint32_t numBytesInVclNalUnits, AccessUnit& accessUnit );
 
   void xUpdateAfterPicRC              ( const Picture* pic );
   void xCalculateAddPSNR              ( const Picture* pic, CPelUnitBuf cPicD, AccessUnit&, bool printFrameMSE, double* PSNR_Y, bool isEncodeLtRef );
@@ -0,0 +1,124 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+
+
+/** \file     EncHRD.cpp
+    \brief    hypothetical reference decoder parameter setup
+*/
+
+#include "EncHRD.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+// calculate scale value of bitrate and initial delay
+int EncHRD::xCalcScale( int x ) const
+{
+  if( x == 0 )
+  {
+    return 0;
+  }
+  uint32_t mask = 0xffffffff;
+  int scaleValue = 32;
+
+  while( ( x & mask ) != 0 )
+  {
+    scaleValue--;
+    mask = ( mask >> 1 );
+  }
+
+  return scaleValue;
+}
+
+void EncHRD::initHRDParameters( const EncCfg& encCfg )
+{
+  const int bitRate = encCfg.m_RCMaxBitrate;
+  const int cpbSize = encCfg.m_RCCpbSize;
+
+  m_generalHrdParams.numUnitsInTick                      = encCfg.m_temporalSubsampleRatio;
+  m_generalHrdParams.timeScale                           = encCfg.m_FrameRate;
+  m_generalHrdParams.generalNalHrdParamsPresent          = true;
+  m_generalHrdParams.generalVclHrdParamsPresent          = true;
+  m_generalHrdParams.generalSamePicTimingInAllOlsFlag    = true;
+  m_generalHrdParams.generalDecodingUnitHrdParamsPresent = false;
+  m_generalHrdParams.tickDivisorMinus2                   = 0;
+  m_generalHrdParams.cpbSizeDuScale                      = 0;
+  m_generalHrdParams.hrdCpbCntMinus1                     = 0;
+
+  // the scales are chosen such that the values are exactly representable where possible
+  const int bitRateScale = Clip3( 0, 15, xCalcScale( bitRate ) - 6 );
+  const int cpbSizeScale = Clip3( 0, 15, xCalcScale( cpbSize ) - 4 );
+  m_generalHrdParams.bitRateScale = bitRateScale;
+  m_generalHrdParams.cpbSizeScale = cpbSizeScale;
+
+  // rounding up keeps the signalled values at or above the ones used by the rate control
+  const uint32_t bitRateValue = std::max<uint32_t>( 1, ( bitRate + ( 1 << ( 6 + bitRateScale ) ) - 1 ) >> ( 6 + bitRateScale ) );
+  const uint32_t cpbSizeValue = std::max<uint32_t>( 1, ( cpbSize + ( 1 << ( 4 + cpbSizeScale ) ) - 1 ) >> ( 4 + cpbSizeScale ) );
+
+  for( int i = 0; i < MAX_TLAYER; i++ )
+  {
+    OlsHrdParams& olsHrd = m_olsHrdParams[ i ];
+    olsHrd.fixedPicRateGeneralFlag   = true;
+    olsHrd.fixedPicRateWithinCvsFlag = true;
+    olsHrd.elementDurationInTcMinus1 = 0;
+    olsHrd.lowDelayHrdFlag           = false;
+
+    for( int j = 0; j <= (int)m_generalHrdParams.hrdCpbCntMinus1; j++ )
+    {
+      for( int k = 0; k < 2; k++ )
+      {
+        olsHrd.bitRateValueMinus1  [ j ][ k ] = bitRateValue - 1;
+        olsHrd.cpbSizeValueMinus1  [ j ][ k ] = cpbSizeValue - 1;
+        olsHrd.duCpbSizeValueMinus1[ j ][ k ] = 0;
+        olsHrd.duBitRateValueMinus1[ j ][ k ] = 0;
+        olsHrd.cbrFlag             [ j ][ k ] = false;
+      }
+    }
+  }
+}
+
+} // namespace vvenc
+
+//! \}
+
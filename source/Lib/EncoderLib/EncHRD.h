@@ -52,11 +52,11 @@ namespace vvenc {
   class EncHRD :public HRD
   {
   public:
-    void initHRDParameters( EncCfg* encCfg );
+    void initHRDParameters( const EncCfg& encCfg );
 
   protected:
     // calculate scale value of bitrate and initial delay
-    int xCalcScale( int x );
+    int xCalcScale( int x ) const;
 
   };
 
@@ -46,6 +46,7 @@ vvc@hhi.fraunhofer.de
 */
 
 #include "EncLib.h"
+#include "EncHRD.h"
 
 #include "../../../include/vvenc/EncoderIf.h"
 #include "CommonLib/Picture.h"
@@ -76,6 +77,7 @@ EncLib::EncLib()
   , m_ppsMap        ( MAX_NUM_PPS )
   , m_GOPSizeLog2   ( -1 )
   , m_TicksPerFrameMul4 ( 0 )
+  , m_recOutStop    ( false )
 {
 }
 
@@ -88,7 +90,15 @@ void EncLib::init( const EncCfg& encCfg, YUVWriterIf* yuvWriterIf )
   // copy config parameter
   const_cast<EncCfg&>(m_cEncCfg).setCfgParameter( encCfg );
 
+  MemTagScope memScope( &m_memAccount, MEM_TAG_OTHER );
+  m_memAccount.setHugePageMode( m_cEncCfg.m_hugePages );
+
   m_yuvWriterIf = yuvWriterIf;
+  if ( m_yuvWriterIf )
+  {
+    m_recOutStop   = false;
+    m_recOutThread = std::thread( &EncLib::xRecOutThread, this );
+  }
 
 #if ENABLE_TRACING
   g_trace_ctx = tracing_init( m_cEncCfg.m_traceFile, m_cEncCfg.m_traceRule );
@@ -118,12 +128,27 @@ void EncLib::init( const EncCfg& encCfg, YUVWriterIf* yuvWriterIf )
     m_threadPool = new NoMallocThreadPool( maxCntEnc, "EncSliceThreadPool" );
   }
 
-  m_MCTF.init( m_cEncCfg.m_internalBitDepth, m_cEncCfg.m_SourceWidth, m_cEncCfg.m_SourceHeight, sps0.CTUSize,
-               m_cEncCfg.m_internChromaFormat, m_cEncCfg.m_QP, m_cEncCfg.m_MCTFFrames, m_cEncCfg.m_MCTFStrengths,
-               m_cEncCfg.m_MCTFFutureReference, m_cEncCfg.m_MCTF,
-               m_cEncCfg.m_MCTFNumLeadFrames, m_cEncCfg.m_MCTFNumTrailFrames, m_cEncCfg.m_framesToBeEncoded, m_threadPool );
+  {
+    MemTagScope mctfScope( MEM_TAG_MCTF );
+    m_MCTF.init( m_cEncCfg.m_internalBitDepth, m_cEncCfg.m_SourceWidth, m_cEncCfg.m_SourceHeight, sps0.CTUSize,
+                 m_cEncCfg.m_internChromaFormat, m_cEncCfg.m_QP, m_cEncCfg.m_MCTFFrames, m_cEncCfg.m_MCTFStrengths,
+                 m_cEncCfg.m_MCTFFutureReference, m_cEncCfg.m_MCTF, m_cEncCfg.m_MCTFMotionSeed || m_cEncCfg.m_analysisMode == 1,
+                 m_cEncCfg.m_MCTFNumLeadFrames, m_cEncCfg.m_MCTFNumTrailFrames, m_cEncCfg.m_framesToBeEncoded, m_threadPool, &m_picBufPool );
+  }
+
+  m_picScratchPool.init( sps0.chromaFormatIdc, Size( pps0.picWidthInLumaSamples, pps0.picHeightInLumaSamples ), sps0.CTUSize, m_cEncCfg.m_MCTF ? MCTF_PADDING : 0 );
+
+  if ( m_cEncCfg.m_sceneCutThreshold > 0 || m_cEncCfg.m_RCPass == 1 || m_cEncCfg.m_constQuality )
+  {
+    m_cLookAhead.init( m_cEncCfg );
+  }
+
+  if ( ! m_cEncCfg.m_splitPredictorDumpFile.empty() )
+  {
+    m_splitPredDump.open( m_cEncCfg.m_splitPredictorDumpFile );
+  }
 
-  m_cGOPEncoder.init( m_cEncCfg, sps0, pps0, m_cRateCtrl, m_threadPool );
+  m_cGOPEncoder.init( m_cEncCfg, sps0, pps0, m_cRateCtrl, &m_splitPredDump, m_threadPool, &m_picBufPool );
 
   m_pocToGopId.resize( m_cEncCfg.m_GOPSize, -1 );
   m_nextPocOffset.resize( m_cEncCfg.m_GOPSize, 0 );
@@ -147,6 +172,18 @@ void EncLib::init( const EncCfg& encCfg, YUVWriterIf* yuvWriterIf )
   {
     m_cRateCtrl.init( encCfg.m_RCRateControlMode, encCfg.m_framesToBeEncoded, encCfg.m_RCTargetBitrate, (int)( (double)encCfg.m_FrameRate / encCfg.m_temporalSubsampleRatio + 0.5 ), encCfg.m_IntraPeriod, encCfg.m_GOPSize, encCfg.m_SourceWidth, encCfg.m_SourceHeight,
       encCfg.m_CTUSize, encCfg.m_CTUSize, encCfg.m_internalBitDepth[ CH_L ], encCfg.m_RCKeepHierarchicalBit, encCfg.m_RCUseLCUSeparateModel, encCfg.m_GOPList );
+    if ( encCfg.m_RCMaxBitrate > 0 )
+    {
+      m_cRateCtrl.encRCSeq->initVBV( encCfg.m_RCMaxBitrate, encCfg.m_RCCpbSize, encCfg.m_RCInitialCpbFullness );
+    }
+  }
+  if ( encCfg.m_RCPass > 0 )
+  {
+    m_cRateCtrl.initRCPass( encCfg.m_RCPass, encCfg.m_RCStatsFileName );
+  }
+  if ( encCfg.m_analysisMode > 0 )
+  {
+    m_cAnalysis.init( encCfg );
   }
 
   int iOffset = -1;
@@ -190,8 +227,20 @@ void EncLib::init( const EncCfg& encCfg, YUVWriterIf* yuvWriterIf )
 
 void EncLib::destroy()
 {
+  if ( m_recOutThread.joinable() )
+  {
+    {
+      std::unique_lock<std::mutex> lock( m_recOutMutex );
+      m_recOutStop = true;
+    }
+    m_recOutCond.notify_one();
+    m_recOutThread.join();
+  }
+
   m_MCTF.uninit();
   m_cRateCtrl.destroy();
+  m_cAnalysis.uninit();
+  m_splitPredDump.close();
 
 #if ENABLE_CU_MODE_COUNTERS
   std::cout << std::endl;
@@ -272,6 +321,7 @@ void EncLib::destroy()
 
   // internal picture buffer
   xDeletePicBuffer();
+  m_picScratchPool.destroy();
 
 #if ENABLE_TRACING
   if ( g_trace_ctx )
@@ -289,6 +339,8 @@ void EncLib::encodePicture( bool flush, const YUVBuffer& yuvInBuf, AccessUnit& a
 {
   PROFILER_ACCUM_AND_START_NEW_SET( 1, g_timeProfiler, P_PIC_LEVEL );
 
+  MemTagScope memScope( &m_memAccount, MEM_TAG_OTHER );
+
   // clear output access unit
   au.m_bCtsValid = false;
   au.m_bDtsValid = false;
@@ -296,18 +348,25 @@ void EncLib::encodePicture( bool flush, const YUVBuffer& yuvInBuf, AccessUnit& a
   au.m_cInfo     = "";
   au.m_iStatus   = 0;
 
+  // with a bounded input queue, calls passing a picture only enqueue it and calls without input picture encode
+  const bool hasInput    = ! flush && yuvInBuf.yuvPlanes[ 0 ].planeBuf != nullptr;
+  const bool isDecoupled = m_cEncCfg.m_InputQueueMaxSize > 0;
+
   // setup picture and store original yuv
   Picture* pic = nullptr;
-  if ( ! flush )
+  if ( hasInput )
   {
     CHECK( m_ppsMap.getFirstPS() == nullptr || m_spsMap.getPS( m_ppsMap.getFirstPS()->spsId ) == nullptr, "picture set not initialised" );
+    CHECK( isDecoupled && m_numPicsInQueue >= m_cEncCfg.m_InputQueueMaxSize, "input queue full, encode a queued picture before passing the next one" );
 
     if ( m_cEncCfg.m_MCTF && m_numPicsRcvd <= 0 && m_MCTF.getNumLeadFrames() < m_cEncCfg.m_MCTFNumLeadFrames )
     {
+      MemTagScope mctfScope( MEM_TAG_MCTF );
       m_MCTF.addLeadFrame( yuvInBuf );
     }
     else if ( m_cEncCfg.m_MCTF && m_cEncCfg.m_framesToBeEncoded > 0 && m_numPicsRcvd >= m_cEncCfg.m_framesToBeEncoded )
     {
+      MemTagScope mctfScope( MEM_TAG_MCTF );
       m_MCTF.addTrailFrame( yuvInBuf );
     }
     else
@@ -328,23 +387,34 @@ void EncLib::encodePicture( bool flush, const YUVBuffer& yuvInBuf, AccessUnit& a
       }
 
       xInitPicture( *pic, m_numPicsRcvd, pps, sps, m_cVPS, m_cDCI );
+      m_cAnalysis.loadPicture( *pic );
+
+      if ( m_cEncCfg.m_sceneCutThreshold > 0 || m_cEncCfg.m_RCPass == 1 || m_cEncCfg.m_constQuality )
+      {
+        m_cLookAhead.analysePicture( *pic );
+      }
 
       m_numPicsRcvd    += 1;
       m_numPicsInQueue += 1;
     }
   }
 
-  // mctf filter
+  // mctf filter, advances once per passed or flushed picture
   int mctfDealy = 0;
   if ( m_cEncCfg.m_MCTF )
   {
-    m_MCTF.filter( pic );
+    if ( hasInput || flush )
+    {
+      MemTagScope mctfScope( MEM_TAG_MCTF );
+      m_MCTF.filter( pic );
+    }
     mctfDealy = m_MCTF.getCurDelay();
   }
 
   // encode picture
-  if ( m_numPicsInQueue >= m_cEncCfg.m_InputQueueSize
-      || ( m_numPicsInQueue - mctfDealy > 0 && flush ) )
+  if ( ( ! isDecoupled || ! hasInput )
+      && ( m_numPicsInQueue >= m_cEncCfg.m_InputQueueSize
+        || ( m_numPicsInQueue - mctfDealy > 0 && flush ) ) )
   {
     if ( m_cEncCfg.m_RCRateControlMode )
     {
@@ -388,6 +458,7 @@ void EncLib::encodePicture( bool flush, const YUVBuffer& yuvInBuf, AccessUnit& a
 
     // encode picture with current poc
     m_cGOPEncoder.encodePicture( encList, m_cListPic, au, false );
+    m_cAnalysis.savePicture( *encList.front() );
     m_numPicsInQueue -= 1;
     m_numPicsCoded   += 1;
     // output reconstructed yuv
@@ -396,15 +467,54 @@ void EncLib::encodePicture( bool flush, const YUVBuffer& yuvInBuf, AccessUnit& a
 
   isQueueEmpty = ( m_numPicsInQueue <= 0 );
 
+  // all reconstructed pictures have to be passed to the writer when the encoder has been flushed
+  if ( flush && isQueueEmpty )
+  {
+    xWaitRecOutput();
+  }
+
   if ( m_cEncCfg.m_RCRateControlMode && isQueueEmpty )
   {
     m_cRateCtrl.destroyRCGOP();
   }
 }
 
+void EncLib::getQueueStatus( InputQueueStatus& queueStatus ) const
+{
+  MemUsage memUsage;
+  m_memAccount.getUsage( memUsage );
+
+  const size_t picBytes = m_cListPic.empty() ? 0 : m_cListPic.front()->getOrigBufSize();
+
+  queueStatus.numPics     = m_numPicsInQueue;
+  queueStatus.numMctfPics = m_cEncCfg.m_MCTF ? m_MCTF.getNumLeadFrames() + m_MCTF.getNumTrailFrames() : 0;
+  queueStatus.maxPics     = m_cEncCfg.m_InputQueueMaxSize;
+  queueStatus.bytes       = m_numPicsInQueue * picBytes + memUsage.curBytes[ MEM_TAG_MCTF ];
+  queueStatus.wouldBlock  = m_cEncCfg.m_InputQueueMaxSize > 0 && m_numPicsInQueue >= m_cEncCfg.m_InputQueueMaxSize;
+}
+
 void  EncLib::printSummary()
 {
   m_cGOPEncoder.printOutSummary( m_numPicsCoded, m_cEncCfg.m_printMSEBasedSequencePSNR, m_cEncCfg.m_printSequenceMSE, m_cEncCfg.m_printHexPsnr, m_spsMap.getFirstPS()->bitDepths );
+
+  if( m_cEncCfg.m_memoryBudget > 0 )
+  {
+    // the budget is applied to the estimate in the configuration, report if the encoder still needed more
+    MemUsage memUsage;
+    m_memAccount.getUsage( memUsage );
+    if( memUsage.peakTotal > ( size_t( m_cEncCfg.m_memoryBudget ) << 20 ) )
+    {
+      msg( WARNING, "Peak memory of %.1f MiB exceeded the MemoryBudget of %d MiB\n", memUsage.peakTotal / double( 1 << 20 ), m_cEncCfg.m_memoryBudget );
+    }
+  }
+
+  if( m_cEncCfg.m_hugePages )
+  {
+    const HugePageStats stats = m_memAccount.getHugePageStats();
+    const double mib          = 1.0 / ( 1 << 20 );
+    msg( INFO, "Huge pages: %.1f MiB of picture buffers (peak), %.1f MiB mapped from reserved huge pages, %.1f MiB advised for transparent huge pages, %.1f MiB backed by transparent huge pages\n",
+         stats.peakBytes * mib, stats.peakExplicitBytes * mib, stats.peakAdvisedBytes * mib, stats.anonHugeBytes * mib );
+  }
 }
 
 // ====================================================================================================================
@@ -437,12 +547,14 @@ int EncLib::xGetNextPocICO( int poc, bool flush, int max ) const
  */
 Picture* EncLib::xGetNewPicBuffer( const PPS& pps, const SPS& sps )
 {
+  MemTagScope memScope( MEM_TAG_PICTURES );
+
   Slice::sortPicList( m_cListPic );
 
   Picture* pic = nullptr;
 
   // use an entry in the buffered list if the maximum number that need buffering has been reached:
-  if ( (int)m_cListPic.size() >= ( m_cEncCfg.m_InputQueueSize + m_cEncCfg.m_maxDecPicBuffering[ MAX_TLAYER - 1 ] + 2 ) )
+  if ( (int)m_cListPic.size() >= ( std::max( m_cEncCfg.m_InputQueueSize, m_cEncCfg.m_InputQueueMaxSize ) + m_cEncCfg.m_maxDecPicBuffering[ MAX_TLAYER - 1 ] + 2 ) )
   {
     auto picItr = std::begin( m_cListPic );
     while ( picItr != std::end( m_cListPic ) )
@@ -456,24 +568,42 @@ Picture* EncLib::xGetNewPicBuffer( const PPS& pps, const SPS& sps )
       picItr++;
     }
 
+    // pictures may still be held by the reconstruction output, wait for the writer and try again
+    if ( pic == nullptr && m_recOutThread.joinable() )
+    {
+      xWaitRecOutput();
+      for ( picItr = std::begin( m_cListPic ); picItr != std::end( m_cListPic ); picItr++ )
+      {
+        if ( ! (*picItr)->isNeededForOutput && ! (*picItr)->isReferenced && (*picItr)->refCounter <= 0 )
+        {
+          pic = *picItr;
+          break;
+        }
+      }
+    }
+
     CHECK( pic == nullptr, "Error: no free entry in picture list found" );
 
     // if PPS ID is the same, we will assume that it has not changed since it was last used and return the old object.
     if ( pps.ppsId != pic->cs->pps->ppsId )
     {
-      // the IDs differ - free up an entry in the list, and then create a new one, as with the case where the max buffering state has not been reached.
-      m_cListPic.erase( picItr );
+      // the IDs differ - recreate the entry in place, the storage of the picture buffers is recycled by the pool
+      if ( pic->cs->picHeader )
+      {
+        delete pic->cs->picHeader;
+        pic->cs->picHeader = nullptr;
+      }
       pic->destroy();
-      delete pic;
-      pic = nullptr;
+      xCreatePicture( *pic, pps, sps );
     }
   }
 
   if ( pic == nullptr )
   {
-    const int padding = m_cEncCfg.m_MCTF ? MCTF_PADDING : 0;
     pic = new Picture;
-    pic->create( sps.chromaFormatIdc, Size( pps.picWidthInLumaSamples, pps.picHeightInLumaSamples), sps.CTUSize, sps.CTUSize+16, false, padding );
+    pic->scratchPool = &m_picScratchPool;
+    pic->bufPool     = &m_picBufPool;
+    xCreatePicture( *pic, pps, sps );
     m_cListPic.push_back( pic );
   }
 
@@ -487,14 +617,26 @@ Picture* EncLib::xGetNewPicBuffer( const PPS& pps, const SPS& sps )
   pic->encPic            = false;
   pic->refCounter        = 0;
   pic->poc               = -1;
+  pic->isSceneCutIrap    = false;
+  pic->blockHash.release();
+  pic->mctfMotion.clear();
+  pic->analysis.clear();
 
   pic->encTime.resetTimer();
 
   return pic;
 }
 
+void EncLib::xCreatePicture( Picture& pic, const PPS& pps, const SPS& sps ) const
+{
+  const int padding = m_cEncCfg.m_MCTF ? MCTF_PADDING : 0;
+  pic.create( sps.chromaFormatIdc, Size( pps.picWidthInLumaSamples, pps.picHeightInLumaSamples), sps.CTUSize, sps.CTUSize+16, false, padding );
+}
+
 void EncLib::xInitPicture( Picture& pic, int picNum, const PPS& pps, const SPS& sps, const VPS& vps, const DCI& dci )
 {
+  MemTagScope memScope( MEM_TAG_PICTURES );
+
   const int gopId = xGetGopIdFromPoc( picNum );
 
   pic.poc    = picNum;
@@ -831,6 +973,20 @@ void EncLib::xInitSPS(SPS &sps) const
     sps.numReorderPics[i]           = m_cEncCfg.m_numReorderPics[i];
   }
 
+  sps.hrdParametersPresent          = m_cEncCfg.m_hrdParametersPresent;
+
+  if (sps.hrdParametersPresent)
+  {
+    EncHRD hrd;
+    hrd.initHRDParameters( m_cEncCfg );
+    sps.generalHrdParams            = hrd.getGeneralHrdParameters();
+    sps.subLayerCpbParamsPresent    = false;
+    for (int i = 0; i < MAX_TLAYER; i++ )
+    {
+      sps.olsHrdParams[i]           = hrd.getOlsHrdParameters( i );
+    }
+  }
+
   sps.vuiParametersPresent          = m_cEncCfg.m_vuiParametersPresent;
 
   if (sps.vuiParametersPresent)
@@ -1122,18 +1278,55 @@ void EncLib::xOutputRecYuv()
       continue;
     if ( ! picItr->isReconstructed || picItr->poc != m_pocRecOut )
       return;
-    const PPS& pps = *(picItr->cs->pps);
-    YUVBuffer yuvBuffer;
-    setupYuvBuffer( picItr->getRecoBuf(), yuvBuffer, &pps.conformanceWindow );
     if ( m_yuvWriterIf )
     {
-      m_yuvWriterIf->outputYuv( yuvBuffer );
+      // the writer thread releases the picture after output
+      picItr->refCounter++;
+      {
+        std::unique_lock<std::mutex> lock( m_recOutMutex );
+        m_recOutQueue.push_back( picItr );
+      }
+      m_recOutCond.notify_one();
     }
     m_pocRecOut = picItr->poc + 1;
     picItr->isNeededForOutput = false;
   }
 }
 
+void EncLib::xRecOutThread()
+{
+  std::unique_lock<std::mutex> lock( m_recOutMutex );
+  while ( true )
+  {
+    m_recOutCond.wait( lock, [this]{ return m_recOutStop || ! m_recOutQueue.empty(); } );
+    if ( m_recOutQueue.empty() )
+    {
+      return;
+    }
+    Picture* pic = m_recOutQueue.front();
+    lock.unlock();
+
+    const PPS& pps = *(pic->cs->pps);
+    YUVBuffer yuvBuffer;
+    setupYuvBuffer( pic->getRecoBuf(), yuvBuffer, &pps.conformanceWindow );
+    m_yuvWriterIf->outputYuv( yuvBuffer );
+    pic->refCounter--;
+
+    lock.lock();
+    m_recOutQueue.pop_front();
+    if ( m_recOutQueue.empty() )
+    {
+      m_recOutDoneCond.notify_all();
+    }
+  }
+}
+
+void EncLib::xWaitRecOutput()
+{
+  std::unique_lock<std::mutex> lock( m_recOutMutex );
+  m_recOutDoneCond.wait( lock, [this]{ return m_recOutQueue.empty(); } );
+}
+
 } // namespace vvenc
 
 //! \}
@@ -46,8 +46,13 @@ vvc@hhi.fraunhofer.de
 #pragma once
 
 #include "EncGOP.h"
+#include "LookAhead.h"
+#include "EncAnalysis.h"
 #include "CommonLib/MCTF.h"
 #include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <deque>
 #include "../../../include/vvenc/EncCfg.h"
 #include "../../../include/vvenc/Nal.h"
 
@@ -67,6 +72,8 @@ class NoMallocThreadPool;
 class EncLib
 {
 private:
+  MemAccount                m_memAccount;                         ///< declared first to outlive all buffers accounted to it
+  PelStoragePool            m_picBufPool;                         ///< picture storage recycled between the picture list, MCTF and the internal decoder
   int                       m_numPicsRcvd;
   int                       m_numPicsInQueue;
   int                       m_numPicsCoded;
@@ -76,10 +83,14 @@ private:
   const EncCfg              m_cEncCfg;
   EncGOP                    m_cGOPEncoder;
   MCTF                      m_MCTF;
+  LookAhead                 m_cLookAhead;
   PicList                   m_cListPic;
   YUVWriterIf*              m_yuvWriterIf;
   NoMallocThreadPool*       m_threadPool;
   RateCtrl                  m_cRateCtrl;                          ///< Rate control class
+  EncAnalysis               m_cAnalysis;                          ///< shared analysis across renditions
+  SplitPredictorDump        m_splitPredDump;                      ///< training dump of the split predictor, shared by the CU encoders
+  PicScratchPool            m_picScratchPool;                     ///< transient picture buffers, held only while a picture is encoded
 
   VPS                       m_cVPS;
   DCI                       m_cDCI;
@@ -95,6 +106,13 @@ private:
   int                       m_GOPSizeLog2;
   int                       m_TicksPerFrameMul4;
 
+  std::thread               m_recOutThread;                       ///< writes reconstructed pictures through the YUV writer interface
+  std::deque<Picture*>      m_recOutQueue;                        ///< reconstructed pictures waiting for output, kept alive by refCounter
+  std::mutex                m_recOutMutex;
+  std::condition_variable   m_recOutCond;
+  std::condition_variable   m_recOutDoneCond;
+  bool                      m_recOutStop;
+
 public:
   EncLib();
   virtual ~EncLib();
@@ -103,11 +121,14 @@ public:
   void     destroy             ();
   void     encodePicture       ( bool flush, const YUVBuffer& yuvInBuf, AccessUnit& au, bool& isQueueEmpty );
   void     printSummary        ();
+  void     getMemUsage         ( MemUsage& memUsage ) const { m_memAccount.getUsage( memUsage ); }
+  void     getQueueStatus      ( InputQueueStatus& queueStatus ) const;
 
 private:
   int      xGetGopIdFromPoc    ( int poc ) const { return m_pocToGopId[ poc % m_cEncCfg.m_GOPSize ]; }
   int      xGetNextPocICO      ( int poc, bool flush, int max ) const;
   void     xCreateCodingOrder  ( int start, int max, int numInQueue, bool flush, std::vector<Picture*>& encList );
+  void     xCreatePicture      ( Picture& pic, const PPS& pps, const SPS& sps ) const;
   void     xInitPicture        ( Picture& pic, int picNum, const PPS& pps, const SPS& sps, const VPS& vps, const DCI& dci );
   void     xDeletePicBuffer    ();
   Picture* xGetNewPicBuffer    ( const PPS& pps, const SPS& sps );            ///< get picture buffer which will be processed. If ppsId<0, then the ppsMap will be queried for the first match.
@@ -121,6 +142,8 @@ private:
   void     xInitPPSforTiles    ( PPS &pps ) const;
   void     xInitRPL            ( SPS &sps ) const;
   void     xOutputRecYuv       ();
+  void     xRecOutThread       ();
+  void     xWaitRecOutput      ();
 };
 
 } // namespace vvenc
@@ -519,7 +519,7 @@ bool BestEncInfoCache::setCsFrom( CodingStructure& cs, EncTestMode& testMode, co
 //////////////////////////////////////////////////////////////////////////
 // EncModeCtrl
 //////////////////////////////////////////////////////////////////////////
-void EncModeCtrl::init( const EncCfg& encCfg, RdCost* pRdCost )
+void EncModeCtrl::init( const EncCfg& encCfg, RdCost* pRdCost, SplitPredictorDump* splitPredDump )
 {
   m_pcEncCfg  = &encCfg;
   m_pcRdCost  = pRdCost;
@@ -528,6 +528,9 @@ void EncModeCtrl::init( const EncCfg& encCfg, RdCost* pRdCost )
   CacheBlkInfoCtrl::create();
   BestEncInfoCache::create( encCfg.m_internChromaFormat );
   SaveLoadEncInfoSbt::create();
+
+  m_splitPredictor.init( encCfg.m_splitPredictor ? encCfg.m_splitPredictorThreshold : 0.0, splitPredDump );
+  m_speedParams = SpeedCtrl::getSpeedParams( encCfg, 0 );
 }
 
 void EncModeCtrl::destroy()
@@ -546,6 +549,84 @@ void EncModeCtrl::xExtractFeatures( const EncTestMode& encTestmode, CodingStruct
   cs.features[ENC_FT_ENC_MODE_OPTS  ] = double( encTestmode.opts     );
 }
 
+bool EncModeCtrl::xSkipSplitPredicted( const EncTestMode& encTestmode, const CodingStructure& cs, Partitioner& partitioner )
+{
+  ComprCUCtx& cuECtx = *comprCUCtx;
+  const CodingStructure* bestCS = cuECtx.bestCS;
+  const CodingUnit*      bestCU = cuECtx.bestCU;
+
+  xFlushSplitSample( cuECtx );
+
+  if( !bestCS || !bestCU || bestCS->cost == MAX_DOUBLE || !isLuma( partitioner.chType ) )
+  {
+    return false;
+  }
+
+  if( !cuECtx.splitFeaturesValid )
+  {
+    SplitPredictor::extractBlockFeatures( cs, partitioner, cuECtx.splitFeatures );
+    cuECtx.splitFeaturesValid = true;
+  }
+
+  float* features = cuECtx.splitSample;
+  std::copy( cuECtx.splitFeatures, cuECtx.splitFeatures + NUM_SPLIT_FEATURES, features );
+
+  const double numSamples  = double( partitioner.currArea().lumaSize().area() );
+  const double bestBtCost  = std::min( cuECtx.bestCostHorzSplit, cuECtx.bestCostVertSplit );
+  features[ SPF_SPLIT_TYPE     ] = float( encTestmode.type - ETM_SPLIT_BT_H );
+  features[ SPF_QP             ] = float( encTestmode.qp );
+  features[ SPF_TEMPORAL_LAYER ] = float( cs.slice->TLayer );
+  features[ SPF_BEST_COST      ] = float( bestCS->cost / ( m_pcRdCost->getLambda() * numSamples ) );
+  features[ SPF_BEST_SKIP      ] = bestCU->skip ? 1.0f : 0.0f;
+  features[ SPF_BEST_INTRA     ] = CU::isIntra( *bestCU ) ? 1.0f : 0.0f;
+  features[ SPF_BEST_CBF       ] = bestCU->rootCbf ? 1.0f : 0.0f;
+  features[ SPF_BT_COST_RATIO  ] = float( bestBtCost == MAX_DOUBLE ? 2.0 : std::min( 2.0, bestBtCost / bestCS->cost ) );
+
+  if( m_splitPredictor.isDumpEnabled() )
+  {
+    cuECtx.splitSampleMode     = encTestmode.type;
+    cuECtx.splitSampleImproved = false;
+    return false;
+  }
+
+  return m_splitPredictor.canSkipSplit( features );
+}
+
+void EncModeCtrl::xFlushSplitSample( ComprCUCtx& cuECtx )
+{
+  if( cuECtx.splitSampleMode != ETM_INVALID )
+  {
+    m_splitPredictor.writeTrainingSample( cuECtx.splitSample, cuECtx.splitSampleImproved );
+    cuECtx.splitSampleMode = ETM_INVALID;
+  }
+}
+
+bool EncModeCtrl::xGetAnalysisDepths( const CodingStructure& cs, const Partitioner& partitioner, unsigned& minQtDepth, unsigned& maxQtDepth, unsigned& maxMtDepth ) const
+{
+  const PicAnalysis& analysis = cs.picture->analysis;
+  if( partitioner.chType != CH_L || !analysis.valid() )
+  {
+    return false;
+  }
+
+  const CompArea& area = cs.area.Y();
+  const int       step = 1 << analysis.blkSizeLog2;
+  minQtDepth = MAX_UINT;
+  maxQtDepth = 0;
+  maxMtDepth = 0;
+  for( int y = area.y; y < area.y + (int)area.height; y += step )
+  {
+    for( int x = area.x; x < area.x + (int)area.width; x += step )
+    {
+      const AnalysisBlk& blk = analysis.at( x, y );
+      minQtDepth = std::min<unsigned>( minQtDepth, blk.qtDepth );
+      maxQtDepth = std::max<unsigned>( maxQtDepth, blk.qtDepth );
+      maxMtDepth = std::max<unsigned>( maxMtDepth, blk.mtDepth );
+    }
+  }
+  return true;
+}
+
 void EncModeCtrl::initCTUEncoding( const Slice &slice )
 {
   CacheBlkInfoCtrl::init( slice );
@@ -574,8 +655,21 @@ void EncModeCtrl::initCULevel( Partitioner &partitioner, const CodingStructure&
     partitioner.setMaxMinDepth( minDepth, maxDepth, cs );
   }
 
+  // a loaded analysis of the same input restricts the tested depths to a margin around the previously chosen partitioning
+  unsigned refMinQtDepth = 0, refMaxQtDepth = 0, refMaxMtDepth = MAX_UINT;
+  const bool useAnalysis = m_pcEncCfg->m_analysisMode == 2 && m_pcEncCfg->m_analysisReuseLevel >= 2
+                        && xGetAnalysisDepths( cs, partitioner, refMinQtDepth, refMaxQtDepth, refMaxMtDepth );
+  if( useAnalysis )
+  {
+    // the quad split is always tested down to 32x32, large intra blocks are not searched reliably without it
+    const unsigned minQtMaxDepth = cs.pcv->maxCUSizeLog2 > 5 ? cs.pcv->maxCUSizeLog2 - 5 : 0;
+    minDepth = std::max( minDepth, refMinQtDepth > 0 ? refMinQtDepth - 1 : 0 );
+    maxDepth = std::max( minDepth, std::min( maxDepth, std::max( refMaxQtDepth + 1, minQtMaxDepth ) ) );
+  }
+
   m_ComprCUCtxList.push_back( ComprCUCtx( cs, minDepth, maxDepth ) );
   comprCUCtx = &m_ComprCUCtxList.back();
+  comprCUCtx->refMaxMtDepth = refMaxMtDepth;
 
   const CodingUnit* cuLeft  = cs.getCU( cs.area.blocks[partitioner.chType].pos().offset( -1, 0 ), partitioner.chType, partitioner.treeType );
   const CodingUnit* cuAbove = cs.getCU( cs.area.blocks[partitioner.chType].pos().offset( 0, -1 ), partitioner.chType, partitioner.treeType );
@@ -599,6 +693,7 @@ void EncModeCtrl::initCULevel( Partitioner &partitioner, const CodingStructure&
 
 void EncModeCtrl::finishCULevel( Partitioner &partitioner )
 {
+  xFlushSplitSample( m_ComprCUCtxList.back() );
   m_ComprCUCtxList.pop_back();
   comprCUCtx = m_ComprCUCtxList.size() ? &m_ComprCUCtxList.back() : nullptr;
 }
@@ -662,7 +757,7 @@ bool EncModeCtrl::trySplit( const EncTestMode& encTestmode, const CodingStructur
   }
 
   const PartSplit split = getPartSplit( encTestmode );
-  if( !partitioner.canSplit( split, cs ) || skipScore >= 2 )
+  if( !partitioner.canSplit( split, cs ) || skipScore >= 2 || ( split != CU_QUAD_SPLIT && ( partitioner.currMtDepth >= m_speedParams.maxMTTDepth || partitioner.currMtDepth > cuECtx.refMaxMtDepth ) ) )
   {
     if( split == CU_HORZ_SPLIT ) cuECtx.didHorzSplit = false;
     if( split == CU_VERT_SPLIT ) cuECtx.didVertSplit = false;
@@ -841,6 +936,12 @@ bool EncModeCtrl::trySplit( const EncTestMode& encTestmode, const CodingStructur
   {
     cuECtx.didQuadSplit = !m_pcEncCfg->m_qtbttSpeedUp || !!cuECtx.doMoreSplits;
   }
+  else if( ( m_pcEncCfg->m_splitPredictor || m_splitPredictor.isDumpEnabled() ) && ( !m_pcEncCfg->m_qtbttSpeedUp || cuECtx.doMoreSplits )
+           && xSkipSplitPredicted( encTestmode, cs, partitioner ) )
+  {
+    // the split counts as tested without gain, as for the following QT and TT decisions
+    return false;
+  }
 
   return !m_pcEncCfg->m_qtbttSpeedUp || !!cuECtx.doMoreSplits;
 }
@@ -863,6 +964,11 @@ bool EncModeCtrl::tryMode( const EncTestMode& encTestmode, const CodingStructure
     return false;
   }
 
+  if( m_speedParams.skipExtraInterModes && ( encTestmode.type == ETM_AFFINE || encTestmode.type == ETM_MERGE_GEO || encTestmode.type == ETM_INTER_IMV ) )
+  {
+    return false;
+  }
+
   const Slice&           slice        = *cs.slice;
   const uint32_t         numComp      = getNumberValidComponents( slice.sps->chromaFormatIdc );
   const CodedCUInfo      &relatedCU   = getBlkInfo( partitioner.currArea() );
@@ -1082,7 +1188,14 @@ bool EncModeCtrl::useModeResult( const EncTestMode& encTestmode, CodingStructure
   }
 
   // for now just a simple decision based on RD-cost or choose tempCS if bestCS is not yet coded
-  if( tempCS->features[ENC_FT_RD_COST] != MAX_DOUBLE && ( !cuECtx.bestCS || ( ( tempCS->features[ENC_FT_RD_COST] + ( useEDO ? tempCS->costDbOffset : 0 ) ) < ( cuECtx.bestCS->features[ENC_FT_RD_COST] + ( useEDO ? cuECtx.bestCS->costDbOffset : 0 ) ) ) ) )
+  const bool isBetter = tempCS->features[ENC_FT_RD_COST] != MAX_DOUBLE && ( !cuECtx.bestCS || ( ( tempCS->features[ENC_FT_RD_COST] + ( useEDO ? tempCS->costDbOffset : 0 ) ) < ( cuECtx.bestCS->features[ENC_FT_RD_COST] + ( useEDO ? cuECtx.bestCS->costDbOffset : 0 ) ) ) );
+
+  if( encTestmode.type == cuECtx.splitSampleMode )
+  {
+    cuECtx.splitSampleImproved = isBetter;
+  }
+
+  if( isBetter )
   {
     cuECtx.bestCS = tempCS;
     cuECtx.bestCU = tempCS->cus[0];
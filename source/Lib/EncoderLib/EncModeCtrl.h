@@ -46,6 +46,7 @@ vvc@hhi.fraunhofer.de
 #pragma once
 
 #include "InterSearch.h"
+#include "SplitPredictor.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/CodingStructure.h"
 
@@ -181,6 +182,7 @@ struct ComprCUCtx
   ComprCUCtx( const CodingStructure& cs, const uint32_t _minDepth, const uint32_t _maxDepth )
     : minDepth      ( _minDepth  )
     , maxDepth      ( _maxDepth  )
+    , refMaxMtDepth ( MAX_UINT   )
     , bestCS        ( nullptr    )
     , bestCU        ( nullptr    )
     , bestTU        ( nullptr    )
@@ -203,11 +205,15 @@ struct ComprCUCtx
     , didVertSplit          (false)
     , isBestNoSplitSkip     (false)
     , skipSecondMTSPass     (false)
+    , splitFeaturesValid    (false)
+    , splitSampleMode       (ETM_INVALID)
+    , splitSampleImproved   (false)
   {
   }
 
   unsigned          minDepth;
   unsigned          maxDepth;
+  unsigned          refMaxMtDepth;                      // deepest MTT depth of a loaded analysis within the CU, MAX_UINT if none
   CodingStructure*  bestCS;
   CodingUnit*       bestCU;
   TransformUnit*    bestTU;
@@ -231,6 +237,11 @@ struct ComprCUCtx
   bool              didVertSplit;
   bool              isBestNoSplitSkip;
   bool              skipSecondMTSPass;
+  bool              splitFeaturesValid;
+  float             splitFeatures[NUM_SPLIT_FEATURES];  // block features of the split predictor, computed once per CU
+  EncTestModeType   splitSampleMode;                    // split mode awaiting its outcome for the training dump
+  bool              splitSampleImproved;
+  float             splitSample[NUM_SPLIT_FEATURES];
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -346,13 +357,16 @@ protected:
         RdCost*         m_pcRdCost;
   static_vector<ComprCUCtx, ( MAX_CU_DEPTH << 2 )> m_ComprCUCtxList;
   unsigned              m_skipThresholdE0023FastEnc;
+  SplitPredictor        m_splitPredictor;
+  SpeedParams           m_speedParams;
 
 public:
   ComprCUCtx*           comprCUCtx;
 
   virtual ~EncModeCtrl    () { destroy(); }
 
-  void init               ( const EncCfg& encCfg, RdCost *pRdCost );
+  void init               ( const EncCfg& encCfg, RdCost *pRdCost, SplitPredictorDump* splitPredDump );
+  void setSpeedParams     ( const SpeedParams& speedParams ) { m_speedParams = speedParams; }
   void destroy            ();
   void initCTUEncoding    ( const Slice &slice );
   void initCULevel        ( Partitioner &partitioner, const CodingStructure& cs );
@@ -366,6 +380,9 @@ public:
 
 private:
   void xExtractFeatures   ( const EncTestMode& encTestmode, CodingStructure& cs );
+  bool xSkipSplitPredicted( const EncTestMode& encTestmode, const CodingStructure& cs, Partitioner& partitioner );
+  void xFlushSplitSample  ( ComprCUCtx& cuECtx );
+  bool xGetAnalysisDepths ( const CodingStructure& cs, const Partitioner& partitioner, unsigned& minQtDepth, unsigned& maxQtDepth, unsigned& maxMtDepth ) const;
 
 };
 
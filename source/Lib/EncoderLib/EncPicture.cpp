@@ -47,6 +47,7 @@ vvc@hhi.fraunhofer.de
 
 #include "EncPicture.h"
 #include "EncGOP.h"
+#include "EncAnalysis.h"
 #include "UnitTools.h"
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/dtrace_buffer.h"
@@ -68,12 +69,12 @@ static __itt_domain* itt_domain_ALF_post     = __itt_domain_create( "ALFPost" );
 // ---------------------------------------------------------------------------------------------------------------------
 
 void EncPicture::init( const EncCfg& encCfg, std::vector<int>* const globalCtuQpVector,
-                       const SPS& sps, const PPS& pps, RateCtrl& rateCtrl, NoMallocThreadPool* threadPool )
+                       const SPS& sps, const PPS& pps, RateCtrl& rateCtrl, SplitPredictorDump* splitPredDump, NoMallocThreadPool* threadPool )
 {
   m_pcEncCfg = &encCfg;
 
   m_ALF.init         ( encCfg, m_CABACEstimator, m_CtxCache, threadPool );
-  m_SliceEncoder.init( encCfg, sps, pps, globalCtuQpVector, m_LoopFilter, m_ALF, rateCtrl, threadPool );
+  m_SliceEncoder.init( encCfg, sps, pps, globalCtuQpVector, m_LoopFilter, m_ALF, rateCtrl, splitPredDump, threadPool );
 }
 
 
@@ -83,6 +84,11 @@ void EncPicture::encodePicture( Picture& pic, ParameterSetMap<APS>& shrdApsMap,
 
   pic.encTime.startTimer();
 
+  if ( pic.cs->sps->saoEnabled )
+  {
+    pic.getScratchBuf( PIC_SAO_TEMP );
+  }
+
   // compress picture
   if ( pic.encPic )
   {
@@ -103,15 +109,27 @@ void EncPicture::encodePicture( Picture& pic, ParameterSetMap<APS>& shrdApsMap,
 
   // finalize
   pic.extendPicBorder();
+  if ( m_pcEncCfg->m_HashME && pic.isReferenced )
+  {
+    MemTagScope memScope( MEM_TAG_PICTURES );
+    pic.blockHash.generate( pic.getOrigBuf( COMP_Y ) );
+  }
   pic.slices[ 0 ]->updateRefPicCounter( -1 );
   if ( m_pcEncCfg->m_useAMaxBT )
   {
     pic.picBlkStat.storeBlkSize( pic );
   }
+  if ( m_pcEncCfg->m_analysisMode == 1 )
+  {
+    EncAnalysis::storePicAnalysis( pic );
+  }
   // cleanup
+  pic.releaseScratchBuf( PIC_SAO_TEMP );
+  pic.releaseScratchBuf( PIC_ORIGINAL_RSP );
   pic.destroyTempBuffers();
   pic.cs->destroyCoeffs();
   pic.cs->releaseIntermediateData();
+  pic.cs->compactMotionField();
 
   pic.encTime.stopTimer();
 
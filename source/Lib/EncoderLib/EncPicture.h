@@ -80,7 +80,7 @@ class EncPicture
     virtual ~EncPicture() {}
 
     void      init          ( const EncCfg& encCfg, std::vector<int>* const globalCtuQpVector,
-                              const SPS& sps, const PPS& pps, RateCtrl& rateCtrl, NoMallocThreadPool* threadPool );
+                              const SPS& sps, const PPS& pps, RateCtrl& rateCtrl, SplitPredictorDump* splitPredDump, NoMallocThreadPool* threadPool );
     EncSlice* getEncSlice   () { return &m_SliceEncoder; }
 
     void      encodePicture ( Picture& pic, ParameterSetMap<APS>& shrdApsMap, EncGOP& gopEncoder );
@@ -74,6 +74,8 @@ static const __itt_string_handle* itt_handle_alf_derive = __itt_string_handle_cr
 static const __itt_string_handle* itt_handle_alf_recon  = __itt_string_handle_create( "ALF_RECONSTRUCT" );
 #endif
 
+static const int CQ_MAX_ACTIVITY_QP_OFFSET = 3; // limit of the visual activity based picture QP offset in constant quality mode
+
 struct LineEncRsrc
 {
   BitEstimator            m_BitEstimator;
@@ -131,12 +133,14 @@ EncSlice::~EncSlice()
     delete lnRsc;
   }
   m_LineEncRsrc.clear();
+  m_LineEncRsrcMem.release();
 
   for( auto* taskRsc: m_CtuTaskRsrc )
   {
     delete taskRsc;
   }
   m_CtuTaskRsrc.clear();
+  m_CtuTaskRsrcMem.release();
 
   m_processStates.clear();
   m_saoReconParams.clear();
@@ -159,6 +163,7 @@ void EncSlice::init( const EncCfg& encCfg,
                      LoopFilter& loopFilter,
                      EncAdaptiveLoopFilter& alf,
                      RateCtrl& rateCtrl,
+                     SplitPredictorDump* splitPredDump,
                      NoMallocThreadPool* threadPool
                    )
 {
@@ -177,13 +182,16 @@ void EncSlice::init( const EncCfg& encCfg,
 
   for( CtuTaskRsrc*& taskRsc : m_CtuTaskRsrc )
   {
+    MemTagScope memScope( MEM_TAG_CTU_RSRC );
     taskRsc = new CtuTaskRsrc();
+    m_CtuTaskRsrcMem.add( sizeof( CtuTaskRsrc ) );
     taskRsc->m_encCu.init( encCfg,
                            sps,
                            &loopFilter,
                            globalCtuQpVector,
                            m_syncPicCtx.data(),
-                           &rateCtrl );
+                           &rateCtrl,
+                           splitPredDump );
     if( sps.saoEnabled )
     {
       taskRsc->m_encSao.init( encCfg );
@@ -192,7 +200,9 @@ void EncSlice::init( const EncCfg& encCfg,
 
   for( LineEncRsrc*& lnRsc : m_LineEncRsrc )
   {
+    MemTagScope memScope( MEM_TAG_LINE_RSRC );
     lnRsc = new LineEncRsrc( encCfg );
+    m_LineEncRsrcMem.add( sizeof( LineEncRsrc ) );
   }
 
   m_appliedSwitchDQQ = 0;
@@ -395,6 +405,17 @@ int EncSlice::xGetQPForPicture( const Slice* slice, unsigned gopId )
         qp += qpOffset ;
       }
     }
+
+    if( m_pcEncCfg->m_constQuality )
+    {
+      // the QP acts as quality factor, the picture QP follows the complexity estimated in the lookahead and, unless
+      // the QPA adapts the slice QP itself, the visual activity
+      qp += slice->pic->lookAheadQpOffset;
+      if( ! m_pcEncCfg->m_usePerceptQPA )
+      {
+        qp += Clip3( -CQ_MAX_ACTIVITY_QP_OFFSET, CQ_MAX_ACTIVITY_QP_OFFSET, BitAllocation::getPicVisualActivityQPOffset( slice, m_pcEncCfg ) );
+      }
+    }
   }
   qp = Clip3( -lumaQpBDOffset, MAX_QP, qp );
   return qp;
@@ -765,7 +786,7 @@ void EncSlice::xProcessCtus( Picture* pic, const unsigned startCtuTsAddr, const
   CS::setRefinedMotionField( cs );
 
   // cleanup
-  pic->getFilteredOrigBuffer().destroy();
+  pic->releaseScratchBuf( PIC_ORIGINAL_RSP );
 }
 
 template<bool checkReadyState>
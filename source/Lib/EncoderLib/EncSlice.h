@@ -90,6 +90,8 @@ private:
 
   std::vector<CtuTaskRsrc*>    m_CtuTaskRsrc;
   std::vector<LineEncRsrc*>    m_LineEncRsrc;
+  MemTrack                     m_CtuTaskRsrcMem;
+  MemTrack                     m_LineEncRsrcMem;
   NoMallocThreadPool*          m_threadPool;
   std::vector<ProcessCtuState> m_processStates;
 
@@ -121,6 +123,7 @@ public:
                                 LoopFilter& loopFilter,
                                 EncAdaptiveLoopFilter& alf,
                                 RateCtrl& rateCtrl,
+                                SplitPredictorDump* splitPredDump,
                                 NoMallocThreadPool* threadPool );
 
   void    initPic             ( Picture* pic, int gopId );
@@ -225,6 +225,7 @@ void InterSearch::init( const EncCfg& encCfg, TrQuant* pTrQuant, RdCost* pRdCost
   m_iSearchRange                 = encCfg.m_SearchRange;
   m_bipredSearchRange            = encCfg.m_bipredSearchRange;
   m_motionEstimationSearchMethod = MESearchMethod( encCfg.m_motionEstimationSearchMethod );
+  m_speedParams                  = SpeedCtrl::getSpeedParams( encCfg, 0 );
 
   for( uint32_t iDir = 0; iDir < MAX_NUM_REF_LIST_ADAPT_SR; iDir++ )
   {
@@ -780,7 +781,7 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
                                             bool useAltHpelIf )
 {
   Distortion  uiDist;
-  uiDistBest = m_pcEncCfg->m_fastSubPel ? uiDistBest : MAX_DISTORTION;
+  uiDistBest = m_speedParams.fastSubPel ? uiDistBest : MAX_DISTORTION;
   uint32_t        uiDirecBest = 0;
 
   Pel*  piRefPos;
@@ -808,7 +809,7 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
   const Mv* pcMvRefine = (iFrac == 2 ? s_acMvRefineH : s_acMvRefineQ);
   for (uint32_t i = 0; i < 9; i++)
   {
-    if( m_pcEncCfg->m_fastSubPel )
+    if( m_speedParams.fastSubPel )
     {
       if( s_skipQpelPosition[ patternId ][ i ] )
       {
@@ -894,7 +895,7 @@ Distortion InterSearch::xPatternRefinement( const CPelBuf* pcPatternKey,
 
   rcMvFrac = pcMvRefine[uiDirecBest];
 
-  if( m_pcEncCfg->m_fastSubPel )
+  if( m_speedParams.fastSubPel )
   {
     if( 2 == iFrac )
     {
@@ -1596,7 +1597,7 @@ void InterSearch::predInterSearch(CodingUnit& cu, Partitioner& partitioner)
         checkAffine = false;
       }
     }
-    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.slice->sps->Affine && checkAffine)
+    if (cu.Y().width > 8 && cu.Y().height > 8 && cu.slice->sps->Affine && checkAffine && !m_speedParams.skipExtraInterModes)
     {
       PROFILER_SCOPE_AND_STAGE_EXT( 1, g_timeProfiler, P_INTER_MVD_SEARCH_AFFINE, &cs, partitioner.chType );
       m_hevcCost = uiHevcCost;
@@ -1978,6 +1979,22 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, CPelUnitBuf& origBuf, Re
   m_pcRdCost->setPredictor( predQuarter );
   m_pcRdCost->setCostScale(2);
 
+  // blocks with an exact match in the original of the reference need neither integer nor sub-pel search
+  Distortion uiHashDist = 0;
+  if( m_pcEncCfg->m_HashME && !bBi && pu.cu->imv == 0 && !pu.cs->sps->wrapAroundEnabled
+      && xHashMotionSearch( pu, *pcPatternKey, *refPic, cStruct.imvShift, rcMv, uiHashDist ) )
+  {
+    relatedCU.setMv( refPicList, iRefIdxPred, rcMv );
+    m_pcRdCost->setCostScale( 0 );
+    rcMv.changePrecision( MV_PRECISION_INT, MV_PRECISION_QUARTER );
+    uint32_t uiMvBits = m_pcRdCost->getBitsOfVectorWithPredictor( rcMv.hor, rcMv.ver, cStruct.imvShift );
+    ruiBits += uiMvBits;
+    ruiCost  = uiHashDist + ( Distortion ) m_pcRdCost->getCost( ruiBits );
+    rcMv.changePrecision( MV_PRECISION_QUARTER, MV_PRECISION_INTERNAL );
+    DTRACE( g_trace_ctx, D_ME, "   MECostHash<L%d,%d>: %6d (%d)  MV:%d,%d\n", (int)refPicList, (int)bBi, ruiCost, ruiBits, rcMv.hor, rcMv.ver );
+    return;
+  }
+
   //  Do integer search
   if( ( m_motionEstimationSearchMethod == MESEARCH_FULL ) || bBi || bQTBTMV )
   {
@@ -2023,9 +2040,30 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, CPelUnitBuf& origBuf, Re
       }
     }
 
+    bool bMctfSeedReliable = false;
+    Mv   cMctfMv;
+    if( m_pcEncCfg->m_MCTFMotionSeed && !bBi && xGetMctfStartMv( pu, *refPic, cMctfMv, bMctfSeedReliable ) )
+    {
+      cTmpMv = cMctfMv;
+      clipMv(cTmpMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->pcv);
+      cTmpMv.changePrecision(MV_PRECISION_INTERNAL, MV_PRECISION_INT);
+      m_cDistParam.cur.buf = cStruct.piRefY + (cTmpMv.ver * cStruct.iRefStride) + cTmpMv.hor;
+
+      Distortion uiSad = m_cDistParam.distFunc(m_cDistParam);
+      uiSad += m_pcRdCost->getCostOfVectorWithPredictor(cTmpMv.hor, cTmpMv.ver, cStruct.imvShift);
+      bMctfSeedReliable &= uiSad < uiBestSad;
+      if (uiSad < uiBestSad)
+      {
+        uiBestSad = uiSad;
+        bestInitMv = cMctfMv;
+        m_cDistParam.maximumDistortionForEarlyExit = uiSad;
+      }
+    }
+
     if( !bQTBTMV )
     {
-      xSetSearchRange(pu, bestInitMv, iSrchRng, cStruct.searchRange );
+      // a well matching MCTF vector as best start point needs only a reduced window around it
+      xSetSearchRange(pu, bestInitMv, bMctfSeedReliable ? iSrchRng >> 1 : iSrchRng, cStruct.searchRange );
     }
     xPatternSearch( cStruct, rcMv, ruiCost);
   }
@@ -2069,6 +2107,152 @@ void InterSearch::xMotionEstimation(PredictionUnit& pu, CPelUnitBuf& origBuf, Re
 }
 
 
+bool InterSearch::xGetMctfStartMv( const PredictionUnit& pu, const Picture& refPic, Mv& rcMv, bool& bReliable ) const
+{
+  const Picture& curPic  = *pu.cs->picture;
+  const int      refDist = refPic.poc - curPic.poc;
+  bReliable = false;
+  if( curPic.mctfMotion.empty() || refDist == 0 )
+  {
+    return false;
+  }
+
+  // take the field of the farthest neighbour towards the reference and extrapolate the remaining distance linearly
+  const MctfMotionField* field = nullptr;
+  for( const auto& cand : curPic.mctfMotion )
+  {
+    if( cand.pocOffset * refDist > 0 && abs( cand.pocOffset ) <= abs( refDist )
+        && ( field == nullptr || abs( cand.pocOffset ) > abs( field->pocOffset ) ) )
+    {
+      field = &cand;
+    }
+  }
+  if( field == nullptr || field->widthInBlks == 0 || field->heightInBlks == 0 )
+  {
+    return false;
+  }
+
+  const CompArea& blk = pu.blocks[ COMP_Y ];
+  const int bx  = std::min<int>( ( blk.x + ( blk.width  >> 1 ) ) >> field->blkSizeLog2, field->widthInBlks  - 1 );
+  const int by  = std::min<int>( ( blk.y + ( blk.height >> 1 ) ) >> field->blkSizeLog2, field->heightInBlks - 1 );
+  const int idx = by * field->widthInBlks + bx;
+  if( field->errors[ idx ] == INT_LEAST32_MAX )
+  {
+    return false;
+  }
+
+  rcMv = field->mvs[ idx ];
+  if( refDist != field->pocOffset )
+  {
+    rcMv.hor = rcMv.hor * refDist / field->pocOffset;
+    rcMv.ver = rcMv.ver * refDist / field->pocOffset;
+  }
+
+  // a mean squared error of up to 16 (8 bit) per sample marks a trustworthy match
+  static const int MCTF_SEED_MAX_MSE = 16;
+  const int maxError = ( MCTF_SEED_MAX_MSE << ( 2 * field->blkSizeLog2 ) ) << ( 2 * ( m_lumaClpRng.bd - 8 ) );
+  bReliable = field->errors[ idx ] <= maxError;
+  return true;
+}
+
+
+bool InterSearch::xTZSearchMctfCand( const PredictionUnit& pu, RefPicList refPicList, int iRefIdxPred, TZSearchStruct& cStruct )
+{
+  bool bReliable = false;
+  Mv   cMctfMv;
+  if( !xGetMctfStartMv( pu, *pu.cu->slice->getRefPic( refPicList, iRefIdxPred ), cMctfMv, bReliable ) )
+  {
+    return false;
+  }
+
+  clipMv( cMctfMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->pcv );
+  cMctfMv.changePrecision( MV_PRECISION_INTERNAL, MV_PRECISION_INT );
+  if( cMctfMv.hor == cStruct.iBestX && cMctfMv.ver == cStruct.iBestY )
+  {
+    return bReliable;
+  }
+
+  xTZSearchHelp( cStruct, cMctfMv.hor, cMctfMv.ver, 0, 0 );
+  return bReliable && cMctfMv.hor == cStruct.iBestX && cMctfMv.ver == cStruct.iBestY;
+}
+
+
+bool InterSearch::xTZSearchAnalysisCand( const PredictionUnit& pu, RefPicList refPicList, int iRefIdxPred, TZSearchStruct& cStruct )
+{
+  const PicAnalysis& analysis = pu.cs->picture->analysis;
+  if( !analysis.valid() )
+  {
+    return false;
+  }
+
+  // the motion chosen at the co-located block by the previous encoding, if it used the same reference
+  const CompArea&    blk = pu.blocks[ COMP_Y ];
+  const AnalysisBlk& ref = analysis.at( blk.x + ( blk.width >> 1 ), blk.y + ( blk.height >> 1 ) );
+  if( !( ref.interDir & ( 1 << refPicList ) ) || ref.refIdx[ refPicList ] != iRefIdxPred )
+  {
+    return false;
+  }
+
+  Mv cAnalysisMv = ref.mv[ refPicList ];
+  clipMv( cAnalysisMv, pu.cu->lumaPos(), pu.cu->lumaSize(), *pu.cs->pcv );
+  cAnalysisMv.changePrecision( MV_PRECISION_INTERNAL, MV_PRECISION_INT );
+  if( cAnalysisMv.hor != cStruct.iBestX || cAnalysisMv.ver != cStruct.iBestY )
+  {
+    xTZSearchHelp( cStruct, cAnalysisMv.hor, cAnalysisMv.ver, 0, 0 );
+  }
+  return cAnalysisMv.hor == cStruct.iBestX && cAnalysisMv.ver == cStruct.iBestY;
+}
+
+
+bool InterSearch::xHashMotionSearch( const PredictionUnit& pu, const CPelBuf& pattern, const Picture& refPic, const int imvShift, Mv& rcMv, Distortion& ruiDist )
+{
+  const CompArea& blk = pu.blocks[ COMP_Y ];
+  if( !refPic.blockHash.isValid() || !BlockHash::isSupported( blk.width, blk.height ) )
+  {
+    return false;
+  }
+
+  // the hash tables are built from the original samples, lossy reconstructions rarely match exactly
+  const CPelBuf orgBlk = pu.cs->picture->getOrigBuf( blk );
+  static const int MAX_HASH_CAND = 64;
+  Position cand[ MAX_HASH_CAND ];
+  const int numCand = refPic.blockHash.getCandidates( BlockHash::getBlockHash( orgBlk ), floorLog2( blk.width ), cand, MAX_HASH_CAND );
+  if( numCand == 0 )
+  {
+    return false;
+  }
+
+  const CPelBuf refOrg     = refPic.getOrigBuf( COMP_Y );
+  const CPelBuf refReco    = refPic.getRecoBuf( COMP_Y );
+  Distortion    bestCost   = MAX_DISTORTION;
+  DistParam     cMatchParam;
+  m_pcRdCost->setDistParam( cMatchParam,  orgBlk,  refOrg.buf,  refOrg.stride,  m_lumaClpRng.bd, COMP_Y, 0 );
+  m_pcRdCost->setDistParam( m_cDistParam, pattern, refReco.buf, refReco.stride, m_lumaClpRng.bd, COMP_Y, 0 );
+
+  for( int i = 0; i < numCand; i++ )
+  {
+    // the hash only preselects the candidates, the original samples have to match exactly
+    cMatchParam.cur.buf = refOrg.bufAt( cand[ i ] );
+    if( cMatchParam.distFunc( cMatchParam ) != 0 )
+    {
+      continue;
+    }
+    const Mv cMv( cand[ i ].x - blk.x, cand[ i ].y - blk.y );
+    m_cDistParam.cur.buf = refReco.bufAt( cand[ i ] );
+    const Distortion uiDist = m_cDistParam.distFunc( m_cDistParam );
+    const Distortion uiCost = uiDist + m_pcRdCost->getCostOfVectorWithPredictor( cMv.hor, cMv.ver, imvShift );
+    if( uiCost < bestCost )
+    {
+      bestCost = uiCost;
+      ruiDist  = uiDist;
+      rcMv     = cMv;
+    }
+  }
+
+  return bestCost != MAX_DISTORTION;
+}
+
+
 void InterSearch::xSetSearchRange ( const PredictionUnit& pu,
                                     const Mv& cMvPred,
                                     const int iSrchRng,
@@ -2294,11 +2478,20 @@ void InterSearch::xTZSearch( const PredictionUnit& pu,
     }
   }
 
+  if( m_pcEncCfg->m_MCTFMotionSeed && xTZSearchMctfCand( pu, refPicList, iRefIdxPred, cStruct ) )
+  {
+    iSearchRange >>= 1;
+  }
+  if( m_pcEncCfg->m_analysisMode == 2 && xTZSearchAnalysisCand( pu, refPicList, iRefIdxPred, cStruct ) )
+  {
+    iSearchRange >>= 1;
+  }
+
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
     currBestMv <<= MV_FRACTIONAL_BITS_INTERNAL;
-    xSetSearchRange(pu, currBestMv, m_iSearchRange >> (bFastSettings ? 1 : 0), sr );
+    xSetSearchRange(pu, currBestMv, iSearchRange >> (bFastSettings ? 1 : 0), sr );
   }
 
   // start search
@@ -2502,8 +2695,7 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
   const bool bStarRefinementDiamond   = true;   // 1 = xTZ8PointDiamondSearch   0 = xTZ8PointSquareSearch
   const bool bStarRefinementStop      = false;
   const uint32_t uiStarRefinementRounds   = 2;  // star refinement stop X rounds after best match (must be >=1)
-  const int  iSearchRange             = m_iSearchRange;
-  const int  iSearchRangeInitial      = m_iSearchRange >> 2;
+  int        iSearchRange             = m_iSearchRange;
   const int  uiSearchStep             = 4;
   const int  iMVDistThresh            = 8;
 
@@ -2578,11 +2770,21 @@ void InterSearch::xTZSearchSelective( const PredictionUnit& pu,
     }
   }
 
+  if( m_pcEncCfg->m_MCTFMotionSeed && xTZSearchMctfCand( pu, refPicList, iRefIdxPred, cStruct ) )
+  {
+    iSearchRange >>= 1;
+  }
+  if( m_pcEncCfg->m_analysisMode == 2 && xTZSearchAnalysisCand( pu, refPicList, iRefIdxPred, cStruct ) )
+  {
+    iSearchRange >>= 1;
+  }
+  const int  iSearchRangeInitial      = iSearchRange >> 2;
+
   {
     // set search range
     Mv currBestMv(cStruct.iBestX, cStruct.iBestY );
     currBestMv <<= 2;
-    xSetSearchRange( pu, currBestMv, m_iSearchRange, sr );
+    xSetSearchRange( pu, currBestMv, iSearchRange, sr );
   }
 
   // Initial search
@@ -2776,7 +2978,7 @@ void InterSearch::xPatternSearchFracDIF(
 
   //  Half-pel refinement
   m_pcRdCost->setCostScale(1);
-  if( 0 == m_pcEncCfg->m_fastSubPel )
+  if( 0 == m_speedParams.fastSubPel )
   {
     xExtDIFUpSamplingH( &cPatternRoi, cStruct.useAltHpelIf );
   }
@@ -2786,7 +2988,7 @@ void InterSearch::xPatternSearchFracDIF(
   Distortion  uiDistBest = MAX_DISTORTION;
   int patternId = 41;
   ruiCost = xPatternRefinement( cStruct.pcPatternKey, baseRefMv, 2, rcMvHalf, ( !pu.cs->slice->disableSATDForRd ), uiDistBest, patternId, &cPatternRoi, cStruct.useAltHpelIf );
-  patternId -= ( m_pcEncCfg->m_fastSubPel ? 41 : 0 );
+  patternId -= ( m_speedParams.fastSubPel ? 41 : 0 );
 
 
   //  quarter-pel refinement
@@ -5669,8 +5871,19 @@ uint32_t InterSearch::xCalcAffineMVBits(PredictionUnit& pu, Mv acMvTemp[3], Mv a
 //! set adaptive search range based on poc difference
 void InterSearch::setSearchRange( const Slice* slice, const EncCfg& encCfg )
 {
+  int iMaxSR = encCfg.m_SearchRange >> m_speedParams.searchRangeShift;
+  int iMinSR = encCfg.m_minSearchWindow >> m_speedParams.searchRangeShift;
+
   if( !encCfg.m_bUseASR || slice->isIRAP() )
   {
+    // the speed control may change the range from picture to picture
+    for( uint32_t iDir = 0; iDir < MAX_NUM_REF_LIST_ADAPT_SR; iDir++ )
+    {
+      for( uint32_t iRefIdx = 0; iRefIdx < MAX_IDX_ADAPT_SR; iRefIdx++ )
+      {
+        m_aaiAdaptSR[iDir][iRefIdx] = iMaxSR;
+      }
+    }
     return;
   }
 
@@ -5678,7 +5891,6 @@ void InterSearch::setSearchRange( const Slice* slice, const EncCfg& encCfg )
   int iRefPOC;
   int iGOPSize = encCfg.m_GOPSize;
   int iOffset = (iGOPSize >> 1);
-  int iMaxSR = encCfg.m_SearchRange;
   int iNumPredDir = slice->isInterP() ? 1 : 2;
 
   for (int iDir = 0; iDir < iNumPredDir; iDir++)
@@ -5687,7 +5899,7 @@ void InterSearch::setSearchRange( const Slice* slice, const EncCfg& encCfg )
     for (int iRefIdx = 0; iRefIdx < slice->numRefIdx[e]; iRefIdx++)
     {
       iRefPOC = slice->getRefPic(e, iRefIdx)->getPOC();
-      int newSearchRange = Clip3(encCfg.m_minSearchWindow, iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
+      int newSearchRange = Clip3(iMinSR, iMaxSR, (iMaxSR*ADAPT_SR_SCALE*abs(iCurrPOC - iRefPOC)+iOffset)/iGOPSize);
       m_aaiAdaptSR[iDir][iRefIdx] = newSearchRange;
     }
   }
@@ -46,6 +46,7 @@ vvc@hhi.fraunhofer.de
 #pragma once
 
 #include "CABACWriter.h"
+#include "SpeedCtrl.h"
 #include "CommonLib/MotionInfo.h"
 #include "CommonLib/InterPrediction.h"
 #include "CommonLib/TrQuant.h"
@@ -349,6 +350,7 @@ protected:
   int               m_bipredSearchRange; // Search range for bi-prediction
   MESearchMethod    m_motionEstimationSearchMethod;
   int               m_aaiAdaptSR[MAX_NUM_REF_LIST_ADAPT_SR][MAX_IDX_ADAPT_SR];
+  SpeedParams       m_speedParams;
 
   // RD computation
   CABACWriter*      m_CABACEstimator;
@@ -391,6 +393,7 @@ public:
   void encodeResAndCalcRdInterCU    ( CodingStructure &cs, Partitioner &partitioner, const bool skipResidual );
 
   void setSearchRange               ( const Slice* slice, const EncCfg& encCfg );
+  void setSpeedParams               ( const SpeedParams& speedParams ) { m_speedParams = speedParams; }
 
   void resetSavedAffineMotion       ();
   void storeAffineMotion            ( Mv acAffineMv[2][3], int16_t affineRefIdx[2], EAffineModel affineType, int BcwIdx);
@@ -533,6 +536,32 @@ private:
                                     Distortion&           ruiCost
                                   );
 
+  bool xHashMotionSearch          ( const PredictionUnit& pu,
+                                    const CPelBuf&        pattern,
+                                    const Picture&        refPic,
+                                    const int             imvShift,
+                                    Mv&                   rcMv,
+                                    Distortion&           ruiDist
+                                  );
+
+  bool xGetMctfStartMv            ( const PredictionUnit& pu,
+                                    const Picture&        refPic,
+                                    Mv&                   rcMv,
+                                    bool&                 bReliable
+                                  ) const;
+
+  bool xTZSearchMctfCand          ( const PredictionUnit& pu,
+                                    RefPicList            refPicList,
+                                    int                   iRefIdxPred,
+                                    TZSearchStruct&       cStruct
+                                  );
+
+  bool xTZSearchAnalysisCand      ( const PredictionUnit& pu,
+                                    RefPicList            refPicList,
+                                    int                   iRefIdxPred,
+                                    TZSearchStruct&       cStruct
+                                  );
+
   void xPredAffineInterSearch     ( PredictionUnit&       pu,
                                     CPelUnitBuf&          origBuf,
                                     int                   puIdx,
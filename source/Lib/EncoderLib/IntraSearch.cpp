@@ -83,6 +83,7 @@ void IntraSearch::init(const EncCfg &encCfg, TrQuant *pTrQuant, RdCost *pRdCost,
   m_pcTrQuant         = pTrQuant;
   m_pcRdCost          = pRdCost;
   m_SortedPelUnitBufs = pSortedPelUnitBufs;
+  m_speedParams       = SpeedCtrl::getSpeedParams( encCfg, 0 );
 
   const ChromaFormat chrFormat = encCfg.m_internChromaFormat;
   const int maxCUSize          = encCfg.m_CTUSize;
@@ -245,10 +246,14 @@ void IntraSearch::xEstimateLumaRdModeList(int& numModesForFullRD,
 
   bool satdChecked[NUM_INTRA_MODE] = { false };
 
+  // the restricted angle search starts with every fourth angular mode and refines by two
+  const unsigned angStepMask = m_speedParams.fastIntraAngles ? 3 : 1;
+  const int      angRefStep  = m_speedParams.fastIntraAngles ? 2 : 1;
+
   for( unsigned mode = 0; mode < numModesAvailable; mode++ )
   {
     // Skip checking extended Angular modes in the first round of SATD
-    if( mode > DC_IDX && ( mode & 1 ) )
+    if( mode > DC_IDX && ( mode & angStepMask ) )
     {
       continue;
     }
@@ -285,9 +290,9 @@ void IntraSearch::xEstimateLumaRdModeList(int& numModesForFullRD,
   for (unsigned modeIdx = 0; modeIdx < numModesForFullRD; modeIdx++)
   {
     unsigned parentMode = parentCandList[modeIdx].modeId;
-    if (parentMode > (DC_IDX + 1) && parentMode < (NUM_LUMA_MODE - 1))
+    if (parentMode > (DC_IDX + angRefStep) && parentMode < (NUM_LUMA_MODE - angRefStep))
     {
-      for (int subModeIdx = -1; subModeIdx <= 1; subModeIdx += 2)
+      for (int subModeIdx = -angRefStep; subModeIdx <= angRefStep; subModeIdx += 2 * angRefStep)
       {
         unsigned mode = parentMode + subModeIdx;
 
@@ -469,6 +474,10 @@ bool IntraSearch::estIntraPredLumaQT(CodingUnit &cu, Partitioner &partitioner, d
 #if INTRA_FULL_SEARCH
   numModesForFullRD = numModesAvailable;
 #endif
+  if( m_speedParams.maxIntraRdCand > 0 )
+  {
+    numModesForFullRD = std::min( numModesForFullRD, m_speedParams.maxIntraRdCand );
+  }
   const SPS& sps = *cu.cs->sps;
   const bool mipAllowed = sps.MIP && pu.lwidth() <= sps.getMaxTbSize() && pu.lheight() <= sps.getMaxTbSize() && ((cu.lfnstIdx == 0) || allowLfnstWithMip(cu.pu->lumaSize()));
   const int SizeThr = 8>>std::max(0,m_pcEncCfg->m_useFastMIP-2);
@@ -46,6 +46,7 @@ vvc@hhi.fraunhofer.de
 #pragma once
 
 #include "CABACWriter.h"
+#include "SpeedCtrl.h"
 #include "CommonLib/IntraPrediction.h"
 #include "CommonLib/TrQuant.h"
 #include "CommonLib/Unit.h"
@@ -101,11 +102,13 @@ protected:
   CtxCache*       m_CtxCache;
 
   SortedPelUnitBufs<SORTED_BUFS> *m_SortedPelUnitBufs;
+  SpeedParams     m_speedParams;
 public:
   IntraSearch();
   ~IntraSearch();
   void init                       ( const EncCfg &encCfg, TrQuant *pTrQuant, RdCost *pRdCost, SortedPelUnitBufs<SORTED_BUFS> *pSortedPelUnitBufs, XUCache &unitCache);
   void setCtuEncRsrc              ( CABACWriter* cabacEstimator, CtxCache* ctxCache );
+  void setSpeedParams             ( const SpeedParams& speedParams ) { m_speedParams = speedParams; }
   void destroy                    ();
 
   CodingStructure  **getSaveCSBuf () { return m_pSaveCS; }
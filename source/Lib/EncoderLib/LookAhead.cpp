@@ -0,0 +1,258 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     LookAhead.cpp
+    \brief    lookahead pre-analysis of the input pictures
+*/
+
+#include "LookAhead.h"
+#include "CommonLib/CommonDef.h"
+#include "vvenc/EncCfg.h"
+
+#include <cmath>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+static const int LA_SCALE_LOG2   = 2;   // the analysis runs on luma downscaled by 4 in both directions
+static const int LA_BLOCK_SIZE   = 8;   // analysis block size in the downscaled picture, 32x32 in the original
+static const int LA_SEARCH_RANGE = 2;   // motion search range in the downscaled picture, +-8 in the original
+
+static const double LA_CQ_QCOMP         = 0.6;  // QP compression of the constant quality mode, 0: constant QP, 1: constant complexity per QP
+static const double LA_CQ_CPLX_DECAY    = 0.5;  // decay of the complexity of the preceding pictures
+static const double LA_CQ_BASE_CPLX     = 8.0;  // complexity per downscaled sample at 8 bit, which keeps the QP unchanged
+static const int    LA_CQ_MAX_QP_OFFSET = 6;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+LookAhead::LookAhead()
+  : m_pcEncCfg        ( nullptr )
+  , m_lowResWidth     ( 0 )
+  , m_lowResHeight    ( 0 )
+  , m_curIdx          ( 0 )
+  , m_lastPoc         ( -1 )
+  , m_sceneCutPending ( false )
+  , m_cplxSum         ( 0.0 )
+  , m_cplxCount       ( 0.0 )
+{
+}
+
+
+void LookAhead::init( const EncCfg& encCfg )
+{
+  m_pcEncCfg     = &encCfg;
+  m_lowResWidth  = encCfg.m_SourceWidth  >> LA_SCALE_LOG2;
+  m_lowResHeight = encCfg.m_SourceHeight >> LA_SCALE_LOG2;
+  m_lowRes[ 0 ].resize( m_lowResWidth * m_lowResHeight );
+  m_lowRes[ 1 ].resize( m_lowResWidth * m_lowResHeight );
+  m_curIdx          = 0;
+  m_lastPoc         = -1;
+  m_sceneCutPending = false;
+  m_cplxSum         = 0.0;
+  m_cplxCount       = 0.0;
+}
+
+
+void LookAhead::analysePicture( Picture& pic )
+{
+  const int poc          = pic.getPOC();
+  pic.isSceneCutIrap     = false;
+  pic.lookAheadIntraCost = 0;
+  pic.lookAheadInterCost = 0;
+  pic.lookAheadQpOffset  = 0;
+  if( m_lowResWidth < LA_BLOCK_SIZE || m_lowResHeight < LA_BLOCK_SIZE )
+  {
+    return;
+  }
+
+  Pel* cur = m_lowRes[ m_curIdx ].data();
+  xDownscale( pic.getOrigBuf().Y(), cur );
+
+  const bool hasRef = m_lastPoc >= 0 && m_lastPoc + 1 == poc;
+  xGetPicCosts( cur, hasRef ? m_lowRes[ 1 - m_curIdx ].data() : nullptr, pic.lookAheadIntraCost, pic.lookAheadInterCost );
+
+  if( m_pcEncCfg->m_constQuality )
+  {
+    pic.lookAheadQpOffset = xGetQpOffset( pic, hasRef );
+  }
+
+  // the picture is a scene cut if predicting it from its predecessor is hardly cheaper than intra coding
+  const int threshold = m_pcEncCfg->m_sceneCutThreshold;
+  if( threshold > 0 && hasRef && pic.lookAheadIntraCost > 0 && pic.lookAheadInterCost * 100 >= pic.lookAheadIntraCost * ( 100 - threshold ) )
+  {
+    msg( DETAILS, "scene cut detected at POC %d\n", poc );
+    m_sceneCutPending = true;
+  }
+
+  // the GOP structure is fixed, so the CRA picture is placed at the first GOP boundary after the cut, the pictures of
+  // the cut GOP become its leading pictures and can predict from either side of the cut
+  if( poc % m_pcEncCfg->m_GOPSize == 0 )
+  {
+    pic.isSceneCutIrap = m_sceneCutPending && poc % m_pcEncCfg->m_IntraPeriod != 0;
+    m_sceneCutPending  = false;
+  }
+
+  m_lastPoc = poc;
+  m_curIdx  = 1 - m_curIdx;
+}
+
+
+int LookAhead::xGetQpOffset( const Picture& pic, bool hasRef )
+{
+  // the motion compensated cost is the complexity of a picture, it is blurred over the preceding pictures, so the QP
+  // does not follow every single picture, a picture without predecessor keeps the complexity of the previous ones
+  if( hasRef || m_cplxCount == 0.0 )
+  {
+    m_cplxSum   = m_cplxSum   * LA_CQ_CPLX_DECAY + double( pic.lookAheadInterCost ) / double( m_lowResWidth * m_lowResHeight );
+    m_cplxCount = m_cplxCount * LA_CQ_CPLX_DECAY + 1.0;
+  }
+
+  // as in CRF coding, the quantisation step size grows with complexity^(1-qcomp): complex and fast moving content
+  // masks distortion and its pictures are less useful as reference, simple content gets a lower QP
+  const double baseCplx = LA_CQ_BASE_CPLX * double( 1 << ( m_pcEncCfg->m_internalBitDepth[ CH_L ] - 8 ) );
+  const double cplx     = std::max( m_cplxSum / m_cplxCount, 0.1 * baseCplx );
+  const int    qpOffset = int( floor( 6.0 * ( 1.0 - LA_CQ_QCOMP ) * log2( cplx / baseCplx ) + 0.5 ) );
+
+  return Clip3( -LA_CQ_MAX_QP_OFFSET, LA_CQ_MAX_QP_OFFSET, qpOffset );
+}
+
+
+void LookAhead::xDownscale( const CPelBuf& src, Pel* dst ) const
+{
+  const int scale = 1 << LA_SCALE_LOG2;
+  const int shift = 2 * LA_SCALE_LOG2;
+  const int round = 1 << ( shift - 1 );
+
+  for( int y = 0; y < m_lowResHeight; y++ )
+  {
+    const Pel* srcRow = src.bufAt( 0, y << LA_SCALE_LOG2 );
+    for( int x = 0; x < m_lowResWidth; x++ )
+    {
+      const Pel* srcBlk = srcRow + ( x << LA_SCALE_LOG2 );
+      int sum = 0;
+      for( int j = 0; j < scale; j++, srcBlk += src.stride )
+      {
+        for( int i = 0; i < scale; i++ )
+        {
+          sum += srcBlk[ i ];
+        }
+      }
+      dst[ y * m_lowResWidth + x ] = Pel( ( sum + round ) >> shift );
+    }
+  }
+}
+
+
+Distortion LookAhead::xGetIntraCost( const Pel* cur, int x, int y, int w, int h ) const
+{
+  // deviation from the block mean as a cheap estimate of the intra coding cost
+  const Pel* blk = cur + y * m_lowResWidth + x;
+  int sum = 0;
+  for( int j = 0; j < h; j++ )
+  {
+    for( int i = 0; i < w; i++ )
+    {
+      sum += blk[ j * m_lowResWidth + i ];
+    }
+  }
+  const int mean = ( sum + ( ( w * h ) >> 1 ) ) / ( w * h );
+
+  Distortion cost = 0;
+  for( int j = 0; j < h; j++ )
+  {
+    for( int i = 0; i < w; i++ )
+    {
+      cost += abs( blk[ j * m_lowResWidth + i ] - mean );
+    }
+  }
+  return cost;
+}
+
+
+Distortion LookAhead::xGetInterCost( const Pel* cur, const Pel* ref, int x, int y, int w, int h, Distortion maxCost ) const
+{
+  const Pel* blk     = cur + y * m_lowResWidth + x;
+  Distortion minCost = maxCost;
+
+  for( int dy = std::max( -LA_SEARCH_RANGE, -y ); dy <= std::min( LA_SEARCH_RANGE, m_lowResHeight - h - y ); dy++ )
+  {
+    for( int dx = std::max( -LA_SEARCH_RANGE, -x ); dx <= std::min( LA_SEARCH_RANGE, m_lowResWidth - w - x ); dx++ )
+    {
+      const Pel* refBlk = ref + ( y + dy ) * m_lowResWidth + x + dx;
+      Distortion cost   = 0;
+      for( int j = 0; j < h && cost < minCost; j++ )
+      {
+        for( int i = 0; i < w; i++ )
+        {
+          cost += abs( blk[ j * m_lowResWidth + i ] - refBlk[ j * m_lowResWidth + i ] );
+        }
+      }
+      minCost = std::min( minCost, cost );
+    }
+  }
+  return minCost;
+}
+
+
+void LookAhead::xGetPicCosts( const Pel* cur, const Pel* ref, Distortion& intraCost, Distortion& interCost ) const
+{
+  intraCost = 0;
+  interCost = 0;
+
+  for( int y = 0; y < m_lowResHeight; y += LA_BLOCK_SIZE )
+  {
+    const int h = std::min( LA_BLOCK_SIZE, m_lowResHeight - y );
+    for( int x = 0; x < m_lowResWidth; x += LA_BLOCK_SIZE )
+    {
+      const int w = std::min( LA_BLOCK_SIZE, m_lowResWidth - x );
+      const Distortion blkIntraCost = xGetIntraCost( cur, x, y, w, h );
+      intraCost += blkIntraCost;
+      interCost += ref ? xGetInterCost( cur, ref, x, y, w, h, blkIntraCost ) : blkIntraCost;
+    }
+  }
+}
+
+} // namespace vvenc
+
+//! \}
+
@@ -45,7 +45,7 @@ vvc@hhi.fraunhofer.de
 #include "CommonLib/BitStream.h"
 #include <vector>
 #include <algorithm>
-#include <ostream>
+#include <cstring>
 #include "../../../include/vvenc/Nal.h"
 
 //! \ingroup EncoderLib
@@ -55,7 +55,7 @@ namespace vvenc {
 
 static const uint8_t emulation_prevention_three_byte = 3;
 
-void writeNalUnitHeader(std::ostream& out, OutputNALUnit& nalu)       // nal_unit_header()
+static void writeNalUnitHeader(std::vector<uint8_t>& out, OutputNALUnit& nalu)       // nal_unit_header()
 {
 OutputBitstream bsNALUHeader;
   int forbiddenZero = 0;
@@ -67,14 +67,37 @@ OutputBitstream bsNALUHeader;
   bsNALUHeader.write(nalu.m_nalUnitType, 5);      // nal_unit_type
   bsNALUHeader.write(nalu.m_temporalId + 1, 3);   // nuh_temporal_id_plus1
 
-  out.write(reinterpret_cast<const char*>(bsNALUHeader.getByteStream()), bsNALUHeader.getByteStreamLength());
+  out.insert(out.end(), bsNALUHeader.getByteStream(), bsNALUHeader.getByteStream() + bsNALUHeader.getByteStreamLength());
 }
 /**
- * write nalu to bytestream out, performing RBSP anti startcode
- * emulation as required.  nalu.m_RBSPayload must be byte aligned.
+ * append nalu with its start code to the annex B byte stream of au,
+ * performing RBSP anti startcode emulation as required.
+ * nalu.m_RBSPayload must be byte aligned.
  */
-void write(std::ostream& out, OutputNALUnit& nalu)
+void write(AccessUnit& au, OutputNALUnit& nalu)
 {
+  std::vector<uint8_t>& out = au.m_annexB;
+
+  /* From AVC, When any of the following conditions are fulfilled, the
+   * zero_byte syntax element shall be present:
+   *  - the nal_unit_type within the nal_unit() is equal to 7 (sequence
+   *    parameter set) or 8 (picture parameter set),
+   *  - the byte stream NAL unit syntax structure contains the first NAL
+   *    unit of an access unit in decoding order, as specified by subclause
+   *    7.4.1.2.3.
+   */
+  static const uint8_t start_code_prefix[] = {0,0,0,1};
+  const bool zeroByte = au.empty()
+                     || nalu.m_nalUnitType == NAL_UNIT_DCI
+                     || nalu.m_nalUnitType == NAL_UNIT_VPS
+                     || nalu.m_nalUnitType == NAL_UNIT_SPS
+                     || nalu.m_nalUnitType == NAL_UNIT_PPS
+                     || nalu.m_nalUnitType == NAL_UNIT_PREFIX_APS
+                     || nalu.m_nalUnitType == NAL_UNIT_SUFFIX_APS;
+  au.push_back( NALUnitEBSP( nalu, uint32_t( out.size() ), zeroByte ? 4 : 3 ) );
+  out.insert(out.end(), zeroByte ? start_code_prefix : start_code_prefix+1, start_code_prefix+4);
+
+  const std::size_t nalStart = out.size();
   writeNalUnitHeader(out, nalu);
   /* write out rsbp_byte's, inserting any required
    * emulation_prevention_three_byte's */
@@ -96,15 +119,33 @@ void write(std::ostream& out, OutputNALUnit& nalu)
    *  - 0x00000302
    *  - 0x00000303
    */
-  std::vector<uint8_t>& rbsp   = nalu.m_Bitstream.getFIFO();
-
-  std::vector<uint8_t> outputBuffer;
-  outputBuffer.resize(rbsp.size()*2+1); //there can never be enough emulation_prevention_three_bytes to require this much space
-  std::size_t outputAmount = 0;
+  std::vector<uint8_t>& rbsp     = nalu.m_Bitstream.getFIFO();
+  const uint8_t*        rbspData = rbsp.data();
+  const std::size_t     rbspSize = rbsp.size();
+
+  // write the rbsp bytes directly into the byte stream, at most every second byte can be followed by an emulation_prevention_three_byte
+  std::size_t outputAmount = out.size();
+  out.resize(outputAmount + rbspSize + rbspSize/2 + 2);
+  uint8_t*    outputBuffer = out.data();
   int         zeroCount    = 0;
-  for (std::vector<uint8_t>::iterator it = rbsp.begin(); it != rbsp.end(); it++)
+  std::size_t pos          = 0;
+  while (pos < rbspSize)
   {
-    const uint8_t v=(*it);
+    if (zeroCount == 0)
+    {
+      // nothing has to be inserted before the next pair of zero bytes, copy up to there at once
+      const std::size_t next = g_bitstreamOps.findZeroPair(rbspData, pos, rbspSize);
+      if (next > pos)
+      {
+        memcpy(outputBuffer + outputAmount, rbspData + pos, next - pos);
+        outputAmount += next - pos;
+        zeroCount     = rbspData[next - 1] == 0 ? 1 : 0;
+        pos           = next;
+        continue;
+      }
+    }
+
+    const uint8_t v=rbspData[pos++];
     if (zeroCount==2 && v<=3)
     {
       outputBuffer[outputAmount++]=emulation_prevention_three_byte;
@@ -131,7 +172,8 @@ void write(std::ostream& out, OutputNALUnit& nalu)
   {
     outputBuffer[outputAmount++]=emulation_prevention_three_byte;
   }
-  out.write(reinterpret_cast<const char*>(&(*outputBuffer.begin())), outputAmount);
+  out.resize(outputAmount);
+  au.back().m_nalUnitSize = uint32_t(outputAmount - nalStart);
 }
 
 } // namespace vvenc
@@ -43,7 +43,6 @@ vvc@hhi.fraunhofer.de
 
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/BitStream.h"
-#include <ostream>
 #include "../../../include/vvenc/Nal.h"
 
 //! \ingroup EncoderLib
@@ -80,13 +79,7 @@ struct OutputNALUnit : public NALUnit
   OutputBitstream m_Bitstream;
 };
 
-void write(std::ostream& out, OutputNALUnit& nalu);
-
-inline NALUnitEBSP::NALUnitEBSP(OutputNALUnit& nalu)
-  : NALUnit(nalu)
-{
-  write(m_nalUnitData, nalu);
-}
+void write(AccessUnit& au, OutputNALUnit& nalu);
 
 } // namespace vvenc
 
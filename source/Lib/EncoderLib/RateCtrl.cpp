@@ -48,6 +48,7 @@ vvc@hhi.fraunhofer.de
 #include "CommonLib/Picture.h"
 
 #include <cmath>
+#include <sstream>
 
 namespace vvenc {
 
@@ -69,6 +70,9 @@ static const double RC_BETA_MAX_VALUE =                             -0.1;
 static const double RC_ALPHA =                                    6.7542;
 static const double RC_BETA1 =                                    1.2517;
 static const double RC_BETA2 =                                    1.7860;
+static const double RC_VBV_SAFETY_MARGIN =                           0.1;    // part of the VBV buffer kept as reserve against model errors
+static const int    RC_VBV_MAX_CTU_QP_OFFSET =                         6;
+static const double RC_VBV_LOW_FULLNESS =                            0.5;
 
 //sequence level
 EncRCSeq::EncRCSeq()
@@ -103,6 +107,10 @@ EncRCSeq::EncRCSeq()
   alphaUpdate         = 0.0;
   betaUpdate          = 0.0;
   bitDepth            = 0;
+  firstPassAvgWeight  = 0.0;
+  vbvBufferSize       = 0;
+  vbvFillPerPic       = 0.0;
+  vbvFullness         = 0.0;
 }
 
 EncRCSeq::~EncRCSeq()
@@ -318,6 +326,96 @@ void EncRCSeq::updateAfterPic ( int bits )
   framesCoded++;
   bitsLeft -= bits;
   framesLeft--;
+
+  if ( isVBVEnabled() )
+  {
+    vbvFullness -= bits;
+    if ( vbvFullness < 0.0 )
+    {
+      msg( WARNING, "\nWarning: VBV underflow by %d bits\n", int( -vbvFullness ) );
+      vbvFullness = 0.0;
+    }
+    vbvFullness = std::min( vbvFullness + vbvFillPerPic, (double)vbvBufferSize );
+  }
+}
+
+void EncRCSeq::initVBV( int maxBitrate, int bufferSize, double initialFullness )
+{
+  vbvBufferSize = bufferSize;
+  vbvFillPerPic = (double)maxBitrate / (double)frameRate;
+  vbvFullness   = initialFullness * bufferSize;
+}
+
+int EncRCSeq::getVBVMaxPicBits() const
+{
+  // keep a reserve in the buffer, but always allow a part of the bits arriving during one picture period
+  const double maxBits = std::max( vbvFullness - RC_VBV_SAFETY_MARGIN * vbvBufferSize, 0.5 * std::min( vbvFullness, vbvFillPerPic ) );
+  return std::max( 1, int( maxBits ) );
+}
+
+void EncRCSeq::initTwoPass( const std::vector<TRCPassStats>& passStats )
+{
+  CHECK( passStats.empty(), "No first pass statistics available" );
+
+  // the first pass bits are normalised to the mean QP of their temporal layer, so QP changes made by the first pass
+  // (rate control or QPA) do not distort the measured complexity, while the QP hierarchy of the GOP is kept
+  double qpSum[ MAX_TLAYER ]   = { 0.0 };
+  int    numPics[ MAX_TLAYER ] = { 0 };
+  int    maxPoc = 0;
+  for ( const TRCPassStats& stats : passStats )
+  {
+    const int tLayer = Clip3( 0, MAX_TLAYER - 1, stats.tempLayer );
+    qpSum  [ tLayer ] += stats.qp;
+    numPics[ tLayer ] += 1;
+    maxPoc = std::max( maxPoc, stats.poc );
+  }
+
+  TRCPassStats missingPic = { -1, 0, 0, 0, 0, 0, 0 };
+  firstPassStats.assign( maxPoc + 1, missingPic );
+  firstPassWeight.assign( maxPoc + 1, 0.0 );
+  double weightSum = 0.0;
+  for ( const TRCPassStats& stats : passStats )
+  {
+    const int    tLayer = Clip3( 0, MAX_TLAYER - 1, stats.tempLayer );
+    const double weight = std::max( stats.numBits, 1 ) * pow( 2.0, ( stats.qp - qpSum[ tLayer ] / numPics[ tLayer ] ) / 6.0 );
+    firstPassStats [ stats.poc ] = stats;
+    firstPassWeight[ stats.poc ] = weight;
+    weightSum += weight;
+  }
+  firstPassAvgWeight = weightSum / passStats.size();
+
+  if ( totalFrames <= 0 )
+  {
+    // the sequence length is known from the first pass
+    totalFrames = maxPoc + 1;
+    targetBits  = (int64_t)totalFrames * (int64_t)targetRate / (int64_t)frameRate;
+    framesLeft  = totalFrames - framesCoded;
+    bitsLeft    = targetBits - bitsUsed;
+  }
+}
+
+double EncRCSeq::getFirstPassWeight( int poc ) const
+{
+  // pictures missing in the first pass get the average demand
+  if ( poc < 0 || poc >= (int)firstPassWeight.size() || firstPassWeight[ poc ] <= 0.0 )
+  {
+    return firstPassAvgWeight;
+  }
+  return firstPassWeight[ poc ];
+}
+
+double EncRCSeq::getFirstPassLambda( int poc, int targetBits ) const
+{
+  if ( poc < 0 || poc >= (int)firstPassStats.size() || firstPassStats[ poc ].poc < 0 || targetBits <= 0 )
+  {
+    return -1.0;
+  }
+
+  // move from the rate-QP point of the first pass assuming the bits halve every 6 QP steps
+  const TRCPassStats& stats = firstPassStats[ poc ];
+  const int    bitdepthLumaScale = 2 * ( bitDepth - 8 - DISTORTION_PRECISION_ADJUSTMENT( bitDepth ) );
+  const double estQP = stats.qp + 6.0 * log2( std::max( stats.numBits, 1 ) / (double)targetBits );
+  return pow( 2.0, bitdepthLumaScale ) * exp( ( estQP - 13.7122 ) / 4.2005 );
 }
 
 void EncRCSeq::setAllBitRatio( double basicLambda, double* equaCoeffA, double* equaCoeffB )
@@ -362,6 +460,7 @@ EncRCGOP::EncRCGOP()
   maxEstLambda       = 0.0;
   gopQP              = 0;
   idealTargetGOPBits = -1;
+  firstPassWeightLeft = 0.0;
 }
 
 EncRCGOP::~EncRCGOP()
@@ -600,6 +699,27 @@ void EncRCGOP::updateAfterPicture( int bitsCost )
 
 int EncRCGOP::xEstGOPTargetBits( EncRCSeq* encRCSeq, int GOPSize )
 {
+  if ( encRCSeq->isTwoPass() )
+  {
+    // distribute the remaining bits in proportion to the bit demand measured in the first pass,
+    // the pictures of the GOP directly follow the pictures coded so far
+    const int firstPoc = encRCSeq->framesCoded;
+    double leftWeight  = 0.0;
+    firstPassWeightLeft = 0.0;
+    for ( int poc = firstPoc; poc < std::max( encRCSeq->totalFrames, firstPoc + GOPSize ); poc++ )
+    {
+      const double weight = encRCSeq->getFirstPassWeight( poc );
+      leftWeight += weight;
+      if ( poc < firstPoc + GOPSize )
+      {
+        firstPassWeightLeft += weight;
+      }
+    }
+
+    idealTargetGOPBits = (int)( GOPSize * encRCSeq->targetRate / (double)encRCSeq->frameRate );
+    return std::max( 200, (int)( encRCSeq->getBitsLeft() * firstPassWeightLeft / leftWeight ) );
+  }
+
   int realInfluencePicture = encRCSeq->totalFrames > 0 ? std::min( 8 < encRCSeq->intraPeriod ? encRCSeq->intraPeriod + encRCSeq->gopSize : RC_SMOOTH_WINDOW_SIZE, encRCSeq->framesLeft ) :
                                                              ( 8 < encRCSeq->intraPeriod ? encRCSeq->intraPeriod + encRCSeq->gopSize : RC_SMOOTH_WINDOW_SIZE );
   double averageTargetBitsPerPic = ( (double)( encRCSeq->targetRate ) / encRCSeq->frameRate );
@@ -632,7 +752,14 @@ EncRCPic::EncRCPic()
   picEstLambda        = 0.0;
   lcuLeft             = 0;
   bitsLeft            = 0;
+  vbvQPOffset         = 0;
+  picWidthInLCU       = 0;
+  vbvMaxBits          = 0;
+  vbvLimited          = false;
+  vbvCodedBits        = 0;
+  vbvCodedPixels      = 0;
   lcu                 = NULL;
+  poc                 = 0;
   picActualHeaderBits = 0;
   picActualBits       = 0;
   picQP               = 0;
@@ -651,6 +778,15 @@ int EncRCPic::xEstPicTargetBits( EncRCSeq* encRcSeq, EncRCGOP* encRcGOP )
   int targetBits        = 0;
   int GOPbitsLeft       = encRcGOP->bitsLeft;
 
+  if ( encRcSeq->isTwoPass() )
+  {
+    // share of the bits left in the GOP according to the first pass
+    const double weight = encRcSeq->getFirstPassWeight( poc );
+    targetBits = std::max( 100, int( (double)GOPbitsLeft * weight / std::max( encRcGOP->firstPassWeightLeft, weight ) ) );
+    encRcGOP->firstPassWeightLeft -= weight;
+    return targetBits;
+  }
+
   int currPicPosition = encRcGOP->numPics - encRcGOP->picsLeft;
   int currPicRatio    = encRcSeq->bitsRatio[ currPicPosition ];
   int totalPicRatio   = 0;
@@ -711,15 +847,30 @@ void EncRCPic::addToPictureList( std::list<EncRCPic*>& listPreviousPictures )
   listPreviousPictures.push_back( this );
 }
 
-void EncRCPic::create( EncRCSeq* encRcSeq, EncRCGOP* encRcGOP, int frameLvl, std::list<EncRCPic*>& listPreviousPictures )
+void EncRCPic::create( EncRCSeq* encRcSeq, EncRCGOP* encRcGOP, int frameLvl, int POC, std::list<EncRCPic*>& listPreviousPictures )
 {
   destroy();
   encRCSeq = encRcSeq;
   encRCGOP = encRcGOP;
+  poc      = POC;
 
   int tgtBits    = xEstPicTargetBits( encRcSeq, encRcGOP );
   int estHeadBits = xEstPicHeaderBits( listPreviousPictures, frameLvl );
 
+  vbvMaxBits = 0;
+  vbvLimited = false;
+  if ( encRcSeq->isVBVEnabled() )
+  {
+    vbvMaxBits = encRcSeq->getVBVMaxPicBits();
+    if ( tgtBits > vbvMaxBits )
+    {
+      tgtBits    = vbvMaxBits;
+      vbvLimited = true;
+    }
+    // with a draining buffer the model estimate is followed even if it deviates from the previous pictures
+    vbvLimited |= encRcSeq->getVBVFullness() < RC_VBV_LOW_FULLNESS * encRcSeq->getVBVBufferSize();
+  }
+
   if ( tgtBits < estHeadBits + 100 )
   {
     tgtBits = estHeadBits + 100;   // at least allocate 100 bits for picture data
@@ -736,7 +887,7 @@ void EncRCPic::create( EncRCSeq* encRcSeq, EncRCGOP* encRcGOP, int frameLvl, std
   int picHeight      = encRcSeq->picHeight;
   int LCUWidth       = encRcSeq->lcuWidth;
   int LCUHeight      = encRcSeq->lcuHeight;
-  int picWidthInLCU  = ( picWidth  % LCUWidth  ) == 0 ? picWidth  / LCUWidth  : picWidth  / LCUWidth  + 1;
+  picWidthInLCU      = ( picWidth  % LCUWidth  ) == 0 ? picWidth  / LCUWidth  : picWidth  / LCUWidth  + 1;
   int picHeightInLCU = ( picHeight % LCUHeight ) == 0 ? picHeight / LCUHeight : picHeight / LCUHeight + 1;
 
   lcuLeft         = numberOfLCU;
@@ -770,6 +921,9 @@ void EncRCPic::create( EncRCSeq* encRcSeq, EncRCGOP* encRcGOP, int frameLvl, std
   picLambda           = 0.0;
   picLambdaOffsetQPA  = 0.0;
   picMSE              = 0.0;
+  vbvQPOffset         = 0;
+  vbvCodedBits        = 0;
+  vbvCodedPixels      = 0;
 }
 
 void EncRCPic::destroy()
@@ -812,6 +966,8 @@ double EncRCPic::estimatePicLambda( std::list<EncRCPic*>& listPreviousPictures,
     estLambda = alpha * pow( bpp, beta );
   }
 
+  const double vbvLambda = estLambda;   // lambda reaching the VBV limited target bits
+
   bool setLastLevelLambda = false;
   double lastPrevTLLambda = -1.0;
   double lastLevelLambda = -1.0;
@@ -841,6 +997,16 @@ double EncRCPic::estimatePicLambda( std::list<EncRCPic*>& listPreviousPictures,
     }
   }
 
+  if ( ! setLastLevelLambda && encRCSeq->isTwoPass() )
+  {
+    // the model of this level is not trained yet, start from the first pass result instead
+    const double firstPassLambda = encRCSeq->getFirstPassLambda( poc, targetBits );
+    if ( firstPassLambda > 0.0 )
+    {
+      estLambda = firstPassLambda;
+    }
+  }
+
   if ( lastLevelLambda > 0.0 )
   {
     lastLevelLambda = Clip3( encRCGOP->minEstLambda, encRCGOP->maxEstLambda, lastLevelLambda );
@@ -916,6 +1082,12 @@ double EncRCPic::estimatePicLambda( std::list<EncRCPic*>& listPreviousPictures,
     estLambda = encRCGOP->minEstLambda;
   }
 
+  if ( vbvLimited )
+  {
+    // the clipping to the lambdas of previous pictures must not undo the VBV restriction
+    estLambda = std::max( estLambda, std::min( vbvLambda, encRCGOP->maxEstLambda ) );
+  }
+
   //Avoid different results in different platforms. The problem is caused by the different results of pow() in different platforms.
   estLambda = double( int64_t( estLambda * (double)RC_LAMBDA_PREC + 0.5 ) ) / (double)RC_LAMBDA_PREC;
   picEstLambda = estLambda;
@@ -958,6 +1130,7 @@ int EncRCPic::estimatePicQP( double lambda, std::list<EncRCPic*>& listPreviousPi
   int bitdepthLumaScale = 2 * ( encRCSeq->bitDepth - 8 - DISTORTION_PRECISION_ADJUSTMENT( encRCSeq->bitDepth ) );
 
   int QP = int(4.2005 * log(lambda / pow(2.0, bitdepthLumaScale )) + 13.7122 + 0.5);
+  const int vbvQP = QP;
 
   bool setLastLevelQP = false;
   int lastPrevTLQP = RC_INVALID_QP_VALUE;
@@ -1049,6 +1222,11 @@ int EncRCPic::estimatePicQP( double lambda, std::list<EncRCPic*>& listPreviousPi
     }
   }
 
+  if ( vbvLimited )
+  {
+    QP = std::max( QP, vbvQP );
+  }
+
   return QP;
 }
 
@@ -1058,6 +1236,11 @@ double EncRCPic::getLCUTargetBpp(bool isIRAP, const int ctuRsAddr )
   double bpp      = -1.0;
   int avgBits     = 0;
 
+  if ( vbvMaxBits > 0 && LCUIdx % picWidthInLCU == 0 )
+  {
+    xUpdateVBVQPOffset( LCUIdx );
+  }
+
   if (isIRAP)
   {
     int bitrateWindow = std::min( 4, lcuLeft );
@@ -1135,6 +1318,10 @@ double EncRCPic::getLCUEstLambda( double bpp, const int ctuRsAddr )
   if ( clipPicLambda > 0.0 )
   {
     estLambda = Clip3( clipPicLambda * pow( 2.0, -2.0/3.0 ), clipPicLambda * pow( 2.0, 2.0/3.0 ), estLambda );
+    if ( vbvQPOffset > 0 )
+    {
+      estLambda = std::max( estLambda, clipPicLambda * pow( 2.0, vbvQPOffset / 3.0 ) );
+    }
   }
   else
   {
@@ -1176,6 +1363,10 @@ int EncRCPic::getLCUEstQP( double lambda, int clipPicQP, const int ctuRsAddr )
   }
 
   estQP = Clip3( clipPicQP - 2, clipPicQP + 2, estQP );
+  if ( vbvQPOffset > 0 )
+  {
+    estQP = std::max( estQP, clipPicQP + vbvQPOffset );
+  }
 
   return estQP;
 }
@@ -1189,6 +1380,8 @@ void EncRCPic::updateAfterCTU(int LCUIdx, int bits, int QP, double lambda, doubl
 
   lcuLeft--;
   bitsLeft -= bits;
+  vbvCodedBits   += bits;
+  vbvCodedPixels += lcu[ LCUIdx ].numberOfPixel;
 
   if ( !updateLCUParameter )
   {
@@ -1318,9 +1511,12 @@ void EncRCPic::updateAfterPicture( int actualHeaderBits, int actualTotalBits, do
   double beta  = encRCSeq->picParam[ frameLevel ].beta;
   double skipRatio = 0;
   int numOfSkipPixel = 0;
-  for (int LCUIdx = 0; LCUIdx < numberOfLCU; LCUIdx++)
+  if ( encRCSeq->useLCUSeparateModel )
   {
-    numOfSkipPixel += int( encRCSeq->lcuParam[ frameLevel ][ LCUIdx ].skipRatio * lcu[ LCUIdx ].numberOfPixel );
+    for (int LCUIdx = 0; LCUIdx < numberOfLCU; LCUIdx++)
+    {
+      numOfSkipPixel += int( encRCSeq->lcuParam[ frameLevel ][ LCUIdx ].skipRatio * lcu[ LCUIdx ].numberOfPixel );
+    }
   }
   skipRatio = (double)numOfSkipPixel / (double)numberOfPixel;
 
@@ -1389,6 +1585,12 @@ int EncRCPic::getRefineBitsForIntra( int orgBits )
 
   iIntraBits = (int)( alpha * pow( totalCostIntra * 4.0 / (double)orgBits, beta ) * (double)orgBits + 0.5 );
 
+  if ( vbvMaxBits > 0 && iIntraBits > vbvMaxBits )
+  {
+    iIntraBits = vbvMaxBits;
+    vbvLimited = true;
+  }
+
   return iIntraBits;
 }
 
@@ -1421,6 +1623,24 @@ void EncRCPic::getLCUInitTargetBits()
 }
 
 
+void EncRCPic::xUpdateVBVQPOffset( const int ctuRsAddr )
+{
+  // at the start of each CTU row, project the picture size from the rows coded so far
+  if ( vbvCodedPixels <= 0 )
+  {
+    return;
+  }
+  const double projectedBits = estHeaderBits + (double)vbvCodedBits * numberOfPixel / vbvCodedPixels;
+  if ( projectedBits > vbvMaxBits )
+  {
+    vbvQPOffset = std::min( RC_VBV_MAX_CTU_QP_OFFSET, (int)ceil( 6.0 * log2( projectedBits / vbvMaxBits ) ) );
+  }
+  else
+  {
+    vbvQPOffset = 0;
+  }
+}
+
 double EncRCPic::getLCUEstLambdaAndQP(double bpp, int clipPicQP, int *estQP, const int ctuRsAddr )
 {
   int   LCUIdx = ctuRsAddr;
@@ -1451,6 +1671,12 @@ double EncRCPic::getLCUEstLambdaAndQP(double bpp, int clipPicQP, int *estQP, con
     minQP = std::max( clipNeighbourQP - 1, minQP );
   }
 
+  if ( vbvQPOffset > 0 )
+  {
+    minQP = std::max( minQP, clipPicQP + vbvQPOffset );
+    maxQP = std::max( maxQP, minQP );
+  }
+
   int bitdepthLumaScale = 2 * ( encRCSeq->bitDepth - 8 - DISTORTION_PRECISION_ADJUSTMENT( encRCSeq->bitDepth ) );
 
   double maxLambda = exp( ( (double)( maxQP + 0.49 ) - 13.7122 ) / 4.2005 ) * pow( 2.0, bitdepthLumaScale );
@@ -1497,6 +1723,10 @@ void RateCtrl::destroy()
     m_listRCPictures.pop_front();
     delete p;
   }
+  if ( m_passStatsFile.is_open() )
+  {
+    m_passStatsFile.close();
+  }
 }
 
 void RateCtrl::init(int RCMode, int totalFrames, int targetBitrate, int frameRate, int intraPeriod, int GOPSize, int picWidth, int picHeight, int LCUWidth, int LCUHeight, int bitDepth, int keepHierBits, bool useLCUSeparateModel, const GOPEntry  GOPList[MAX_GOP])
@@ -1756,10 +1986,10 @@ void RateCtrl::init(int RCMode, int totalFrames, int targetBitrate, int frameRat
   delete[] GOPID2Level;
 }
 
-void RateCtrl::initRCPic( int frameLevel )
+void RateCtrl::initRCPic( int frameLevel, int poc )
 {
   encRCPic = new EncRCPic;
-  encRCPic->create( encRCSeq, encRCGOP, frameLevel, m_listRCPictures );
+  encRCPic->create( encRCSeq, encRCGOP, frameLevel, poc, m_listRCPictures );
 }
 
 void RateCtrl::initRCGOP( int numberOfPictures )
@@ -1774,6 +2004,57 @@ void RateCtrl::destroyRCGOP()
   encRCGOP = NULL;
 }
 
+void RateCtrl::initRCPass( int pass, const std::string& statsFileName )
+{
+  if ( pass == 1 )
+  {
+    m_passStatsFile.open( statsFileName.c_str(), std::ios::out | std::ios::trunc );
+    if ( m_passStatsFile.fail() )
+    {
+      EXIT( "Failed to open rate control statistics file for writing: " << statsFileName.c_str() );
+    }
+    m_passStatsFile << "# POC TId SliceType QP Bits IntraCost InterCost\n";
+  }
+  else if ( pass == 2 )
+  {
+    CHECK( encRCSeq == NULL, "Second pass requires rate control" );
+
+    std::ifstream statsFile( statsFileName.c_str() );
+    if ( statsFile.fail() )
+    {
+      EXIT( "Failed to open rate control statistics file for reading: " << statsFileName.c_str() );
+    }
+
+    std::vector<TRCPassStats> firstPassStats;
+    std::string line;
+    while ( std::getline( statsFile, line ) )
+    {
+      if ( line.empty() || line[ 0 ] == '#' )
+      {
+        continue;
+      }
+      std::istringstream lineStream( line );
+      TRCPassStats stats;
+      lineStream >> stats.poc >> stats.tempLayer >> stats.sliceType >> stats.qp >> stats.numBits >> stats.intraCost >> stats.interCost;
+      if ( lineStream.fail() || stats.poc < 0 )
+      {
+        EXIT( "Invalid rate control statistics in file " << statsFileName.c_str() << ": " << line );
+      }
+      firstPassStats.push_back( stats );
+    }
+
+    encRCSeq->initTwoPass( firstPassStats );
+  }
+}
+
+void RateCtrl::addRCPassStats( const TRCPassStats& stats )
+{
+  if ( m_passStatsFile.is_open() )
+  {
+    m_passStatsFile << stats.poc << ' ' << stats.tempLayer << ' ' << stats.sliceType << ' ' << stats.qp << ' ' << stats.numBits << ' ' << stats.intraCost << ' ' << stats.interCost << '\n';
+  }
+}
+
 
 
 static int xCalcHADs8x8_ISlice( const Pel *piOrg, const int iStrideOrg )
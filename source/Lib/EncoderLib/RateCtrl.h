@@ -55,6 +55,7 @@ vvc@hhi.fraunhofer.de
 #include <vector>
 #include <algorithm>
 #include <list>
+#include <fstream>
 
 namespace vvenc {
   struct Picture;
@@ -81,6 +82,17 @@ namespace vvenc {
     int     validPix;
   };
 
+  struct TRCPassStats
+  {
+    int       poc;
+    int       tempLayer;
+    char      sliceType;
+    int       qp;
+    int       numBits;
+    uint64_t  intraCost;  // lookahead cost estimates of the original picture
+    uint64_t  interCost;
+  };
+
   class EncRCSeq
   {
   public:
@@ -98,6 +110,16 @@ namespace vvenc {
     void setQpInGOP( int gopId, int gopQp, int &qp );
     bool isQpResetRequired( int gopId );
     int  getLeftAverageBits() { CHECK( !( framesLeft > 0 ), "No frames left" ); return (int)( bitsLeft / framesLeft ); }
+    void initTwoPass( const std::vector<TRCPassStats>& passStats );
+    bool isTwoPass() const { return !firstPassWeight.empty(); }
+    double getFirstPassWeight( int poc ) const;
+    double getFirstPassLambda( int poc, int targetBits ) const;
+    int64_t getBitsLeft() const { return bitsLeft; }
+    void initVBV( int maxBitrate, int bufferSize, double initialFullness );
+    bool isVBVEnabled() const { return vbvBufferSize > 0; }
+    int  getVBVMaxPicBits() const;
+    double getVBVFullness() const { return vbvFullness; }
+    int  getVBVBufferSize() const { return vbvBufferSize; }
 
   public:
     int             rcMode;
@@ -124,6 +146,9 @@ namespace vvenc {
     TRCParameter**  lcuParam;
     int*            bitsRatio;
     int*            gopID2Level;
+    std::vector<TRCPassStats> firstPassStats;  // first pass statistics indexed by POC
+    std::vector<double> firstPassWeight;    // relative bit demand of each picture measured in the first pass, indexed by POC
+    double          firstPassAvgWeight;
 
   private:
     int             numberOfLevel;
@@ -132,6 +157,9 @@ namespace vvenc {
     double          seqTargetBpp;
     double          alphaUpdate;
     double          betaUpdate;
+    int             vbvBufferSize;
+    double          vbvFillPerPic;          // bits entering the coded picture buffer per picture period at the maximum bit rate
+    double          vbvFullness;            // buffer fullness right before the removal of the next picture
   };
 
   class EncRCGOP
@@ -157,6 +185,7 @@ namespace vvenc {
     int     gopQP;
     int     idealTargetGOPBits;
     int*    picTargetBitInGOP;
+    double  firstPassWeightLeft;
     double  minEstLambda;
     double  maxEstLambda;
 
@@ -170,7 +199,7 @@ namespace vvenc {
     EncRCPic();
     ~EncRCPic();
 
-    void create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, std::list<EncRCPic*>& listPreviousPictures );
+    void create( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP, int frameLevel, int POC, std::list<EncRCPic*>& listPreviousPictures );
     void destroy();
 
     void   calCostSliceI( Picture* pic );
@@ -193,8 +222,9 @@ namespace vvenc {
     double calAverageLambda();
 
   private:
-    int xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP );
-    int xEstPicHeaderBits( std::list<EncRCPic*>& listPreviousPictures, int frameLevel );
+    int  xEstPicTargetBits( EncRCSeq* encRCSeq, EncRCGOP* encRCGOP );
+    int  xEstPicHeaderBits( std::list<EncRCPic*>& listPreviousPictures, int frameLevel );
+    void xUpdateVBVQPOffset( const int ctuRsAddr );
 
   public:
     TRCLCU* lcu;
@@ -202,6 +232,7 @@ namespace vvenc {
     int     bitsLeft;
     int     numberOfLCU;
     int     lcuLeft;
+    int     vbvQPOffset;            // QP increase of the remaining CTUs to keep the picture within the VBV limit
     int     picQPOffsetQPA;
     double  picLambdaOffsetQPA;
     double  picEstLambda;
@@ -211,8 +242,14 @@ namespace vvenc {
     EncRCGOP* encRCGOP;
 
     int     frameLevel;
+    int     poc;
     int     numberOfPixel;
+    int     picWidthInLCU;
     int     estHeaderBits;
+    int     vbvMaxBits;             // maximum bits of the picture allowed by the VBV, 0 if unconstrained
+    bool    vbvLimited;             // target bits have been reduced to the VBV limit
+    int     vbvCodedBits;
+    int     vbvCodedPixels;
     int     picActualHeaderBits;
     int     picActualBits;          // the whole picture, including header
     int     picQP;                  // in integer form
@@ -231,9 +268,11 @@ namespace vvenc {
 
     void init( int RCMode, int totFrames, int targetBitrate, int frameRate, int intraPeriod, int GOPSize, int picWidth, int picHeight, int LCUWidth, int LCUHeight, int bitDepth, int keepHierBits, bool useLCUSeparateModel, const GOPEntry GOPList[ MAX_GOP ] );
     void destroy();
-    void initRCPic( int frameLevel );
+    void initRCPic( int frameLevel, int poc );
     void initRCGOP( int numberOfPictures );
     void destroyRCGOP();
+    void initRCPass( int pass, const std::string& statsFileName );
+    void addRCPassStats( const TRCPassStats& stats );
 
     std::list<EncRCPic*>& getPicList() { return m_listRCPictures; }
 
@@ -246,6 +285,7 @@ namespace vvenc {
 
   private:
     std::list<EncRCPic*> m_listRCPictures;
+    std::ofstream        m_passStatsFile;
   };
 }
 #endif
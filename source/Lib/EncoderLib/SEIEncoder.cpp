@@ -47,6 +47,7 @@ vvc@hhi.fraunhofer.de
 #include "CommonLib/CommonDef.h"
 #include "CommonLib/SEI.h"
 #include "CommonLib/PicYuvMD5.h"
+#include "CommonLib/Slice.h"
 
 //! \ingroup EncoderLib
 //! \{
@@ -85,6 +86,63 @@ void SEIEncoder::initDecodedPictureHashSEI(SEIDecodedPictureHash *decodedPicture
   }
 }
 
+//! initial CPB removal delay from the buffer fullness estimated by the rate control
+void SEIEncoder::initBufferingPeriodSEI(SEIBufferingPeriod *bufferingPeriodSEI, const SPS& sps, double cpbFullness)
+{
+  CHECK(!(m_isInitialized), "Unspecified error");
+  CHECK(!(bufferingPeriodSEI!=NULL), "Unspecified error");
+  CHECK(!sps.hrdParametersPresent, "Buffering period SEI requires HRD parameters in the SPS");
+
+  const GeneralHrdParams& hrd    = sps.generalHrdParams;
+  const OlsHrdParams&     olsHrd = sps.olsHrdParams[ sps.maxTLayers - 1 ];
+
+  bufferingPeriodSEI->m_bpNalCpbParamsPresent            = hrd.generalNalHrdParamsPresent;
+  bufferingPeriodSEI->m_bpVclCpbParamsPresent            = hrd.generalVclHrdParamsPresent;
+  bufferingPeriodSEI->m_initialCpbRemovalDelayLength     = 24;
+  bufferingPeriodSEI->m_cpbRemovalDelayLength            = 24;
+  bufferingPeriodSEI->m_dpbOutputDelayLength             = 24;
+  bufferingPeriodSEI->m_bpCpbCnt                         = hrd.hrdCpbCntMinus1 + 1;
+  bufferingPeriodSEI->m_bpMaxSubLayers                   = sps.maxTLayers;
+  bufferingPeriodSEI->m_bpDecodingUnitHrdParamsPresent   = false;
+  bufferingPeriodSEI->m_concatenationFlag                = false;
+  bufferingPeriodSEI->m_auCpbRemovalDelayDelta           = 1;
+  bufferingPeriodSEI->m_cpbRemovalDelayDeltasPresent     = false;
+  bufferingPeriodSEI->m_sublayerInitialCpbRemovalDelayPresent = false;
+  bufferingPeriodSEI->m_sublayerDpbOutputOffsetsPresent  = false;
+  bufferingPeriodSEI->m_altCpbParamsPresent              = false;
+
+  const int maxDelay = ( 1 << bufferingPeriodSEI->m_initialCpbRemovalDelayLength ) - 1;
+  for( int j = 0; j < bufferingPeriodSEI->m_bpCpbCnt; j++ )
+  {
+    for( int nalOrVcl = 0; nalOrVcl < 2; nalOrVcl++ )
+    {
+      const double bitRate = double( olsHrd.bitRateValueMinus1[ j ][ nalOrVcl ] + 1 ) * ( 1 << ( 6 + hrd.bitRateScale ) );
+      const double cpbSize = double( olsHrd.cpbSizeValueMinus1[ j ][ nalOrVcl ] + 1 ) * ( 1 << ( 4 + hrd.cpbSizeScale ) );
+      // delays in units of the 90 kHz clock, delay plus offset is kept constant over all buffering periods
+      const int delayPlusOffset = std::min( maxDelay, int( 90000.0 * cpbSize / bitRate ) );
+      const int delay           = Clip3( 1, delayPlusOffset, int( 90000.0 * cpbFullness / bitRate ) );
+      for( int i = 0; i < bufferingPeriodSEI->m_bpMaxSubLayers; i++ )
+      {
+        bufferingPeriodSEI->m_initialCpbRemovalDelay [ i ][ j ][ nalOrVcl ] = delay;
+        bufferingPeriodSEI->m_initialCpbRemovalOffset[ i ][ j ][ nalOrVcl ] = delayPlusOffset - delay;
+      }
+    }
+  }
+}
+
+void SEIEncoder::initPictureTimingSEI(SEIPictureTiming *pictureTimingSEI, const SPS& sps, int cpbRemovalDelay, int dpbOutputDelay)
+{
+  CHECK(!(m_isInitialized), "Unspecified error");
+  CHECK(!(pictureTimingSEI!=NULL), "Unspecified error");
+
+  for( int i = 0; i < sps.maxTLayers; i++ )
+  {
+    pictureTimingSEI->m_subLayerDelaysPresent[ i ] = false;
+    pictureTimingSEI->m_auCpbRemovalDelay    [ i ] = cpbRemovalDelay;
+  }
+  pictureTimingSEI->m_picDpbOutputDelay             = dpbOutputDelay;
+  pictureTimingSEI->m_displayElementalPeriodsMinus1 = 0;
+}
 
 } // namespace vvenc
 
@@ -51,6 +51,7 @@ namespace vvenc {
 
 // forward declarations
 class EncCfg;
+struct SPS;
 
 //! Initializes different SEI message types based on given encoder configuration parameters
 class SEIEncoder
@@ -68,6 +69,8 @@ public:
     m_isInitialized = true;
   };
   void initDecodedPictureHashSEI(SEIDecodedPictureHash *decodedPictureHashSEI, const CPelUnitBuf& pic, std::string &rHashString, const BitDepths &bitDepths);
+  void initBufferingPeriodSEI   (SEIBufferingPeriod *bufferingPeriodSEI, const SPS& sps, double cpbFullness);
+  void initPictureTimingSEI     (SEIPictureTiming *pictureTimingSEI, const SPS& sps, int cpbRemovalDelay, int dpbOutputDelay);
 private:
   const EncCfg* m_pcCfg;
 
@@ -53,7 +53,7 @@ vvc@hhi.fraunhofer.de
 
 namespace vvenc {
 
-void SEIWriter::xWriteSEIpayloadData(OutputBitstream& bs, const SEI& sei, const SPS *sps)
+void SEIWriter::xWriteSEIpayloadData(OutputBitstream& bs, const SEI& sei, const SPS *sps, const uint32_t temporalId)
 {
   switch (sei.payloadType())
   {
@@ -70,10 +70,11 @@ void SEIWriter::xWriteSEIpayloadData(OutputBitstream& bs, const SEI& sei, const
     xWriteSEIDecodedPictureHash(*static_cast<const SEIDecodedPictureHash*>(&sei));
     break;
   case SEI::BUFFERING_PERIOD:
-    xWriteSEIBufferingPeriod(*static_cast<const SEIBufferingPeriod*>(&sei), sps);
+    xWriteSEIBufferingPeriod(*static_cast<const SEIBufferingPeriod*>(&sei));
     break;
   case SEI::PICTURE_TIMING:
-    xWriteSEIPictureTiming(*static_cast<const SEIPictureTiming*>(&sei), sps);
+    CHECK( !m_bufferingPeriodAvailable, "Picture timing SEI requires a preceding buffering period SEI" );
+    xWriteSEIPictureTiming(*static_cast<const SEIPictureTiming*>(&sei), m_bufferingPeriod, temporalId);
     break;
   case SEI::RECOVERY_POINT:
     xWriteSEIRecoveryPoint(*static_cast<const SEIRecoveryPoint*>(&sei));
@@ -103,7 +104,7 @@ void SEIWriter::xWriteSEIpayloadData(OutputBitstream& bs, const SEI& sei, const
     xWriteSEISOPDescription(*static_cast<const SEISOPDescription*>(&sei));
     break;
   case SEI::SCALABLE_NESTING:
-    xWriteSEIScalableNesting(bs, *static_cast<const SEIScalableNesting*>(&sei), sps);
+    xWriteSEIScalableNesting(bs, *static_cast<const SEIScalableNesting*>(&sei), sps, temporalId);
     break;
   case SEI::CHROMA_RESAMPLING_FILTER_HINT:
     xWriteSEIChromaResamplingFilterHint(*static_cast<const SEIChromaResamplingFilterHint*>(&sei));
@@ -139,7 +140,7 @@ void SEIWriter::xWriteSEIpayloadData(OutputBitstream& bs, const SEI& sei, const
 /**
  * marshal all SEI messages in provided list into one bitstream bs
  */
-void SEIWriter::writeSEImessages(OutputBitstream& bs, const SEIMessages &seiList, const SPS *sps, bool isNested)
+void SEIWriter::writeSEImessages(OutputBitstream& bs, const SEIMessages &seiList, const SPS *sps, const uint32_t temporalId, bool isNested)
 {
 #if ENABLE_TRACING
   if (g_HLSTraceEnable)
@@ -159,7 +160,7 @@ void SEIWriter::writeSEImessages(OutputBitstream& bs, const SEIMessages &seiList
     bool traceEnable = g_HLSTraceEnable;
     g_HLSTraceEnable = false;
 #endif
-    xWriteSEIpayloadData(bs_count, **sei, sps);
+    xWriteSEIpayloadData(bs_count, **sei, sps, temporalId);
 #if ENABLE_TRACING
     g_HLSTraceEnable = traceEnable;
 #endif
@@ -187,7 +188,7 @@ void SEIWriter::writeSEImessages(OutputBitstream& bs, const SEIMessages &seiList
       xTraceSEIMessageType((*sei)->payloadType());
 #endif
 
-    xWriteSEIpayloadData(bs, **sei, sps);
+    xWriteSEIpayloadData(bs, **sei, sps, temporalId);
   }
   if (!isNested)
   {
@@ -255,13 +256,134 @@ void SEIWriter::xWriteSEIDecodingUnitInfo(const SEIDecodingUnitInfo& sei, const
 {
   THROW("no support");
 }
-void SEIWriter::xWriteSEIBufferingPeriod(const SEIBufferingPeriod& sei, const SPS *sps)
+void SEIWriter::xWriteSEIBufferingPeriod(const SEIBufferingPeriod& sei)
 {
-  THROW("no support");
+  WRITE_FLAG( sei.m_bpNalCpbParamsPresent, "bp_nal_hrd_params_present_flag");
+  WRITE_FLAG( sei.m_bpVclCpbParamsPresent, "bp_vcl_hrd_params_present_flag");
+  CHECK( !sei.m_bpNalCpbParamsPresent && !sei.m_bpVclCpbParamsPresent, "bp_nal_hrd_params_present_flag and/or bp_vcl_hrd_params_present_flag must be true");
+  CHECK( sei.m_initialCpbRemovalDelayLength < 1, "sei.m_initialCpbRemovalDelayLength must be > 0");
+  WRITE_CODE( sei.m_initialCpbRemovalDelayLength - 1, 5, "bp_cpb_initial_removal_delay_length_minus1" );
+  CHECK( sei.m_cpbRemovalDelayLength < 1, "sei.m_cpbRemovalDelayLength must be > 0");
+  WRITE_CODE( sei.m_cpbRemovalDelayLength - 1,        5, "bp_cpb_removal_delay_length_minus1" );
+  CHECK( sei.m_dpbOutputDelayLength < 1, "sei.m_dpbOutputDelayLength must be > 0");
+  WRITE_CODE( sei.m_dpbOutputDelayLength - 1,         5, "bp_dpb_output_delay_length_minus1" );
+  WRITE_FLAG( sei.m_bpDecodingUnitHrdParamsPresent, "bp_du_hrd_params_present_flag" );
+  if( sei.m_bpDecodingUnitHrdParamsPresent )
+  {
+    CHECK( sei.m_duCpbRemovalDelayIncrementLength < 1, "sei.m_duCpbRemovalDelayIncrementLength must be > 0");
+    WRITE_CODE( sei.m_duCpbRemovalDelayIncrementLength - 1, 5, "bp_du_cpb_removal_delay_increment_length_minus1" );
+    CHECK( sei.m_dpbOutputDelayDuLength < 1, "sei.m_dpbOutputDelayDuLength must be > 0");
+    WRITE_CODE( sei.m_dpbOutputDelayDuLength - 1, 5, "bp_dpb_output_delay_du_length_minus1" );
+    WRITE_FLAG( sei.m_decodingUnitCpbParamsInPicTimingSeiFlag, "bp_du_cpb_params_in_pic_timing_sei_flag" );
+    WRITE_FLAG( sei.m_decodingUnitDpbDuParamsInPicTimingSeiFlag, "bp_du_dpb_params_in_pic_timing_sei_flag");
+  }
+
+  WRITE_FLAG( sei.m_concatenationFlag, "bp_concatenation_flag");
+  WRITE_FLAG( sei.m_additionalConcatenationInfoPresent, "bp_additional_concatenation_info_present_flag");
+  if( sei.m_additionalConcatenationInfoPresent )
+  {
+    WRITE_CODE( sei.m_maxInitialRemovalDelayForConcatenation, sei.m_initialCpbRemovalDelayLength, "bp_max_initial_removal_delay_for_concatenation" );
+  }
+
+  CHECK( sei.m_auCpbRemovalDelayDelta < 1, "sei.m_auCpbRemovalDelayDelta must be > 0");
+  WRITE_CODE( sei.m_auCpbRemovalDelayDelta - 1, sei.m_cpbRemovalDelayLength, "bp_cpb_removal_delay_delta_minus1" );
+
+  CHECK( sei.m_bpMaxSubLayers < 1, "bp_max_sub_layers_minus1 must be > 0");
+  WRITE_CODE( sei.m_bpMaxSubLayers - 1, 3, "bp_max_sublayers_minus1");
+  if( sei.m_bpMaxSubLayers - 1 > 0 )
+  {
+    WRITE_FLAG( sei.m_cpbRemovalDelayDeltasPresent, "bp_cpb_removal_delay_deltas_present_flag");
+  }
+
+  if( sei.m_cpbRemovalDelayDeltasPresent )
+  {
+    CHECK( sei.m_numCpbRemovalDelayDeltas < 1, "m_numCpbRemovalDelayDeltas must be > 0");
+    WRITE_UVLC( sei.m_numCpbRemovalDelayDeltas - 1, "bp_num_cpb_removal_delay_deltas_minus1" );
+    for( int i = 0; i < sei.m_numCpbRemovalDelayDeltas; i++ )
+    {
+      WRITE_CODE( sei.m_cpbRemovalDelayDelta[i], sei.m_cpbRemovalDelayLength, "bp_cpb_removal_delay_delta_val[i]" );
+    }
+  }
+  CHECK( sei.m_bpCpbCnt < 1, "sei.m_bpCpbCnt must be > 0");
+  WRITE_UVLC( sei.m_bpCpbCnt - 1, "bp_cpb_cnt_minus1");
+  if( sei.m_bpMaxSubLayers - 1 > 0 )
+  {
+    WRITE_FLAG( sei.m_sublayerInitialCpbRemovalDelayPresent, "bp_sublayer_initial_cpb_removal_delay_present_flag");
+  }
+  for( int i = ( sei.m_sublayerInitialCpbRemovalDelayPresent ? 0 : sei.m_bpMaxSubLayers - 1 ); i < sei.m_bpMaxSubLayers; i++ )
+  {
+    for( int nalOrVcl = 0; nalOrVcl < 2; nalOrVcl++ )
+    {
+      if( ( ( nalOrVcl == 0 ) && sei.m_bpNalCpbParamsPresent ) || ( ( nalOrVcl == 1 ) && sei.m_bpVclCpbParamsPresent ) )
+      {
+        for( int j = 0; j < sei.m_bpCpbCnt; j++ )
+        {
+          WRITE_CODE( sei.m_initialCpbRemovalDelay[i][j][nalOrVcl],  sei.m_initialCpbRemovalDelayLength, "bp_initial_cpb_removal_delay[i][j][nalOrVcl]" );
+          WRITE_CODE( sei.m_initialCpbRemovalOffset[i][j][nalOrVcl], sei.m_initialCpbRemovalDelayLength, "bp_initial_cpb_removal_offset[i][j][nalOrVcl]" );
+          CHECK( sei.m_bpDecodingUnitHrdParamsPresent, "alternative decoding unit CPB removal delays not supported" );
+        }
+      }
+    }
+  }
+  if( sei.m_bpMaxSubLayers - 1 > 0 )
+  {
+    WRITE_FLAG( sei.m_sublayerDpbOutputOffsetsPresent, "bp_sublayer_dpb_output_offsets_present_flag");
+  }
+
+  if( sei.m_sublayerDpbOutputOffsetsPresent )
+  {
+    for( int i = 0; i < sei.m_bpMaxSubLayers - 1; i++ )
+    {
+      WRITE_UVLC( sei.m_dpbOutputTidOffset[i], "bp_dpb_output_tid_offset[i]" );
+    }
+  }
+  WRITE_FLAG( sei.m_altCpbParamsPresent, "bp_alt_cpb_params_present_flag");
+  if( sei.m_altCpbParamsPresent )
+  {
+    WRITE_FLAG( sei.m_useAltCpbParamsFlag, "bp_use_alt_cpb_params_flag");
+  }
+
+  sei.copyTo( m_bufferingPeriod );
+  m_bufferingPeriodAvailable = true;
 }
-void SEIWriter::xWriteSEIPictureTiming(const SEIPictureTiming& sei, const SPS *sps)
+
+void SEIWriter::xWriteSEIPictureTiming(const SEIPictureTiming& sei, const SEIBufferingPeriod& bp, const uint32_t temporalId)
 {
-  THROW("no support");
+  WRITE_CODE( sei.m_auCpbRemovalDelay[bp.m_bpMaxSubLayers - 1] - 1, bp.m_cpbRemovalDelayLength, "pt_cpb_removal_delay_minus1[bp_max_sub_layers_minus1]" );
+  for( int i = temporalId; i < bp.m_bpMaxSubLayers - 1; i++ )
+  {
+    WRITE_FLAG( sei.m_subLayerDelaysPresent[i], "pt_sublayer_delays_present_flag[i]");
+    if( sei.m_subLayerDelaysPresent[i] )
+    {
+      if( bp.m_cpbRemovalDelayDeltasPresent )
+      {
+        WRITE_FLAG( sei.m_cpbRemovalDelayDeltaEnabledFlag[i], "pt_cpb_removal_delay_delta_enabled_flag[i]");
+      }
+      if( sei.m_cpbRemovalDelayDeltaEnabledFlag[i] )
+      {
+        if( ( bp.m_numCpbRemovalDelayDeltas - 1 ) > 0 )
+        {
+          WRITE_CODE( sei.m_cpbRemovalDelayDeltaIdx[i], ceilLog2( bp.m_numCpbRemovalDelayDeltas ), "pt_cpb_removal_delay_delta_idx[i]");
+        }
+      }
+      else
+      {
+        WRITE_CODE( sei.m_auCpbRemovalDelay[i] - 1, bp.m_cpbRemovalDelayLength, "pt_cpb_removal_delay_minus1[i]");
+      }
+    }
+  }
+  WRITE_CODE( sei.m_picDpbOutputDelay, bp.m_dpbOutputDelayLength, "pt_dpb_output_delay");
+  CHECK( bp.m_altCpbParamsPresent, "alternative CPB timing not supported" );
+  if( bp.m_bpDecodingUnitHrdParamsPresent && bp.m_decodingUnitDpbDuParamsInPicTimingSeiFlag )
+  {
+    WRITE_CODE( sei.m_picDpbOutputDuDelay, bp.m_dpbOutputDelayDuLength, "pt_dpb_output_du_delay" );
+  }
+  CHECK( bp.m_bpDecodingUnitHrdParamsPresent && bp.m_decodingUnitCpbParamsInPicTimingSeiFlag, "decoding unit CPB parameters in picture timing SEI not supported" );
+  if( bp.m_additionalConcatenationInfoPresent )
+  {
+    WRITE_FLAG( sei.m_delayForConcatenationEnsureFlag, "pt_delay_for_concatenation_ensured_flag" );
+  }
+  WRITE_CODE( sei.m_displayElementalPeriodsMinus1, 8, "pt_display_elemental_periods_minus1" );
 }
 void SEIWriter::xWriteSEIRecoveryPoint(const SEIRecoveryPoint& sei)
 {
@@ -434,7 +556,7 @@ void SEIWriter::xWriteSEISOPDescription(const SEISOPDescription& sei)
   }
 }
 
-void SEIWriter::xWriteSEIScalableNesting(OutputBitstream& bs, const SEIScalableNesting& sei, const SPS *sps)
+void SEIWriter::xWriteSEIScalableNesting(OutputBitstream& bs, const SEIScalableNesting& sei, const SPS *sps, const uint32_t temporalId)
 {
   WRITE_FLAG( sei.m_bitStreamSubsetFlag,             "bitstream_subset_flag"         );
   WRITE_FLAG( sei.m_nestingOpFlag,                   "nesting_op_flag      "         );
@@ -469,7 +591,7 @@ void SEIWriter::xWriteSEIScalableNesting(OutputBitstream& bs, const SEIScalableN
   }
 
   // write nested SEI messages
-  writeSEImessages(bs, sei.m_nestedSEIs, sps, true);
+  writeSEImessages(bs, sei.m_nestedSEIs, sps, temporalId, true);
 }
 
 void SEIWriter::xWriteSEITempMotionConstrainedTileSets(const SEITempMotionConstrainedTileSets& sei)
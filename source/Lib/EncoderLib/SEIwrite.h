@@ -56,18 +56,18 @@ class OutputBitstream;
 class SEIWriter : public VLCWriter
 {
 public:
-  SEIWriter() {};
+  SEIWriter() : m_bufferingPeriodAvailable( false ) {};
   virtual ~SEIWriter() {};
 
-  void writeSEImessages(OutputBitstream& bs, const SEIMessages &seiList, const SPS *sps, bool isNested);
+  void writeSEImessages(OutputBitstream& bs, const SEIMessages &seiList, const SPS *sps, const uint32_t temporalId, bool isNested);
 
 protected:
   void xWriteSEIuserDataUnregistered(const SEIuserDataUnregistered &sei);
   void xWriteSEIActiveParameterSets(const SEIActiveParameterSets& sei);
   void xWriteSEIDecodingUnitInfo(const SEIDecodingUnitInfo& sei, const SPS *sps);
   void xWriteSEIDecodedPictureHash(const SEIDecodedPictureHash& sei);
-  void xWriteSEIBufferingPeriod(const SEIBufferingPeriod& sei, const SPS *sps);
-  void xWriteSEIPictureTiming(const SEIPictureTiming& sei, const SPS *sps);
+  void xWriteSEIBufferingPeriod(const SEIBufferingPeriod& sei);
+  void xWriteSEIPictureTiming(const SEIPictureTiming& sei, const SEIBufferingPeriod& bp, const uint32_t temporalId);
   void xWriteSEIRecoveryPoint(const SEIRecoveryPoint& sei);
   void xWriteSEIFramePacking(const SEIFramePacking& sei);
   void xWriteSEISegmentedRectFramePacking(const SEISegmentedRectFramePacking& sei);
@@ -77,7 +77,7 @@ protected:
   void xWriteSEINoDisplay(const SEINoDisplay &sei);
   void xWriteSEIToneMappingInfo(const SEIToneMappingInfo& sei);
   void xWriteSEISOPDescription(const SEISOPDescription& sei);
-  void xWriteSEIScalableNesting(OutputBitstream& bs, const SEIScalableNesting& sei, const SPS *sps);
+  void xWriteSEIScalableNesting(OutputBitstream& bs, const SEIScalableNesting& sei, const SPS *sps, const uint32_t temporalId);
   void xWriteSEITempMotionConstrainedTileSets(const SEITempMotionConstrainedTileSets& sei);
   void xWriteSEITimeCode(const SEITimeCode& sei);
   void xWriteSEIChromaResamplingFilterHint(const SEIChromaResamplingFilterHint& sei);
@@ -87,8 +87,12 @@ protected:
   void xWriteSEIAlternativeTransferCharacteristics(const SEIAlternativeTransferCharacteristics& sei);
   void xWriteSEIGreenMetadataInfo(const SEIGreenMetadataInfo &sei);
 
-  void xWriteSEIpayloadData(OutputBitstream& bs, const SEI& sei, const SPS *sps);
+  void xWriteSEIpayloadData(OutputBitstream& bs, const SEI& sei, const SPS *sps, const uint32_t temporalId);
   void xWriteByteAlign();
+
+protected:
+  SEIBufferingPeriod m_bufferingPeriod;           // last buffering period, the picture timing syntax depends on it
+  bool               m_bufferingPeriodAvailable;
 };
 
 } // namespace vvenc
@@ -0,0 +1,153 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     SpeedCtrl.cpp
+    \brief    real-time speed control, adapts the encoder effort to a target frame rate
+*/
+
+#include "SpeedCtrl.h"
+#include "CommonLib/Picture.h"
+#include "vvenc/EncCfg.h"
+
+#include <chrono>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+SpeedCtrl::SpeedCtrl()
+  : m_targetPicTime  ( 0.0 )
+  , m_numParallelPics( 1 )
+  , m_windowSize     ( 1 )
+  , m_numPics        ( 0 )
+  , m_accumTime      ( 0.0 )
+  , m_speedLevel     ( 0 )
+{
+}
+
+void SpeedCtrl::init( const EncCfg& encCfg, const int numParallelPics )
+{
+  m_targetPicTime   = encCfg.m_speedCtrlFps > 0 ? 1.0 / encCfg.m_speedCtrlFps : 0.0;
+  m_numParallelPics = std::max( numParallelPics, 1 );
+  m_windowSize      = std::max( encCfg.m_GOPSize, 1 );
+  m_numPics         = 0;
+  m_accumTime       = 0.0;
+  m_speedLevel      = 0;
+}
+
+void SpeedCtrl::updateAfterPicture( const Picture& pic )
+{
+  if( ! isEnabled() )
+  {
+    return;
+  }
+
+  // pictures of the different temporal layers differ a lot in encoding time, therefore the level is only adapted once per GOP size
+  m_accumTime += std::chrono::duration<double>( pic.encTime.m_timer ).count() / m_numParallelPics;
+  m_numPics   += 1;
+  if( m_numPics < m_windowSize )
+  {
+    return;
+  }
+
+  const double picTime = m_accumTime / m_numPics;
+  if( picTime > m_targetPicTime )
+  {
+    m_speedLevel += picTime > SPEED_CTRL_FAST_STEP_RATIO * m_targetPicTime ? 2 : 1;
+  }
+  else if( picTime < SPEED_CTRL_RECOVER_RATIO * m_targetPicTime )
+  {
+    m_speedLevel -= 1;
+  }
+  m_speedLevel = Clip3( 0, SPEED_CTRL_MAX_LEVEL, m_speedLevel );
+
+  m_numPics   = 0;
+  m_accumTime = 0.0;
+}
+
+SpeedParams SpeedCtrl::getSpeedParams( const EncCfg& encCfg, const int speedLevel )
+{
+  const auto reduce = []( const int numCand, const int maxCand ) { return numCand > 0 ? std::min( numCand, maxCand ) : maxCand; };
+
+  SpeedParams sp;
+  sp.maxMTTDepth      = MAX_INT;
+  sp.searchRangeShift = 0;
+  sp.maxIntraRdCand   = encCfg.m_maxIntraRdCand;
+  sp.maxMergeRdCand   = encCfg.m_maxMergeRdCand;
+  sp.fastSubPel       = encCfg.m_fastSubPel != 0;
+  sp.fastIntraAngles  = encCfg.m_fastIntraAngles;
+  sp.skipExtraInterModes = false;
+
+  if( speedLevel >= 1 )
+  {
+    sp.searchRangeShift = 1;
+    sp.maxIntraRdCand   = reduce( sp.maxIntraRdCand, 3 );
+    sp.maxMergeRdCand   = reduce( sp.maxMergeRdCand, 3 );
+    sp.fastSubPel       = true;
+  }
+  if( speedLevel >= 2 )
+  {
+    sp.maxMTTDepth      = 1;
+    sp.skipExtraInterModes = true;
+    sp.maxIntraRdCand   = reduce( sp.maxIntraRdCand, 2 );
+    sp.maxMergeRdCand   = reduce( sp.maxMergeRdCand, 2 );
+    sp.fastIntraAngles  = true;
+  }
+  if( speedLevel >= 3 )
+  {
+    sp.maxMTTDepth      = 0;
+    sp.searchRangeShift = 2;
+  }
+  if( speedLevel >= 4 )
+  {
+    sp.maxIntraRdCand   = 1;
+    sp.maxMergeRdCand   = 1;
+    sp.searchRangeShift = 3;
+  }
+
+  return sp;
+}
+
+} // namespace vvenc
+
+//! \}
+
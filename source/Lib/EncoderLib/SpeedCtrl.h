@@ -0,0 +1,103 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     SpeedCtrl.h
+    \brief    real-time speed control, adapts the encoder effort to a target frame rate (header)
+*/
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+class EncCfg;
+struct Picture;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+static const int    SPEED_CTRL_MAX_LEVEL        = 4;
+static const double SPEED_CTRL_RECOVER_RATIO    = 0.7;   // measured picture time below this ratio of the budget allows to lower the speed level
+static const double SPEED_CTRL_FAST_STEP_RATIO  = 1.5;   // measured picture time above this ratio of the budget raises the speed level by two
+
+/// encoder side effort parameters of a picture, not signalled in the bitstream
+struct SpeedParams
+{
+  int  maxMTTDepth;         // limit of the tested MTT depth, on top of the signalled one
+  int  searchRangeShift;    // reduction of the motion search range
+  int  maxIntraRdCand;      // 0: unrestricted
+  int  maxMergeRdCand;      // 0: unrestricted
+  bool fastSubPel;
+  bool fastIntraAngles;
+  bool skipExtraInterModes; // no affine, geometric and adaptive MV precision tests
+};
+
+/// measures the encoding time of the pictures of each GOP and selects the speed level of the following pictures,
+/// such that the encoder keeps up with the target frame rate and recovers quality when there is time left
+class SpeedCtrl
+{
+  private:
+    double m_targetPicTime;   // time budget per picture in seconds, 0: speed control disabled
+    int    m_numParallelPics;
+    int    m_windowSize;
+    int    m_numPics;
+    double m_accumTime;
+    int    m_speedLevel;
+
+  public:
+    SpeedCtrl();
+    virtual ~SpeedCtrl() {}
+
+    void init                       ( const EncCfg& encCfg, const int numParallelPics );
+    bool isEnabled                  () const { return m_targetPicTime > 0.0; }
+    int  getSpeedLevel              () const { return m_speedLevel; }
+    void updateAfterPicture         ( const Picture& pic );
+
+    static SpeedParams getSpeedParams( const EncCfg& encCfg, const int speedLevel );
+};
+
+} // namespace vvenc
+
+//! \}
+
@@ -0,0 +1,261 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     SplitPredictor.cpp
+    \brief    decision tree based early termination of binary and ternary CU splits
+*/
+
+#include "SplitPredictor.h"
+#include "CommonLib/CodingStructure.h"
+#include "CommonLib/UnitPartitioner.h"
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+static const char* const SPF_NAMES[ NUM_SPLIT_FEATURES ] =
+{
+  "log2W", "log2H", "split", "mtDepth", "qp", "tLayer", "var", "gradH", "gradV", "neighDepth", "bestCost", "bestSkip", "bestIntra", "bestCbf", "btCostRatio"
+};
+
+// depth 6 CART model, fitted on training dumps of the faster and medium presets at QP 27, 32 and 37 over camera and
+// screen content; at a threshold of 0.1 it skips about 30% of the tested splits and misses 2.4% of the improving ones
+// { feature, threshold, left, right, probability }
+static const SplitTreeNode SPLIT_TREE_MODEL[] =
+{
+  {  6,   709.024f,  1, 50, 0.319f },  // var
+  { 10,   230.000f,  2, 33, 0.160f },  // bestCost
+  {  9,     0.250f,  3, 18, 0.123f },  // neighDepth
+  { 14,     1.994f,  4, 11, 0.083f },  // btCostRatio
+  {  2,     1.500f,  5,  8, 0.158f },  // split
+  { 10,     7.151f,  6,  7, 0.231f },  // bestCost
+  { -1,     0.000f,  0,  0, 0.130f },
+  { -1,     0.000f,  0,  0, 0.268f },
+  { 14,     1.042f,  9, 10, 0.082f },  // btCostRatio
+  { -1,     0.000f,  0,  0, 0.145f },
+  { -1,     0.000f,  0,  0, 0.016f },
+  {  2,     0.500f, 12, 15, 0.059f },  // split
+  { 13,     0.500f, 13, 14, 0.093f },  // bestCbf
+  { -1,     0.000f,  0,  0, 0.009f },
+  { -1,     0.000f,  0,  0, 0.119f },
+  {  1,     2.500f, 16, 17, 0.023f },  // log2H
+  { -1,     0.000f,  0,  0, 0.089f },
+  { -1,     0.000f,  0,  0, 0.013f },
+  {  6,    20.422f, 19, 26, 0.225f },  // var
+  { 10,    52.505f, 20, 23, 0.089f },  // bestCost
+  { 13,     0.500f, 21, 22, 0.042f },  // bestCbf
+  { -1,     0.000f,  0,  0, 0.022f },
+  { -1,     0.000f,  0,  0, 0.094f },
+  { 10,   192.240f, 24, 25, 0.257f },  // bestCost
+  { -1,     0.000f,  0,  0, 0.197f },
+  { -1,     0.000f,  0,  0, 0.371f },
+  {  2,     1.500f, 27, 30, 0.333f },  // split
+  { 10,     5.815f, 28, 29, 0.406f },  // bestCost
+  { -1,     0.000f,  0,  0, 0.159f },
+  { -1,     0.000f,  0,  0, 0.437f },
+  {  7,     3.240f, 31, 32, 0.165f },  // gradH
+  { -1,     0.000f,  0,  0, 0.128f },
+  { -1,     0.000f,  0,  0, 0.356f },
+  { 10,   282.216f, 34, 43, 0.592f },  // bestCost
+  {  0,     2.500f, 35, 36, 0.487f },  // log2W
+  { -1,     0.000f,  0,  0, 0.304f },
+  {  2,     0.500f, 37, 40, 0.515f },  // split
+  {  8,     1.777f, 38, 39, 0.621f },  // gradV
+  { -1,     0.000f,  0,  0, 0.520f },
+  { -1,     0.000f,  0,  0, 0.769f },
+  {  8,     1.938f, 41, 42, 0.452f },  // gradV
+  { -1,     0.000f,  0,  0, 0.564f },
+  { -1,     0.000f,  0,  0, 0.302f },
+  {  3,     0.500f, 44, 45, 0.739f },  // mtDepth
+  { -1,     0.000f,  0,  0, 0.902f },
+  { 10,   341.703f, 46, 49, 0.704f },  // bestCost
+  {  8,     1.391f, 47, 48, 0.634f },  // gradV
+  { -1,     0.000f,  0,  0, 0.722f },
+  { -1,     0.000f,  0,  0, 0.590f },
+  { -1,     0.000f,  0,  0, 0.827f },
+  { 10,    10.463f, 51, 58, 0.580f },  // bestCost
+  { 13,     0.500f, 52, 57, 0.073f },  // bestCbf
+  { 14,     1.039f, 53, 54, 0.040f },  // btCostRatio
+  { -1,     0.000f,  0,  0, 0.242f },
+  {  9,     0.250f, 55, 56, 0.026f },  // neighDepth
+  { -1,     0.000f,  0,  0, 0.020f },
+  { -1,     0.000f,  0,  0, 0.107f },
+  { -1,     0.000f,  0,  0, 0.405f },
+  { 14,     1.744f, 59, 74, 0.672f },  // btCostRatio
+  {  0,     3.500f, 60, 67, 0.547f },  // log2W
+  {  7,    57.281f, 61, 64, 0.493f },  // gradH
+  {  1,     3.500f, 62, 63, 0.517f },  // log2H
+  { -1,     0.000f,  0,  0, 0.574f },
+  { -1,     0.000f,  0,  0, 0.458f },
+  { 14,     1.009f, 65, 66, 0.345f },  // btCostRatio
+  { -1,     0.000f,  0,  0, 0.397f },
+  { -1,     0.000f,  0,  0, 0.240f },
+  { 14,     1.000f, 68, 71, 0.612f },  // btCostRatio
+  { 10,   939.374f, 69, 70, 0.575f },  // bestCost
+  { -1,     0.000f,  0,  0, 0.552f },
+  { -1,     0.000f,  0,  0, 0.744f },
+  {  8,    42.116f, 72, 73, 0.767f },  // gradV
+  { -1,     0.000f,  0,  0, 0.830f },
+  { -1,     0.000f,  0,  0, 0.636f },
+  {  8,    52.059f, 75, 82, 0.759f },  // gradV
+  {  8,     3.340f, 76, 79, 0.827f },  // gradV
+  { 10,    65.550f, 77, 78, 0.410f },  // bestCost
+  { -1,     0.000f,  0,  0, 0.307f },
+  { -1,     0.000f,  0,  0, 0.537f },
+  {  7,    28.438f, 80, 81, 0.852f },  // gradH
+  { -1,     0.000f,  0,  0, 0.907f },
+  { -1,     0.000f,  0,  0, 0.770f },
+  {  7,    60.664f, 83, 86, 0.536f },  // gradH
+  {  8,    72.371f, 84, 85, 0.619f },  // gradV
+  { -1,     0.000f,  0,  0, 0.666f },
+  { -1,     0.000f,  0,  0, 0.473f },
+  { 10,  1452.450f, 87, 88, 0.463f },  // bestCost
+  { -1,     0.000f,  0,  0, 0.433f },
+  { -1,     0.000f,  0,  0, 0.603f }
+};
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+void SplitPredictorDump::open( const std::string& fileName )
+{
+  m_file.open( fileName.c_str(), std::ios::out | std::ios::trunc );
+  if( m_file.fail() )
+  {
+    THROW( "unable to open split predictor training file " << fileName );
+  }
+  m_file << "#";
+  for( int i = 0; i < NUM_SPLIT_FEATURES; i++ )
+  {
+    m_file << " " << SPF_NAMES[ i ];
+  }
+  m_file << " improved\n";
+}
+
+void SplitPredictorDump::close()
+{
+  if( m_file.is_open() )
+  {
+    m_file.close();
+  }
+}
+
+void SplitPredictorDump::write( const float* features, const bool splitImproved )
+{
+  std::lock_guard<std::mutex> lock( m_mutex );
+  for( int i = 0; i < NUM_SPLIT_FEATURES; i++ )
+  {
+    m_file << features[ i ] << " ";
+  }
+  m_file << ( splitImproved ? 1 : 0 ) << "\n";
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+SplitPredictor::SplitPredictor()
+  : m_threshold ( 0.0 )
+  , m_dump      ( nullptr )
+{
+}
+
+void SplitPredictor::init( const double threshold, SplitPredictorDump* dump )
+{
+  m_threshold = threshold;
+  m_dump      = dump && dump->isOpen() ? dump : nullptr;
+}
+
+void SplitPredictor::extractBlockFeatures( const CodingStructure& cs, const Partitioner& partitioner, float* features )
+{
+  const CompArea& area    = partitioner.currArea().Y();
+  const CPelBuf   org     = cs.getOrgBuf( area );
+  const int       shift   = cs.sps->bitDepths[ CH_L ] - 8;
+  const int       width   = area.width;
+  const int       height  = area.height;
+
+  int64_t sum = 0, sumSq = 0, gradHor = 0, gradVer = 0;
+  for( int y = 0; y < height; y++ )
+  {
+    const Pel* row  = org.bufAt( 0, y );
+    const Pel* next = org.bufAt( 0, std::min( y + 1, height - 1 ) );
+    for( int x = 0; x < width; x++ )
+    {
+      sum     += row[ x ];
+      sumSq   += row[ x ] * row[ x ];
+      gradVer += abs( next[ x ] - row[ x ] );
+    }
+    for( int x = 0; x < width - 1; x++ )
+    {
+      gradHor += abs( row[ x + 1 ] - row[ x ] );
+    }
+  }
+
+  const double numSamples = double( width * height );
+  const double mean       = sum / numSamples;
+  features[ SPF_LOG2_WIDTH  ] = float( floorLog2( width  ) );
+  features[ SPF_LOG2_HEIGHT ] = float( floorLog2( height ) );
+  features[ SPF_MT_DEPTH    ] = float( partitioner.currMtDepth );
+  features[ SPF_VARIANCE    ] = float( ( sumSq / numSamples - mean * mean ) / ( 1 << ( 2 * shift ) ) );
+  features[ SPF_GRAD_HOR    ] = float( gradHor / numSamples / ( 1 << shift ) );
+  features[ SPF_GRAD_VER    ] = float( gradVer / numSamples / ( 1 << shift ) );
+
+  const CodingUnit* cuLeft  = cs.getCU( area.pos().offset( -1, 0 ), partitioner.chType, partitioner.treeType );
+  const CodingUnit* cuAbove = cs.getCU( area.pos().offset( 0, -1 ), partitioner.chType, partitioner.treeType );
+  int numNeigh = 0, neighDepth = 0;
+  if( cuLeft  ) { neighDepth += cuLeft ->depth; numNeigh++; }
+  if( cuAbove ) { neighDepth += cuAbove->depth; numNeigh++; }
+  features[ SPF_NEIGH_DEPTH ] = numNeigh ? float( neighDepth ) / numNeigh - float( partitioner.currDepth ) : 0.0f;
+}
+
+double SplitPredictor::getSplitProbability( const float* features ) const
+{
+  int node = 0;
+  while( SPLIT_TREE_MODEL[ node ].feature >= 0 )
+  {
+    const SplitTreeNode& n = SPLIT_TREE_MODEL[ node ];
+    node = features[ n.feature ] < n.threshold ? n.left : n.right;
+  }
+  return SPLIT_TREE_MODEL[ node ].prob;
+}
+
+} // namespace vvenc
+
+//! \}
+
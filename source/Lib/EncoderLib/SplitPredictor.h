@@ -0,0 +1,132 @@
+/* -----------------------------------------------------------------------------
+Software Copyright License for the Fraunhofer Software Library VVenc
+
+(c) Copyright (2019-2020) Fraunhofer-Gesellschaft zur Förderung der angewandten Forschung e.V. 
+
+1.    INTRODUCTION
+
+The Fraunhofer Software Library VVenc (“Fraunhofer Versatile Video Encoding Library”) is software that implements (parts of) the Versatile Video Coding Standard - ITU-T H.266 | MPEG-I - Part 3 (ISO/IEC 23090-3) and related technology. 
+The standard contains Fraunhofer patents as well as third-party patents. Patent licenses from third party standard patent right holders may be required for using the Fraunhofer Versatile Video Encoding Library. It is in your responsibility to obtain those if necessary. 
+
+The Fraunhofer Versatile Video Encoding Library which mean any source code provided by Fraunhofer are made available under this software copyright license. 
+It is based on the official ITU/ISO/IEC VVC Test Model (VTM) reference software whose copyright holders are indicated in the copyright notices of its source files. The VVC Test Model (VTM) reference software is licensed under the 3-Clause BSD License and therefore not subject of this software copyright license.
+
+2.    COPYRIGHT LICENSE
+
+Internal use of the Fraunhofer Versatile Video Encoding Library, in source and binary forms, with or without modification, is permitted without payment of copyright license fees for non-commercial purposes of evaluation, testing and academic research. 
+
+No right or license, express or implied, is granted to any part of the Fraunhofer Versatile Video Encoding Library except and solely to the extent as expressly set forth herein. Any commercial use or exploitation of the Fraunhofer Versatile Video Encoding Library and/or any modifications thereto under this license are prohibited.
+
+For any other use of the Fraunhofer Versatile Video Encoding Library than permitted by this software copyright license You need another license from Fraunhofer. In such case please contact Fraunhofer under the CONTACT INFORMATION below.
+
+3.    LIMITED PATENT LICENSE
+
+As mentioned under 1. Fraunhofer patents are implemented by the Fraunhofer Versatile Video Encoding Library. If You use the Fraunhofer Versatile Video Encoding Library in Germany, the use of those Fraunhofer patents for purposes of testing, evaluating and research and development is permitted within the statutory limitations of German patent law. However, if You use the Fraunhofer Versatile Video Encoding Library in a country where the use for research and development purposes is not permitted without a license, you must obtain an appropriate license from Fraunhofer. It is Your responsibility to check the legal requirements for any use of applicable patents.    
+
+Fraunhofer provides no warranty of patent non-infringement with respect to the Fraunhofer Versatile Video Encoding Library.
+
+
+4.    DISCLAIMER
+
+The Fraunhofer Versatile Video Encoding Library is provided by Fraunhofer "AS IS" and WITHOUT ANY EXPRESS OR IMPLIED WARRANTIES, including but not limited to the implied warranties fitness for a particular purpose. IN NO EVENT SHALL FRAUNHOFER BE LIABLE for any direct, indirect, incidental, special, exemplary, or consequential damages, including but not limited to procurement of substitute goods or services; loss of use, data, or profits, or business interruption, however caused and on any theory of liability, whether in contract, strict liability, or tort (including negligence), arising in any way out of the use of the Fraunhofer Versatile Video Encoding Library, even if advised of the possibility of such damage.
+
+5.    CONTACT INFORMATION
+
+Fraunhofer Heinrich Hertz Institute
+Attention: Video Coding & Analytics Department
+Einsteinufer 37
+10587 Berlin, Germany
+www.hhi.fraunhofer.de/vvc
+vvc@hhi.fraunhofer.de
+----------------------------------------------------------------------------- */
+/** \file     SplitPredictor.h
+    \brief    decision tree based early termination of binary and ternary CU splits (header)
+*/
+
+#pragma once
+
+#include "CommonLib/CommonDef.h"
+#include "CommonLib/Unit.h"
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+//! \ingroup EncoderLib
+//! \{
+
+namespace vvenc {
+
+class CodingStructure;
+class Partitioner;
+
+// ---------------------------------------------------------------------------------------------------------------------
+
+enum SplitFeature
+{
+  SPF_LOG2_WIDTH = 0,
+  SPF_LOG2_HEIGHT,
+  SPF_SPLIT_TYPE,         // 0: BT hor, 1: BT ver, 2: TT hor, 3: TT ver
+  SPF_MT_DEPTH,
+  SPF_QP,
+  SPF_TEMPORAL_LAYER,
+  SPF_VARIANCE,           // luma variance per sample, at 8 bit
+  SPF_GRAD_HOR,           // mean absolute horizontal luma gradient, at 8 bit
+  SPF_GRAD_VER,           // mean absolute vertical luma gradient, at 8 bit
+  SPF_NEIGH_DEPTH,        // mean depth of the left and above CU relative to the current depth
+  SPF_BEST_COST,          // best RD cost so far per sample, in units of lambda
+  SPF_BEST_SKIP,
+  SPF_BEST_INTRA,
+  SPF_BEST_CBF,
+  SPF_BT_COST_RATIO,      // best binary split cost so far relative to the best cost, 2 if none tested
+  NUM_SPLIT_FEATURES
+};
+
+struct SplitTreeNode
+{
+  int   feature;          // -1 for leaves
+  float threshold;        // go left if feature < threshold
+  int   left;
+  int   right;
+  float prob;             // leaf: probability that the split improves the RD cost
+};
+
+/// training dump of the split predictor, shared by the CU encoders of one encoder instance
+class SplitPredictorDump
+{
+  private:
+    std::mutex            m_mutex;
+    std::ofstream         m_file;
+
+  public:
+    void   open                 ( const std::string& fileName );
+    void   close                ();
+    bool   isOpen               () const { return m_file.is_open(); }
+    void   write                ( const float* features, const bool splitImproved );
+};
+
+/// predicts from cheap block features whether a binary or ternary split can improve the best RD cost found so far,
+/// using a small compiled-in decision tree, and optionally dumps the features with the observed outcome for training
+class SplitPredictor
+{
+  private:
+    double                m_threshold;
+    SplitPredictorDump*   m_dump;
+
+  public:
+    SplitPredictor();
+    virtual ~SplitPredictor() {}
+
+    void   init                 ( const double threshold, SplitPredictorDump* dump );
+    bool   isDumpEnabled        () const { return m_dump != nullptr; }
+
+    static void extractBlockFeatures( const CodingStructure& cs, const Partitioner& partitioner, float* features );
+    double getSplitProbability  ( const float* features ) const;
+    bool   canSkipSplit         ( const float* features ) const { return !m_dump && getSplitProbability( features ) < m_threshold; }
+    void   writeTrainingSample  ( const float* features, const bool splitImproved ) const { m_dump->write( features, splitImproved ); }
+};
+
+} // namespace vvenc
+
+//! \}
+
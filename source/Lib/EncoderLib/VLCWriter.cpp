@@ -606,9 +606,67 @@ void HLSWriter::codeVUI( const VUI *pcVUI, const SPS* pcSPS )
   }
 }
 
+void HLSWriter::codeGeneralHrdparameters(const GeneralHrdParams * hrd)
+{
+  WRITE_CODE(hrd->numUnitsInTick, 32,                     "num_units_in_tick");
+  WRITE_CODE(hrd->timeScale, 32,                          "time_scale");
+  WRITE_FLAG(hrd->generalNalHrdParamsPresent,             "general_nal_hrd_parameters_present_flag");
+  WRITE_FLAG(hrd->generalVclHrdParamsPresent,             "general_vcl_hrd_parameters_present_flag");
+  if( hrd->generalNalHrdParamsPresent || hrd->generalVclHrdParamsPresent )
+  {
+    WRITE_FLAG(hrd->generalSamePicTimingInAllOlsFlag,     "general_same_pic_timing_in_all_ols_flag");
+    WRITE_FLAG(hrd->generalDecodingUnitHrdParamsPresent,  "general_decoding_unit_hrd_params_present_flag");
+    if (hrd->generalDecodingUnitHrdParamsPresent)
+    {
+      WRITE_CODE(hrd->tickDivisorMinus2, 8,               "tick_divisor_minus2");
+    }
+    WRITE_CODE(hrd->bitRateScale, 4,                      "bit_rate_scale");
+    WRITE_CODE(hrd->cpbSizeScale, 4,                      "cpb_size_scale");
+    if (hrd->generalDecodingUnitHrdParamsPresent)
+    {
+      WRITE_CODE(hrd->cpbSizeDuScale, 4,                  "cpb_size_du_scale");
+    }
+    WRITE_UVLC(hrd->hrdCpbCntMinus1,                      "hrd_cpb_cnt_minus1");
+  }
+}
+
 void HLSWriter::codeOlsHrdParameters(const GeneralHrdParams * generalHrd, const OlsHrdParams *olsHrd, const uint32_t firstSubLayer, const uint32_t maxNumSubLayersMinus1)
 {
-  THROW("no support");
+  for( uint32_t i = firstSubLayer; i <= maxNumSubLayersMinus1; i++ )
+  {
+    const OlsHrdParams *hrd = &(olsHrd[i]);
+    WRITE_FLAG(hrd->fixedPicRateGeneralFlag,              "fixed_pic_rate_general_flag");
+    if (!hrd->fixedPicRateGeneralFlag)
+    {
+      WRITE_FLAG(hrd->fixedPicRateWithinCvsFlag,          "fixed_pic_rate_within_cvs_flag");
+    }
+    if (hrd->fixedPicRateWithinCvsFlag)
+    {
+      WRITE_UVLC(hrd->elementDurationInTcMinus1,          "elemental_duration_in_tc_minus1");
+    }
+    else if ((generalHrd->generalNalHrdParamsPresent || generalHrd->generalVclHrdParamsPresent) && generalHrd->hrdCpbCntMinus1 == 0)
+    {
+      WRITE_FLAG(hrd->lowDelayHrdFlag,                    "low_delay_hrd_flag");
+    }
+
+    for( int nalOrVcl = 0; nalOrVcl < 2; nalOrVcl++ )
+    {
+      if( ( nalOrVcl == 0 && generalHrd->generalNalHrdParamsPresent ) || ( nalOrVcl == 1 && generalHrd->generalVclHrdParamsPresent ) )
+      {
+        for( int j = 0; j <= generalHrd->hrdCpbCntMinus1; j++ )
+        {
+          WRITE_UVLC(hrd->bitRateValueMinus1[j][nalOrVcl],   "bit_rate_value_minus1");
+          WRITE_UVLC(hrd->cpbSizeValueMinus1[j][nalOrVcl],   "cpb_size_value_minus1");
+          if (generalHrd->generalDecodingUnitHrdParamsPresent)
+          {
+            WRITE_UVLC(hrd->duCpbSizeValueMinus1[j][nalOrVcl], "cpb_size_du_value_minus1");
+            WRITE_UVLC(hrd->duBitRateValueMinus1[j][nalOrVcl], "bit_rate_du_value_minus1");
+          }
+          WRITE_FLAG(hrd->cbrFlag[j][nalOrVcl],              "cbr_flag");
+        }
+      }
+    }
+  }
 }
 
 void HLSWriter::dpb_parameters(int maxSubLayersMinus1, bool subLayerInfoFlag, const SPS *pcSPS)
@@ -932,7 +990,13 @@ void HLSWriter::codeSPS( const SPS* pcSPS )
 
     if( pcSPS->hrdParametersPresent )
     {
-      THROW("no support");
+      codeGeneralHrdparameters(&pcSPS->generalHrdParams);
+      if ((pcSPS->maxTLayers - 1) > 0)
+      {
+        WRITE_FLAG(pcSPS->subLayerCpbParamsPresent,       "sps_sublayer_cpb_params_present_flag");
+      }
+      uint32_t firstSubLayer = pcSPS->subLayerCpbParamsPresent ? 0 : (pcSPS->maxTLayers - 1);
+      codeOlsHrdParameters(&pcSPS->generalHrdParams, pcSPS->olsHrdParams, firstSubLayer, pcSPS->maxTLayers - 1);
     }
   }
 
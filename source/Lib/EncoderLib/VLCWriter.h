@@ -56,8 +56,8 @@ vvc@hhi.fraunhofer.de
 
 namespace vvenc {
 
-class GeneralHrdParams;
-class OlsHrdParams;
+struct GeneralHrdParams;
+struct OlsHrdParams;
 
 #if ENABLE_TRACING
 
@@ -125,6 +125,7 @@ public:
   void  codeSliceHeader         ( const Slice* slice );
   void  codeConstraintInfo      ( const ConstraintInfo* cinfo );
   void  codeProfileTierLevel    ( const ProfileTierLevel* ptl, bool profileTierPresentFlag, int maxNumSubLayersMinus1 );
+  void  codeGeneralHrdparameters( const GeneralHrdParams * hrd );
   void  codeOlsHrdParameters    ( const GeneralHrdParams * generalHrd, const OlsHrdParams *olsHrd , const uint32_t firstSubLayer, const uint32_t maxNumSubLayersMinus1);
 
   void  codeAUD                 ( const int audIrapOrGdrAuFlag, const int pictureType );
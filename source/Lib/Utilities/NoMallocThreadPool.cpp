@@ -61,8 +61,9 @@ namespace vvenc {
 
 
 NoMallocThreadPool::NoMallocThreadPool( int numThreads, const char * threadPoolName )
-  : m_poolName( threadPoolName )
-  , m_threads ( numThreads < 0 ? std::thread::hardware_concurrency() : numThreads )
+  : m_poolName  ( threadPoolName )
+  , m_memAccount( MemTagScope::account() )
+  , m_threads   ( numThreads < 0 ? std::thread::hardware_concurrency() : numThreads )
 {
   int tid = 0;
   for( auto& t: m_threads )
@@ -145,6 +146,8 @@ void NoMallocThreadPool::threadProc( int threadId )
   }
 #endif
 
+  MemTagScope memScope( m_memAccount, MEM_TAG_OTHER );
+
   auto nextTaskIt = m_tasks.begin();
   while( !m_exitThreads )
   {
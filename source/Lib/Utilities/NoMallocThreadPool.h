@@ -478,6 +478,7 @@ private:
 
   // members
   std::string              m_poolName;
+  MemAccount*              m_memAccount;         // memory account of the creating thread, inherited by the worker threads
   std::atomic_bool         m_exitThreads{ false };
   std::vector<std::thread> m_threads;
   ChunkedTaskQueue         m_tasks;
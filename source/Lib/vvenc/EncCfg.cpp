@@ -48,7 +48,9 @@ vvc@hhi.fraunhofer.de
 #include "../../../include/vvenc/EncCfg.h"
 
 #include "CommonLib/CommonDef.h"
+#include "CommonLib/Hash.h"
 #include "CommonLib/Slice.h"
+#include "CommonLib/Unit.h"
 
 #include <math.h>
 
@@ -109,6 +111,10 @@ bool EncCfg::initCfgParameter()
   {
     m_InputQueueSize += MCTF_ADD_QUEUE_DELAY;
   }
+  if ( m_InputQueueMaxSize > 0 )
+  {
+    m_InputQueueMaxSize = std::max( m_InputQueueMaxSize, m_InputQueueSize );
+  }
 
   m_framesToBeEncoded = ( m_framesToBeEncoded + m_temporalSubsampleRatio - 1 ) / m_temporalSubsampleRatio;
 
@@ -405,6 +411,11 @@ bool EncCfg::initCfgParameter()
   m_reshapeCW.adpOption  = m_adpOption;
   m_reshapeCW.initialCW  = m_initialCW;
 
+  if( m_RCMaxBitrate > 0 && m_RCCpbSize == 0 )
+  {
+    m_RCCpbSize = m_RCMaxBitrate;
+  }
+
 
   //
   // do some check and set of parameters next
@@ -472,8 +483,21 @@ bool EncCfg::initCfgParameter()
   confirmParameter( (m_IntraPeriod > 0 && m_IntraPeriod < m_GOPSize) || m_IntraPeriod == 0,     "Intra period must be more than GOP size, or -1 , not 0" );
   confirmParameter( m_InputQueueSize < m_GOPSize ,                                              "Input queue size must be greater or equal to gop size" );
   confirmParameter( m_MCTF && m_InputQueueSize < m_GOPSize + MCTF_ADD_QUEUE_DELAY ,             "Input queue size must be greater or equal to gop size + N frames for MCTF" );
+  confirmParameter( m_InputQueueMaxSize < 0 ,                                                   "Input queue max size must be greater or equal to 0" );
   confirmParameter( m_DecodingRefreshType < 0 || m_DecodingRefreshType > 3,                     "Decoding Refresh Type must be comprised between 0 and 3 included" );
+  confirmParameter( m_sceneCutThreshold < 0 || m_sceneCutThreshold > 100,                       "Scene cut threshold must be in the range of 0 to 100" );
+  confirmParameter( m_RCPass < 0 || m_RCPass > 2,                                               "Rate control pass must be 0, 1 or 2" );
+  confirmParameter( m_RCPass > 0 && m_RCStatsFileName.empty(),                                  "Two-pass rate control requires a statistics file" );
+  confirmParameter( m_RCPass == 2 && m_RCRateControlMode == 0,                                  "The second rate control pass requires rate control to be enabled" );
+  confirmParameter( m_RCMaxBitrate < 0 || m_RCCpbSize < 0,                                      "VBV maximum bit rate and buffer size must not be negative" );
+  confirmParameter( m_RCMaxBitrate > 0 && m_RCRateControlMode == 0,                             "VBV constraints require rate control to be enabled" );
+  confirmParameter( m_RCMaxBitrate > 0 && m_RCMaxBitrate < m_RCTargetBitrate,                   "VBV maximum bit rate must not be lower than the target bit rate" );
+  confirmParameter( m_RCMaxBitrate > 0 && m_FrameRate > 0 && m_RCCpbSize < m_RCMaxBitrate / m_FrameRate, "VBV buffer size must hold at least the bits of one frame at the maximum bit rate" );
+  confirmParameter( m_RCInitialCpbFullness <= 0.0 || m_RCInitialCpbFullness > 1.0,              "Initial CPB fullness must be in the range of (0, 1]" );
+  confirmParameter( m_hrdParametersPresent && m_RCMaxBitrate == 0,                              "HRD parameters require a VBV maximum bit rate" );
+  confirmParameter( m_sceneCutThreshold > 0 && ( m_IntraPeriod <= 0 || m_DecodingRefreshType != 1 ),   "Scene cut detection requires an intra period with CRA refresh" );
   confirmParameter( m_QP < -6 * (m_internalBitDepth[CH_L] - 8) || m_QP > MAX_QP,                "QP exceeds supported range (-QpBDOffsety to 63)" );
+  confirmParameter( m_constQuality && m_RCRateControlMode > 0,                                  "Constant quality mode cannot be combined with rate control" );
   for( int comp = 0; comp < 3; comp++)
   {
     confirmParameter( m_loopFilterBetaOffsetDiv2[comp] < -12 || m_loopFilterBetaOffsetDiv2[comp] > 12,          "Loop Filter Beta Offset div. 2 exceeds supported range (-12 to 12)" );
@@ -482,12 +506,20 @@ bool EncCfg::initCfgParameter()
   confirmParameter( m_SearchRange < 0 ,                                                         "Search Range must be more than 0" );
   confirmParameter( m_bipredSearchRange < 0 ,                                                   "Bi-prediction refinement search range must be more than 0" );
   confirmParameter( m_minSearchWindow < 0,                                                      "Minimum motion search window size for the adaptive window ME must be greater than or equal to 0" );
+  confirmParameter( m_maxIntraRdCand < 0 || m_maxIntraRdCand >= NUM_LUMA_MODE,                  "MaxIntraRdCand out of range" );
+  confirmParameter( m_maxMergeRdCand < 0,                                                       "MaxMergeRdCand must be greater than or equal to 0" );
+  confirmParameter( m_speedCtrlFps < 0,                                                         "SpeedControlFps must be greater than or equal to 0" );
+  confirmParameter( m_analysisMode < 0 || m_analysisMode > 2,                                   "Analysis mode must be 0, 1 or 2" );
+  confirmParameter( m_analysisMode > 0 && m_analysisFileName.empty(),                           "Shared analysis requires an analysis file" );
+  confirmParameter( m_analysisReuseLevel < 1 || m_analysisReuseLevel > 2,                       "AnalysisReuseLevel must be 1 or 2" );
+  confirmParameter( m_splitPredictorThreshold < 0.0 || m_splitPredictorThreshold > 1.0,          "Split predictor threshold must be in the range 0 to 1" );
 
   confirmParameter( m_MCTFFrames.size() != m_MCTFStrengths.size(),        "MCTF parameter list sizes differ");
   confirmParameter( m_MCTFNumLeadFrames  < 0,                             "MCTF number of lead frames must be greater than or equal to 0" );
   confirmParameter( m_MCTFNumTrailFrames < 0,                             "MCTF number of trailing frames must be greater than or equal to 0" );
   confirmParameter( m_MCTFNumLeadFrames  > 0 && ! m_MCTF,                 "MCTF disabled but number of MCTF lead frames is given" );
   confirmParameter( m_MCTFNumTrailFrames > 0 && ! m_MCTF,                 "MCTF disabled but number of MCTF trailing frames is given" );
+  confirmParameter( m_MCTFMotionSeed && ! m_MCTF,                         "MCTF disabled but MCTF motion seeding is enabled" );
   confirmParameter( m_MCTFNumTrailFrames > 0 && m_framesToBeEncoded <= 0, "If number of MCTF trailing frames is given, the total number of frames to be encoded has to be set" );
 
   confirmParameter( m_numWppThreads < 0,                            "NumWppThreads out of range");
@@ -611,6 +643,8 @@ bool EncCfg::initCfgParameter()
   confirmParameter( ( m_frameParallel || m_ensureFppBitEqual ) && m_cabacInitPresent,     "CabacInitPresent and frame parallel encoding not supported" );
   confirmParameter( ( m_frameParallel || m_ensureFppBitEqual ) && m_alf,                  "ALF and frame parallel encoding not supported" );
   confirmParameter( ( m_frameParallel || m_ensureFppBitEqual ) && m_saoEncodingRate >= 0, "SaoEncodingRate and frame parallel encoding not supported" );
+  confirmParameter( m_hugePages < 0 || m_hugePages > 2,                                   "HugePages must be 0, 1 or 2" );
+  confirmParameter( m_memoryBudget < 0,                                                   "MemoryBudget must be greater than or equal to 0" );
 #if ENABLE_TRACING
   confirmParameter( m_frameParallel && ( m_numFppThreads != 0 && m_numFppThreads != 1 ) && ! m_traceFile.empty(), "Tracing and frame parallel encoding not supported" );
 #endif
@@ -1478,9 +1512,97 @@ bool EncCfg::initCfgParameter()
     }
   }
 
+  if ( m_memoryBudget > 0 )
+  {
+    // give up the input buffering beyond the input queue size first, then parallelism, then lookahead
+    const int64_t budget  = int64_t( m_memoryBudget ) << 20;
+    const int     minIQS  = m_MCTF ? m_GOPSize + MCTF_ADD_QUEUE_DELAY : m_GOPSize;
+    while ( estimateMemoryUsage() > budget )
+    {
+      if ( m_InputQueueMaxSize > m_InputQueueSize )
+      {
+        m_InputQueueMaxSize--;
+      }
+      else if ( m_frameParallel && m_numFppThreads > 1 )
+      {
+        m_numFppThreads--;
+      }
+      else if ( m_numWppThreads > 1 )
+      {
+        m_numWppThreads--;
+      }
+      else if ( m_InputQueueSize > minIQS )
+      {
+        m_InputQueueSize--;
+      }
+      else
+      {
+        break;
+      }
+    }
+    confirmParameter( estimateMemoryUsage() > budget, "MemoryBudget too small, the encoder needs more memory even without frame parallel encoding, WPP threads and additional input queue" );
+  }
+
   return( m_confirmFailed );
 }
 
+int64_t EncCfg::estimateMemoryUsage() const
+{
+  // the picture, scratch and hash table sizes follow the allocations, the per thread, per CTU line and per CTU constants are fitted to the accounting of the encoder
+  const ChromaFormat chFmt     = m_internChromaFormat;
+  const Area    picArea        ( 0, 0, m_SourceWidth, m_SourceHeight );
+  const int64_t widthInCtus    = ( m_SourceWidth  + m_CTUSize - 1 ) / m_CTUSize;
+  const int64_t heightInCtus   = ( m_SourceHeight + m_CTUSize - 1 ) / m_CTUSize;
+  const int     padding        = m_MCTF ? MCTF_PADDING : 0;
+  const int64_t lumaSamples    = int64_t( m_SourceWidth ) * m_SourceHeight;
+  const int64_t chromaSamples  = chFmt == CHROMA_400 ? 0 : lumaSamples / ( ( 1 << getComponentScaleX( COMP_Cb, chFmt ) ) * ( 1 << getComponentScaleY( COMP_Cb, chFmt ) ) );
+  const int64_t numMiBlocks    = lumaSamples >> ( 2 * MIN_CU_LOG2 );
+  const int64_t numChannels    = chFmt == CHROMA_400 ? 1 : 2;
+
+  // pictures: original and reconstruction from the size classes of the picture buffer pool, the coding structure with coefficients, unit maps, loop filter parameters and motion
+  const int64_t origBytes      = PelStorage::getAllocSize( chFmt, picArea, 0, padding, 0, true, true );
+  const int64_t recoBytes      = PelStorage::getAllocSize( chFmt, picArea, m_CTUSize, m_CTUSize + 16, MEMORY_ALIGN_DEF_SIZE, true, true );
+  const int64_t coeffBytes     = ( lumaSamples + 2 * chromaSamples ) * int64_t( sizeof( TCoeff ) + sizeof( Pel ) ) + ( lumaSamples + chromaSamples ) * int64_t( sizeof( bool ) );
+  const int64_t mapBytes       = numMiBlocks * int64_t( numChannels * ( 3 * sizeof( void* ) + sizeof( bool ) ) + NUM_EDGE_DIR * LoopFilterParamMap::NUM_PLANES + sizeof( MotionInfo ) );
+  const int64_t picBytes       = origBytes + recoBytes + coeffBytes + mapBytes;
+  const int64_t numQueuePics   = std::max( m_InputQueueSize, m_InputQueueMaxSize );
+        int64_t numPics        = numQueuePics + m_maxDecPicBuffering[ MAX_TLAYER - 1 ] + 2;
+  if ( m_framesToBeEncoded > 0 )
+  {
+    numPics = std::min<int64_t>( numPics, m_framesToBeEncoded );
+  }
+
+  // temporal filter: lead/trail pictures and the subsampled luma of the filtered picture and one reference, the motion compensated block lines are negligible
+  const int64_t subPadding     = 32;
+  const int64_t pyramidBytes   = ( ( m_SourceWidth / 2 + 2 * subPadding ) * ( m_SourceHeight / 2 + 2 * subPadding ) + ( m_SourceWidth / 4 + 2 * subPadding ) * ( m_SourceHeight / 4 + 2 * subPadding ) ) * int64_t( sizeof( Pel ) );
+  const int64_t mctfBytes      = m_MCTF ? ( m_MCTFNumLeadFrames + m_MCTFNumTrailFrames ) * ( origBytes + recoBytes ) + 2 * pyramidBytes + 1200000 : 0;
+
+  // per picture encoder: SAO and reshaped original scratch buffers, CTU resources per thread (CU encoder incl. its coding structure tree), line resources per CTU row and ALF statistics per CTU
+  const int64_t numEncoders    = m_frameParallel && m_numFppThreads > 1 ? m_numFppThreads : 1;
+  const int64_t numCtuRsrc     = m_numWppThreads > 0 ? std::min<int64_t>( heightInCtus, m_numWppThreads ) : 1;
+  const int64_t numLineRsrc    = m_numWppThreads > 0 ? heightInCtus : 1;
+  const int64_t rspOrigBytes   = PelStorage::getAllocSize( chFmt, picArea, 0, padding );
+  const int64_t scratchBytes   = PelStorage::getAllocSize( chFmt, picArea, m_CTUSize, 0, MEMORY_ALIGN_DEF_SIZE ) + ( m_lumaReshapeEnable ? rspOrigBytes : 0 ) + ( m_HashME ? 2 * lumaSamples * int64_t( sizeof( uint32_t ) ) : 0 );
+  const int64_t ctuRsrcBytes   = int64_t( 18400000 ) * m_CTUSize * m_CTUSize / ( 128 * 128 ) + 52000 * widthInCtus * heightInCtus;
+  const int64_t encBytes       = scratchBytes + numCtuRsrc * ctuRsrcBytes + numLineRsrc * 330000 + widthInCtus * heightInCtus * 830000 + 1150000;
+
+  // filtered originals, which wait in the input queue until their picture is encoded
+  int64_t numFilteredPics      = 0;
+  if ( m_MCTF && ! m_MCTFFrames.empty() )
+  {
+    numFilteredPics = std::min<int64_t>( numPics, numQueuePics / std::max( 1, *std::min_element( m_MCTFFrames.begin(), m_MCTFFrames.end() ) ) + 1 );
+  }
+
+  // hash tables of the pictures used for reference and of the pictures being encoded
+  const int64_t numHashPics    = m_HashME ? std::min<int64_t>( numPics, m_maxDecPicBuffering[ MAX_TLAYER - 1 ] + numEncoders ) : 0;
+  const int64_t hashBytes      = numHashPics * int64_t( BlockHash::getMaxTableSize( m_SourceWidth, m_SourceHeight ) );
+
+  const int64_t bytes          = numPics * picBytes + numFilteredPics * rspOrigBytes + hashBytes + mctfBytes + numEncoders * encBytes;
+
+  // safety margin for the smaller allocations, which are not modelled
+  return bytes + bytes / 16;
+}
+
 void EncCfg::setCfgParameter( const EncCfg& encCfg )
 {
   *this = encCfg;
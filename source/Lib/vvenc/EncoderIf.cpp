@@ -99,6 +99,18 @@ void EncoderIf::printSummary()
   m_pEncLib->printSummary();
 }
 
+void EncoderIf::getMemUsage( MemUsage& memUsage ) const
+{
+  CHECK( m_pEncLib == nullptr, "encoder library not initialized" );
+  m_pEncLib->getMemUsage( memUsage );
+}
+
+void EncoderIf::getQueueStatus( InputQueueStatus& queueStatus ) const
+{
+  CHECK( m_pEncLib == nullptr, "encoder library not initialized" );
+  m_pEncLib->getQueueStatus( queueStatus );
+}
+
 // ====================================================================================================================
 
 void setMsgFnc( MsgFnc msgFnc )
@@ -116,6 +128,9 @@ std::string setSIMDExtension( const std::string& simdId )
 #endif
   g_pelBufOP.initPelBufOpsX86();
 #endif
+#if ENABLE_SIMD_OPT_BITSTREAM && defined( TARGET_SIMD_X86 )
+  g_bitstreamOps.initBitstreamOpsX86();
+#endif
 #if ENABLE_SIMD_TRAFO
   g_tCoeffOps.initTCoeffOps();
 #endif
@@ -52,8 +52,15 @@ vvc@hhi.fraunhofer.de
 #include "EncoderLib/NALwrite.h"
 
 #include <iostream>
+#include <sstream>
+#include <algorithm>
 #include "../../../include/vvenc/EncoderIf.h"
 
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
 //! \ingroup Interface
 //! \{
 
@@ -485,7 +492,102 @@ void scaleYuvPlane( YUVPlane& yuvPlane, const int shiftBits, const Pel minVal, c
 
 // ====================================================================================================================
 
-void YuvIO::open( const std::string &fileName, bool bWriteMode, const int fileBitDepth[ MAX_NUM_CH ], const int MSBExtendedBitDepth[ MAX_NUM_CH ], const int internalBitDepth[ MAX_NUM_CH ] )
+static bool readY4mHeader( std::istream& is, int& width, int& height, int& frameRate, int& frameScale, ChromaFormat& chFmt, int& bitDepth )
+{
+  std::string header;
+  if ( ! std::getline( is, header ) || header.compare( 0, 9, "YUV4MPEG2" ) != 0 )
+  {
+    return false;
+  }
+
+  // defaults according to the YUV4MPEG2 specification
+  width      = 0;
+  height     = 0;
+  frameRate  = 25;
+  frameScale = 1;
+  chFmt      = CHROMA_420;
+  bitDepth   = 8;
+
+  std::istringstream tokens( header.substr( 9 ) );
+  std::string token;
+  while ( tokens >> token )
+  {
+    const std::string value = token.substr( 1 );
+    switch ( token[ 0 ] )
+    {
+      case 'W': width  = atoi( value.c_str() ); break;
+      case 'H': height = atoi( value.c_str() ); break;
+      case 'F':
+        {
+          const size_t sep = value.find( ':' );
+          if ( sep == std::string::npos )
+          {
+            return false;
+          }
+          frameRate  = atoi( value.substr( 0, sep ).c_str() );
+          frameScale = atoi( value.substr( sep + 1 ).c_str() );
+        }
+        break;
+      case 'C':
+        {
+          if      ( value.compare( 0, 3, "420"  ) == 0 ) chFmt = CHROMA_420;
+          else if ( value.compare( 0, 3, "422"  ) == 0 ) chFmt = CHROMA_422;
+          else if ( value.compare( 0, 3, "444"  ) == 0 ) chFmt = CHROMA_444;
+          else if ( value.compare( 0, 4, "mono" ) == 0 ) chFmt = CHROMA_400;
+          else return false;
+
+          // bit depth suffix, e.g. 420p10 or mono16, no suffix (420jpeg, 420mpeg2, 420paldv, mono) means 8 bit
+          const size_t pos = ( chFmt == CHROMA_400 ) ? 4 : ( value.size() > 4 && value[ 3 ] == 'p' && isdigit( value[ 4 ] ) ) ? 4 : std::string::npos;
+          if ( pos != std::string::npos && pos < value.size() )
+          {
+            bitDepth = atoi( value.substr( pos ).c_str() );
+          }
+        }
+        break;
+      default:
+        // interlacing (I), pixel aspect ratio (A) and extensions (X) are ignored
+        break;
+    }
+  }
+
+  return width > 0 && height > 0 && frameRate > 0 && frameScale > 0 && bitDepth >= 8 && bitDepth <= 16;
+}
+
+// ====================================================================================================================
+
+YuvIO::YuvIO()
+  : m_inStream ( nullptr )
+  , m_outStream( nullptr )
+  , m_y4m      ( false )
+{
+}
+
+bool YuvIO::isY4mFileName( const std::string &fileName )
+{
+  if ( fileName.size() < 4 )
+  {
+    return false;
+  }
+  std::string ext = fileName.substr( fileName.size() - 4 );
+  std::transform( ext.begin(), ext.end(), ext.begin(), ::tolower );
+  return ext == ".y4m";
+}
+
+bool YuvIO::parseY4mHeader( const std::string &fileName, int& width, int& height, int& frameRate, int& frameScale, ChromaFormat& chFmt, int& bitDepth )
+{
+  if ( fileName == "-" )
+  {
+#ifdef _WIN32
+    _setmode( _fileno( stdin ), _O_BINARY );
+#endif
+    return readY4mHeader( std::cin, width, height, frameRate, frameScale, chFmt, bitDepth );
+  }
+
+  std::ifstream is( fileName.c_str(), std::ios::binary | std::ios::in );
+  return is.is_open() && readY4mHeader( is, width, height, frameRate, frameScale, chFmt, bitDepth );
+}
+
+void YuvIO::open( const std::string &fileName, bool bWriteMode, const int fileBitDepth[ MAX_NUM_CH ], const int MSBExtendedBitDepth[ MAX_NUM_CH ], const int internalBitDepth[ MAX_NUM_CH ], bool forceY4m )
 {
   //NOTE: files cannot have bit depth greater than 16
   for( int ch = 0; ch < MAX_NUM_CH; ch++ )
@@ -507,39 +609,99 @@ void YuvIO::open( const std::string &fileName, bool bWriteMode, const int fileBi
     }
   }
 
+  m_inStream  = nullptr;
+  m_outStream = nullptr;
+  m_y4m       = false;
+
   if ( bWriteMode )
   {
+    if ( fileName == "-" )
+    {
+#ifdef _WIN32
+      _setmode( _fileno( stdout ), _O_BINARY );
+#endif
+      m_outStream = &std::cout;
+      return;
+    }
+
     m_cHandle.open( fileName.c_str(), std::ios::binary | std::ios::out );
 
     if( m_cHandle.fail() )
     {
       EXIT( "Failed to open output YUV file: " << fileName.c_str() );
     }
+    m_outStream = &m_cHandle;
   }
   else
   {
-    m_cHandle.open( fileName.c_str(), std::ios::binary | std::ios::in );
+    if ( fileName == "-" )
+    {
+#ifdef _WIN32
+      _setmode( _fileno( stdin ), _O_BINARY );
+#endif
+      m_inStream = &std::cin;
+    }
+    else
+    {
+      m_cHandle.open( fileName.c_str(), std::ios::binary | std::ios::in );
 
-    if( m_cHandle.fail() )
+      if( m_cHandle.fail() )
+      {
+        EXIT( "Failed to open input YUV file: " << fileName.c_str() );
+      }
+      m_inStream = &m_cHandle;
+    }
+
+    m_y4m = forceY4m || isY4mFileName( fileName );
+    if ( m_y4m && m_inStream->peek() == 'Y' )
     {
-      EXIT( "Failed to open input YUV file: " << fileName.c_str() );
+      // stream header has not been consumed by parseY4mHeader() yet
+      int width, height, frameRate, frameScale, bitDepth;
+      ChromaFormat chFmt;
+      if ( ! readY4mHeader( *m_inStream, width, height, frameRate, frameScale, chFmt, bitDepth ) )
+      {
+        EXIT( "Invalid YUV4MPEG2 header in input file: " << fileName.c_str() );
+      }
     }
   }
 }
 
 void YuvIO::close()
 {
-  m_cHandle.close();
+  if ( m_cHandle.is_open() )
+  {
+    m_cHandle.close();
+  }
+  if ( m_outStream )
+  {
+    m_outStream->flush();
+  }
+  m_inStream  = nullptr;
+  m_outStream = nullptr;
 }
 
 bool YuvIO::isEof()
 {
-  return m_cHandle.eof();
+  return m_inStream ? m_inStream->eof() : m_cHandle.eof();
 }
 
 bool YuvIO::isFail()
 {
-  return m_cHandle.fail();
+  return m_inStream ? m_inStream->fail() : m_outStream ? m_outStream->fail() : m_cHandle.fail();
+}
+
+bool YuvIO::xReadY4mFrameHeader()
+{
+  std::string frameHeader;
+  if ( ! std::getline( *m_inStream, frameHeader ) )
+  {
+    return false;
+  }
+  if ( frameHeader.compare( 0, 5, "FRAME" ) != 0 )
+  {
+    EXIT( "Invalid YUV4MPEG2 frame header" );
+  }
+  return true;
 }
 
 void YuvIO::skipYuvFrames( int numFrames, const ChromaFormat& inputChFmt, int width, int height  )
@@ -563,24 +725,32 @@ void YuvIO::skipYuvFrames( int numFrames, const ChromaFormat& inputChFmt, int wi
   }
   frameSize *= wordsize;
 
+  if ( m_y4m )
+  {
+    // frame headers may vary in size, skip frame by frame
+    for ( int i = 0; i < numFrames; i++ )
+    {
+      if ( ! xReadY4mFrameHeader() )
+      {
+        return;
+      }
+      m_inStream->ignore( frameSize );
+    }
+    return;
+  }
+
   const std::streamoff offset = frameSize * numFrames;
 
   // attempt to seek
-  if ( !! m_cHandle.seekg( offset, std::ios::cur ) )
+  if ( !! m_inStream->seekg( offset, std::ios::cur ) )
   {
     return; /* success */
   }
 
-  m_cHandle.clear();
+  m_inStream->clear();
 
   // fall back to consuming the input
-  char buf[ 512 ];
-  const std::streamoff offset_mod_bufsize = offset % sizeof( buf );
-  for ( std::streamoff i = 0; i < offset - offset_mod_bufsize; i += sizeof( buf ) )
-  {
-    m_cHandle.read( buf, sizeof( buf ) );
-  }
-  m_cHandle.read( buf, offset_mod_bufsize );
+  m_inStream->ignore( offset );
 }
 
 bool YuvIO::readYuvBuf( YUVBuffer& yuvInBuf, const ChromaFormat& inputChFmt, const ChromaFormat& internChFmt, const int pad[ 2 ], bool bClipToRec709 )
@@ -591,6 +761,11 @@ bool YuvIO::readYuvBuf( YUVBuffer& yuvInBuf, const ChromaFormat& inputChFmt, con
     return false;
   }
 
+  if ( m_y4m && ! xReadY4mFrameHeader() )
+  {
+    return false;
+  }
+
   bool is16bit = false;
   for( int ch = 0; ch < MAX_NUM_CH; ch++ )
   {
@@ -613,7 +788,7 @@ bool YuvIO::readYuvBuf( YUVBuffer& yuvInBuf, const ChromaFormat& inputChFmt, con
     const Pel maxVal           = b709Compliance ? ( ( 0xff << ( desired_bitdepth - 8 ) ) -1 ) : ( 1 << desired_bitdepth ) - 1;
     YUVPlane& yuvPlane         = yuvInBuf.yuvPlanes[ comp ];
 
-    if ( ! readYuvPlane( m_cHandle, yuvPlane, is16bit, m_fileBitdepth[ chType ], pad, compID, inputChFmt, internChFmt ) )
+    if ( ! readYuvPlane( *m_inStream, yuvPlane, is16bit, m_fileBitdepth[ chType ], pad, compID, inputChFmt, internChFmt ) )
       return false;
 
     if ( internChFmt == CHROMA_400 )
@@ -678,7 +853,7 @@ bool YuvIO::writeYuvBuf( const YUVBuffer& yuvOutBuf, const ChromaFormat& internC
     const ComponentID compID = ComponentID( comp );
     const ChannelType chType = toChannelType( compID );
     const YUVPlane& yuvPlane = yuvWriteBuf.yuvPlanes[ comp ];
-    if ( ! writeYuvPlane( m_cHandle, yuvPlane, is16bit, m_fileBitdepth[ chType ], bPackedYUVOutputMode, compID, internChFmt, outputChFmt ) )
+    if ( ! writeYuvPlane( *m_outStream, yuvPlane, is16bit, m_fileBitdepth[ chType ], bPackedYUVOutputMode, compID, internChFmt, outputChFmt ) )
       return false;
   }
 
@@ -690,46 +865,22 @@ bool YuvIO::writeYuvBuf( const YUVBuffer& yuvOutBuf, const ChromaFormat& internC
 /**
  * write all NALunits in au to bytestream out in a manner satisfying
  * AnnexB of AVC.  NALunits are written in the order they are found in au.
- * the zero_byte word is appended to:
- *  - the initial startcode in the access unit,
- *  - any SPS/PPS nal units
+ * The access unit already holds the complete byte stream including the
+ * start codes, so it is passed on in one piece.
  */
 std::vector<uint32_t> writeAnnexB( std::ostream& out, const AccessUnit& au )
 {
   std::vector<uint32_t> annexBsizes;
+  annexBsizes.reserve( au.size() );
 
-  for (AccessUnit::const_iterator it = au.begin(); it != au.end(); it++)
+  for ( const auto& nalu : au )
   {
-    const NALUnitEBSP& nalu = **it;
-    uint32_t size = 0; /* size of annexB unit in bytes */
-
-    static const uint8_t start_code_prefix[] = {0,0,0,1};
-    if (it == au.begin() || nalu.m_nalUnitType == NAL_UNIT_DCI || nalu.m_nalUnitType == NAL_UNIT_SPS || nalu.m_nalUnitType == NAL_UNIT_VPS || nalu.m_nalUnitType == NAL_UNIT_PPS || nalu.m_nalUnitType == NAL_UNIT_PREFIX_APS || nalu.m_nalUnitType == NAL_UNIT_SUFFIX_APS )
-    {
-      /* From AVC, When any of the following conditions are fulfilled, the
-       * zero_byte syntax element shall be present:
-       *  - the nal_unit_type within the nal_unit() is equal to 7 (sequence
-       *    parameter set) or 8 (picture parameter set),
-       *  - the byte stream NAL unit syntax structure contains the first NAL
-       *    unit of an access unit in decoding order, as specified by subclause
-       *    7.4.1.2.3.
-       */
-      out.write(reinterpret_cast<const char*>(start_code_prefix), 4);
-      size += 4;
-    }
-    else
-    {
-      out.write(reinterpret_cast<const char*>(start_code_prefix+1), 3);
-      size += 3;
-    }
-    out << nalu.m_nalUnitData.str();
-    size += uint32_t(nalu.m_nalUnitData.str().size());
-
-    annexBsizes.push_back(size);
+    annexBsizes.push_back( nalu.getAnnexBSize() );
   }
 
   if (au.size() > 0)
   {
+    out.write( reinterpret_cast<const char*>( au.getAnnexB() ), au.getAnnexBSize() );
     out.flush();
   }
 
@@ -125,6 +125,14 @@ int VVEnc::encode( InputPicture* pcInputPicture, VvcAccessUnit& rcVvcAccessUnit
   return m_pcVVEncImpl->encode( pcInputPicture, rcVvcAccessUnit );
 }
 
+int VVEnc::getQueueStatus( InputQueueStatus& rcQueueStatus )
+{
+  if( !m_pcVVEncImpl->m_bInitialized )
+  {  return m_pcVVEncImpl->setAndRetErrorMsg(VVENC_ERR_INITIALIZE); }
+
+  return m_pcVVEncImpl->setAndRetErrorMsg( m_pcVVEncImpl->getQueueStatus( rcQueueStatus ) );
+}
+
 int VVEnc::flush( VvcAccessUnit& rcVvcAccessUnit )
 {
   if( !m_pcVVEncImpl->m_bInitialized )
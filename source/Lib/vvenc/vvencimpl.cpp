@@ -151,14 +151,40 @@ int VVEncImpl::encode( InputPicture* pcInputPicture, VvcAccessUnit& rcVvcAccessU
 
   if( !pcInputPicture )
   {
-    m_cErrorString = "InputPicture is null";
-    return VVENC_ERR_UNSPECIFIED;
+    rcVvcAccessUnit.m_iUsedSize = 0;
+
+    // first deliver a chunk still pending from a call that returned VVENC_NOT_ENOUGH_MEM
+    if ( !m_cAu.empty() )
+    {
+      return xCopyPendingAu( rcVvcAccessUnit );
+    }
+
+    // no input, encode a queued picture if the queue holds enough pictures
+    YUVBuffer cYUVBuffer;
+    bool encDone = false;
+
+    m_cEncoderIf.encodePicture( false, cYUVBuffer, m_cAu, encDone );
+
+    if ( !m_cAu.empty() )
+    {
+      iRet = xCopyPendingAu( rcVvcAccessUnit );
+    }
+    return iRet;
   }
 
-  if( pcInputPicture->m_cPicBuffer.m_iBitDepth < 10 )
+  InputQueueStatus cQueueStatus;
+  m_cEncoderIf.getQueueStatus( cQueueStatus );
+  if( cQueueStatus.wouldBlock )
+  {
+    m_cErrorString = "input queue full, encode a queued picture before passing the next one";
+    return VVENC_WOULD_BLOCK;
+  }
+
+  const bool bInput8Bit = m_cVVEncParameter.m_iInternalBitDepth == 8;
+  if( bInput8Bit ? pcInputPicture->m_cPicBuffer.m_iBitDepth != 8 : pcInputPicture->m_cPicBuffer.m_iBitDepth < 10 )
   {
     std::stringstream css;
-    css << "InputPicture: unsupported input BitDepth " <<  pcInputPicture->m_cPicBuffer.m_iBitDepth  << ". must be 10 <= BitDepth <= 16";
+    css << "InputPicture: unsupported input BitDepth " <<  pcInputPicture->m_cPicBuffer.m_iBitDepth  << ( bInput8Bit ? ". must be 8 for InternalBitDepth 8" : ". must be 10 <= BitDepth <= 16" );
     m_cErrorString = css.str();
     return VVENC_ERR_UNSPECIFIED;
   }
@@ -190,12 +216,25 @@ int VVEncImpl::encode( InputPicture* pcInputPicture, VvcAccessUnit& rcVvcAccessU
     yuvPlane.planeBuf  = ( size > 0 ) ? new int16_t[ size ] : nullptr;
   }
 
-  xCopyInputPlane( cYUVBuffer.yuvPlanes[0].planeBuf, cYUVBuffer.yuvPlanes[0].stride, cYUVBuffer.yuvPlanes[0].width, cYUVBuffer.yuvPlanes[0].height,
-                   (int16_t*)pcInputPicture->m_cPicBuffer.m_pvY, pcInputPicture->m_cPicBuffer.m_iStride, pcInputPicture->m_cPicBuffer.m_iWidth, pcInputPicture->m_cPicBuffer.m_iHeight, 0 );
-  xCopyInputPlane( cYUVBuffer.yuvPlanes[1].planeBuf, iChromaInStride, cYUVBuffer.yuvPlanes[1].width, cYUVBuffer.yuvPlanes[1].height,
-                   (int16_t*)pcInputPicture->m_cPicBuffer.m_pvU, iChromaInStride, pcInputPicture->m_cPicBuffer.m_iWidth>>1, pcInputPicture->m_cPicBuffer.m_iHeight>>1, 0 );
-  xCopyInputPlane( cYUVBuffer.yuvPlanes[2].planeBuf, iChromaInStride, cYUVBuffer.yuvPlanes[2].width, cYUVBuffer.yuvPlanes[2].height,
-                   (int16_t*)pcInputPicture->m_cPicBuffer.m_pvV, iChromaInStride, pcInputPicture->m_cPicBuffer.m_iWidth>>1, pcInputPicture->m_cPicBuffer.m_iHeight>>1, 0 );
+  if( bInput8Bit )
+  {
+    // 8-bit input planes hold one byte per sample, widen them to the internal sample type
+    xCopyInputPlane( cYUVBuffer.yuvPlanes[0].planeBuf, cYUVBuffer.yuvPlanes[0].stride, cYUVBuffer.yuvPlanes[0].width, cYUVBuffer.yuvPlanes[0].height,
+                     (uint8_t*)pcInputPicture->m_cPicBuffer.m_pvY, pcInputPicture->m_cPicBuffer.m_iStride, pcInputPicture->m_cPicBuffer.m_iWidth, pcInputPicture->m_cPicBuffer.m_iHeight, 0 );
+    xCopyInputPlane( cYUVBuffer.yuvPlanes[1].planeBuf, iChromaInStride, cYUVBuffer.yuvPlanes[1].width, cYUVBuffer.yuvPlanes[1].height,
+                     (uint8_t*)pcInputPicture->m_cPicBuffer.m_pvU, iChromaInStride, pcInputPicture->m_cPicBuffer.m_iWidth>>1, pcInputPicture->m_cPicBuffer.m_iHeight>>1, 0 );
+    xCopyInputPlane( cYUVBuffer.yuvPlanes[2].planeBuf, iChromaInStride, cYUVBuffer.yuvPlanes[2].width, cYUVBuffer.yuvPlanes[2].height,
+                     (uint8_t*)pcInputPicture->m_cPicBuffer.m_pvV, iChromaInStride, pcInputPicture->m_cPicBuffer.m_iWidth>>1, pcInputPicture->m_cPicBuffer.m_iHeight>>1, 0 );
+  }
+  else
+  {
+    xCopyInputPlane( cYUVBuffer.yuvPlanes[0].planeBuf, cYUVBuffer.yuvPlanes[0].stride, cYUVBuffer.yuvPlanes[0].width, cYUVBuffer.yuvPlanes[0].height,
+                     (int16_t*)pcInputPicture->m_cPicBuffer.m_pvY, pcInputPicture->m_cPicBuffer.m_iStride, pcInputPicture->m_cPicBuffer.m_iWidth, pcInputPicture->m_cPicBuffer.m_iHeight, 0 );
+    xCopyInputPlane( cYUVBuffer.yuvPlanes[1].planeBuf, iChromaInStride, cYUVBuffer.yuvPlanes[1].width, cYUVBuffer.yuvPlanes[1].height,
+                     (int16_t*)pcInputPicture->m_cPicBuffer.m_pvU, iChromaInStride, pcInputPicture->m_cPicBuffer.m_iWidth>>1, pcInputPicture->m_cPicBuffer.m_iHeight>>1, 0 );
+    xCopyInputPlane( cYUVBuffer.yuvPlanes[2].planeBuf, iChromaInStride, cYUVBuffer.yuvPlanes[2].width, cYUVBuffer.yuvPlanes[2].height,
+                     (int16_t*)pcInputPicture->m_cPicBuffer.m_pvV, iChromaInStride, pcInputPicture->m_cPicBuffer.m_iWidth>>1, pcInputPicture->m_cPicBuffer.m_iHeight>>1, 0 );
+  }
 
   cYUVBuffer.sequenceNumber = pcInputPicture->m_cPicBuffer.m_uiSequenceNumber;
   if( pcInputPicture->m_cPicBuffer.m_bCtsValid )
@@ -204,16 +243,16 @@ int VVEncImpl::encode( InputPicture* pcInputPicture, VvcAccessUnit& rcVvcAccessU
     cYUVBuffer.ctsValid = true;
   }
 
-  AccessUnit cAu;
   bool encDone = false;
 
-  m_cEncoderIf.encodePicture( false, cYUVBuffer, cAu, encDone );
+  m_cAu.reset();
+  m_cEncoderIf.encodePicture( false, cYUVBuffer, m_cAu, encDone );
 
   /* copy output AU */
   rcVvcAccessUnit.m_iUsedSize = 0;
-  if ( !cAu.empty() )
+  if ( !m_cAu.empty() )
   {
-    iRet = xCopyAu( rcVvcAccessUnit, cAu  );
+    iRet = xCopyPendingAu( rcVvcAccessUnit );
   }
 
   /* free memory of input image */
@@ -234,25 +273,40 @@ int VVEncImpl::flush( VvcAccessUnit& rcVvcAccessUnit )
 
   int iRet= VVENC_OK;
 
+  // first deliver a chunk still pending from a call that returned VVENC_NOT_ENOUGH_MEM
+  rcVvcAccessUnit.m_iUsedSize = 0;
+  if ( !m_cAu.empty() )
+  {
+    return xCopyPendingAu( rcVvcAccessUnit );
+  }
+
   YUVBuffer cYUVBuffer;
-  AccessUnit cAu;
   bool encDone    = false;
 
-  while( !encDone &&  cAu.empty() )
+  while( !encDone &&  m_cAu.empty() )
   {
-    m_cEncoderIf.encodePicture( true, cYUVBuffer, cAu, encDone );
+    m_cEncoderIf.encodePicture( true, cYUVBuffer, m_cAu, encDone );
 
     /* copy output AU */
     rcVvcAccessUnit.m_iUsedSize = 0;
-    if ( !cAu.empty() )
+    if ( !m_cAu.empty() )
     {
-      iRet = xCopyAu( rcVvcAccessUnit, cAu  );
+      iRet = xCopyPendingAu( rcVvcAccessUnit );
+      break;
     }
   }
 
   return iRet;
 }
 
+int VVEncImpl::getQueueStatus( InputQueueStatus& rcQueueStatus )
+{
+  if( !m_bInitialized ){ return VVENC_ERR_INITIALIZE; }
+
+  m_cEncoderIf.getQueueStatus( rcQueueStatus );
+  return VVENC_OK;
+}
+
 struct BufferDimensions
 {
   BufferDimensions(int iWidth, int iHeight, int iBitDepth, int iMaxCUSizeLog2, int iAddMargin = 16 )
@@ -286,7 +340,7 @@ int VVEncImpl::getPreferredBuffer( PicBuffer &rcPicBuffer )
   bool bMarginReq = false;
   int iAddMargin           = bMarginReq ? 16: -1;
   const int iMaxCUSizeLog2 = 7;
-  const int iBitDepth = 10;
+  const int iBitDepth = m_cVVEncParameter.m_iInternalBitDepth;
 
   int iMaxCUSizeLog2Buffer = bMarginReq ? iMaxCUSizeLog2 : 0;
   const BufferDimensions bd( m_cVVEncParameter.m_iWidth, m_cVVEncParameter.m_iHeight, iBitDepth, iMaxCUSizeLog2Buffer, iAddMargin);
@@ -350,6 +404,7 @@ const char* VVEncImpl::getErrorMsg( int nRet )
   case VVENC_ERR_PARAMETER:        m_cTmpErrorString = "inconsistent or invalid parameters"; break;
   case VVENC_ERR_NOT_SUPPORTED:    m_cTmpErrorString = "unsupported request"; break;
   case VVENC_ERR_RESTART_REQUIRED: m_cTmpErrorString = "decoder requires restart"; break;
+  case VVENC_WOULD_BLOCK:          m_cTmpErrorString = "input queue full"; break;
   case VVENC_ERR_CPU:              m_cTmpErrorString = "unsupported CPU - SSE 4.1 needed!"; break;
   default:                         m_cTmpErrorString = "unknown ret code"; break;
   }
@@ -398,6 +453,8 @@ int VVEncImpl::xCheckParameter( const vvenc::VVEncParameter& rcSrc, std::string&
   ROTPARAMS( rcSrc.m_iTicksPerSecond <= 0 || rcSrc.m_iTicksPerSecond > 27000000,            "TicksPerSecond must be in range from 1 to 27000000" );
 
   ROTPARAMS( rcSrc.m_iThreadCount <= 0,                                                     "ThreadCount must be > 0" );
+  ROTPARAMS( rcSrc.m_iInputQueueMaxSize < 0,                                                "InputQueueMaxSize must be >= 0" );
+  ROTPARAMS( rcSrc.m_iInternalBitDepth != 8 && rcSrc.m_iInternalBitDepth != 10,             "InternalBitDepth must be 8 or 10" );
 
   ROTPARAMS( rcSrc.m_iIDRPeriod < 0,                                                        "IDR period must be GEZ" );
   ROTPARAMS( rcSrc.m_iGopSize != 1 && rcSrc.m_iGopSize != 16 && rcSrc.m_iGopSize != 32,     "GOP size 1, 16, 32 supported" );
@@ -411,7 +468,7 @@ int VVEncImpl::xCheckParameter( const vvenc::VVEncParameter& rcSrc, std::string&
 
   ROTPARAMS( rcSrc.m_eProfile != VVC_PROFILE_MAIN_10 && rcSrc.m_eProfile != VVC_PROFILE_MAIN_10_STILL_PICTURE && rcSrc.m_eProfile != VVC_PROFILE_AUTO, "unsupported profile, use main_10, main_10_still_picture or auto" );
 
-  ROTPARAMS( rcSrc.m_iQuality < 0 || rcSrc.m_iQuality > 3,                                  "quality must be between 0 - 3  (0: faster, 1: fast, 2: medium, 3: slow)" );
+  ROTPARAMS( rcSrc.m_iQuality < -1 || rcSrc.m_iQuality > 3,                                 "quality must be between -1 - 3  (-1: ultrafast, 0: faster, 1: fast, 2: medium, 3: slow)" );
   ROTPARAMS( rcSrc.m_iTargetBitRate < 0 || rcSrc.m_iTargetBitRate > 100000000,              "TargetBitrate must be between 0 - 100000000" );
 
   return 0;
@@ -446,7 +503,7 @@ int VVEncImpl::xInitLibCfg( const VVEncParameter& rcVVEncParameter, vvenc::EncCf
   }
 
 
-  rcEncCfg.m_internalBitDepth[0] = 10;
+  rcEncCfg.m_internalBitDepth[0] = rcVVEncParameter.m_iInternalBitDepth;
 
   if( rcVVEncParameter.m_iThreadCount > 1 )
   {
@@ -464,6 +521,7 @@ int VVEncImpl::xInitLibCfg( const VVEncParameter& rcVVEncParameter, vvenc::EncCf
   //======== Coding Structure =============
   rcEncCfg.m_GOPSize                             = rcVVEncParameter.m_iGopSize;
   rcEncCfg.m_InputQueueSize                      = rcVVEncParameter.m_iGopSize;
+  rcEncCfg.m_InputQueueMaxSize                   = rcVVEncParameter.m_iInputQueueMaxSize;
 
   rcEncCfg.m_IntraPeriod                         = rcVVEncParameter.m_iIDRPeriod;
   if( rcVVEncParameter.m_eDecodingRefreshType == VVC_DRT_IDR )
@@ -549,7 +607,7 @@ int VVEncImpl::xInitLibCfg( const VVEncParameter& rcVVEncParameter, vvenc::EncCf
   if( 0 != xInitPreset( rcEncCfg, rcVVEncParameter.m_iQuality  ) )
   {
     std::stringstream css;
-    css << "undefined quality preset " << rcVVEncParameter.m_iQuality << " quality must be between 0 - 3.";
+    css << "undefined quality preset " << rcVVEncParameter.m_iQuality << " quality must be between -1 - 3.";
     m_cErrorString  = css.str();
     return VVENC_ERR_PARAMETER;
   }
@@ -570,6 +628,48 @@ int VVEncImpl::xInitPreset( vvenc::EncCfg& rcEncCfg, int iQuality )
 
   switch( iQuality )
   {
+  case -1: // ultrafast, for low latency preview renditions
+          rcEncCfg.m_RDOQ                  = 0;
+          rcEncCfg.m_useRDOQTS             = false;
+          rcEncCfg.m_DepQuantEnabled       = false;
+          rcEncCfg.m_SignDataHidingEnabled = true;
+          rcEncCfg.m_BDOF                  = false;
+          rcEncCfg.m_alf                   = false;
+          rcEncCfg.m_ccalf                 = false;
+          rcEncCfg.m_DMVR                  = false;
+          rcEncCfg.m_JointCbCrMode         = false;
+          rcEncCfg.m_AMVRspeed             = 0;
+          rcEncCfg.m_lumaReshapeEnable     = false;
+          rcEncCfg.m_EDO                   = 0;
+          rcEncCfg.m_motionEstimationSearchMethod = 4;
+          rcEncCfg.m_SearchRange           = 128;
+          rcEncCfg.m_minSearchWindow       = 32;
+
+          rcEncCfg.m_useFastMrg            = 2;
+          rcEncCfg.m_fastLocalDualTreeMode = 2;
+          rcEncCfg.m_fastSubPel            = 1;
+          rcEncCfg.m_qtbttSpeedUp          = 1;
+          rcEncCfg.m_bUseEarlyCU           = true;
+          rcEncCfg.m_useEarlySkipDetection = true;
+
+          // SATD based intra and merge decisions with a reduced set of angles
+          rcEncCfg.m_bFastUDIUseMPMEnabled = false;
+          rcEncCfg.m_fastIntraAngles       = true;
+          rcEncCfg.m_maxIntraRdCand        = 1;
+          rcEncCfg.m_maxMergeRdCand        = 1;
+
+          rcEncCfg.m_LMCSOffset      = 6;
+          rcEncCfg.m_MRL             = false;
+
+          rcEncCfg.m_maxMTTDepth        = 0;
+          rcEncCfg.m_maxMTTDepthI       = 1;
+          rcEncCfg.m_maxMTTDepthIChroma = 1;
+          rcEncCfg.m_maxNumMergeCand    = 4;
+
+          rcEncCfg.m_useNonLinearAlfLuma   = false;
+          rcEncCfg.m_useNonLinearAlfChroma = false;
+
+          break;
   case 0: // faster
           rcEncCfg.m_RDOQ                  = 2;
           rcEncCfg.m_DepQuantEnabled       = false;
@@ -774,6 +874,7 @@ void VVEncImpl::xPrintCfg()
   msgApp( (int)LL_DETAILS, "Cr QP Offset (dual tree)               : %d (%d)\n", m_cEncCfg.m_chromaCrQpOffset, m_cEncCfg.m_chromaCrQpOffsetDualTree);
   msgApp( (int)LL_DETAILS, "GOP size                               : %d\n", m_cEncCfg.m_GOPSize );
   msgApp( (int)LL_DETAILS, "Input queue size                       : %d\n", m_cEncCfg.m_InputQueueSize );
+  msgApp( (int)LL_DETAILS, "Input queue max size                   : %d\n", m_cEncCfg.m_InputQueueMaxSize );
   msgApp( (int)LL_DETAILS, "Input bit depth                        : (Y:%d, C:%d)\n", m_cEncCfg.m_inputBitDepth[ 0 ], m_cEncCfg.m_inputBitDepth[ 1 ] );
   msgApp( (int)LL_DETAILS, "MSB-extended bit depth                 : (Y:%d, C:%d)\n", m_cEncCfg.m_MSBExtendedBitDepth[ 0 ], m_cEncCfg.m_MSBExtendedBitDepth[ 1 ] );
   msgApp( (int)LL_DETAILS, "Internal bit depth                     : (Y:%d, C:%d)\n", m_cEncCfg.m_internalBitDepth[ 0 ], m_cEncCfg.m_internalBitDepth[ 1 ] );
@@ -925,74 +1026,41 @@ int VVEncImpl::xCopyInputPlane( int16_t* pDes, const int iDesStride, const int i
   return 0;
 }
 
+int VVEncImpl::xCopyInputPlane( int16_t* pDes, const int iDesStride, const int iDesWidth, const int iDesHeight, const uint8_t* pSrc, const int iSrcStride, const int iSrcWidth, const int iSrcHeight, const int iMargin )
+{
+  for( int y = 0; y < iSrcHeight; y++ )
+  {
+    for( int x = 0; x < iSrcWidth; x++ )
+    {
+      pDes[x] = pSrc[x];
+    }
+    pSrc += iSrcStride;
+    pDes += iDesStride;
+  }
+
+  return 0;
+}
+
 
 int VVEncImpl::xCopyAu( VvcAccessUnit& rcVvcAccessUnit, const vvenc::AccessUnit& rcAu )
 {
   rcVvcAccessUnit.m_bRAP = false;
 
-  /* copy output AU */
+  /* copy output AU, the access unit already holds the complete annex B byte stream */
   if ( ! rcAu.empty() )
   {
-    uint32_t size = 0;  /* size of annexB unit in bytes */
-    for (vvenc::AccessUnit::const_iterator it = rcAu.begin(); it != rcAu.end(); it++)
-    {
-      const vvenc::NALUnitEBSP& nalu = **it;
-
-      if (it == rcAu.begin() ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_DCI ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_SPS ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_VPS ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_PPS ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_PREFIX_APS ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_SUFFIX_APS )
-      {
-        size += 4;
-      }
-      else
-      {
-        size += 3;
-      }
-      size += uint32_t(nalu.m_nalUnitData.str().size());
-    }
+    const uint32_t size = uint32_t( rcAu.getAnnexBSize() );  /* size of annexB unit in bytes */
 
     if( rcVvcAccessUnit.m_iBufSize < (int)size || rcVvcAccessUnit.m_pucBuffer == NULL )
     {
+      rcVvcAccessUnit.m_iUsedSize = size;  /* minimum buffer size to fetch the pending chunk */
       return VVENC_NOT_ENOUGH_MEM;
     }
 
-    uint32_t iUsedSize = 0;
-    for (vvenc::AccessUnit::const_iterator it = rcAu.begin(); it != rcAu.end(); it++)
-    {
-      const vvenc::NALUnitEBSP& nalu = **it;
-      static const uint8_t start_code_prefix[] = {0,0,0,1};
-      if (it == rcAu.begin() ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_DCI ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_SPS ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_VPS ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_PPS ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_PREFIX_APS ||
-          nalu.m_nalUnitType == vvenc::NAL_UNIT_SUFFIX_APS )
-      {
-        /* From AVC, When any of the following conditions are fulfilled, the
-         * zero_byte syntax element shall be present:
-         *  - the nal_unit_type within the nal_unit() is equal to 7 (sequence
-         *    parameter set) or 8 (picture parameter set),
-         *  - the byte stream NAL unit syntax structure contains the first NAL
-         *    unit of an access unit in decoding order, as specified by subclause
-         *    7.4.1.2.3.
-         */
-        ::memcpy( rcVvcAccessUnit.m_pucBuffer + iUsedSize, reinterpret_cast<const char*>(start_code_prefix), 4 );
-        iUsedSize += 4;
-      }
-      else
-      {
-        ::memcpy( rcVvcAccessUnit.m_pucBuffer + iUsedSize, reinterpret_cast<const char*>(start_code_prefix+1), 3 );
-        iUsedSize += 3;
-      }
-      uint32_t nalDataSize = uint32_t(nalu.m_nalUnitData.str().size()) ;
-      ::memcpy( rcVvcAccessUnit.m_pucBuffer + iUsedSize, nalu.m_nalUnitData.str().c_str() , nalDataSize );
-      iUsedSize += nalDataSize;
+    ::memcpy( rcVvcAccessUnit.m_pucBuffer, rcAu.getAnnexB(), size );
 
+    for ( const auto& nalu : rcAu )
+    {
       if( nalu.m_nalUnitType == vvenc::NAL_UNIT_CODED_SLICE_IDR_W_RADL ||
           nalu.m_nalUnitType == vvenc::NAL_UNIT_CODED_SLICE_IDR_N_LP ||
           nalu.m_nalUnitType == vvenc::NAL_UNIT_CODED_SLICE_CRA ||
@@ -1002,11 +1070,6 @@ int VVEncImpl::xCopyAu( VvcAccessUnit& rcVvcAccessUnit, const vvenc::AccessUnit&
       }
     }
 
-    if( iUsedSize != size  )
-    {
-      return VVENC_NOT_ENOUGH_MEM;
-    }
-
     rcVvcAccessUnit.m_iUsedSize = size;
     rcVvcAccessUnit.m_bCtsValid = rcAu.m_bCtsValid;
     rcVvcAccessUnit.m_bDtsValid = rcAu.m_bDtsValid;
@@ -1024,6 +1087,17 @@ int VVEncImpl::xCopyAu( VvcAccessUnit& rcVvcAccessUnit, const vvenc::AccessUnit&
   return 0;
 }
 
+int VVEncImpl::xCopyPendingAu( VvcAccessUnit& rcVvcAccessUnit )
+{
+  const int iRet = xCopyAu( rcVvcAccessUnit, m_cAu );
+  if( iRet == VVENC_OK )
+  {
+    /* delivered, otherwise the chunk is kept for the retry after VVENC_NOT_ENOUGH_MEM */
+    m_cAu.reset();
+  }
+  return iRet;
+}
+
 void VVEncImpl::msgApp( int level, const char* fmt, ... )
 {
     va_list args;
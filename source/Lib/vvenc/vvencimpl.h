@@ -52,6 +52,7 @@ vvc@hhi.fraunhofer.de
 #include <chrono>
 #include "../../../include/vvenc/EncCfg.h"
 #include "../../../include/vvenc/EncoderIf.h"
+#include "../../../include/vvenc/Nal.h"
 #include "../../../include/vvenc/vvenc.h"
 
 namespace vvenc {
@@ -75,6 +76,7 @@ public:
 
   int encode( InputPicture* pcInputPicture, VvcAccessUnit& rcVvcAccessUnit);
   int flush( VvcAccessUnit& rcVvcAccessUnit );
+  int getQueueStatus( InputQueueStatus& rcQueueStatus );
 
   int getPreferredBuffer( PicBuffer &rcPicBuffer );
   int getConfig( VVEncParameter& rcVVEncParameter );
@@ -100,7 +102,10 @@ private:
 
   int xCopyInputPlane( int16_t* pDes, const int iDesStride, const int iDesWidth, const int iDesHeight,
                        const int16_t* pSrc, const int iSrcStride, const int iSrcWidth, const int iSrcHeight, const int iMargin );
+  int xCopyInputPlane( int16_t* pDes, const int iDesStride, const int iDesWidth, const int iDesHeight,
+                       const uint8_t* pSrc, const int iSrcStride, const int iSrcWidth, const int iSrcHeight, const int iMargin );
   int xCopyAu( VvcAccessUnit& rcVvcAccessUnit, const vvenc::AccessUnit& rcAu );
+  int xCopyPendingAu( VvcAccessUnit& rcVvcAccessUnit );
 
   static void msgApp( int level, const char* fmt, ... );
   static void msgFnc( int level, const char* fmt, va_list args );
@@ -113,6 +118,7 @@ public:
   bool                                                        m_bInitialized         = false;
 
   vvenc::EncoderIf                                            m_cEncoderIf;                      ///< encoder library class
+  vvenc::AccessUnit                                           m_cAu;                             ///< output access unit, its byte stream memory is reused for every picture
 
   VVEncParameter                                              m_cVVEncParameter;
   vvenc::EncCfg                                               m_cEncCfg;